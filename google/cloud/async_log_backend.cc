@@ -0,0 +1,164 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/async_log_backend.h"
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+std::size_t RoundUpToPowerOfTwo(std::size_t capacity) {
+  std::size_t size = 2;
+  while (size < capacity) {
+    size *= 2;
+  }
+  return size;
+}
+}  // namespace
+
+AsyncLogBackend::AsyncLogBackend(std::shared_ptr<LogBackend> backend,
+                                 std::size_t capacity)
+    : backend_(std::move(backend)),
+      slots_(RoundUpToPowerOfTwo(capacity)),
+      mask_(slots_.size() - 1),
+      enqueue_position_(0),
+      forwarded_position_(0),
+      dropped_count_(0),
+      dequeue_position_(0),
+      writer_sleeping_(false),
+      shutdown_(false) {
+  for (std::size_t i = 0; i != slots_.size(); ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  writer_ = std::thread([this] { WriterLoop(); });
+}
+
+AsyncLogBackend::~AsyncLogBackend() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_one();
+  writer_.join();
+}
+
+void AsyncLogBackend::Process(LogRecord const& log_record) {
+  Push(log_record);
+}
+
+void AsyncLogBackend::ProcessWithOwnership(LogRecord log_record) {
+  Push(std::move(log_record));
+}
+
+void AsyncLogBackend::Flush() {
+  auto const target = enqueue_position_.load();
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.notify_one();
+  // Dropped records do not claim a position, so all the positions before
+  // `target` eventually reach the writer.
+  flushed_.wait(
+      lk, [this, target] { return forwarded_position_.load() >= target; });
+}
+
+void AsyncLogBackend::Push(LogRecord log_record) {
+  auto position = enqueue_position_.load(std::memory_order_relaxed);
+  for (;;) {
+    auto& slot = slots_[position & mask_];
+    auto const sequence = slot.sequence.load(std::memory_order_acquire);
+    auto const diff = static_cast<std::ptrdiff_t>(sequence) -
+                      static_cast<std::ptrdiff_t>(position);
+    if (diff < 0) {
+      // The slot still holds a record from the previous lap, the buffer is
+      // full.
+      ++dropped_count_;
+      return;
+    }
+    if (diff > 0) {
+      // Another thread claimed this position, try again with the new one.
+      position = enqueue_position_.load(std::memory_order_relaxed);
+      continue;
+    }
+    if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+      slot.record = std::move(log_record);
+      // Both this store and the load of `writer_sleeping_` are sequentially
+      // consistent, so either the writer sees the record before going to
+      // sleep, or this thread sees the writer is sleeping.
+      slot.sequence.store(position + 1);
+      if (writer_sleeping_.load()) {
+        std::lock_guard<std::mutex> lk(mu_);
+        cv_.notify_one();
+      }
+      return;
+    }
+  }
+}
+
+bool AsyncLogBackend::Pop(LogRecord& log_record) {
+  if (!HasPending()) {
+    return false;
+  }
+  auto& slot = slots_[dequeue_position_ & mask_];
+  log_record = std::move(slot.record);
+  slot.sequence.store(dequeue_position_ + slots_.size(),
+                      std::memory_order_release);
+  ++dequeue_position_;
+  return true;
+}
+
+bool AsyncLogBackend::HasPending() const {
+  return slots_[dequeue_position_ & mask_].sequence.load() ==
+         dequeue_position_ + 1;
+}
+
+void AsyncLogBackend::WriterLoop() {
+  std::uint64_t reported_drops = 0;
+  LogRecord log_record;
+  for (;;) {
+    while (Pop(log_record)) {
+      backend_->ProcessWithOwnership(std::move(log_record));
+      forwarded_position_.store(dequeue_position_);
+    }
+    auto const dropped = dropped_count_.load();
+    if (dropped != reported_drops) {
+      LogRecord record;
+      record.severity = Severity::GCP_LS_WARNING;
+      record.function = __func__;
+      record.filename = __FILE__;
+      record.lineno = __LINE__;
+      record.timestamp = std::chrono::system_clock::now();
+      record.message = "AsyncLogBackend dropped " +
+                       std::to_string(dropped - reported_drops) +
+                       " log records, the buffer was full";
+      backend_->ProcessWithOwnership(std::move(record));
+      reported_drops = dropped;
+    }
+
+    std::unique_lock<std::mutex> lk(mu_);
+    flushed_.notify_all();
+    writer_sleeping_.store(true);
+    if (!HasPending()) {
+      if (shutdown_) {
+        return;
+      }
+      cv_.wait(lk);
+    }
+    writer_sleeping_.store(false);
+  }
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
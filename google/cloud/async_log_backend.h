@@ -0,0 +1,119 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_ASYNC_LOG_BACKEND_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_ASYNC_LOG_BACKEND_H_
+
+#include "google/cloud/log.h"
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+/**
+ * A log backend that forwards the records to another backend in a background
+ * thread.
+ *
+ * Writing log records, for example to `std::clog`, is slow and serializes all
+ * the threads that log. This backend queues the records in a bounded ring
+ * buffer, and a background thread forwards them to the wrapped backend. The
+ * threads that log never block: if the buffer is full the record is dropped,
+ * and the number of dropped records is reported (with `WARNING` severity)
+ * once there is space again.
+ *
+ * @par Example
+ * @code
+ * auto backend = std::make_shared<google::cloud::AsyncLogBackend>(
+ *     std::make_shared<MyBackend>(), 16384);
+ * google::cloud::LogSink::Instance().AddBackend(backend);
+ * @endcode
+ *
+ * The wrapped backend is only called from the background thread. Records are
+ * forwarded in the order they were queued. The destructor forwards any queued
+ * records before returning.
+ */
+class AsyncLogBackend : public LogBackend {
+ public:
+  /**
+   * Create a backend forwarding to @p backend.
+   *
+   * @param backend the backend receiving the records.
+   * @param capacity the maximum number of queued records, rounded up to a
+   *     power of two.
+   */
+  explicit AsyncLogBackend(std::shared_ptr<LogBackend> backend,
+                           std::size_t capacity = 8192);
+  ~AsyncLogBackend() override;
+
+  AsyncLogBackend(AsyncLogBackend const&) = delete;
+  AsyncLogBackend& operator=(AsyncLogBackend const&) = delete;
+
+  void Process(LogRecord const& log_record) override;
+  void ProcessWithOwnership(LogRecord log_record) override;
+
+  /// Block until all the records queued before this call are forwarded.
+  void Flush();
+
+  std::size_t capacity() const { return slots_.size(); }
+
+  /// The number of records dropped because the buffer was full.
+  std::uint64_t dropped_count() const { return dropped_count_.load(); }
+
+ private:
+  /**
+   * A slot in the ring buffer.
+   *
+   * The ring buffer is a bounded multi-producer queue: each slot has a
+   * sequence number that tells producers and the consumer whether the slot is
+   * free or holds a record for a given position.
+   */
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    LogRecord record;
+  };
+
+  void Push(LogRecord log_record);
+
+  //@{
+  /// @name Only called from the writer thread.
+  bool Pop(LogRecord& log_record);
+  bool HasPending() const;
+  void WriterLoop();
+  //@}
+
+  std::shared_ptr<LogBackend> backend_;
+  std::vector<Slot> slots_;
+  std::size_t const mask_;
+  std::atomic<std::size_t> enqueue_position_;
+  std::atomic<std::size_t> forwarded_position_;
+  std::atomic<std::uint64_t> dropped_count_;
+  std::size_t dequeue_position_;
+
+  /// Wakes up the writer thread when it has nothing to do.
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::condition_variable flushed_;
+  std::atomic<bool> writer_sleeping_;
+  bool shutdown_;
+  std::thread writer_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_ASYNC_LOG_BACKEND_H_
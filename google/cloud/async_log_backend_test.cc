@@ -0,0 +1,193 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/async_log_backend.h"
+#include <gmock/gmock.h>
+#include <future>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+using ::testing::HasSubstr;
+
+/// Capture the messages and the threads that process them.
+class CaptureBackend : public LogBackend {
+ public:
+  void Process(LogRecord const& lr) override { ProcessWithOwnership(lr); }
+  void ProcessWithOwnership(LogRecord lr) override {
+    std::lock_guard<std::mutex> lk(mu);
+    messages.push_back(std::move(lr.message));
+    thread_ids.push_back(std::this_thread::get_id());
+  }
+
+  std::vector<std::string> Messages() {
+    std::lock_guard<std::mutex> lk(mu);
+    return messages;
+  }
+
+  std::mutex mu;
+  std::vector<std::string> messages;
+  std::vector<std::thread::id> thread_ids;
+};
+
+LogRecord MakeRecord(std::string message) {
+  LogRecord record;
+  record.severity = Severity::GCP_LS_DEBUG;
+  record.function = __func__;
+  record.filename = __FILE__;
+  record.lineno = __LINE__;
+  record.timestamp = std::chrono::system_clock::now();
+  record.message = std::move(message);
+  return record;
+}
+
+/// @test Verify that the records are forwarded, in order, by another thread.
+TEST(AsyncLogBackendTest, ForwardsInOrder) {
+  auto capture = std::make_shared<CaptureBackend>();
+  AsyncLogBackend backend(capture, 1000);
+  EXPECT_EQ(1024U, backend.capacity());
+
+  std::vector<std::string> expected;
+  for (int i = 0; i != 100; ++i) {
+    expected.push_back("message " + std::to_string(i));
+    if (i % 2 == 0) {
+      backend.ProcessWithOwnership(MakeRecord(expected.back()));
+    } else {
+      backend.Process(MakeRecord(expected.back()));
+    }
+  }
+  backend.Flush();
+  EXPECT_EQ(expected, capture->Messages());
+  EXPECT_EQ(0U, backend.dropped_count());
+  for (auto const& id : capture->thread_ids) {
+    EXPECT_NE(std::this_thread::get_id(), id);
+  }
+}
+
+/// @test Verify that records are dropped, and counted, when the buffer is full.
+TEST(AsyncLogBackendTest, DropsWhenFull) {
+  std::promise<void> entered;
+  std::promise<void> unblock;
+  auto unblock_future = unblock.get_future().share();
+
+  class BlockingBackend : public CaptureBackend {
+   public:
+    BlockingBackend(std::promise<void>& entered,
+                    std::shared_future<void> unblock)
+        : entered_(entered), unblock_(std::move(unblock)) {}
+
+    void ProcessWithOwnership(LogRecord lr) override {
+      if (first_) {
+        first_ = false;
+        entered_.set_value();
+        unblock_.wait();
+      }
+      CaptureBackend::ProcessWithOwnership(std::move(lr));
+    }
+
+   private:
+    bool first_ = true;
+    std::promise<void>& entered_;
+    std::shared_future<void> unblock_;
+  };
+  auto capture = std::make_shared<BlockingBackend>(entered, unblock_future);
+
+  AsyncLogBackend backend(capture, 2);
+  EXPECT_EQ(2U, backend.capacity());
+  backend.Process(MakeRecord("m0"));
+  // Wait until the writer thread is blocked processing the first record, the
+  // buffer is empty at this point.
+  entered.get_future().wait();
+  for (int i = 1; i != 6; ++i) {
+    backend.Process(MakeRecord("m" + std::to_string(i)));
+  }
+  EXPECT_EQ(3U, backend.dropped_count());
+  unblock.set_value();
+  backend.Flush();
+
+  auto messages = capture->Messages();
+  ASSERT_EQ(4U, messages.size());
+  EXPECT_EQ("m0", messages[0]);
+  EXPECT_EQ("m1", messages[1]);
+  EXPECT_EQ("m2", messages[2]);
+  EXPECT_THAT(messages[3], HasSubstr("dropped 3 log records"));
+}
+
+/// @test Verify that records from many threads are all forwarded.
+TEST(AsyncLogBackendTest, ManyProducers) {
+  auto capture = std::make_shared<CaptureBackend>();
+  AsyncLogBackend backend(capture, 4096);
+
+  int const kThreads = 4;
+  int const kRecords = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&backend, t] {
+      for (int i = 0; i != kRecords; ++i) {
+        backend.ProcessWithOwnership(
+            MakeRecord(std::to_string(t) + " " + std::to_string(i)));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  backend.Flush();
+
+  // The records from each thread must be in order.
+  std::vector<int> next(kThreads, 0);
+  auto messages = capture->Messages();
+  EXPECT_EQ(static_cast<std::size_t>(kThreads * kRecords), messages.size());
+  for (auto const& m : messages) {
+    std::istringstream is(m);
+    int t;
+    int i;
+    is >> t >> i;
+    EXPECT_EQ(next[t], i);
+    next[t] = i + 1;
+  }
+  EXPECT_EQ(0U, backend.dropped_count());
+}
+
+/// @test Verify that the destructor forwards the queued records.
+TEST(AsyncLogBackendTest, DestructorDrains) {
+  auto capture = std::make_shared<CaptureBackend>();
+  {
+    AsyncLogBackend backend(capture);
+    for (int i = 0; i != 10; ++i) {
+      backend.Process(MakeRecord("message"));
+    }
+  }
+  EXPECT_EQ(10U, capture->Messages().size());
+}
+
+/// @test Verify that AsyncLogBackend works as a LogSink backend.
+TEST(AsyncLogBackendTest, WithLogSink) {
+  auto capture = std::make_shared<CaptureBackend>();
+  auto backend = std::make_shared<AsyncLogBackend>(capture);
+  LogSink sink;
+  sink.AddBackend(backend);
+  GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, sink) << "test message";
+  backend->Flush();
+  auto messages = capture->Messages();
+  ASSERT_EQ(1U, messages.size());
+  EXPECT_EQ("test message", messages[0]);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
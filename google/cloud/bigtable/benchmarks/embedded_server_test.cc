@@ -145,3 +145,24 @@ TEST(EmbeddedServer, ReadRows100) {
   server->Shutdown();
   wait_thread.join();
 }
+
+TEST(EmbeddedServer, SampleRowKeys) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server->address());
+  bigtable::Table table(bigtable::CreateDefaultDataClient(
+                            "fake-project", "fake-instance", options),
+                        "fake-table");
+
+  EXPECT_EQ(0, server->sample_row_keys_count());
+  auto samples = table.SampleRows<std::vector>();
+  ASSERT_EQ(11U, samples.size());
+  EXPECT_EQ("user0", samples.front().row_key);
+  EXPECT_EQ("", samples.back().row_key);
+  EXPECT_EQ(1, server->sample_row_keys_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
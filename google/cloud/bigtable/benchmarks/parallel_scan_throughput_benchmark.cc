@@ -0,0 +1,138 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @file
+ *
+ * Measure how the throughput of `bigtable::Table::ParallelReadRows()` scales
+ * with the number of shards.
+ *
+ * This benchmark is a variation of `scan_throughput_benchmark`. It uses the
+ * same table layout and upload phase, but instead of scanning short ranges the
+ * main phase of the benchmark:
+ *
+ * - Executes the following block with 1, 2, 4, 8, and 16 shards:
+ *   - Execute the following loop for S seconds (at least once):
+ *     - Scan the full table using `ParallelReadRows()`, without requiring the
+ *       rows to be delivered in order.
+ *
+ * The benchmark reports the throughput in rows per second for each shard
+ * count. With a single shard `ParallelReadRows()` uses one stream, which is a
+ * good baseline for a plain `ReadRows()` scan.
+ *
+ * Using a command-line parameter the benchmark can be configured to create a
+ * local gRPC server that implements the Cloud Bigtable APIs used by the
+ * benchmark.  If this parameter is not used, the benchmark uses the default
+ * configuration, that is, a production instance of Cloud Bigtable unless the
+ * CLOUD_BIGTABLE_EMULATOR environment variable is set.
+ */
+
+/// Helper functions and types for the parallel_scan_throughput_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+constexpr std::size_t kShardCounts[] = {1, 2, 4, 8, 16};
+
+/// Run an iteration of the test.
+BenchmarkResult RunBenchmark(std::shared_ptr<bigtable::DataClient> data_client,
+                             bigtable::AppProfileId app_profile_id,
+                             std::string const& table_id,
+                             std::size_t shard_count,
+                             std::chrono::seconds test_duration);
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  bigtable::benchmarks::BenchmarkSetup setup("pscan", argc, argv);
+
+  Benchmark benchmark(setup);
+
+  // Create and populate the table for the benchmark.
+  benchmark.CreateTable();
+  auto populate_results = benchmark.PopulateTable();
+  benchmark.PrintThroughputResult(std::cout, "pscan", "Upload",
+                                  populate_results);
+
+  auto data_client = benchmark.MakeDataClient();
+  std::map<std::string, BenchmarkResult> results_by_shards;
+  for (auto shard_count : kShardCounts) {
+    std::cout << "# Running benchmark [" << shard_count << "] " << std::flush;
+    auto start = std::chrono::steady_clock::now();
+    auto combined = RunBenchmark(
+        data_client, bigtable::AppProfileId(setup.app_profile_id()),
+        setup.table_id(), shard_count, setup.test_duration());
+    using std::chrono::duration_cast;
+    combined.elapsed = duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << " DONE. Elapsed=" << FormatDuration(combined.elapsed)
+              << ", Ops=" << combined.operations.size()
+              << ", Rows=" << combined.row_count << std::endl;
+    std::ostringstream os;
+    os << "ParallelScan(" << std::setw(2) << std::setfill('0') << shard_count
+       << ")";
+    auto op_name = os.str();
+    benchmark.PrintThroughputResult(std::cout, "pscan", op_name, combined);
+    results_by_shards[op_name] = std::move(combined);
+  }
+
+  std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << std::endl;
+  benchmark.PrintResultCsv(std::cout, "pscan", "BulkApply()", "Latency",
+                           populate_results);
+  for (auto& kv : results_by_shards) {
+    benchmark.PrintResultCsv(std::cout, "pscan", kv.first, "IterationTime",
+                             kv.second);
+  }
+
+  benchmark.DeleteTable();
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
+
+namespace {
+BenchmarkResult RunBenchmark(std::shared_ptr<bigtable::DataClient> data_client,
+                             bigtable::AppProfileId app_profile_id,
+                             std::string const& table_id,
+                             std::size_t shard_count,
+                             std::chrono::seconds test_duration) {
+  BenchmarkResult result = {};
+
+  bigtable::Table table(std::move(data_client), app_profile_id, table_id);
+
+  auto test_start = std::chrono::steady_clock::now();
+  do {
+    std::atomic<long> count(0);
+    auto op = [&count, &table, shard_count]() {
+      table.ParallelReadRows(
+          bigtable::RowSet(),
+          bigtable::Filter::ColumnRangeClosed(kColumnFamily, "field0",
+                                              "field9"),
+          shard_count, [&count](bigtable::Row) { ++count; });
+    };
+    result.operations.push_back(Benchmark::TimeOperation(op));
+    result.row_count += count.load();
+  } while (std::chrono::steady_clock::now() < test_start + test_duration);
+  return result;
+}
+
+}  // anonymous namespace
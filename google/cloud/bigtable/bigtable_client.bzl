@@ -28,6 +28,7 @@ bigtable_client_hdrs = [
     "cluster_config.h",
     "column_family.h",
     "completion_queue.h",
+    "completion_queue_executor.h",
     "data_client.h",
     "filters.h",
     "grpc_error.h",
@@ -37,6 +38,7 @@ bigtable_client_hdrs = [
     "instance_update_config.h",
     "internal/async_bulk_apply.h",
     "internal/async_check_consistency.h",
+    "internal/async_flow_controlled_row_reader.h",
     "internal/async_future_from_callback.h",
     "internal/async_list_app_profiles.h",
     "internal/async_list_clusters.h",
@@ -60,26 +62,35 @@ bigtable_client_hdrs = [
     "internal/endian.h",
     "internal/grpc_error_delegate.h",
     "internal/instance_admin.h",
+    "internal/load_tracking_reader.h",
+    "internal/parallel_read_rows.h",
     "internal/poll_longrunning_operation.h",
     "internal/prefix_range_end.h",
     "internal/readrowsparser.h",
     "internal/rpc_policy_parameters.inc",
     "internal/rpc_policy_parameters.h",
     "internal/rowreaderiterator.h",
+    "internal/rpc_tracer.h",
     "internal/strong_type.h",
     "internal/table.h",
     "internal/table_admin.h",
     "internal/unary_client_utils.h",
+    "internal/work_stealing_pool.h",
     "idempotent_mutation_policy.h",
     "mutations.h",
+    "mutation_batcher.h",
     "polling_policy.h",
+    "read_hedging_policy.h",
     "read_modify_write_rule.h",
     "row.h",
+    "row_cache.h",
     "row_key_sample.h",
     "row_range.h",
     "row_reader.h",
     "row_set.h",
     "rpc_backoff_policy.h",
+    "rpc_instrumentation.h",
+    "rpc_latency_histogram.h",
     "rpc_retry_policy.h",
     "metadata_update_policy.h",
     "table.h",
@@ -95,6 +106,7 @@ bigtable_client_srcs = [
     "client_options.cc",
     "cluster_config.cc",
     "completion_queue.cc",
+    "completion_queue_executor.cc",
     "data_client.cc",
     "grpc_error.cc",
     "instance_admin_client.cc",
@@ -108,18 +120,26 @@ bigtable_client_srcs = [
     "internal/endian.cc",
     "internal/grpc_error_delegate.cc",
     "internal/instance_admin.cc",
+    "internal/parallel_read_rows.cc",
     "internal/prefix_range_end.cc",
     "internal/readrowsparser.cc",
     "internal/rowreaderiterator.cc",
+    "internal/rpc_tracer.cc",
     "internal/table.cc",
     "internal/table_admin.cc",
+    "internal/work_stealing_pool.cc",
     "idempotent_mutation_policy.cc",
     "mutations.cc",
+    "mutation_batcher.cc",
     "polling_policy.cc",
+    "read_hedging_policy.cc",
+    "row_cache.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
     "rpc_backoff_policy.cc",
+    "rpc_instrumentation.cc",
+    "rpc_latency_histogram.cc",
     "rpc_retry_policy.cc",
     "metadata_update_policy.cc",
     "table.cc",
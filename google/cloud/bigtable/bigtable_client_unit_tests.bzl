@@ -25,6 +25,7 @@ bigtable_client_unit_tests = [
     "cluster_config_test.cc",
     "column_family_test.cc",
     "completion_queue_test.cc",
+    "completion_queue_executor_test.cc",
     "data_client_test.cc",
     "filters_test.cc",
     "force_sanitizer_failures_test.cc",
@@ -45,33 +46,43 @@ bigtable_client_unit_tests = [
     "internal/async_retry_op_test.cc",
     "internal/async_retry_unary_rpc_and_poll_test.cc",
     "internal/bulk_mutator_test.cc",
+    "internal/common_client_test.cc",
     "internal/table_async_check_and_mutate_row_test.cc",
     "internal/instance_admin_test.cc",
     "internal/grpc_error_delegate_test.cc",
+    "internal/parallel_read_rows_test.cc",
     "internal/prefix_range_end_test.cc",
     "internal/table_admin_test.cc",
     "internal/table_async_apply_test.cc",
     "internal/table_async_bulk_apply_test.cc",
+    "internal/table_async_flow_controlled_row_reader_test.cc",
     "internal/table_async_row_reader_test.cc",
     "internal/table_async_sample_row_keys_test.cc",
+    "internal/table_rpc_instrumentation_test.cc",
     "internal/table_test.cc",
+    "internal/work_stealing_pool_test.cc",
     "mutations_test.cc",
+    "mutation_batcher_test.cc",
     "table_admin_test.cc",
     "table_apply_test.cc",
     "table_bulk_apply_test.cc",
     "table_check_and_mutate_row_test.cc",
     "table_config_test.cc",
+    "table_parallel_readrows_test.cc",
     "table_readrow_test.cc",
     "table_readrows_test.cc",
     "table_sample_row_keys_test.cc",
     "table_test.cc",
     "table_readmodifywriterow_test.cc",
+    "read_hedging_policy_test.cc",
     "read_modify_write_rule_test.cc",
+    "row_cache_test.cc",
     "row_reader_test.cc",
     "row_test.cc",
     "row_range_test.cc",
     "row_set_test.cc",
     "rpc_backoff_policy_test.cc",
+    "rpc_latency_histogram_test.cc",
     "metadata_update_policy_test.cc",
     "rpc_retry_policy_test.cc",
     "polling_policy_test.cc",
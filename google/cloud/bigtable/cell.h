@@ -19,12 +19,18 @@
 #include "google/cloud/bigtable/version.h"
 
 #include <chrono>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+class ReadRowsParser;
+}  // namespace internal
+
 /**
  * The in-memory representation of a Bigtable cell.
  *
@@ -34,7 +40,9 @@ inline namespace BIGTABLE_CLIENT_NS {
  * storage is sparse, column families, columns, and timestamps might contain
  * zero cells.
  *
- * The Cell class owns all its data.
+ * The Cell class owns all its data. The row key, family and column names are
+ * immutable, and cells created by the library share them with the other cells
+ * in the same row (or with the same column) instead of holding a copy.
  */
 class Cell {
  public:
@@ -42,9 +50,11 @@ class Cell {
   Cell(std::string row_key, std::string family_name,
        std::string column_qualifier, std::int64_t timestamp, std::string value,
        std::vector<std::string> labels)
-      : row_key_(std::move(row_key)),
-        family_name_(std::move(family_name)),
-        column_qualifier_(std::move(column_qualifier)),
+      : row_key_(std::make_shared<std::string const>(std::move(row_key))),
+        family_name_(
+            std::make_shared<std::string const>(std::move(family_name))),
+        column_qualifier_(
+            std::make_shared<std::string const>(std::move(column_qualifier))),
         timestamp_(timestamp),
         value_(std::move(value)),
         labels_(std::move(labels)) {}
@@ -53,24 +63,26 @@ class Cell {
   Cell(std::string row_key, std::string family_name,
        std::string column_qualifier, std::int64_t timestamp,
        bigendian64_t value, std::vector<std::string> labels)
-      : row_key_(std::move(row_key)),
-        family_name_(std::move(family_name)),
-        column_qualifier_(std::move(column_qualifier)),
+      : row_key_(std::make_shared<std::string const>(std::move(row_key))),
+        family_name_(
+            std::make_shared<std::string const>(std::move(family_name))),
+        column_qualifier_(
+            std::make_shared<std::string const>(std::move(column_qualifier))),
         timestamp_(timestamp),
         value_(google::cloud::bigtable::internal::AsBigEndian64(value)),
         labels_(std::move(labels)) {}
 
   /// Return the row key this cell belongs to. The returned value is not valid
   /// after this object is deleted.
-  std::string const& row_key() const { return row_key_; }
+  std::string const& row_key() const { return *row_key_; }
 
   /// Return the family this cell belongs to. The returned value is not valid
   /// after this object is deleted.
-  std::string const& family_name() const { return family_name_; }
+  std::string const& family_name() const { return *family_name_; }
 
   /// Return the column this cell belongs to. The returned value is not valid
   /// after this object is deleted.
-  std::string const& column_qualifier() const { return column_qualifier_; }
+  std::string const& column_qualifier() const { return *column_qualifier_; }
 
   /// Return the timestamp of this cell.
   std::chrono::microseconds timestamp() const {
@@ -99,9 +111,30 @@ class Cell {
   std::vector<std::string> const& labels() const { return labels_; }
 
  private:
-  std::string row_key_;
-  std::string family_name_;
-  std::string column_qualifier_;
+  friend class internal::ReadRowsParser;
+
+  /**
+   * Create a Cell sharing the row key and names with other cells.
+   *
+   * Full table scans create millions of cells, with the same handful of row
+   * keys, families and columns. Sharing them avoids allocating three strings
+   * for each cell.
+   */
+  Cell(std::shared_ptr<std::string const> row_key,
+       std::shared_ptr<std::string const> family_name,
+       std::shared_ptr<std::string const> column_qualifier,
+       std::int64_t timestamp, std::string value,
+       std::vector<std::string> labels)
+      : row_key_(std::move(row_key)),
+        family_name_(std::move(family_name)),
+        column_qualifier_(std::move(column_qualifier)),
+        timestamp_(timestamp),
+        value_(std::move(value)),
+        labels_(std::move(labels)) {}
+
+  std::shared_ptr<std::string const> row_key_;
+  std::shared_ptr<std::string const> family_name_;
+  std::shared_ptr<std::string const> column_qualifier_;
   std::int64_t timestamp_;
   std::string value_;
   std::vector<std::string> labels_;
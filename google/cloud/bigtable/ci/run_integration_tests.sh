@@ -67,7 +67,8 @@ fi
 # consistent enough to use the results, but we want to detect crashes and ensure
 # the code at least is able to run as soon as possible.
 log="$(mktemp -t "bigtable_benchmarks.XXXXXX")"
-for benchmark in endurance apply_read_latency scan_throughput; do
+for benchmark in endurance apply_read_latency scan_throughput \
+    parallel_scan_throughput; do
   if [ ! -x "${BTDIR}/benchmarks/${benchmark}_benchmark" ]; then
     echo "${COLOR_YELLOW}[ SKIPPED  ]${COLOR_RESET} ${benchmark} benchmark"
     continue
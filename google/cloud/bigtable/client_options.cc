@@ -25,6 +25,12 @@
 #define BIGTABLE_CLIENT_DEFAULT_CHANNELS_PER_CPU 2
 #endif  // BIGTABLE_CLIENT_DEFAULT_CHANNELS_PER_CPU
 
+#ifndef BIGTABLE_CLIENT_DEFAULT_MAX_STREAMS_PER_CONNECTION
+// Most HTTP/2 servers limit the number of concurrent streams per connection to
+// 100, streams above that limit are queued in the client.
+#define BIGTABLE_CLIENT_DEFAULT_MAX_STREAMS_PER_CONNECTION 100
+#endif  // BIGTABLE_CLIENT_DEFAULT_MAX_STREAMS_PER_CONNECTION
+
 #ifndef BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH
 #define BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH (256 * 1024L * 1024L)
 #endif  // BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH
@@ -58,6 +64,9 @@ inline std::size_t CalculateDefaultConnectionPoolSize() {
 ClientOptions::ClientOptions(std::shared_ptr<grpc::ChannelCredentials> creds)
     : credentials_(std::move(creds)),
       connection_pool_size_(CalculateDefaultConnectionPoolSize()),
+      max_connection_pool_size_(0),
+      max_streams_per_connection_(
+          BIGTABLE_CLIENT_DEFAULT_MAX_STREAMS_PER_CONNECTION),
       data_endpoint_("bigtable.googleapis.com"),
       admin_endpoint_("bigtableadmin.googleapis.com"),
       instance_admin_endpoint_("bigtableadmin.googleapis.com") {
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CLIENT_OPTIONS_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CLIENT_OPTIONS_H_
 
+#include "google/cloud/bigtable/rpc_instrumentation.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include <grpcpp/grpcpp.h>
@@ -114,6 +115,55 @@ class ClientOptions {
   }
   std::size_t connection_pool_size() const { return connection_pool_size_; }
 
+  /**
+   * Set the maximum size of the connection pool.
+   *
+   * The client tracks the number of outstanding streaming RPCs on each
+   * connection. When all the connections have at least
+   * `max_streams_per_connection()` outstanding streams the pool grows, one
+   * connection at a time, up to this size. Long running streams, such as large
+   * `ReadRows()` scans, can then no longer starve other requests.
+   *
+   * The default (zero) disables growth, the pool keeps
+   * `connection_pool_size()` connections.
+   */
+  ClientOptions& set_max_connection_pool_size(std::size_t size) {
+    max_connection_pool_size_ = size;
+    return *this;
+  }
+  std::size_t max_connection_pool_size() const {
+    return max_connection_pool_size_;
+  }
+
+  /// Set the number of outstanding streams on a connection to grow the pool.
+  ClientOptions& set_max_streams_per_connection(std::size_t count) {
+    if (count == 0) {
+      google::cloud::internal::ThrowRangeError(
+          "ClientOptions::set_max_streams_per_connection requires count > 0");
+    }
+    max_streams_per_connection_ = count;
+    return *this;
+  }
+  std::size_t max_streams_per_connection() const {
+    return max_streams_per_connection_;
+  }
+
+  /**
+   * Report the latency and retries of each `Table` operation.
+   *
+   * The default (null) disables the instrumentation.
+   *
+   * @see RpcLatencyHistogram for a ready to use implementation.
+   */
+  ClientOptions& set_rpc_instrumentation(
+      std::shared_ptr<RpcInstrumentation> instrumentation) {
+    rpc_instrumentation_ = std::move(instrumentation);
+    return *this;
+  }
+  std::shared_ptr<RpcInstrumentation> const& rpc_instrumentation() const {
+    return rpc_instrumentation_;
+  }
+
   /// Return the current credentials.
   std::shared_ptr<grpc::ChannelCredentials> credentials() const {
     return credentials_;
@@ -300,6 +350,9 @@ class ClientOptions {
   grpc::ChannelArguments channel_arguments_;
   std::string connection_pool_name_;
   std::size_t connection_pool_size_;
+  std::size_t max_connection_pool_size_;
+  std::size_t max_streams_per_connection_;
+  std::shared_ptr<RpcInstrumentation> rpc_instrumentation_;
   std::string data_endpoint_;
   std::string admin_endpoint_;
   // The endpoint for instance admin operations, in most scenarios this should
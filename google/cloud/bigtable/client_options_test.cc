@@ -165,6 +165,32 @@ TEST(ClientOptionsTest, InvalidConnectionPoolSize) {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
 
+TEST(ClientOptionsTest, EditMaxConnectionPoolSize) {
+  bigtable::ClientOptions client_options_object(
+      grpc::InsecureChannelCredentials());
+  EXPECT_EQ(0UL, client_options_object.max_connection_pool_size());
+  auto& returned = client_options_object.set_max_connection_pool_size(64);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(64UL, returned.max_connection_pool_size());
+}
+
+TEST(ClientOptionsTest, EditMaxStreamsPerConnection) {
+  bigtable::ClientOptions client_options_object(
+      grpc::InsecureChannelCredentials());
+  EXPECT_EQ(100UL, client_options_object.max_streams_per_connection());
+  auto& returned = client_options_object.set_max_streams_per_connection(8);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(8UL, returned.max_streams_per_connection());
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(client_options_object.set_max_streams_per_connection(0),
+               std::range_error);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      client_options_object.set_max_streams_per_connection(0),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
 TEST(ClientOptionsTest, SetGrpclbFallbackTimeoutMS) {
   // Test milliseconds are set properly to channel_arguments
   bigtable::ClientOptions client_options_object = bigtable::ClientOptions();
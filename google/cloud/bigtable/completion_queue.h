@@ -205,6 +205,54 @@ class CompletionQueue {
     return op;
   }
 
+  /**
+   * Make an asynchronous streaming RPC where the consumer controls the pace.
+   *
+   * Like `MakeUnaryStreamRpc()`, but @p data_functor returns a `future<bool>`.
+   * The next response is not requested until that future is satisfied, and if
+   * it is satisfied with `false` the stream is cancelled. Use this when the
+   * consumer may be slower than the stream, to avoid buffering responses.
+   *
+   * @tparam DataFunctor the type of the callback provided by the application.
+   *     It must satisfy (using C++17 classes):
+   *     @code
+   *     static_assert(std::is_same_v<std::invoke_result_t<
+   *         DataFunctor, CompletionQueue&, const grpc::ClientContext&,
+   *         ResponseType&>, future<bool>>)
+   *     @endcode
+   *
+   * @see `MakeUnaryStreamRpc()` for the other parameters.
+   */
+  template <typename Client, typename MemberFunction, typename Request,
+            typename DataFunctor, typename FinishedFunctor,
+            typename Sig =
+                internal::CheckAsyncUnaryStreamRpcSignature<MemberFunction>,
+            typename std::enable_if<Sig::value, int>::type
+                valid_member_function_type = 0,
+            typename std::enable_if<
+                internal::CheckFlowControlledStreamRpcDataCallback<
+                    DataFunctor, typename Sig::ResponseType>::value,
+                int>::type valid_data_callback_type = 0,
+            typename std::enable_if<
+                internal::CheckUnaryStreamRpcFinishedCallback<
+                    FinishedFunctor, typename Sig::ResponseType>::value,
+                int>::type valid_finished_callback_type = 0>
+  std::shared_ptr<AsyncOperation> MakeFlowControlledUnaryStreamRpc(
+      Client& client, MemberFunction Client::*call, Request const& request,
+      std::unique_ptr<grpc::ClientContext> context, DataFunctor&& data_functor,
+      FinishedFunctor&& finished_functor) {
+    static_assert(std::is_same<typename Sig::RequestType,
+                               typename std::decay<Request>::type>::value,
+                  "Mismatched pointer to member function and request types");
+    auto op = std::make_shared<internal::AsyncFlowControlledStreamRpcFunctor<
+        typename Sig::RequestType, typename Sig::ResponseType, DataFunctor,
+        FinishedFunctor>>(std::forward<DataFunctor>(data_functor),
+                          std::forward<FinishedFunctor>(finished_functor));
+    void* tag = impl_->RegisterOperation(op);
+    op->Set(client, call, std::move(context), request, &impl_->cq(), tag);
+    return op;
+  }
+
   /**
    * Asynchronously run a functor on a thread `Run()`ning the `CompletionQueue`.
    *
@@ -219,6 +267,13 @@ class CompletionQueue {
             typename std::enable_if<
                 internal::CheckRunAsyncCallback<Functor>::value, int>::type = 0>
   std::shared_ptr<AsyncOperation> RunAsync(Functor&& functor) {
+    auto const& executor = impl_->executor();
+    if (executor) {
+      // Skip the round trip through the gRPC completion queue.
+      CompletionQueue cq(*this);
+      executor->Submit([cq, functor]() mutable { functor(cq); });
+      return std::make_shared<internal::AsyncRunOperation>();
+    }
     return MakeRelativeTimer(
         std::chrono::seconds(0),
         [functor](CompletionQueue& cq, AsyncTimerResult result) {
@@ -0,0 +1,73 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/completion_queue_executor.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+std::size_t DefaultThreadCount() {
+  // `std::thread::hardware_concurrency()` is only a hint, it may return 0.
+  auto const count = std::thread::hardware_concurrency();
+  return count == 0 ? 1 : count;
+}
+}  // namespace
+
+CompletionQueueExecutor::CompletionQueueExecutor()
+    : CompletionQueueExecutor(1, DefaultThreadCount()) {}
+
+CompletionQueueExecutor::CompletionQueueExecutor(std::size_t queue_count,
+                                                 std::size_t thread_count)
+    : pool_(std::make_shared<internal::WorkStealingPool>(thread_count)),
+      next_queue_(0) {
+  if (queue_count == 0) {
+    queue_count = 1;
+  }
+  queues_.reserve(queue_count);
+  pollers_.reserve(queue_count);
+  for (std::size_t i = 0; i != queue_count; ++i) {
+    auto impl = std::make_shared<internal::CompletionQueueImpl>();
+    impl->set_executor(pool_);
+    queues_.emplace_back(std::move(impl));
+    CompletionQueue cq = queues_.back();
+    pollers_.emplace_back([cq]() mutable { cq.Run(); });
+  }
+}
+
+CompletionQueueExecutor::~CompletionQueueExecutor() { Shutdown(); }
+
+CompletionQueue CompletionQueueExecutor::cq() {
+  return queues_[next_queue_.fetch_add(1) % queues_.size()];
+}
+
+void CompletionQueueExecutor::Shutdown() {
+  if (pollers_.empty()) {
+    return;
+  }
+  for (auto& cq : queues_) {
+    cq.Shutdown();
+  }
+  for (auto& t : pollers_) {
+    t.join();
+  }
+  pollers_.clear();
+  pool_->Shutdown();
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
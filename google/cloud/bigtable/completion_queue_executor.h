@@ -0,0 +1,90 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_EXECUTOR_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_EXECUTOR_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/work_stealing_pool.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Run asynchronous operations on threads owned by the library.
+ *
+ * With a plain `CompletionQueue` the application must create threads to call
+ * `CompletionQueue::Run()`, and the callbacks run on those threads. This class
+ * owns one thread per completion queue, which only polls for completed
+ * operations, and a pool of worker threads that run the callbacks. The workers
+ * steal work from each other, so a slow callback does not delay the others.
+ *
+ * `CompletionQueue::RunAsync()` on the queues returned by `cq()` schedules the
+ * functor directly on the worker threads, instead of using a gRPC alarm.
+ *
+ * @par Example
+ * @code
+ * bigtable::CompletionQueueExecutor executor;
+ * auto cq = executor.cq();
+ * table.AsyncApply(cq, ...);
+ * @endcode
+ */
+class CompletionQueueExecutor {
+ public:
+  /// Use one completion queue and one worker thread per core.
+  CompletionQueueExecutor();
+
+  /**
+   * Create an executor with @p queue_count completion queues, and
+   * @p thread_count worker threads.
+   *
+   * Zero values are treated as one.
+   */
+  CompletionQueueExecutor(std::size_t queue_count, std::size_t thread_count);
+
+  /// Shutdown the completion queues and join all the threads.
+  ~CompletionQueueExecutor();
+
+  CompletionQueueExecutor(CompletionQueueExecutor const&) = delete;
+  CompletionQueueExecutor& operator=(CompletionQueueExecutor const&) = delete;
+
+  /// Return one of the completion queues, in round-robin order.
+  CompletionQueue cq();
+
+  /**
+   * Stop the completion queues and join all the threads.
+   *
+   * Callbacks already scheduled on the worker threads run before this function
+   * returns. It must not be called from one of the executor threads.
+   */
+  void Shutdown();
+
+ private:
+  std::shared_ptr<internal::WorkStealingPool> pool_;
+  std::vector<CompletionQueue> queues_;
+  std::vector<std::thread> pollers_;
+  std::atomic<std::size_t> next_queue_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_EXECUTOR_H_
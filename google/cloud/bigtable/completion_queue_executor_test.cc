@@ -0,0 +1,108 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/completion_queue_executor.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <thread>
+
+using namespace google::cloud::testing_util::chrono_literals;
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/// @test Verify that timers fire on the worker threads.
+TEST(CompletionQueueExecutorTest, Timer) {
+  CompletionQueueExecutor executor(1, 2);
+  auto cq = executor.cq();
+
+  std::promise<std::thread::id> promise;
+  auto alarm = cq.MakeRelativeTimer(
+      2_ms, [&promise](CompletionQueue&, AsyncTimerResult& result) {
+        EXPECT_FALSE(result.cancelled);
+        promise.set_value(std::this_thread::get_id());
+      });
+
+  auto f = promise.get_future();
+  ASSERT_EQ(std::future_status::ready, f.wait_for(500_ms));
+  EXPECT_NE(std::this_thread::get_id(), f.get());
+}
+
+/// @test Verify that RunAsync() does not need the completion queue.
+TEST(CompletionQueueExecutorTest, RunAsync) {
+  CompletionQueueExecutor executor(2, 4);
+
+  std::atomic<int> count(0);
+  int const kTaskCount = 100;
+  std::promise<void> done;
+  for (int i = 0; i != kTaskCount; ++i) {
+    executor.cq().RunAsync([&count, &done](CompletionQueue& cq) {
+      if (++count == kTaskCount) {
+        done.set_value();
+      }
+    });
+  }
+  auto f = done.get_future();
+  EXPECT_EQ(std::future_status::ready, f.wait_for(500_ms));
+}
+
+/// @test Verify that callbacks can schedule more work on the same queue.
+TEST(CompletionQueueExecutorTest, Chained) {
+  CompletionQueueExecutor executor;
+
+  std::promise<void> done;
+  executor.cq().RunAsync([&done](CompletionQueue& cq) {
+    cq.MakeRelativeTimer(1_ms, [&done](CompletionQueue& cq, AsyncTimerResult&) {
+      cq.RunAsync([&done](CompletionQueue&) { done.set_value(); });
+    });
+  });
+  auto f = done.get_future();
+  EXPECT_EQ(std::future_status::ready, f.wait_for(500_ms));
+  executor.Shutdown();
+  // Shutdown is idempotent, the destructor calls it again.
+  executor.Shutdown();
+}
+
+/// @test Verify that Run() waits for the callbacks on the worker threads.
+TEST(CompletionQueueExecutorTest, RunWaitsForCallbacks) {
+  auto pool = std::make_shared<internal::WorkStealingPool>(2);
+  auto impl = std::make_shared<internal::CompletionQueueImpl>();
+  impl->set_executor(pool);
+  CompletionQueue cq(impl);
+
+  std::promise<void> started;
+  std::atomic<bool> finished(false);
+  cq.MakeRelativeTimer(1_ms, [&started, &finished](CompletionQueue&,
+                                                   AsyncTimerResult&) {
+    started.set_value();
+    std::this_thread::sleep_for(50_ms);
+    finished.store(true);
+  });
+  std::thread runner([&cq] { cq.Run(); });
+  started.get_future().wait();
+  cq.Shutdown();
+  runner.join();
+  EXPECT_TRUE(finished.load());
+  pool->Shutdown();
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
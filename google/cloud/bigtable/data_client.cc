@@ -14,6 +14,8 @@
 
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/internal/common_client.h"
+#include "google/cloud/bigtable/internal/load_tracking_reader.h"
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
 
 namespace btproto = google::bigtable::v2;
 
@@ -44,6 +46,7 @@ class DefaultDataClient : public DataClient {
                     ClientOptions options)
       : project_(std::move(project)),
         instance_(std::move(instance)),
+        rpc_instrumentation_(options.rpc_instrumentation()),
         impl_(std::move(options)) {}
 
   DefaultDataClient(std::string project, std::string instance)
@@ -55,26 +58,39 @@ class DefaultDataClient : public DataClient {
 
   std::shared_ptr<grpc::Channel> Channel() override { return impl_.Channel(); }
   void reset() override { impl_.reset(); }
+  std::shared_ptr<RpcInstrumentation> rpc_instrumentation() const override {
+    return rpc_instrumentation_;
+  }
 
   grpc::Status MutateRow(grpc::ClientContext* context,
                          btproto::MutateRowRequest const& request,
                          btproto::MutateRowResponse* response) override {
-    return impl_.Stub()->MutateRow(context, request, response);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return tracked.stub->MutateRow(context, request, response);
   }
 
+  // gRPC does not delete `grpc::ClientAsyncResponseReaderInterface<>` objects,
+  // they are allocated in the call arena, so they cannot be decorated to track
+  // the load of the channel. Asynchronous unary RPCs are short-lived, they
+  // simply use the least loaded of two channels.
   std::unique_ptr<
       grpc::ClientAsyncResponseReaderInterface<btproto::MutateRowResponse>>
   AsyncMutateRow(grpc::ClientContext* context,
                  btproto::MutateRowRequest const& request,
                  grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncMutateRow(context, request, cq);
+    auto indexed = impl_.IndexedStub();
+    ReportChannel(context, indexed.channel_index);
+    return indexed.stub->AsyncMutateRow(context, request, cq);
   }
 
   grpc::Status CheckAndMutateRow(
       grpc::ClientContext* context,
       btproto::CheckAndMutateRowRequest const& request,
       btproto::CheckAndMutateRowResponse* response) override {
-    return impl_.Stub()->CheckAndMutateRow(context, request, response);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return tracked.stub->CheckAndMutateRow(context, request, response);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -83,33 +99,48 @@ class DefaultDataClient : public DataClient {
       grpc::ClientContext* context,
       const google::bigtable::v2::CheckAndMutateRowRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncCheckAndMutateRow(context, request, cq);
+    auto indexed = impl_.IndexedStub();
+    ReportChannel(context, indexed.channel_index);
+    return indexed.stub->AsyncCheckAndMutateRow(context, request, cq);
   }
 
   grpc::Status ReadModifyWriteRow(
       grpc::ClientContext* context,
       btproto::ReadModifyWriteRowRequest const& request,
       btproto::ReadModifyWriteRowResponse* response) override {
-    return impl_.Stub()->ReadModifyWriteRow(context, request, response);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return tracked.stub->ReadModifyWriteRow(context, request, response);
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
   ReadRows(grpc::ClientContext* context,
            btproto::ReadRowsRequest const& request) override {
-    return impl_.Stub()->ReadRows(context, request);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return internal::TrackChannelLoad(
+        tracked.stub->ReadRows(context, request), std::move(tracked.token));
   }
 
   std::unique_ptr<grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>>
   AsyncReadRows(grpc::ClientContext* context,
                 const google::bigtable::v2::ReadRowsRequest& request,
                 grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncReadRows(context, request, cq, tag);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return internal::TrackChannelLoad(
+        tracked.stub->AsyncReadRows(context, request, cq, tag),
+        std::move(tracked.token));
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::SampleRowKeysResponse>>
   SampleRowKeys(grpc::ClientContext* context,
                 btproto::SampleRowKeysRequest const& request) override {
-    return impl_.Stub()->SampleRowKeys(context, request);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return internal::TrackChannelLoad(
+        tracked.stub->SampleRowKeys(context, request),
+        std::move(tracked.token));
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::SampleRowKeysResponse>>
@@ -117,25 +148,44 @@ class DefaultDataClient : public DataClient {
       ::grpc::ClientContext* context,
       const ::google::bigtable::v2::SampleRowKeysRequest& request,
       ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncSampleRowKeys(context, request, cq, tag);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return internal::TrackChannelLoad(
+        tracked.stub->AsyncSampleRowKeys(context, request, cq, tag),
+        std::move(tracked.token));
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
   MutateRows(grpc::ClientContext* context,
              btproto::MutateRowsRequest const& request) override {
-    return impl_.Stub()->MutateRows(context, request);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return internal::TrackChannelLoad(
+        tracked.stub->MutateRows(context, request), std::move(tracked.token));
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::MutateRowsResponse>>
   AsyncMutateRows(::grpc::ClientContext* context,
                   const ::google::bigtable::v2::MutateRowsRequest& request,
                   ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncMutateRows(context, request, cq, tag);
+    auto tracked = impl_.TrackedStub();
+    ReportChannel(context, tracked.channel_index);
+    return internal::TrackChannelLoad(
+        tracked.stub->AsyncMutateRows(context, request, cq, tag),
+        std::move(tracked.token));
   }
 
  private:
+  /// Report the channel picked for the RPC using @p context.
+  void ReportChannel(grpc::ClientContext const* context, int channel_index) {
+    if (rpc_instrumentation_) {
+      internal::RpcTracer::ReportChannel(*context, channel_index);
+    }
+  }
+
   std::string project_;
   std::string instance_;
+  std::shared_ptr<RpcInstrumentation> rpc_instrumentation_;
   Impl impl_;
 };
 
@@ -39,6 +39,8 @@ template <typename ReadRowCallback,
                   ReadRowCallback, CompletionQueue&, Row, grpc::Status&>::value,
               int>::type>
 class AsyncRowReader;
+template <typename ReadRowCallback>
+class AsyncFlowControlledRowReader;
 }  // namespace internal
 
 /**
@@ -83,6 +85,17 @@ class DataClient {
    */
   virtual void reset() = 0;
 
+  /**
+   * Return the instrumentation for the `Table` operations using this client.
+   *
+   * The default implementation returns null, which disables instrumentation.
+   *
+   * @see ClientOptions::set_rpc_instrumentation()
+   */
+  virtual std::shared_ptr<RpcInstrumentation> rpc_instrumentation() const {
+    return nullptr;
+  }
+
   // The member functions of this class are not intended for general use by
   // application developers (they are simply a dependency injection point). Make
   // them protected, so the mock classes can override them, and then make the
@@ -100,6 +113,8 @@ class DataClient {
                                         grpc::Status&>::value,
                                     int>::type>
   friend class internal::AsyncRowReader;
+  template <typename ReadRowCallback>
+  friend class internal::AsyncFlowControlledRowReader;
   //@{
   /// @name the `google.bigtable.v2.Bigtable` wrappers.
   virtual grpc::Status MutateRow(
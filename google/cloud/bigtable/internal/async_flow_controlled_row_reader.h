@@ -0,0 +1,314 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_FLOW_CONTROLLED_ROW_READER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_FLOW_CONTROLLED_ROW_READER_H_
+
+#include "google/cloud/bigtable/async_operation.h"
+#include "google/cloud/bigtable/bigtable_strong_types.h"
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/data_client.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/async_retry_op.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/rpc_backoff_policy.h"
+#include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/table_strong_types.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/make_unique.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <cinttypes>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Verify that @p Functor meets the requirements for a flow controlled
+ * AsyncReadRows row callback.
+ */
+template <typename Functor>
+using CheckFlowControlledReadRowCallback =
+    std::is_same<google::cloud::internal::invoke_result_t<
+                     Functor, CompletionQueue&, Row>,
+                 future<bool>>;
+
+/**
+ * Async-friendly version of RowReader, with flow control.
+ *
+ * The callback receiving the rows returns a `future<bool>`. The next row is
+ * not delivered, and no more data is requested from the server, until that
+ * future is satisfied. If the future is satisfied with `false` the stream is
+ * cancelled and the operation completes successfully.
+ *
+ * On a retry the stream resumes after the last row delivered to the callback,
+ * as `AsyncRowReader` does.
+ *
+ * It satisfies the requirements to be used in `AsyncRetryOp`.
+ */
+template <typename ReadRowCallback>
+class AsyncFlowControlledRowReader {
+  static_assert(CheckFlowControlledReadRowCallback<ReadRowCallback>::value,
+                "ReadRowCallback must return future<bool>");
+
+ public:
+  /**
+   * A constant for the magic value that means "no limit, get all rows".
+   *
+   * Zero is used as a magic value that means "get all rows" in the
+   * Cloud Bigtable RPC protocol.
+   */
+  static std::int64_t constexpr NO_ROWS_LIMIT = 0;
+
+  AsyncFlowControlledRowReader(
+      std::shared_ptr<bigtable::DataClient> client,
+      bigtable::AppProfileId const& app_profile_id,
+      bigtable::TableId const& table_name, RowSet row_set,
+      std::int64_t rows_limit, Filter filter,
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      ReadRowCallback&& read_row_callback)
+      : client_(std::move(client)),
+        app_profile_id_(std::move(app_profile_id)),
+        table_name_(std::move(table_name)),
+        row_set_(std::move(row_set)),
+        rows_limit_(rows_limit),
+        filter_(std::move(filter)),
+        parser_factory_(std::move(parser_factory)),
+        rows_count_(0),
+        stopped_(false),
+        status_(grpc::Status::OK),
+        read_row_callback_(std::move(read_row_callback)) {}
+
+  using Request = google::bigtable::v2::ReadRowsRequest;
+  using Response = bool;
+
+  template <typename Functor,
+            typename std::enable_if<
+                google::cloud::internal::is_invocable<Functor, CompletionQueue&,
+                                                      grpc::Status&>::value,
+                int>::type valid_callback_type = 0>
+  std::shared_ptr<AsyncOperation> Start(
+      CompletionQueue& cq, std::unique_ptr<grpc::ClientContext>&& context,
+      Functor&& callback) {
+    google::bigtable::v2::ReadRowsRequest request;
+    request.set_app_profile_id(app_profile_id_.get());
+    request.set_table_name(table_name_.get());
+
+    if (!last_read_row_key_.empty()) {
+      // We've returned some rows and need to make sure we don't
+      // request them again.
+      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+    }
+    auto row_set_proto = row_set_.as_proto();
+    request.mutable_rows()->Swap(&row_set_proto);
+
+    auto filter_proto = filter_.as_proto();
+    request.mutable_filter()->Swap(&filter_proto);
+
+    if (rows_limit_ != NO_ROWS_LIMIT) {
+      request.set_rows_limit(rows_limit_ - rows_count_);
+    }
+
+    // Each attempt starts a new stream, partial rows from a previous attempt
+    // are discarded.
+    parser_ = parser_factory_->Create();
+    status_ = grpc::Status::OK;
+
+    return cq.MakeFlowControlledUnaryStreamRpc(
+        *client_, &DataClient::AsyncReadRows, request, std::move(context),
+        [this](CompletionQueue& cq, const grpc::ClientContext&,
+               google::bigtable::v2::ReadRowsResponse& response) {
+          return ProcessResponse(cq, response);
+        },
+        FinishedCallback<Functor>(*this, std::forward<Functor>(callback)));
+  }
+
+  bool AccumulatedResult() { return status_.ok(); }
+
+ private:
+  /**
+   * Parse a response and deliver its rows to the callback.
+   *
+   * @return a future satisfied when the callback has consumed all the rows,
+   *     with `false` if the stream should be cancelled.
+   */
+  future<bool> ProcessResponse(
+      CompletionQueue& cq, google::bigtable::v2::ReadRowsResponse& response) {
+    for (auto& chunk : *response.mutable_chunks()) {
+      parser_->HandleChunk(std::move(chunk), status_);
+      if (!status_.ok()) {
+        // Deliver the complete rows, then stop the stream, an error results
+        // in a retry.
+        break;
+      }
+      if (parser_->HasNext()) {
+        pending_rows_.emplace_back(parser_->Next(status_));
+        if (!status_.ok()) {
+          pending_rows_.pop_back();
+          break;
+        }
+      }
+    }
+    return DeliverPendingRows(cq);
+  }
+
+  /// Deliver the parsed rows one at a time, waiting for the callback.
+  future<bool> DeliverPendingRows(CompletionQueue& cq) {
+    while (!pending_rows_.empty()) {
+      Row row = std::move(pending_rows_.front());
+      pending_rows_.pop_front();
+      ++rows_count_;
+      last_read_row_key_ = row.row_key();
+      auto ready = read_row_callback_(cq, std::move(row));
+      if (!ready.is_ready()) {
+        // Continue once the consumer is ready, from whatever thread satisfies
+        // the future.
+        return ready.then([this, cq](future<bool> f) mutable {
+          if (!ConsumerKeepsReading(std::move(f))) {
+            return Stop();
+          }
+          return DeliverPendingRows(cq);
+        });
+      }
+      if (!ConsumerKeepsReading(std::move(ready))) {
+        return Stop();
+      }
+    }
+    return make_ready_future(status_.ok());
+  }
+
+  future<bool> Stop() {
+    stopped_ = true;
+    pending_rows_.clear();
+    return make_ready_future(false);
+  }
+
+  template <typename Functor,
+            typename std::enable_if<
+                google::cloud::internal::is_invocable<Functor, CompletionQueue&,
+                                                      grpc::Status&>::value,
+                int>::type valid_callback_type = 0>
+  struct FinishedCallback {
+    FinishedCallback(AsyncFlowControlledRowReader& parent, Functor&& callback)
+        : parent_(parent), callback_(std::move(callback)) {}
+
+    void operator()(CompletionQueue& cq, grpc::ClientContext& context,
+                    grpc::Status& status) {
+      if (parent_.stopped_) {
+        // The consumer asked to stop, the stream was cancelled on its behalf.
+        grpc::Status ok;
+        callback_(cq, ok);
+        return;
+      }
+      if (status.ok() && parent_.status_.ok()) {
+        // a successful call so close the parser.
+        parent_.parser_->HandleEndOfStream(status);
+      }
+      if (!parent_.status_.ok()) {
+        status = grpc::Status(grpc::StatusCode::UNAVAILABLE,
+                              "Some rows were not returned");
+      }
+      callback_(cq, status);
+    }
+
+    // The user of AsyncFlowControlledRowReader has to make sure that it is not
+    // destructed before all callbacks return, so we have a guarantee that this
+    // reference is valid for as long as we don't call callback_.
+    AsyncFlowControlledRowReader& parent_;
+    Functor callback_;
+  };
+
+  std::shared_ptr<bigtable::DataClient> client_;
+  bigtable::AppProfileId app_profile_id_;
+  bigtable::TableId table_name_;
+  RowSet row_set_;
+  std::int64_t rows_limit_;
+  Filter filter_;
+
+  std::unique_ptr<internal::ReadRowsParserFactory> parser_factory_;
+  std::unique_ptr<internal::ReadRowsParser> parser_;
+
+  /// Rows parsed from the current response, not yet delivered.
+  std::deque<Row> pending_rows_;
+  /// Number of rows delivered so far, used to set row_limit in retries.
+  std::int64_t rows_count_;
+  /// Holds the last delivered row key, for retries.
+  std::string last_read_row_key_;
+  /// The consumer asked to stop reading.
+  bool stopped_;
+
+  grpc::Status status_;
+  ReadRowCallback read_row_callback_;
+};
+
+/**
+ * Perform an AsyncReadRows operation request with flow control and retries.
+ *
+ * @tparam ReadRowCallback the type of the function-like object that will
+ * receive the rows. It must satisfy (using C++17 types):
+ *     static_assert(std::is_same_v<std::invoke_result_t<
+ *         Functor, CompletionQueue&, Row>, future<bool>>);
+ *
+ * @tparam DoneCallback the type of the function-like object that will receive
+ * the results. It must satisfy (using C++17 types):
+ *     static_assert(std::is_invocable_v<
+ *         Functor, CompletionQueue&, bool&, grpc::Status&>);
+ */
+template <typename ReadRowCallback, typename DoneCallback,
+          typename std::enable_if<
+              CheckFlowControlledReadRowCallback<ReadRowCallback>::value,
+              int>::type valid_data_callback_type = 0,
+          typename std::enable_if<google::cloud::internal::is_invocable<
+                                      DoneCallback, CompletionQueue&, bool&,
+                                      grpc::Status const&>::value,
+                                  int>::type valid_callback_type = 0>
+class AsyncFlowControlledReadRowsOperation
+    : public AsyncRetryOp<ConstantIdempotencyPolicy, DoneCallback,
+                          AsyncFlowControlledRowReader<ReadRowCallback>> {
+ public:
+  AsyncFlowControlledReadRowsOperation(
+      std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::shared_ptr<bigtable::DataClient> client,
+      bigtable::AppProfileId const& app_profile_id,
+      bigtable::TableId const& table_name, RowSet row_set,
+      std::int64_t rows_limit, Filter filter,
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      ReadRowCallback&& read_row_callback, DoneCallback&& done_callback)
+      : AsyncRetryOp<ConstantIdempotencyPolicy, DoneCallback,
+                     AsyncFlowControlledRowReader<ReadRowCallback>>(
+            __func__, std::move(rpc_retry_policy),
+            std::move(rpc_backoff_policy), ConstantIdempotencyPolicy(true),
+            std::move(metadata_update_policy),
+            std::forward<DoneCallback>(done_callback),
+            AsyncFlowControlledRowReader<ReadRowCallback>(
+                client, std::move(app_profile_id), std::move(table_name),
+                std::move(row_set), rows_limit, std::move(filter),
+                std::move(parser_factory), std::move(read_row_callback))) {}
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_FLOW_CONTROLLED_ROW_READER_H_
@@ -162,6 +162,9 @@ class AsyncLoopOp : public std::enable_shared_from_this<AsyncLoopOp<Operation>>,
     return res;
   }
 
+ protected:
+  Operation& operation() { return operation_; }
+
  private:
   /**
    * Kick off the asynchronous request.
@@ -116,6 +116,9 @@ class MultipageRetriableAdapter {
     }
     if (finished) {
       // Finished, just report the result.
+      if (status.ok()) {
+        rpc_retry_policy_->OnSuccess();
+      }
       auto res = operation_.AccumulatedResult();
       user_callback_(cq, res, status);
       attempt_completed_callback(cq, true);
@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/internal/async_loop_op.h"
 #include "google/cloud/bigtable/internal/async_op_traits.h"
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
@@ -125,6 +126,8 @@ class RetriableLoopAdapter {
         user_callback_(std::forward<UserFunctor>(callback)),
         operation_(std::move(operation)) {}
 
+  void set_rpc_tracer(RpcTracer tracer) { tracer_ = std::move(tracer); }
+
   template <typename AttemptFunctor>
   std::shared_ptr<AsyncOperation> Start(
       CompletionQueue& cq, AttemptFunctor&& attempt_completed_callback) {
@@ -133,6 +136,7 @@ class RetriableLoopAdapter {
     rpc_backoff_policy_->Setup(*context);
     metadata_update_policy_.Setup(*context);
 
+    tracer_.AttemptStart(*context);
     return operation_.Start(
         cq, std::move(context),
         [this, attempt_completed_callback](CompletionQueue& cq,
@@ -142,7 +146,9 @@ class RetriableLoopAdapter {
   }
 
   std::chrono::milliseconds WaitPeriod() {
-    return rpc_backoff_policy_->OnCompletion(status_);
+    auto delay = rpc_backoff_policy_->OnCompletion(status_);
+    tracer_.Backoff(delay);
+    return delay;
   }
 
   void Cancel(CompletionQueue& cq) {
@@ -150,6 +156,7 @@ class RetriableLoopAdapter {
     grpc::Status res_status(
         grpc::StatusCode::CANCELLED,
         FullErrorMessageUnlocked("pending operation cancelled"));
+    tracer_.Finish(res_status);
     user_callback_(cq, res, res_status);
   }
 
@@ -158,6 +165,7 @@ class RetriableLoopAdapter {
   template <typename AttemptFunctor>
   void OnCompletion(CompletionQueue& cq, grpc::Status& status,
                     AttemptFunctor&& attempt_completed_callback) {
+    tracer_.AttemptEnd(status);
     if (status.error_code() == grpc::StatusCode::CANCELLED) {
       // Cancelled, no retry necessary.
       Cancel(cq);
@@ -166,7 +174,9 @@ class RetriableLoopAdapter {
     }
     if (status.ok()) {
       // Success, just report the result.
+      rpc_retry_policy_->OnSuccess();
       auto res = operation_.AccumulatedResult();
+      tracer_.Finish(status);
       user_callback_(cq, res, status);
       attempt_completed_callback(cq, true);
       return;
@@ -177,6 +187,7 @@ class RetriableLoopAdapter {
           FullErrorMessageUnlocked("non-idempotent operation failed", status),
           status.error_details());
       auto res = operation_.AccumulatedResult();
+      tracer_.Finish(res_status);
       user_callback_(cq, res, res_status);
       attempt_completed_callback(cq, true);
       return;
@@ -190,6 +201,7 @@ class RetriableLoopAdapter {
       grpc::Status res_status(status.error_code(), full_message,
                               status.error_details());
       auto res = operation_.AccumulatedResult();
+      tracer_.Finish(res_status);
       user_callback_(cq, res, res_status);
       attempt_completed_callback(cq, true);
       return;
@@ -221,6 +233,7 @@ class RetriableLoopAdapter {
   UserFunctor user_callback_;
   Operation operation_;
   grpc::Status status_;
+  RpcTracer tracer_;
 };
 
 /**
@@ -260,6 +273,11 @@ class AsyncRetryOp
                 std::move(rpc_backoff_policy), std::move(idempotent_policy),
                 metadata_update_policy, std::forward<Functor>(callback),
                 std::move(operation))) {}
+
+  /// Report the operation events to @p tracer, must be called before Start().
+  void set_rpc_tracer(RpcTracer tracer) {
+    this->operation().set_rpc_tracer(std::move(tracer));
+  }
 };
 
 /**
@@ -56,12 +56,19 @@ BulkMutator::BulkMutator(bigtable::AppProfileId const& app_profile_id,
 }
 
 grpc::Status BulkMutator::MakeOneRequest(bigtable::DataClient& client,
-                                         grpc::ClientContext& client_context) {
+                                         grpc::ClientContext& client_context,
+                                         RpcTracer* tracer) {
   PrepareForRequest();
+  if (tracer != nullptr) {
+    tracer->RequestSent(mutations_);
+  }
   // Send the request to the server and read the resulting result stream.
   auto stream = client.MutateRows(&client_context, mutations_);
   btproto::MutateRowsResponse response;
   while (stream->Read(&response)) {
+    if (tracer != nullptr) {
+      tracer->ResponseReceived(response);
+    }
     ProcessResponse(response);
   }
   FinishRequest();
@@ -20,6 +20,7 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
 #include "google/cloud/bigtable/table_strong_types.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/make_unique.h"
@@ -41,9 +42,15 @@ class BulkMutator {
     return pending_mutations_.entries_size() != 0;
   }
 
-  /// Synchronously send one batch request to the given stub.
+  /**
+   * Synchronously send one batch request to the given stub.
+   *
+   * If @p tracer is not null, the size of the request and responses are
+   * counted against its current attempt.
+   */
   grpc::Status MakeOneRequest(bigtable::DataClient& client,
-                              grpc::ClientContext& client_context);
+                              grpc::ClientContext& client_context,
+                              RpcTracer* tracer = nullptr);
 
   /// Give up on any pending mutations, move them to the failures array.
   std::vector<FailedMutation> ExtractFinalFailures();
@@ -16,7 +16,13 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COMMON_CLIENT_H_
 
 #include "google/cloud/bigtable/client_options.h"
+#include "google/cloud/internal/random.h"
 #include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -28,13 +34,72 @@ namespace internal {
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options);
 
+/// Create the @p id -th channel in a pool based on the client options.
+std::shared_ptr<grpc::Channel> CreateChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    std::size_t id);
+
+/**
+ * Counts an RPC against the load of a channel while the token is alive.
+ *
+ * Destroying the token (or releasing it via `reset()`) decrements the counter.
+ * The counter is shared with the pool, so the token remains valid if the pool
+ * is reset while the RPC is running.
+ */
+class ChannelLoadToken {
+ public:
+  ChannelLoadToken() = default;
+  explicit ChannelLoadToken(std::shared_ptr<std::atomic<std::size_t>> load)
+      : load_(std::move(load)) {
+    if (load_) {
+      load_->fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  ~ChannelLoadToken() { reset(); }
+
+  ChannelLoadToken(ChannelLoadToken&&) noexcept = default;
+  ChannelLoadToken& operator=(ChannelLoadToken&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+    reset();
+    load_ = std::move(rhs.load_);
+    return *this;
+  }
+  ChannelLoadToken(ChannelLoadToken const&) = delete;
+  ChannelLoadToken& operator=(ChannelLoadToken const&) = delete;
+
+  void reset() {
+    if (load_) {
+      load_->fetch_sub(1, std::memory_order_relaxed);
+      load_.reset();
+    }
+  }
+
+ private:
+  std::shared_ptr<std::atomic<std::size_t>> load_;
+};
+
 /**
  * Refactor implementation of `bigtable::{Data,Admin,InstanceAdmin}Client`.
  *
  * All the clients need to keep a collection (sometimes with a single element)
- * of channels, update the collection when needed and round-robin across the
- * channels. At least `bigtable::DataClient` needs to optimize the creation of
- * the stub objects.
+ * of channels, update the collection when needed and balance the calls across
+ * the channels. At least `bigtable::DataClient` needs to optimize the creation
+ * of the stub objects.
+ *
+ * Each channel keeps a count of the outstanding RPCs obtained via
+ * `TrackedStub()`. Calls are sent to the less loaded of two randomly chosen
+ * channels ("power of two choices"), which avoids piling new calls on a
+ * channel busy with long running streams, without the cost of scanning all the
+ * channels. If all the channels have `max_streams_per_connection()` streams the
+ * pool grows, up to `max_connection_pool_size()` channels.
+ *
+ * The pool is an immutable snapshot, replaced as a whole when it is created,
+ * reset, or grows. Picking a channel does not take the client mutex, nor wait
+ * for channels being created. It is not lock-free though: the standard library
+ * typically implements `std::atomic_load()` for `std::shared_ptr` with a small
+ * pool of internal mutexes, held just long enough to copy the pointer.
  *
  * The class exposes the channels because they are needed for clients that
  * use more than one type of Stub.
@@ -52,8 +117,23 @@ class CommonClient {
   using ChannelPtr = std::shared_ptr<grpc::Channel>;
   //@}
 
+  /// A stub and the index of its channel in the pool.
+  struct IndexedStubType {
+    StubPtr stub;
+    int channel_index;
+  };
+
+  /// A stub and the token counting a call against the load of its channel.
+  struct TrackedStubType {
+    ChannelPtr channel;
+    StubPtr stub;
+    ChannelLoadToken token;
+    int channel_index;
+  };
+
   CommonClient(bigtable::ClientOptions options)
-      : options_(std::move(options)), current_index_(0) {}
+      : options_(std::move(options)),
+        random_state_(google::cloud::internal::MakeDefaultPRNG()()) {}
 
   /**
    * Reset the channel and stub.
@@ -64,32 +144,73 @@ class CommonClient {
    */
   void reset() {
     std::lock_guard<std::mutex> lk(mu_);
-    stubs_.clear();
+    std::atomic_store(&pool_, std::shared_ptr<Pool const>());
   }
 
   /// Return the next Stub to make a call.
   StubPtr Stub() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto stub = stubs_[GetIndex(lk)];
-    return stub;
+    auto pool = GetPool();
+    return (*pool)[Pick(*pool)].stub;
+  }
+
+  /// Return the next Stub to make a call, and the index of its channel.
+  IndexedStubType IndexedStub() {
+    auto pool = GetPool();
+    auto const index = Pick(*pool);
+    return IndexedStubType{(*pool)[index].stub, static_cast<int>(index)};
   }
 
   /// Return the next Channel to make a call.
   ChannelPtr Channel() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto channel = channels_[GetIndex(lk)];
-    return channel;
+    auto pool = GetPool();
+    return (*pool)[Pick(*pool)].channel;
+  }
+
+  /**
+   * Return the next Stub and count the call against the load of its channel.
+   *
+   * The caller should keep the token until the call completes, typically this
+   * is used for streaming RPCs.
+   */
+  TrackedStubType TrackedStub() {
+    auto pool = GetPool();
+    auto index = Pick(*pool);
+    if ((*pool)[index].load->load(std::memory_order_relaxed) >=
+            options_.max_streams_per_connection() &&
+        options_.max_connection_pool_size() > pool->size()) {
+      auto grown = Grow(pool);
+      if (grown) {
+        pool = std::move(grown);
+        index = pool->size() - 1;
+      }
+    }
+    auto const& selected = (*pool)[index];
+    return TrackedStubType{selected.channel, selected.stub,
+                           ChannelLoadToken(selected.load),
+                           static_cast<int>(index)};
   }
 
  private:
-  /// Make sure the connections exit, and create them if needed.
-  void CheckConnections(std::unique_lock<std::mutex>& lk) {
-    if (!stubs_.empty()) {
-      return;
+  struct ChannelState {
+    ChannelPtr channel;
+    StubPtr stub;
+    std::shared_ptr<std::atomic<std::size_t>> load;
+  };
+  using Pool = std::vector<ChannelState>;
+
+  ChannelState MakeChannelState(ChannelPtr channel) {
+    auto stub = Interface::NewStub(channel);
+    return ChannelState{std::move(channel), std::move(stub),
+                        std::make_shared<std::atomic<std::size_t>>(0)};
+  }
+
+  /// Return the current pool, creating the connections if needed.
+  std::shared_ptr<Pool const> GetPool() {
+    auto pool = std::atomic_load(&pool_);
+    if (pool) {
+      return pool;
     }
-    // Release the lock while making remote calls.  gRPC uses the current
+    // Create the connections without holding the lock.  gRPC uses the current
     // thread to make remote connections (and probably authenticate), holding
     // a lock for long operations like that is a bad practice.  Releasing
     // the lock here can result in wasted work, but that is a smaller problem
@@ -99,37 +220,88 @@ class CommonClient {
     // only opens one socket per destination+attributes combo, we artificially
     // introduce attributes in the implementation of CreateChannelPool() to
     // create one socket per element in the pool.
-    lk.unlock();
     auto channels = CreateChannelPool(Traits::Endpoint(options_), options_);
-    std::vector<StubPtr> tmp;
-    std::transform(channels.begin(), channels.end(), std::back_inserter(tmp),
-                   [](std::shared_ptr<grpc::Channel> ch) {
-                     return Interface::NewStub(ch);
-                   });
-    lk.lock();
-    if (stubs_.empty()) {
-      channels.swap(channels_);
-      tmp.swap(stubs_);
-      current_index_ = 0;
+    auto tmp = std::make_shared<Pool>();
+    for (auto& ch : channels) {
+      tmp->push_back(MakeChannelState(std::move(ch)));
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    pool = std::atomic_load(&pool_);
+    if (!pool) {
+      pool = std::move(tmp);
+      std::atomic_store(&pool_, pool);
     }
+    return pool;
   }
 
-  /// Get the current index for round-robin over connections.
-  std::size_t GetIndex(std::unique_lock<std::mutex>& lk) {
-    std::size_t current = current_index_++;
-    // Round robin through the connections.
-    if (current_index_ >= stubs_.size()) {
-      current_index_ = 0;
+  /**
+   * Add one channel to the pool, unless all the channels are not busy.
+   *
+   * @return the new pool, the new channel is the last element. Or `nullptr`
+   *     if the pool did not grow.
+   */
+  std::shared_ptr<Pool const> Grow(std::shared_ptr<Pool const> const& pool) {
+    auto const threshold = options_.max_streams_per_connection();
+    for (auto const& state : *pool) {
+      if (state.load->load(std::memory_order_relaxed) < threshold) {
+        return nullptr;
+      }
     }
-    return current;
+    auto channel =
+        CreateChannel(Traits::Endpoint(options_), options_, pool->size());
+    auto state = MakeChannelState(std::move(channel));
+    std::lock_guard<std::mutex> lk(mu_);
+    // Some other thread grew (or reset) the pool, use the new channels.
+    if (std::atomic_load(&pool_) != pool) {
+      return nullptr;
+    }
+    auto tmp = std::make_shared<Pool>(*pool);
+    tmp->push_back(std::move(state));
+    std::shared_ptr<Pool const> grown = std::move(tmp);
+    std::atomic_store(&pool_, grown);
+    return grown;
+  }
+
+  /// Pick the less loaded of two random channels, returns its index.
+  std::size_t Pick(Pool const& pool) {
+    auto const size = pool.size();
+    if (size == 1) {
+      return 0;
+    }
+    auto const r = NextRandom();
+    auto i = static_cast<std::size_t>(r % size);
+    auto j = static_cast<std::size_t>((r >> 32U) % (size - 1));
+    if (j >= i) {
+      ++j;
+    }
+    if (pool[j].load->load(std::memory_order_relaxed) <
+        pool[i].load->load(std::memory_order_relaxed)) {
+      i = j;
+    }
+    return i;
+  }
+
+  /**
+   * Return a pseudo-random number, without locking.
+   *
+   * This is the splitmix64 generator over an atomic counter. It is not a high
+   * quality PRNG, but it is more than enough to pick channels.
+   */
+  std::uint64_t NextRandom() {
+    auto constexpr kGamma = 0x9e3779b97f4a7c15ULL;
+    std::uint64_t z =
+        random_state_.fetch_add(kGamma, std::memory_order_relaxed) + kGamma;
+    z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31U);
   }
 
  private:
   std::mutex mu_;
   ClientOptions options_;
-  std::vector<ChannelPtr> channels_;
-  std::vector<StubPtr> stubs_;
-  std::size_t current_index_;
+  // Always accessed using std::atomic_load() and std::atomic_store().
+  std::shared_ptr<Pool const> pool_;
+  std::atomic<std::uint64_t> random_state_;
 };
 
 }  // namespace internal
@@ -0,0 +1,120 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/common_client.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <gmock/gmock.h>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+struct TestTraits {
+  static std::string const& Endpoint(bigtable::ClientOptions& options) {
+    return options.data_endpoint();
+  }
+};
+
+using TestClient = CommonClient<TestTraits, ::google::bigtable::v2::Bigtable>;
+
+bigtable::ClientOptions TestOptions(std::size_t pool_size) {
+  return bigtable::ClientOptions(grpc::InsecureChannelCredentials())
+      .set_data_endpoint("localhost:1")
+      .set_connection_pool_size(pool_size);
+}
+
+/// @test Verify that busy channels are avoided.
+TEST(CommonClientTest, AvoidsBusyChannel) {
+  TestClient client(TestOptions(2));
+  auto busy = client.TrackedStub();
+  for (int i = 0; i != 20; ++i) {
+    auto tracked = client.TrackedStub();
+    EXPECT_NE(busy.channel.get(), tracked.channel.get());
+  }
+}
+
+/// @test Verify that released calls no longer count against the channel.
+TEST(CommonClientTest, ReleaseToken) {
+  TestClient client(TestOptions(2));
+  auto first = client.TrackedStub();
+  auto second = client.TrackedStub();
+  EXPECT_NE(first.channel.get(), second.channel.get());
+  EXPECT_NE(first.channel_index, second.channel_index);
+  // Only the first channel is busy now.
+  second.token.reset();
+  for (int i = 0; i != 20; ++i) {
+    auto tracked = client.TrackedStub();
+    EXPECT_EQ(second.channel.get(), tracked.channel.get());
+    EXPECT_EQ(second.channel_index, tracked.channel_index);
+  }
+  EXPECT_EQ(second.channel_index, client.IndexedStub().channel_index);
+}
+
+/// @test Verify that moving a token into itself keeps counting the call.
+TEST(ChannelLoadTokenTest, SelfMove) {
+  auto load = std::make_shared<std::atomic<std::size_t>>(0);
+  ChannelLoadToken token(load);
+  EXPECT_EQ(1U, load->load());
+  auto& alias = token;
+  token = std::move(alias);
+  EXPECT_EQ(1U, load->load());
+  token.reset();
+  EXPECT_EQ(0U, load->load());
+}
+
+/// @test Verify that the pool does not grow by default.
+TEST(CommonClientTest, NoGrowthByDefault) {
+  TestClient client(TestOptions(1).set_max_streams_per_connection(1));
+  auto first = client.TrackedStub();
+  auto second = client.TrackedStub();
+  EXPECT_EQ(first.channel.get(), second.channel.get());
+}
+
+/// @test Verify that the pool grows when all the channels are busy.
+TEST(CommonClientTest, GrowsWhenBusy) {
+  TestClient client(TestOptions(1)
+                        .set_max_streams_per_connection(2)
+                        .set_max_connection_pool_size(2));
+  std::vector<TestClient::TrackedStubType> calls;
+  std::set<grpc::Channel*> channels;
+  for (int i = 0; i != 6; ++i) {
+    calls.emplace_back(client.TrackedStub());
+    channels.insert(calls.back().channel.get());
+  }
+  EXPECT_EQ(2U, channels.size());
+  EXPECT_EQ(calls[0].channel.get(), calls[1].channel.get());
+  EXPECT_NE(calls[0].channel.get(), calls[2].channel.get());
+  EXPECT_EQ(0, calls[0].channel_index);
+  EXPECT_EQ(1, calls[2].channel_index);
+}
+
+/// @test Verify that reset() creates new channels.
+TEST(CommonClientTest, Reset) {
+  TestClient client(TestOptions(1));
+  auto channel0 = client.Channel();
+  EXPECT_EQ(channel0.get(), client.Channel().get());
+  client.reset();
+  EXPECT_NE(channel0.get(), client.Channel().get());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/completion_queue_impl.h"
+#include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/internal/throw_delegate.h"
 
@@ -43,10 +44,33 @@ void CompletionQueueImpl::Run(CompletionQueue& cq) {
           "unexpected status from AsyncNext()");
     }
     auto op = FindOperation(tag);
+    if (executor_) {
+      // The copy keeps this object alive until the callback runs.
+      CompletionQueue cq_copy(cq);
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        ++running_callbacks_;
+      }
+      executor_->Submit([this, cq_copy, op, tag, ok]() mutable {
+        if (op->Notify(cq_copy, ok)) {
+          ForgetOperation(tag);
+        }
+        std::lock_guard<std::mutex> lk(mu_);
+        if (--running_callbacks_ == 0) {
+          callbacks_done_.notify_all();
+        }
+      });
+      continue;
+    }
     if (op->Notify(cq, ok)) {
       ForgetOperation(tag);
     }
   }
+  // The callbacks running on the executor may still use the gRPC completion
+  // queue, for example to start the next Read() of a stream. Wait for them,
+  // as the callbacks running on this thread would have completed too.
+  std::unique_lock<std::mutex> lk(mu_);
+  callbacks_done_.wait(lk, [this] { return running_callbacks_ == 0; });
 }
 
 void CompletionQueueImpl::Shutdown() {
@@ -16,12 +16,17 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COMPLETION_QUEUE_IMPL_H_
 
 #include "google/cloud/bigtable/async_operation.h"
+#include "google/cloud/bigtable/internal/work_stealing_pool.h"
+#include "google/cloud/future.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include <grpcpp/alarm.h>
 #include <grpcpp/support/async_stream.h>
 #include <grpcpp/support/async_unary_call.h>
 #include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -152,6 +157,17 @@ template <typename Functor, typename Response>
 using CheckUnaryStreamRpcFinishedCallback =
     google::cloud::internal::is_invocable<Functor, CompletionQueue&,
                                           grpc::ClientContext&, grpc::Status&>;
+
+/**
+ * Verify that @p Functor meets the requirements for a flow controlled
+ * AsyncUnaryStreamRpc data callback.
+ */
+template <typename Functor, typename Response>
+using CheckFlowControlledStreamRpcDataCallback =
+    std::is_same<google::cloud::internal::invoke_result_t<
+                     Functor, CompletionQueue&, const grpc::ClientContext&,
+                     Response&>,
+                 future<bool>>;
 /**
  * Wrap a unary RPC callback into a `AsyncOperation`.
  *
@@ -338,6 +354,149 @@ class AsyncUnaryStreamRpcFunctor : public AsyncGrpcOperation {
   std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> response_reader_;
 };
 
+/**
+ * Extract the decision of a flow-controlled consumer from its future.
+ *
+ * If the consumer abandons the promise, or fails, it will not accept more
+ * data. Callers stop the stream instead of waiting for a value that never
+ * arrives.
+ */
+inline bool ConsumerKeepsReading(future<bool> f) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+    return f.get();
+  } catch (...) {
+    return false;
+  }
+#else
+  return f.get();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+/**
+ * Unary RPC with streaming response and flow control.
+ *
+ * This is a variation of `AsyncUnaryStreamRpcFunctor` for consumers that may
+ * not keep up with the stream. The data callback returns a `future<bool>`, the
+ * next `Read()` is only issued once that future is satisfied, so at most one
+ * response is buffered in the client. If the future is satisfied with `false`,
+ * or the consumer abandons the promise, the stream is cancelled.
+ *
+ * No thread is blocked while the consumer is busy: the next `Read()` is
+ * issued by whichever thread satisfies the future.
+ *
+ * Note that this class lives in the `internal` namespace and thus is
+ * not intended for general use.
+ *
+ * @tparam Request the type of the RPC request.
+ * @tparam Response the type of the RPC response piece.
+ * @tparam DataFunctor the callback type for notifying about data portions.
+ * @tparam FinishedFunctor the callback type for notifying about end of stream.
+ */
+template <typename Request, typename Response, typename DataFunctor,
+          typename FinishedFunctor,
+          typename std::enable_if<CheckFlowControlledStreamRpcDataCallback<
+                                      DataFunctor, Response>::value,
+                                  int>::type = 0,
+          typename std::enable_if<CheckUnaryStreamRpcFinishedCallback<
+                                      FinishedFunctor, Response>::value,
+                                  int>::type = 0>
+class AsyncFlowControlledStreamRpcFunctor
+    : public AsyncGrpcOperation,
+      public std::enable_shared_from_this<AsyncFlowControlledStreamRpcFunctor<
+          Request, Response, DataFunctor, FinishedFunctor>> {
+ public:
+  explicit AsyncFlowControlledStreamRpcFunctor(
+      DataFunctor&& data_functor, FinishedFunctor&& finished_functor)
+      : tag_(nullptr),
+        state_(CREATING),
+        data_functor_(std::forward<DataFunctor>(data_functor)),
+        finished_functor_(std::forward<FinishedFunctor>(finished_functor)) {}
+
+  /// Make the RPC request and prepare the response callback.
+  template <typename Client, typename MemberFunction>
+  void Set(Client& client, MemberFunction Client::*call,
+           std::unique_ptr<grpc::ClientContext> context, Request const& request,
+           grpc::CompletionQueue* cq, void* tag) {
+    std::unique_lock<std::mutex> lk(mu_);
+    tag_ = tag;
+    context_ = std::move(context);
+    response_reader_ = (client.*call)(context_.get(), request, cq, tag);
+  }
+
+  void Cancel() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    context_->TryCancel();
+  }
+
+ private:
+  enum State { CREATING, PROCESSING, WAITING, FINISHING };
+  bool Notify(CompletionQueue& cq, bool ok) override {
+    std::unique_lock<std::mutex> lk(mu_);
+
+    switch (state_) {
+      case CREATING:
+        if (ok) {
+          response_reader_->Read(&response_, tag_);
+          state_ = PROCESSING;
+        } else {
+          response_reader_->Finish(&status_, tag_);
+          state_ = FINISHING;
+        }
+        return false;
+      case PROCESSING:
+        if (ok) {
+          Response received;
+          response_.Swap(&received);
+          state_ = WAITING;
+          lk.unlock();
+          auto self = this->shared_from_this();
+          data_functor_(cq, *context_, received)
+              .then([self](future<bool> f) {
+                self->OnConsumerReady(ConsumerKeepsReading(std::move(f)));
+              });
+        } else {
+          response_reader_->Finish(&status_, tag_);
+          state_ = FINISHING;
+        }
+        return false;
+      case WAITING:
+        // No operation is pending with gRPC while the consumer is busy, only
+        // the simulated completions in the unit tests can get here.
+        return false;
+      case FINISHING:
+        lk.unlock();
+        finished_functor_(cq, *context_, status_);
+        return true;
+    }
+    google::cloud::internal::ThrowRuntimeError(
+        "unexpected state in AsyncFlowControlledStreamRpcFunctor: " +
+        std::to_string(state_));
+  }
+
+  void OnConsumerReady(bool keep_reading) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!keep_reading) {
+      // The pending Read() completes with `ok == false`, and then the stream
+      // is finished as usual.
+      context_->TryCancel();
+    }
+    state_ = PROCESSING;
+    response_reader_->Read(&response_, tag_);
+  }
+
+  // See `AsyncUnaryStreamRpcFunctor` for the reasons to use a mutex.
+  std::mutex mu_;
+  void* tag_;
+  State state_;
+  grpc::Status status_;
+  DataFunctor data_functor_;
+  FinishedFunctor finished_functor_;
+  Response response_;
+  std::unique_ptr<grpc::ClientContext> context_;
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> response_reader_;
+};
+
 template <typename T>
 struct ExtractMemberFunctionType : public std::false_type {
   using ClassType = void;
@@ -398,6 +557,17 @@ template <typename Functor>
 using CheckRunAsyncCallback =
     google::cloud::internal::is_invocable<Functor, CompletionQueue&>;
 
+/**
+ * The `AsyncOperation` returned by `RunAsync()` when the functor is scheduled
+ * directly on a thread pool.
+ *
+ * The functor is scheduled right away, there is nothing to cancel.
+ */
+class AsyncRunOperation : public AsyncOperation {
+ public:
+  void Cancel() override {}
+};
+
 /**
  * The implementation details for `CompletionQueue`.
  *
@@ -407,7 +577,7 @@ using CheckRunAsyncCallback =
  */
 class CompletionQueueImpl {
  public:
-  CompletionQueueImpl() : cq_(), shutdown_(false) {}
+  CompletionQueueImpl() : cq_(), shutdown_(false), running_callbacks_(0) {}
   virtual ~CompletionQueueImpl() = default;
 
   /**
@@ -430,6 +600,22 @@ class CompletionQueueImpl {
   /// Add a new asynchronous operation to the completion queue.
   void* RegisterOperation(std::shared_ptr<AsyncGrpcOperation> op);
 
+  /**
+   * Run the callbacks for completed operations on @p executor.
+   *
+   * By default the callbacks run on the thread calling `Run()`. With an
+   * executor the threads calling `Run()` only poll the gRPC completion queue,
+   * and the callbacks (and any `future<T>::then()` continuations they satisfy)
+   * run on the executor threads. `Run()` returns only once the callbacks it
+   * submitted complete. This must be called before `Run()`.
+   */
+  void set_executor(std::shared_ptr<WorkStealingPool> executor) {
+    executor_ = std::move(executor);
+  }
+  std::shared_ptr<WorkStealingPool> const& executor() const {
+    return executor_;
+  }
+
  protected:
   /// Return the asynchronous operation associated with @p tag.
   std::shared_ptr<AsyncGrpcOperation> FindOperation(void* tag);
@@ -460,6 +646,11 @@ class CompletionQueueImpl {
   mutable std::mutex mu_;
   std::unordered_map<std::intptr_t, std::shared_ptr<AsyncGrpcOperation>>
       pending_ops_;
+  std::shared_ptr<WorkStealingPool> executor_;
+  // The callbacks submitted to `executor_` that have not completed, `Run()`
+  // waits for them before returning.
+  std::size_t running_callbacks_;
+  std::condition_variable callbacks_done_;
 };
 
 }  // namespace internal
@@ -0,0 +1,113 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_LOAD_TRACKING_READER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_LOAD_TRACKING_READER_H_
+
+#include "google/cloud/bigtable/internal/common_client.h"
+#include <grpcpp/support/async_stream.h>
+#include <grpcpp/support/sync_stream.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Decorate a `grpc::ClientReaderInterface<>` to count it against the load of
+ * its channel.
+ *
+ * The stream is counted until `Finish()` is called or the object is deleted.
+ */
+template <typename Response>
+class LoadTrackingClientReader : public grpc::ClientReaderInterface<Response> {
+ public:
+  LoadTrackingClientReader(
+      std::unique_ptr<grpc::ClientReaderInterface<Response>> reader,
+      ChannelLoadToken token)
+      : reader_(std::move(reader)), token_(std::move(token)) {}
+
+  void WaitForInitialMetadata() override { reader_->WaitForInitialMetadata(); }
+  bool NextMessageSize(std::uint32_t* sz) override {
+    return reader_->NextMessageSize(sz);
+  }
+  bool Read(Response* msg) override { return reader_->Read(msg); }
+  grpc::Status Finish() override {
+    auto status = reader_->Finish();
+    token_.reset();
+    return status;
+  }
+
+ private:
+  std::unique_ptr<grpc::ClientReaderInterface<Response>> reader_;
+  ChannelLoadToken token_;
+};
+
+/**
+ * Decorate a `grpc::ClientAsyncReaderInterface<>` to count it against the load
+ * of its channel.
+ *
+ * The stream is counted until the object is deleted, the asynchronous
+ * operations delete the reader once the stream is finished.
+ */
+template <typename Response>
+class LoadTrackingClientAsyncReader
+    : public grpc::ClientAsyncReaderInterface<Response> {
+ public:
+  LoadTrackingClientAsyncReader(
+      std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader,
+      ChannelLoadToken token)
+      : reader_(std::move(reader)), token_(std::move(token)) {}
+
+  void StartCall(void* tag) override { reader_->StartCall(tag); }
+  void ReadInitialMetadata(void* tag) override {
+    reader_->ReadInitialMetadata(tag);
+  }
+  void Read(Response* msg, void* tag) override { reader_->Read(msg, tag); }
+  void Finish(grpc::Status* status, void* tag) override {
+    reader_->Finish(status, tag);
+  }
+
+ private:
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader_;
+  ChannelLoadToken token_;
+};
+
+/// Count @p reader against the load of its channel while it is alive.
+template <typename Response>
+std::unique_ptr<grpc::ClientReaderInterface<Response>> TrackChannelLoad(
+    std::unique_ptr<grpc::ClientReaderInterface<Response>> reader,
+    ChannelLoadToken token) {
+  return std::unique_ptr<grpc::ClientReaderInterface<Response>>(
+      new LoadTrackingClientReader<Response>(std::move(reader),
+                                             std::move(token)));
+}
+
+/// Count @p reader against the load of its channel while it is alive.
+template <typename Response>
+std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> TrackChannelLoad(
+    std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader,
+    ChannelLoadToken token) {
+  return std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>>(
+      new LoadTrackingClientAsyncReader<Response>(std::move(reader),
+                                                  std::move(token)));
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_LOAD_TRACKING_READER_H_
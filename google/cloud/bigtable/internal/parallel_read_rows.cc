@@ -0,0 +1,97 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/parallel_read_rows.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+std::vector<RowRange> ShardRowRanges(std::vector<RowKeySample> const& samples,
+                                     std::size_t shard_count) {
+  // The last sample is (typically) the end of the table, with an empty key.
+  // Ignore the samples with empty keys, they cannot be split points.
+  std::int64_t total_bytes = 0;
+  for (auto const& s : samples) {
+    total_bytes = (std::max)(total_bytes, s.offset_bytes);
+  }
+
+  std::vector<std::string> splits;
+  for (std::size_t shard = 1; shard < shard_count; ++shard) {
+    auto const target = static_cast<std::int64_t>(
+        static_cast<double>(total_bytes) * shard / shard_count);
+    for (auto const& s : samples) {
+      if (s.row_key.empty() || s.offset_bytes < target) {
+        continue;
+      }
+      if (splits.empty() || splits.back() < s.row_key) {
+        splits.push_back(s.row_key);
+      }
+      break;
+    }
+  }
+
+  std::vector<RowRange> result;
+  std::string begin;
+  for (auto& split : splits) {
+    result.push_back(RowRange::Range(std::move(begin), split));
+    begin = std::move(split);
+  }
+  result.push_back(RowRange::StartingAt(std::move(begin)));
+  return result;
+}
+
+bool RowQueue::Push(Row row) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return cancelled_ || rows_.size() < capacity_; });
+  if (cancelled_) {
+    return false;
+  }
+  rows_.push_back(std::move(row));
+  cv_.notify_all();
+  return true;
+}
+
+bool RowQueue::Pop(std::deque<Row>& rows) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return done_ || !rows_.empty(); });
+  if (rows_.empty()) {
+    return false;
+  }
+  rows.swap(rows_);
+  rows_.clear();
+  cv_.notify_all();
+  return true;
+}
+
+void RowQueue::Finish(grpc::Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  done_ = true;
+  status_ = std::move(status);
+  cv_.notify_all();
+}
+
+void RowQueue::Cancel() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cancelled_ = true;
+  rows_.clear();
+  cv_.notify_all();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,100 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_READ_ROWS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_READ_ROWS_H_
+
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_key_sample.h"
+#include "google/cloud/bigtable/row_range.h"
+#include "google/cloud/bigtable/version.h"
+#include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Split the key space of a table into (at most) @p shard_count ranges.
+ *
+ * The ranges are contiguous, sorted, and cover all the possible keys. The
+ * split points are chosen among the keys in @p samples (the result of
+ * `SampleRowKeys`), such that each range contains about the same number of
+ * bytes.
+ */
+std::vector<RowRange> ShardRowRanges(std::vector<RowKeySample> const& samples,
+                                     std::size_t shard_count);
+
+/**
+ * A bounded, blocking queue of rows, with a single producer and consumer.
+ *
+ * `Table::ParallelReadRows()` uses one of these queues for each shard when the
+ * application wants the rows in order: each shard is read by a separate
+ * thread, and the consumer drains the queues one shard at a time. The bound
+ * keeps the memory usage in check when the consumer is slower than the
+ * readers.
+ */
+class RowQueue {
+ public:
+  explicit RowQueue(std::size_t capacity)
+      : capacity_(capacity), done_(false), cancelled_(false) {}
+
+  /**
+   * Add a row to the queue, blocking while the queue is full.
+   *
+   * @return false if the consumer cancelled the queue, the producer should
+   *     stop reading.
+   */
+  bool Push(Row row);
+
+  /**
+   * Move all the available rows into @p rows, blocking until there are some.
+   *
+   * Taking the rows in bulk reduces the contention on the queue lock.
+   *
+   * @return false if the producer finished and there are no more rows.
+   */
+  bool Pop(std::deque<Row>& rows);
+
+  /// The producer has no more rows, @p status is the result of the read.
+  void Finish(grpc::Status status);
+
+  /// The consumer is not interested in more rows.
+  void Cancel();
+
+  /// The status reported by the producer, valid after `Pop()` returns false.
+  grpc::Status const& status() const { return status_; }
+
+ private:
+  std::size_t const capacity_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Row> rows_;
+  bool done_;
+  bool cancelled_;
+  grpc::Status status_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_READ_ROWS_H_
@@ -0,0 +1,106 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/parallel_read_rows.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::vector<RowKeySample> MakeSamples() {
+  return {{"b", 100}, {"d", 200}, {"f", 300}, {"h", 400}, {"", 500}};
+}
+
+std::vector<std::string> AsStrings(std::vector<RowRange> const& ranges) {
+  std::vector<std::string> result;
+  for (auto const& r : ranges) {
+    result.push_back(r.as_proto().DebugString());
+  }
+  return result;
+}
+
+/// @test Verify that a single shard covers the full table.
+TEST(ShardRowRangesTest, SingleShard) {
+  EXPECT_EQ(AsStrings({RowRange::StartingAt("")}),
+            AsStrings(ShardRowRanges(MakeSamples(), 1)));
+  EXPECT_EQ(AsStrings({RowRange::StartingAt("")}),
+            AsStrings(ShardRowRanges(MakeSamples(), 0)));
+}
+
+/// @test Verify that the split points balance the shards.
+TEST(ShardRowRangesTest, Balanced) {
+  EXPECT_EQ(AsStrings({RowRange::Range("", "f"), RowRange::StartingAt("f")}),
+            AsStrings(ShardRowRanges(MakeSamples(), 2)));
+  EXPECT_EQ(AsStrings({RowRange::Range("", "b"), RowRange::Range("b", "d"),
+                       RowRange::Range("d", "f"), RowRange::Range("f", "h"),
+                       RowRange::StartingAt("h")}),
+            AsStrings(ShardRowRanges(MakeSamples(), 5)));
+}
+
+/// @test Verify that there are no more shards than samples.
+TEST(ShardRowRangesTest, MoreShardsThanSamples) {
+  auto actual = ShardRowRanges(MakeSamples(), 32);
+  EXPECT_EQ(5U, actual.size());
+  actual = ShardRowRanges({}, 32);
+  EXPECT_EQ(AsStrings({RowRange::StartingAt("")}), AsStrings(actual));
+}
+
+/// @test Verify that RowQueue delivers all the rows and the final status.
+TEST(RowQueueTest, ProducerConsumer) {
+  int const kRowCount = 100;
+  RowQueue queue(4);
+  std::thread producer([&queue] {
+    for (int i = 0; i != kRowCount; ++i) {
+      EXPECT_TRUE(queue.Push(Row("row" + std::to_string(i), {})));
+    }
+    queue.Finish(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try again"));
+  });
+
+  std::vector<std::string> actual;
+  std::deque<Row> rows;
+  while (queue.Pop(rows)) {
+    EXPECT_GE(4U, rows.size());
+    for (auto& r : rows) {
+      actual.push_back(r.row_key());
+    }
+    rows.clear();
+  }
+  producer.join();
+  ASSERT_EQ(static_cast<std::size_t>(kRowCount), actual.size());
+  for (int i = 0; i != kRowCount; ++i) {
+    EXPECT_EQ("row" + std::to_string(i), actual[i]);
+  }
+  EXPECT_EQ(grpc::StatusCode::UNAVAILABLE, queue.status().error_code());
+}
+
+/// @test Verify that cancelling the queue unblocks the producer.
+TEST(RowQueueTest, Cancel) {
+  RowQueue queue(1);
+  EXPECT_TRUE(queue.Push(Row("r0", {})));
+  std::thread producer([&queue] { EXPECT_FALSE(queue.Push(Row("r1", {}))); });
+  queue.Cancel();
+  producer.join();
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -22,6 +22,18 @@ inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 using google::bigtable::v2::ReadRowsResponse_CellChunk;
 
+namespace {
+/**
+ * Limit the memory used to intern names.
+ *
+ * Most tables have a few families and columns, but some applications use the
+ * column qualifiers as data (e.g. timestamps). Starting over once the limit is
+ * reached keeps the memory bounded for those, and still shares the names of
+ * the cells in the same row.
+ */
+std::size_t constexpr kMaxInternedNames = 1024;
+}  // namespace
+
 void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                                  grpc::Status& status) {
   if (end_of_stream_) {
@@ -41,7 +53,8 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                             "Row keys are expected in increasing order");
       return;
     }
-    chunk.mutable_row_key()->swap(cell_.row);
+    cell_.row = std::make_shared<std::string const>(
+        std::move(*chunk.mutable_row_key()));
   }
 
   if (chunk.has_family_name()) {
@@ -50,11 +63,13 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                             "New column family must specify qualifier");
       return;
     }
-    chunk.mutable_family_name()->mutable_value()->swap(cell_.family);
+    cell_.family =
+        Intern(std::move(*chunk.mutable_family_name()->mutable_value()));
   }
 
   if (chunk.has_qualifier()) {
-    chunk.mutable_qualifier()->mutable_value()->swap(cell_.column);
+    cell_.column =
+        Intern(std::move(*chunk.mutable_qualifier()->mutable_value()));
   }
 
   if (cell_first_chunk_) {
@@ -81,14 +96,14 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
   // Last chunk in the cell has zero for value size
   if (chunk.value_size() == 0) {
     if (cells_.empty()) {
-      if (cell_.row.empty()) {
+      if (!cell_.row || cell_.row->empty()) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
                               "Missing row key at last chunk in cell");
         return;
       }
-      row_key_ = cell_.row;
+      row_key_ = *cell_.row;
     } else {
-      if (row_key_ != cell_.row) {
+      if (!cell_.row || row_key_ != *cell_.row) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
                               "Different row key in cell chunk");
         return;
@@ -119,7 +134,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
     }
     row_ready_ = true;
     last_seen_row_key_ = row_key_;
-    cell_.row.clear();
+    cell_.row.reset();
   }
 }
 
@@ -161,14 +176,28 @@ Row ReadRowsParser::Next(grpc::Status& status) {
 }
 
 Cell ReadRowsParser::MovePartialToCell() {
-  // The row, family, and column are explicitly copied because the
+  // The row, family, and column are shared (not moved) because the
   // ReadRows v2 may reuse them in future chunks. See the CellChunk
   // message comments in bigtable.proto.
-  Cell cell(cell_.row, cell_.family, cell_.column, cell_.timestamp,
+  Cell cell(cell_.row, cell_.family ? cell_.family : empty_name_,
+            cell_.column ? cell_.column : empty_name_, cell_.timestamp,
             std::move(cell_.value), std::move(cell_.labels));
   cell_.value.clear();
   return cell;
 }
+
+std::shared_ptr<std::string const> ReadRowsParser::Intern(std::string name) {
+  auto it = interned_names_.find(name);
+  if (it != interned_names_.end()) {
+    return it->second;
+  }
+  if (interned_names_.size() >= kMaxInternedNames) {
+    interned_names_.clear();
+  }
+  auto interned = std::make_shared<std::string const>(name);
+  interned_names_.emplace(std::move(name), interned);
+  return interned;
+}
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
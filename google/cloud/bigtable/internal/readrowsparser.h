@@ -19,6 +19,8 @@
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/internal/make_unique.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace google {
@@ -55,6 +57,7 @@ class ReadRowsParser {
         cells_(),
         cell_first_chunk_(true),
         cell_(),
+        empty_name_(std::make_shared<std::string const>()),
         last_seen_row_key_(""),
         row_ready_(false),
         end_of_stream_(false) {}
@@ -100,9 +103,9 @@ class ReadRowsParser {
  private:
   /// Holds partially formed data until a full Row is ready.
   struct ParseCell {
-    std::string row;
-    std::string family;
-    std::string column;
+    std::shared_ptr<std::string const> row;
+    std::shared_ptr<std::string const> family;
+    std::shared_ptr<std::string const> column;
     int64_t timestamp;
     std::string value;
     std::vector<std::string> labels;
@@ -113,10 +116,18 @@ class ReadRowsParser {
    *
    * Also helps handle string ownership correctly. The value is moved
    * when converting to a result cell, but the key, family and column
-   * are copied, because they are possibly reused by following cells.
+   * are shared, because they are possibly reused by following cells.
    */
   Cell MovePartialToCell();
 
+  /**
+   * Return a shared copy of a family or column name.
+   *
+   * The same names appear in most rows of a table, the parser keeps a copy
+   * of the recently seen names and shares it with all the cells that use it.
+   */
+  std::shared_ptr<std::string const> Intern(std::string name);
+
   /// Row key for the current row.
   std::string row_key_;
 
@@ -129,6 +140,13 @@ class ReadRowsParser {
   /// Stores partial fields.
   ParseCell cell_;
 
+  /// Used for cells without a family or column name.
+  std::shared_ptr<std::string const> empty_name_;
+
+  /// The family and column names seen in this stream.
+  std::unordered_map<std::string, std::shared_ptr<std::string const>>
+      interned_names_;
+
   /// Set when a row is ready.
   std::string last_seen_row_key_;
 
@@ -93,6 +93,59 @@ TEST(ReadRowsParserTest, SingleChunkSucceeds) {
   EXPECT_TRUE(status.ok());
 }
 
+/// @test Verify that cells share the row key and the family and column names.
+TEST(ReadRowsParserTest, CellsShareNames) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  std::vector<std::string> chunks = {
+      R"(row_key: "RK1"
+         family_name: < value: "F">
+         qualifier: < value: "C">
+         timestamp_micros: 42
+         value: "V1")",
+      R"(qualifier: < value: "D">
+         timestamp_micros: 42
+         value: "V2"
+         commit_row: true)",
+      R"(row_key: "RK2"
+         family_name: < value: "F">
+         qualifier: < value: "C">
+         timestamp_micros: 42
+         value: "V3"
+         commit_row: true)",
+  };
+  grpc::Status status;
+  std::vector<google::cloud::bigtable::Row> rows;
+  for (auto const& text : chunks) {
+    ReadRowsResponse_CellChunk chunk;
+    ASSERT_TRUE(TextFormat::ParseFromString(text, &chunk));
+    parser.HandleChunk(chunk, status);
+    ASSERT_TRUE(status.ok());
+    if (parser.HasNext()) {
+      rows.emplace_back(parser.Next(status));
+      ASSERT_TRUE(status.ok());
+    }
+  }
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+
+  ASSERT_EQ(2U, rows.size());
+  ASSERT_EQ(2U, rows[0].cells().size());
+  ASSERT_EQ(1U, rows[1].cells().size());
+  auto const& c0 = rows[0].cells()[0];
+  auto const& c1 = rows[0].cells()[1];
+  auto const& c2 = rows[1].cells()[0];
+  EXPECT_EQ("RK1", c1.row_key());
+  EXPECT_EQ("F", c1.family_name());
+  EXPECT_EQ("D", c1.column_qualifier());
+  EXPECT_EQ("V2", c1.value());
+  EXPECT_EQ("RK2", c2.row_key());
+  EXPECT_EQ(&c0.row_key(), &c1.row_key());
+  EXPECT_EQ(&c0.family_name(), &c1.family_name());
+  EXPECT_EQ(&c0.family_name(), &c2.family_name());
+  EXPECT_EQ(&c0.column_qualifier(), &c2.column_qualifier());
+}
+
 TEST(ReadRowsParserTest, NextAfterEndOfStreamSucceeds) {
   using google::protobuf::TextFormat;
   ReadRowsParser parser;
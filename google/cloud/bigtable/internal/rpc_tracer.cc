@@ -0,0 +1,193 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+std::chrono::microseconds ToMicros(std::chrono::steady_clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(d);
+}
+
+/**
+ * The attempts waiting for `ReportChannel()`, indexed by their context.
+ *
+ * Attempts are only registered while instrumentation is enabled. The map is
+ * split in shards to reduce contention between threads starting RPCs.
+ */
+class AttemptRegistry {
+ public:
+  using Channel = std::shared_ptr<std::atomic<int>>;
+
+  void Register(grpc::ClientContext const* context, Channel channel) {
+    auto& shard = ShardFor(context);
+    std::lock_guard<std::mutex> lk(shard.mu);
+    // A stale entry, left by a context at the same address, is replaced.
+    shard.attempts[context] = std::move(channel);
+  }
+
+  void Unregister(grpc::ClientContext const* context, Channel const& channel) {
+    auto& shard = ShardFor(context);
+    std::lock_guard<std::mutex> lk(shard.mu);
+    auto i = shard.attempts.find(context);
+    if (i != shard.attempts.end() && i->second == channel) {
+      shard.attempts.erase(i);
+    }
+  }
+
+  void Report(grpc::ClientContext const* context, int channel_index) {
+    auto& shard = ShardFor(context);
+    std::lock_guard<std::mutex> lk(shard.mu);
+    auto i = shard.attempts.find(context);
+    if (i != shard.attempts.end()) {
+      i->second->store(channel_index, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  struct Shard {
+    std::mutex mu;
+    std::unordered_map<grpc::ClientContext const*, Channel> attempts;
+  };
+
+  Shard& ShardFor(grpc::ClientContext const* context) {
+    return shards_[std::hash<grpc::ClientContext const*>()(context) %
+                   shards_.size()];
+  }
+
+  std::array<Shard, 16> shards_;
+};
+
+AttemptRegistry& Registry() {
+  // Never deleted, attempts may be running while the program exits.
+  static auto* const kRegistry = new AttemptRegistry;
+  return *kRegistry;
+}
+}  // namespace
+
+RpcTracer::RpcTracer(std::shared_ptr<RpcInstrumentation> instrumentation,
+                     RpcOperation operation)
+    : instrumentation_(std::move(instrumentation)), operation_(operation) {
+  if (!instrumentation_) {
+    return;
+  }
+  start_ = Clock::now();
+  instrumentation_->OnStart(operation_);
+}
+
+RpcTracer::~RpcTracer() { Unregister(); }
+
+RpcTracer& RpcTracer::operator=(RpcTracer&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+  Unregister();
+  instrumentation_ = std::move(rhs.instrumentation_);
+  operation_ = rhs.operation_;
+  start_ = rhs.start_;
+  attempt_start_ = rhs.attempt_start_;
+  queue_latency_ = rhs.queue_latency_;
+  attempt_latency_ = rhs.attempt_latency_;
+  backoff_latency_ = rhs.backoff_latency_;
+  attempts_ = rhs.attempts_;
+  attempt_context_ = rhs.attempt_context_;
+  attempt_channel_ = std::move(rhs.attempt_channel_);
+  bytes_sent_ = rhs.bytes_sent_;
+  bytes_received_ = rhs.bytes_received_;
+  finished_ = rhs.finished_;
+  return *this;
+}
+
+void RpcTracer::ReportChannel(grpc::ClientContext const& context,
+                              int channel_index) {
+  Registry().Report(&context, channel_index);
+}
+
+void RpcTracer::AttemptStart(grpc::ClientContext const& context) {
+  if (!enabled()) {
+    return;
+  }
+  Unregister();
+  attempt_start_ = Clock::now();
+  if (attempts_ == 0) {
+    queue_latency_ = attempt_start_ - start_;
+  }
+  ++attempts_;
+  bytes_sent_ = 0;
+  bytes_received_ = 0;
+  attempt_context_ = &context;
+  attempt_channel_ = std::make_shared<std::atomic<int>>(-1);
+  Registry().Register(attempt_context_, attempt_channel_);
+}
+
+void RpcTracer::AttemptEnd(grpc::Status const& status) {
+  if (!enabled()) {
+    return;
+  }
+  auto const latency = Clock::now() - attempt_start_;
+  attempt_latency_ += latency;
+  int channel_index = -1;
+  if (attempt_channel_) {
+    // Unregister() locks the registry, so this sees any value reported by
+    // other threads.
+    auto channel = attempt_channel_;
+    Unregister();
+    channel_index = channel->load(std::memory_order_relaxed);
+  }
+  instrumentation_->OnAttempt(RpcAttempt{
+      operation_, attempts_, ToMicros(latency), status.error_code(),
+      channel_index, bytes_sent_, bytes_received_});
+}
+
+void RpcTracer::Unregister() {
+  if (!attempt_channel_) {
+    return;
+  }
+  Registry().Unregister(attempt_context_, attempt_channel_);
+  attempt_context_ = nullptr;
+  attempt_channel_.reset();
+}
+
+void RpcTracer::Backoff(std::chrono::milliseconds delay) {
+  if (!enabled()) {
+    return;
+  }
+  backoff_latency_ += delay;
+  instrumentation_->OnBackoff(RpcBackoff{operation_, attempts_, delay});
+}
+
+void RpcTracer::Finish(grpc::Status const& status) {
+  if (!enabled() || finished_) {
+    return;
+  }
+  finished_ = true;
+  instrumentation_->OnFinish(RpcFinish{
+      operation_, attempts_, status.error_code(),
+      ToMicros(Clock::now() - start_), ToMicros(queue_latency_),
+      ToMicros(attempt_latency_), std::chrono::microseconds(backoff_latency_)});
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
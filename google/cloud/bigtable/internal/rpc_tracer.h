@@ -0,0 +1,125 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RPC_TRACER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RPC_TRACER_H_
+
+#include "google/cloud/bigtable/rpc_instrumentation.h"
+#include "google/cloud/bigtable/version.h"
+#include <google/protobuf/message.h>
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Report the events of one operation to a `RpcInstrumentation`.
+ *
+ * The retry loops create one tracer for each operation, and call
+ * `AttemptStart()`, `AttemptEnd()`, `Backoff()`, and finally `Finish()` as the
+ * operation progresses. If the instrumentation is null, all the member
+ * functions return immediately, so the tracer can be used unconditionally.
+ *
+ * The `DataClient` picks the channel for each RPC, and its interface does not
+ * return it. Instead, `AttemptStart()` registers the `grpc::ClientContext` of
+ * the attempt, and the client calls `ReportChannel()` with that context.
+ *
+ * The tracer is not thread-safe, the retry loops call it serially.
+ */
+class RpcTracer {
+ public:
+  /// A disabled tracer.
+  RpcTracer() = default;
+  RpcTracer(std::shared_ptr<RpcInstrumentation> instrumentation,
+            RpcOperation operation);
+  ~RpcTracer();
+
+  RpcTracer(RpcTracer&&) noexcept = default;
+  RpcTracer& operator=(RpcTracer&& rhs) noexcept;
+  RpcTracer(RpcTracer const&) = delete;
+  RpcTracer& operator=(RpcTracer const&) = delete;
+
+  bool enabled() const { return static_cast<bool>(instrumentation_); }
+
+  /**
+   * Report the channel used by the RPC made with @p context.
+   *
+   * `DataClient` implementations call this after picking the channel for an
+   * RPC. It has no effect unless the context belongs to an attempt started
+   * with `AttemptStart()`, and not yet ended.
+   */
+  static void ReportChannel(grpc::ClientContext const& context,
+                            int channel_index);
+
+  /// Call before sending each request, @p context is used for the request.
+  void AttemptStart(grpc::ClientContext const& context);
+
+  /// Count the size of @p request against the current attempt.
+  void RequestSent(google::protobuf::Message const& request) {
+    if (enabled()) {
+      bytes_sent_ += request.ByteSizeLong();
+    }
+  }
+
+  /// Count the size of @p response against the current attempt.
+  void ResponseReceived(google::protobuf::Message const& response) {
+    if (enabled()) {
+      bytes_received_ += response.ByteSizeLong();
+    }
+  }
+
+  /// Call when the RPC for the current attempt completes.
+  void AttemptEnd(grpc::Status const& status);
+
+  /// Call before waiting @p delay to retry the operation.
+  void Backoff(std::chrono::milliseconds delay);
+
+  /// Call when the operation completes, only the first call has any effect.
+  void Finish(grpc::Status const& status);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /// Stop receiving `ReportChannel()` calls for the current attempt.
+  void Unregister();
+
+  std::shared_ptr<RpcInstrumentation> instrumentation_;
+  RpcOperation operation_ = RpcOperation::kApply;
+  Clock::time_point start_;
+  Clock::time_point attempt_start_;
+  Clock::duration queue_latency_ = {};
+  Clock::duration attempt_latency_ = {};
+  std::chrono::milliseconds backoff_latency_ = {};
+  int attempts_ = 0;
+  // The channel of the current attempt, shared with the registry of attempts
+  // while the attempt is running.
+  grpc::ClientContext const* attempt_context_ = nullptr;
+  std::shared_ptr<std::atomic<int>> attempt_channel_;
+  std::size_t bytes_sent_ = 0;
+  std::size_t bytes_received_ = 0;
+  bool finished_ = false;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RPC_TRACER_H_
@@ -13,9 +13,16 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/completion_queue_executor.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/parallel_read_rows.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
 #include "google/cloud/internal/make_unique.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 
@@ -34,6 +41,17 @@ static_assert(std::is_copy_assignable<bigtable::noex::Table>::value,
 // Call the `google.bigtable.v2.Bigtable.MutateRow` RPC repeatedly until
 // successful, or until the policies in effect tell us to stop.
 std::vector<FailedMutation> Table::Apply(SingleRowMutation&& mut) {
+  if (row_cache_) {
+    std::string row_key = mut.row_key();
+    InvalidateCachedRow(row_key);
+    auto failures = ApplyImpl(std::move(mut));
+    InvalidateCachedRow(row_key);
+    return failures;
+  }
+  return ApplyImpl(std::move(mut));
+}
+
+std::vector<FailedMutation> Table::ApplyImpl(SingleRowMutation&& mut) {
   // Copy the policies in effect for this operation.  Many policy classes change
   // their state as the operation makes progress (or fails to make progress), so
   // we need fresh instances.
@@ -56,13 +74,20 @@ std::vector<FailedMutation> Table::Apply(SingleRowMutation&& mut) {
   btproto::MutateRowResponse response;
   std::vector<FailedMutation> failures;
   grpc::Status status;
+  internal::RpcTracer tracer(rpc_instrumentation_, RpcOperation::kApply);
   while (true) {
     grpc::ClientContext client_context;
     rpc_policy->Setup(client_context);
     backoff_policy->Setup(client_context);
     metadata_update_policy_.Setup(client_context);
+    tracer.AttemptStart(client_context);
+    tracer.RequestSent(request);
     status = client_->MutateRow(&client_context, request, &response);
+    tracer.ResponseReceived(response);
+    tracer.AttemptEnd(status);
     if (status.ok()) {
+      rpc_policy->OnSuccess();
+      tracer.Finish(status);
       return failures;
     }
     // It is up to the policy to terminate this loop, it could run
@@ -76,9 +101,11 @@ std::vector<FailedMutation> Table::Apply(SingleRowMutation&& mut) {
       status = grpc::Status(
           status.error_code(),
           "Permanent (or too many transient) errors in Table::Apply()");
+      tracer.Finish(status);
       return failures;
     }
     auto delay = backoff_policy->OnCompletion(status);
+    tracer.Backoff(delay);
     std::this_thread::sleep_for(delay);
   }
 }
@@ -89,6 +116,27 @@ std::vector<FailedMutation> Table::Apply(SingleRowMutation&& mut) {
 // not succeed.
 std::vector<FailedMutation> Table::BulkApply(BulkMutation&& mut,
                                              grpc::Status& status) {
+  if (row_cache_) {
+    // BulkMutation does not expose the row keys, rebuild it to find them.
+    btproto::MutateRowsRequest request;
+    mut.MoveTo(&request);
+    std::vector<std::string> row_keys;
+    for (auto& entry : *request.mutable_entries()) {
+      row_keys.push_back(entry.row_key());
+      InvalidateCachedRow(entry.row_key());
+      mut.emplace_back(SingleRowMutation(std::move(entry)));
+    }
+    auto failures = BulkApplyImpl(std::move(mut), status);
+    for (auto const& row_key : row_keys) {
+      InvalidateCachedRow(row_key);
+    }
+    return failures;
+  }
+  return BulkApplyImpl(std::move(mut), status);
+}
+
+std::vector<FailedMutation> Table::BulkApplyImpl(BulkMutation&& mut,
+                                                 grpc::Status& status) {
   // Copy the policies in effect for this operation.  Many policy classes change
   // their state as the operation makes progress (or fails to make progress), so
   // we need fresh instances.
@@ -99,52 +147,85 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation&& mut,
   bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
                                           *idemponent_policy,
                                           std::forward<BulkMutation>(mut));
+  internal::RpcTracer tracer(rpc_instrumentation_, RpcOperation::kBulkApply);
   while (mutator.HasPendingMutations()) {
     grpc::ClientContext client_context;
     backoff_policy->Setup(client_context);
     retry_policy->Setup(client_context);
     metadata_update_policy_.Setup(client_context);
-    status = mutator.MakeOneRequest(*client_, client_context);
+    tracer.AttemptStart(client_context);
+    status = mutator.MakeOneRequest(*client_, client_context, &tracer);
+    tracer.AttemptEnd(status);
     if (!status.ok() && !retry_policy->OnFailure(status)) {
       break;
     }
     auto delay = backoff_policy->OnCompletion(status);
+    tracer.Backoff(delay);
     std::this_thread::sleep_for(delay);
   }
   auto failures = mutator.ExtractFinalFailures();
-  if (!status.ok()) {
-    return failures;
-  }
-  if (!failures.empty()) {
+  if (status.ok() && !failures.empty()) {
     status = grpc::Status(
         grpc::StatusCode::INTERNAL,
         "Permanent (or too many transient) errors in Table::BulkApply()");
+  } else if (status.ok()) {
+    retry_policy->OnSuccess();
   }
+  tracer.Finish(status);
   return failures;
 }
 
 RowReader Table::ReadRows(RowSet row_set, Filter filter, bool raise_on_error) {
-  return RowReader(client_, app_profile_id_, table_name_, std::move(row_set),
-                   RowReader::NO_ROWS_LIMIT, std::move(filter),
-                   rpc_retry_policy_->clone(), rpc_backoff_policy_->clone(),
-                   metadata_update_policy_,
-                   google::cloud::internal::make_unique<
-                       bigtable::internal::ReadRowsParserFactory>(),
-                   raise_on_error);
+  return ReadRows(std::move(row_set), RowReader::NO_ROWS_LIMIT,
+                  std::move(filter), raise_on_error);
 }
 
 RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                           Filter filter, bool raise_on_error) {
-  return RowReader(client_, app_profile_id_, table_name_, std::move(row_set),
+  RowReader reader(client_, app_profile_id_, table_name_, std::move(row_set),
                    rows_limit, std::move(filter), rpc_retry_policy_->clone(),
                    rpc_backoff_policy_->clone(), metadata_update_policy_,
                    google::cloud::internal::make_unique<
                        bigtable::internal::ReadRowsParserFactory>(),
                    raise_on_error);
+  reader.tracer_ =
+      internal::RpcTracer(rpc_instrumentation_, RpcOperation::kReadRows);
+  return reader;
 }
 
 std::pair<bool, Row> Table::ReadRow(std::string row_key, Filter filter,
                                     grpc::Status& status) {
+  if (!row_cache_) {
+    return ReadRowFromServer(std::move(row_key), std::move(filter), status);
+  }
+  // The serialized filter is deterministic for a given filter expression,
+  // `RowFilter` has no map fields.
+  auto filter_key = filter.as_proto().SerializeAsString();
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  if (row_cache_->Lookup(table_name(), row_key, filter_key, result,
+                         generation)) {
+    return result;
+  }
+  result = ReadRowFromServer(row_key, std::move(filter), status);
+  if (status.ok()) {
+    row_cache_->Insert(table_name(), row_key, filter_key, result, generation);
+  }
+  return result;
+}
+
+std::pair<bool, Row> Table::ReadRowFromServer(std::string row_key,
+                                              Filter filter,
+                                              grpc::Status& status) {
+  if (hedging_policy_) {
+    auto result = HedgedReadRow(row_key, filter, status);
+    if (status.ok() || RPCRetryPolicy::IsPermanentFailure(status)) {
+      return result;
+    }
+    // Both copies of the request failed with transient errors, use the retry
+    // loop in RowReader.
+    status = grpc::Status::OK;
+  }
   RowSet row_set(std::move(row_key));
   std::int64_t const rows_limit = 1;
   RowReader reader =
@@ -164,6 +245,331 @@ std::pair<bool, Row> Table::ReadRow(std::string row_key, Filter filter,
   return result;
 }
 
+std::pair<bool, Row> Table::ReadRowAttempt(
+    DataClient& client, btproto::ReadRowsRequest const& request,
+    grpc::ClientContext& context, grpc::Status& status) {
+  auto stream = client.ReadRows(&context, request);
+  auto parser = bigtable::internal::ReadRowsParserFactory().Create();
+  std::pair<bool, Row> result(false, Row("", {}));
+  btproto::ReadRowsResponse response;
+  while (status.ok() && stream->Read(&response)) {
+    for (auto& chunk : *response.mutable_chunks()) {
+      parser->HandleChunk(std::move(chunk), status);
+      if (!status.ok()) {
+        break;
+      }
+      if (!parser->HasNext()) {
+        continue;
+      }
+      if (result.first) {
+        status = grpc::Status(
+            grpc::StatusCode::INTERNAL,
+            "internal error - ReadRows returned 2 rows in ReadRow()");
+        break;
+      }
+      result = std::make_pair(true, parser->Next(status));
+      if (!status.ok()) {
+        break;
+      }
+    }
+  }
+  if (!status.ok()) {
+    context.TryCancel();
+    while (stream->Read(&response)) {
+    }
+    (void)stream->Finish();  // ignore errors, already reporting one
+    return std::make_pair(false, Row("", {}));
+  }
+  status = stream->Finish();
+  if (status.ok()) {
+    parser->HandleEndOfStream(status);
+  }
+  if (!status.ok()) {
+    return std::make_pair(false, Row("", {}));
+  }
+  return result;
+}
+
+struct Table::HedgedReadRowState {
+  // The hedged copy may outlive the `Table`, keep copies of what it needs.
+  HedgedReadRowState(Table const& table, btproto::ReadRowsRequest r)
+      : client(table.client_),
+        request(std::move(r)),
+        retry_policy(table.rpc_retry_policy_),
+        backoff_policy(table.rpc_backoff_policy_),
+        metadata_update_policy(table.metadata_update_policy_),
+        hedging_policy(table.hedging_policy_) {}
+
+  std::shared_ptr<DataClient> const client;
+  btproto::ReadRowsRequest const request;
+  std::shared_ptr<RPCRetryPolicy> const retry_policy;
+  std::shared_ptr<RPCBackoffPolicy> const backoff_policy;
+  MetadataUpdatePolicy const metadata_update_policy;
+  std::shared_ptr<ReadHedgingPolicy> const hedging_policy;
+
+  std::mutex mu;
+  std::condition_variable cv;
+  bool original_done = false;
+  bool hedge_running = false;
+  bool has_result = false;
+  bool hedge_won = false;
+  std::pair<bool, Row> result = std::make_pair(false, Row("", {}));
+  grpc::Status status;
+  // Each copy registers its context while it is in flight, so the winner can
+  // cancel the other copy.
+  grpc::ClientContext* in_flight[2] = {nullptr, nullptr};
+};
+
+void Table::HedgedReadRowAttempt(HedgedReadRowState& state, int index,
+                                 std::unique_lock<std::mutex>& lk) {
+  grpc::ClientContext context;
+  // The policies are prototypes shared by all the calls, each copy clones
+  // them to get its own deadline.
+  state.retry_policy->clone()->Setup(context);
+  state.backoff_policy->clone()->Setup(context);
+  state.metadata_update_policy.Setup(context);
+  state.in_flight[index] = &context;
+  lk.unlock();
+  grpc::Status attempt_status;
+  auto row =
+      ReadRowAttempt(*state.client, state.request, context, attempt_status);
+  lk.lock();
+  state.in_flight[index] = nullptr;
+  if (state.has_result) {
+    return;
+  }
+  if (!attempt_status.ok()) {
+    // Report this error unless the other copy succeeds.
+    state.status = std::move(attempt_status);
+    return;
+  }
+  state.has_result = true;
+  state.hedge_won = index == 1;
+  state.result = std::move(row);
+  state.status = std::move(attempt_status);
+  if (state.in_flight[1 - index] != nullptr) {
+    state.in_flight[1 - index]->TryCancel();
+  }
+}
+
+namespace {
+/**
+ * The completion queue used to delay the hedged requests.
+ *
+ * The hedged requests block the thread running them, they run on the worker
+ * threads of an executor shared by all the tables, instead of a new thread per
+ * `ReadRow()`. The executor is never destroyed, as hedged requests may be in
+ * flight at any time.
+ */
+CompletionQueue HedgeCompletionQueue() {
+  static auto* const kExecutor = new CompletionQueueExecutor(
+      1, (std::max)(2U, std::thread::hardware_concurrency()));
+  return kExecutor->cq();
+}
+}  // namespace
+
+std::pair<bool, Row> Table::HedgedReadRow(std::string const& row_key,
+                                          Filter const& filter,
+                                          grpc::Status& status) {
+  btproto::ReadRowsRequest request;
+  bigtable::internal::SetCommonTableOperationRequest<btproto::ReadRowsRequest>(
+      request, app_profile_id_.get(), table_name_.get());
+  request.mutable_rows()->add_row_keys(row_key);
+  *request.mutable_filter() = filter.as_proto();
+  request.set_rows_limit(1);
+
+  hedging_policy_->OnRequest();
+  auto state = std::make_shared<HedgedReadRowState>(*this, std::move(request));
+
+  // With a connection pool the hedged request is likely to use a different
+  // (and less loaded) channel than the original request. The timer only keeps
+  // a weak reference, so a pending timer does not hold the client and
+  // policies once this call returns.
+  std::weak_ptr<HedgedReadRowState> weak = state;
+  auto timer = HedgeCompletionQueue().MakeRelativeTimer(
+      hedging_policy_->delay(), [weak](CompletionQueue&, AsyncTimerResult& t) {
+        auto state = weak.lock();
+        if (t.cancelled || !state) {
+          return;
+        }
+        std::unique_lock<std::mutex> lk(state->mu);
+        if (state->original_done || !state->hedging_policy->AcquireHedge()) {
+          return;
+        }
+        state->hedge_running = true;
+        HedgedReadRowAttempt(*state, 1, lk);
+        state->hedge_running = false;
+        lk.unlock();
+        state->cv.notify_all();
+      });
+
+  std::unique_lock<std::mutex> lk(state->mu);
+  auto const start = std::chrono::steady_clock::now();
+  HedgedReadRowAttempt(*state, 0, lk);
+  auto const original_latency =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+  state->original_done = true;
+  // If the original request failed the hedged request may still succeed.
+  state->cv.wait(
+      lk, [&state] { return state->has_result || !state->hedge_running; });
+  bool const has_result = state->has_result;
+  bool const hedge_won = state->hedge_won;
+  auto result = std::move(state->result);
+  status = std::move(state->status);
+  lk.unlock();
+  // Release the timer early when the hedged request is not needed.
+  timer->Cancel();
+
+  if (has_result) {
+    // The delay is computed from the latency of the original requests only.
+    // When the hedged request wins the original request is cancelled, and its
+    // latency is the time until the cancellation.
+    hedging_policy_->OnCompletion(original_latency, hedge_won);
+  }
+  return result;
+}
+
+void Table::ParallelReadRows(RowSet row_set, Filter filter,
+                             std::size_t parallelism, bool ordered,
+                             std::function<void(Row)> const& consumer,
+                             grpc::Status& status) {
+  auto samples = SampleRows<std::vector>(status);
+  if (!status.ok()) {
+    return;
+  }
+  std::vector<RowSet> shards;
+  for (auto const& range :
+       bigtable::internal::ShardRowRanges(samples, parallelism)) {
+    auto shard = row_set.Intersect(range);
+    if (!shard.IsEmpty()) {
+      shards.push_back(std::move(shard));
+    }
+  }
+
+  if (shards.size() <= 1) {
+    // Nothing to parallelize, read the rows in this thread.
+    auto reader = ReadRows(std::move(row_set), std::move(filter));
+    for (auto& row : reader) {
+      consumer(std::move(row));
+    }
+    status = reader.Finish();
+    return;
+  }
+
+  std::vector<std::thread> readers;
+  std::vector<std::unique_ptr<bigtable::internal::RowQueue>> queues;
+  // Destroying a joinable std::thread terminates the program, the readers must
+  // be stopped and joined on every exit path, including exceptions raised by
+  // `consumer`.
+  struct JoinReaders {
+    std::vector<std::thread>& readers;
+    std::vector<std::unique_ptr<bigtable::internal::RowQueue>>& queues;
+    ~JoinReaders() {
+      for (auto& queue : queues) {
+        queue->Cancel();
+      }
+      for (auto& t : readers) {
+        if (t.joinable()) {
+          t.join();
+        }
+      }
+    }
+  } join_readers{readers, queues};
+
+  if (!ordered) {
+    // Stop all the shards as soon as one fails, the result is an error anyway.
+    std::atomic<bool> failed(false);
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    // The consumer runs in the reader threads, an exception cannot escape them
+    // so it is captured and rethrown once all the readers are joined.
+    std::mutex mu;
+    std::exception_ptr consumer_exception;
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    auto read_shard = [this, &filter, &consumer, &failed,
+                       &status](RowSet& shard) {
+      auto reader = ReadRows(std::move(shard), filter);
+      for (auto& row : reader) {
+        if (failed.load()) {
+          reader.Cancel();
+          return;
+        }
+        consumer(std::move(row));
+      }
+      auto shard_status = reader.Finish();
+      // Only the first failure is reported, joining the threads makes the
+      // value visible to the caller.
+      if (!shard_status.ok() && !failed.exchange(true)) {
+        status = std::move(shard_status);
+      }
+    };
+    for (auto& shard : shards) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      readers.emplace_back([&read_shard, &shard, &failed, &mu,
+                            &consumer_exception] {
+        try {
+          read_shard(shard);
+        } catch (...) {
+          failed.store(true);
+          std::lock_guard<std::mutex> lk(mu);
+          if (!consumer_exception) {
+            consumer_exception = std::current_exception();
+          }
+        }
+      });
+#else
+      readers.emplace_back([&read_shard, &shard] { read_shard(shard); });
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+    for (auto& t : readers) {
+      t.join();
+    }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    if (consumer_exception) {
+      std::rethrow_exception(consumer_exception);
+    }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    return;
+  }
+
+  // The rows in each shard are sorted, and the shards do not overlap, so
+  // draining the shards one at a time returns all the rows in order. The
+  // queues are bounded, readers for the later shards block once they are
+  // far enough ahead.
+  std::size_t const kQueueCapacity = 1024;
+  for (auto& shard : shards) {
+    queues.emplace_back(
+        google::cloud::internal::make_unique<bigtable::internal::RowQueue>(
+            kQueueCapacity));
+    auto& queue = *queues.back();
+    readers.emplace_back([this, &shard, &filter, &queue] {
+      auto reader = ReadRows(std::move(shard), filter);
+      for (auto& row : reader) {
+        if (!queue.Push(std::move(row))) {
+          reader.Cancel();
+          break;
+        }
+      }
+      queue.Finish(reader.Finish());
+    });
+  }
+  std::deque<Row> rows;
+  for (auto& queue : queues) {
+    if (!status.ok()) {
+      queue->Cancel();
+      continue;
+    }
+    while (queue->Pop(rows)) {
+      for (auto& row : rows) {
+        consumer(std::move(row));
+      }
+      rows.clear();
+    }
+    status = queue->status();
+  }
+  // The readers are joined by `join_readers`.
+}
+
 bool Table::CheckAndMutateRow(std::string row_key, Filter filter,
                               std::vector<Mutation> true_mutations,
                               std::vector<Mutation> false_mutations,
@@ -182,20 +588,30 @@ bool Table::CheckAndMutateRow(std::string row_key, Filter filter,
   }
   bool const is_idempotent =
       idempotent_mutation_policy_->is_idempotent(request);
+  InvalidateCachedRow(request.row_key());
+  internal::RpcTracer tracer(rpc_instrumentation_,
+                             RpcOperation::kCheckAndMutateRow);
   auto response = ClientUtils::MakeCall(
       *client_, rpc_retry_policy_->clone(), rpc_backoff_policy_->clone(),
       metadata_update_policy_, &DataClient::CheckAndMutateRow, request,
-      "Table::CheckAndMutateRow", status, is_idempotent);
+      "Table::CheckAndMutateRow", status, is_idempotent, &tracer);
+  tracer.Finish(status);
+  InvalidateCachedRow(request.row_key());
 
   return response.predicate_matched();
 }
 
 Row Table::CallReadModifyWriteRowRequest(
     btproto::ReadModifyWriteRowRequest const& request, grpc::Status& status) {
+  InvalidateCachedRow(request.row_key());
+  internal::RpcTracer tracer(rpc_instrumentation_,
+                             RpcOperation::kReadModifyWriteRow);
   auto response = ClientUtils::MakeNonIdemponentCall(
       *client_, rpc_retry_policy_->clone(), metadata_update_policy_,
       &DataClient::ReadModifyWriteRow, request, "ReadModifyWriteRowRequest",
-      status);
+      status, &tracer);
+  tracer.Finish(status);
+  InvalidateCachedRow(request.row_key());
   if (!status.ok()) {
     return Row("", {});
   }
@@ -239,14 +655,19 @@ void Table::SampleRowsImpl(
       btproto::SampleRowKeysRequest>(request, app_profile_id_.get(),
                                      table_name_.get());
 
+  internal::RpcTracer tracer(rpc_instrumentation_,
+                             RpcOperation::kSampleRowKeys);
   while (true) {
     grpc::ClientContext client_context;
     backoff_policy->Setup(client_context);
     retry_policy->Setup(client_context);
     metadata_update_policy_.Setup(client_context);
 
+    tracer.AttemptStart(client_context);
+    tracer.RequestSent(request);
     auto stream = client_->SampleRowKeys(&client_context, request);
     while (stream->Read(&response)) {
+      tracer.ResponseReceived(response);
       // Assuming collection will be either list or vector.
       bigtable::RowKeySample row_sample;
       row_sample.offset_bytes = response.offset_bytes();
@@ -254,18 +675,23 @@ void Table::SampleRowsImpl(
       inserter(std::move(row_sample));
     }
     status = stream->Finish();
+    tracer.AttemptEnd(status);
     if (status.ok()) {
+      retry_policy->OnSuccess();
       break;
     }
     if (!retry_policy->OnFailure(status)) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "No more retries allowed as per policy.");
+      tracer.Finish(status);
       return;
     }
     clearer();
     auto delay = backoff_policy->OnCompletion(status);
+    tracer.Backoff(delay);
     std::this_thread::sleep_for(delay);
   }
+  tracer.Finish(status);
 }
 
 }  // namespace noex
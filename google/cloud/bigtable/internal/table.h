@@ -21,13 +21,17 @@
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
+#include "google/cloud/bigtable/internal/async_flow_controlled_row_reader.h"
 #include "google/cloud/bigtable/internal/async_read_row_operation.h"
 #include "google/cloud/bigtable/internal/async_retry_unary_rpc.h"
 #include "google/cloud/bigtable/internal/async_sample_row_keys.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/read_hedging_policy.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/row_cache.h"
 #include "google/cloud/bigtable/row_key_sample.h"
 #include "google/cloud/bigtable/row_reader.h"
 #include "google/cloud/bigtable/row_set.h"
@@ -36,6 +40,8 @@
 #include "google/cloud/bigtable/table_strong_types.h"
 #include "google/cloud/bigtable/version.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <functional>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -114,7 +120,8 @@ class Table {
             bigtable::DefaultRPCBackoffPolicy(internal::kBigtableLimits)),
         metadata_update_policy_(table_name(), MetadataParamTypes::TABLE_NAME),
         idempotent_mutation_policy_(
-            bigtable::DefaultIdempotentMutationPolicy()) {}
+            bigtable::DefaultIdempotentMutationPolicy()),
+        rpc_instrumentation_(client_->rpc_instrumentation()) {}
 
   Table(std::shared_ptr<DataClient> client, std::string const& table_id)
       : Table(std::move(client), bigtable::AppProfileId(""), table_id) {}
@@ -219,6 +226,8 @@ class Table {
         internal::ConstantIdempotencyPolicy(is_idempotent),
         metadata_update_policy_, client_, &DataClient::AsyncMutateRow,
         std::move(request), std::forward<Functor>(callback));
+    retry->set_rpc_tracer(
+        internal::RpcTracer(rpc_instrumentation_, RpcOperation::kAsyncApply));
     return retry->Start(cq);
   }
 
@@ -257,7 +266,8 @@ class Table {
             *idempotent_mutation_policy_, metadata_update_policy_, client_,
             app_profile_id_, table_name_, std::move(mut),
             std::forward<Functor>(callback));
-
+    op->set_rpc_tracer(internal::RpcTracer(rpc_instrumentation_,
+                                           RpcOperation::kAsyncBulkApply));
     return op->Start(cq);
   }
 
@@ -273,6 +283,21 @@ class Table {
   std::pair<bool, Row> ReadRow(std::string row_key, Filter filter,
                                grpc::Status& status);
 
+  /**
+   * Read a set of rows using one stream for each shard of the table.
+   *
+   * Uses `SampleRowKeys` to split the table into (at most) @p parallelism
+   * shards of similar size, and reads the rows in @p row_set from each shard
+   * in a separate thread.
+   *
+   * @param ordered if true, @p consumer is called from this thread with the
+   *     rows in key order. Otherwise @p consumer is called from the reader
+   *     threads, in any order, and must be thread-safe.
+   */
+  void ParallelReadRows(RowSet row_set, Filter filter, std::size_t parallelism,
+                        bool ordered, std::function<void(Row)> const& consumer,
+                        grpc::Status& status);
+
   /**
    * Reads a limited set of rows from the table asynchronously.
    *
@@ -320,7 +345,62 @@ class Table {
             bigtable::internal::ReadRowsParserFactory>(),
         std::forward<ReadRowCallback>(read_row_callback),
         std::forward<DoneCallback>(done_callback));
+    op->set_rpc_tracer(internal::RpcTracer(rpc_instrumentation_,
+                                           RpcOperation::kAsyncReadRows));
+    return op->Start(cq);
+  }
 
+  /**
+   * Reads a set of rows asynchronously, at the pace of the application.
+   *
+   * Unlike `AsyncReadRows()`, the callback receiving each row returns a
+   * `future<bool>`. The next row is not delivered, and no more data is
+   * requested from the server, until that future is satisfied, so a slow
+   * consumer does not cause the rows to accumulate in memory. Satisfying the
+   * future with `false` stops the read, the operation then completes
+   * successfully.
+   *
+   * Failed streams are retried, resuming after the last row delivered to the
+   * callback.
+   *
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @param read_row_callback a functor to be called for each row. It must
+   *     satisfy (using C++17 types):
+   *     static_assert(std::is_same_v<std::invoke_result_t<
+   *         ReadRowCallback, CompletionQueue&, Row>, future<bool>>);
+   * @param done_callback a functor to be called when the operation completes.
+   *     It must satisfy (using C++17 types): static_assert(std::is_invocable<
+   *         DoneCallback, CompletionQueue&, bool&, grpc::Status const&>);
+   * @param row_set the rows to read from.
+   * @param rows_limit the maximum number of rows to read, zero means no limit.
+   * @param filter is applied on the server-side to data in the rows.
+   */
+  template <typename ReadRowCallback, typename DoneCallback,
+            typename std::enable_if<
+                internal::CheckFlowControlledReadRowCallback<
+                    ReadRowCallback>::value,
+                int>::type valid_data_callback_type = 0,
+            typename std::enable_if<google::cloud::internal::is_invocable<
+                                        DoneCallback, CompletionQueue&, bool&,
+                                        grpc::Status const&>::value,
+                                    int>::type valid_callback_type = 0>
+  std::shared_ptr<AsyncOperation> AsyncReadRowsWithFlowControl(
+      CompletionQueue& cq, ReadRowCallback&& read_row_callback,
+      DoneCallback&& done_callback, RowSet row_set, std::int64_t rows_limit,
+      Filter filter) {
+    auto op = std::make_shared<internal::AsyncFlowControlledReadRowsOperation<
+        ReadRowCallback, DoneCallback>>(
+        rpc_retry_policy_->clone(), rpc_backoff_policy_->clone(),
+        metadata_update_policy_, client_, app_profile_id_, table_name_,
+        std::move(row_set), rows_limit, std::move(filter),
+        google::cloud::internal::make_unique<
+            bigtable::internal::ReadRowsParserFactory>(),
+        std::forward<ReadRowCallback>(read_row_callback),
+        std::forward<DoneCallback>(done_callback));
+    op->set_rpc_tracer(internal::RpcTracer(rpc_instrumentation_,
+                                           RpcOperation::kAsyncReadRows));
     return op->Start(cq);
   }
 
@@ -442,6 +522,8 @@ class Table {
         std::move(request),
         internal::UnwrapCheckAndMutateResponse<Functor>(
             std::forward<Functor>(callback)));
+    retry->set_rpc_tracer(internal::RpcTracer(
+        rpc_instrumentation_, RpcOperation::kAsyncCheckAndMutateRow));
     return retry->Start(cq);
   }
 
@@ -511,7 +593,8 @@ class Table {
             __func__, rpc_retry_policy_->clone(), rpc_backoff_policy_->clone(),
             metadata_update_policy_, client_, app_profile_id_, table_name_,
             std::forward<Functor>(callback));
-
+    op->set_rpc_tracer(internal::RpcTracer(rpc_instrumentation_,
+                                           RpcOperation::kAsyncSampleRowKeys));
     return op->Start(cq);
   }
   //@}
@@ -531,6 +614,14 @@ class Table {
     idempotent_mutation_policy_ = policy.clone();
   }
 
+  void ChangePolicy(std::shared_ptr<RowCache> const& cache) {
+    row_cache_ = cache;
+  }
+
+  void ChangePolicy(std::shared_ptr<ReadHedgingPolicy> const& policy) {
+    hedging_policy_ = policy;
+  }
+
   template <typename Policy, typename... Policies>
   void ChangePolicies(Policy&& policy, Policies&&... policies) {
     ChangePolicy(policy);
@@ -539,6 +630,61 @@ class Table {
   void ChangePolicies() {}
   //@}
 
+  /// Apply a mutation, without invalidating the cache.
+  std::vector<FailedMutation> ApplyImpl(SingleRowMutation&& mut);
+
+  /// Apply a bulk mutation, without invalidating the cache.
+  std::vector<FailedMutation> BulkApplyImpl(BulkMutation&& mut,
+                                            grpc::Status& status);
+
+  /// Read a single row, bypassing the cache.
+  std::pair<bool, Row> ReadRowFromServer(std::string row_key, Filter filter,
+                                         grpc::Status& status);
+
+  /**
+   * Read a single row, hedging the request if it is slow.
+   *
+   * Each copy of the request is a single RPC, without retries. The caller
+   * falls back to the retry loop if both copies fail.
+   */
+  std::pair<bool, Row> HedgedReadRow(std::string const& row_key,
+                                     Filter const& filter,
+                                     grpc::Status& status);
+
+  /**
+   * The state shared by the original and the hedged copies of a `ReadRow()`.
+   *
+   * The hedged copy may still be running when `ReadRow()` returns, so both
+   * copies own the state.
+   */
+  struct HedgedReadRowState;
+
+  /**
+   * Make one copy of a hedged `ReadRow()`, the first successful copy wins.
+   *
+   * Called and returns with @p lk, a lock on `state.mu`, held.
+   */
+  static void HedgedReadRowAttempt(HedgedReadRowState& state, int index,
+                                   std::unique_lock<std::mutex>& lk);
+
+  /// Make a single `ReadRows` RPC for at most one row, using @p context.
+  static std::pair<bool, Row> ReadRowAttempt(
+      DataClient& client, google::bigtable::v2::ReadRowsRequest const& request,
+      grpc::ClientContext& context, grpc::Status& status);
+
+  /**
+   * Discard any cached results for @p row_key.
+   *
+   * Mutations call this before and after contacting the server: the first
+   * call prevents reads already in progress from caching the old values, the
+   * second discards any results read while the mutation was in progress.
+   */
+  void InvalidateCachedRow(std::string const& row_key) {
+    if (row_cache_) {
+      row_cache_->Invalidate(table_name(), row_key);
+    }
+  }
+
   /**
    * Send request ReadModifyWriteRowRequest to modify the row and get it back
    */
@@ -577,6 +723,9 @@ class Table {
   std::shared_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<IdempotentMutationPolicy> idempotent_mutation_policy_;
+  std::shared_ptr<RowCache> row_cache_;
+  std::shared_ptr<ReadHedgingPolicy> hedging_policy_;
+  std::shared_ptr<RpcInstrumentation> rpc_instrumentation_;
 };
 
 }  // namespace noex
@@ -0,0 +1,303 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/testing/internal_table_test_fixture.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/bigtable/testing/mock_data_client.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace noex {
+namespace {
+
+namespace bt = ::google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+using namespace ::testing;
+using bigtable::testing::MockClientAsyncReaderInterface;
+using MockAsyncReadRowsReader =
+    MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+
+class NoexTableAsyncReadRowsWithFlowControlTest
+    : public bigtable::testing::internal::TableTestFixture {
+ protected:
+  NoexTableAsyncReadRowsWithFlowControlTest()
+      : cq_impl_(std::make_shared<bigtable::testing::MockCompletionQueue>()),
+        cq_(cq_impl_) {}
+
+  std::shared_ptr<bigtable::testing::MockCompletionQueue> cq_impl_;
+  CompletionQueue cq_;
+};
+
+void AddRow(btproto::ReadRowsResponse& r, std::string row_key) {
+  auto& c = *r.add_chunks();
+  c.set_row_key(std::move(row_key));
+  c.set_timestamp_micros(1000);
+  c.set_value("test");
+  c.set_value_size(0);
+  c.set_commit_row(true);
+}
+
+/// @test Verify that no data is requested while the consumer is busy.
+TEST_F(NoexTableAsyncReadRowsWithFlowControlTest, Backpressure) {
+  auto reader = new MockAsyncReadRowsReader;
+  std::unique_ptr<MockAsyncReadRowsReader> reader_deleter(reader);
+  int read_count = 0;
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([&read_count](btproto::ReadRowsResponse* r, void*) {
+        ++read_count;
+        AddRow(*r, "0001");
+        AddRow(*r, "0002");
+      }))
+      .WillOnce(Invoke(
+          [&read_count](btproto::ReadRowsResponse*, void*) { ++read_count; }));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  std::vector<std::string> rows;
+  promise<bool> first_row_consumed;
+  bool done_op_called = false;
+  table_.AsyncReadRowsWithFlowControl(
+      cq_,
+      [&rows, &first_row_consumed](CompletionQueue&, Row row) {
+        rows.push_back(row.row_key());
+        if (rows.size() == 1U) {
+          return first_row_consumed.get_future();
+        }
+        return make_ready_future(true);
+      },
+      [&done_op_called](CompletionQueue&, bool& response,
+                        grpc::Status const& status) {
+        EXPECT_TRUE(response);
+        EXPECT_TRUE(status.ok());
+        done_op_called = true;
+      },
+      bt::RowSet(), bt::RowReader::NO_ROWS_LIMIT, bt::Filter::PassAllFilter());
+
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == WAITING, the consumer has not finished with the first row.
+  EXPECT_EQ(std::vector<std::string>{"0001"}, rows);
+  EXPECT_EQ(1, read_count);
+  cq_impl_->SimulateCompletion(cq_, true);
+  // Spurious completions do not request more data either.
+  EXPECT_EQ(std::vector<std::string>{"0001"}, rows);
+  EXPECT_EQ(1, read_count);
+
+  // Satisfying the future delivers the next row and requests more data.
+  first_row_consumed.set_value(true);
+  EXPECT_EQ((std::vector<std::string>{"0001", "0002"}), rows);
+  EXPECT_EQ(2, read_count);
+  cq_impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  EXPECT_FALSE(done_op_called);
+  cq_impl_->SimulateCompletion(cq_, true);
+  EXPECT_TRUE(done_op_called);
+}
+
+/// @test Verify that the consumer can stop the stream.
+TEST_F(NoexTableAsyncReadRowsWithFlowControlTest, StopReading) {
+  auto reader = new MockAsyncReadRowsReader;
+  std::unique_ptr<MockAsyncReadRowsReader> reader_deleter(reader);
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        AddRow(*r, "0001");
+        AddRow(*r, "0002");
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::CANCELLED, "cancelled");
+      }));
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  std::vector<std::string> rows;
+  bool done_op_called = false;
+  table_.AsyncReadRowsWithFlowControl(
+      cq_,
+      [&rows](CompletionQueue&, Row row) {
+        rows.push_back(row.row_key());
+        return make_ready_future(false);
+      },
+      [&done_op_called](CompletionQueue&, bool&, grpc::Status const& status) {
+        EXPECT_TRUE(status.ok());
+        done_op_called = true;
+      },
+      bt::RowSet(), bt::RowReader::NO_ROWS_LIMIT, bt::Filter::PassAllFilter());
+
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, the stream is cancelled
+  EXPECT_EQ(std::vector<std::string>{"0001"}, rows);
+  cq_impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  cq_impl_->SimulateCompletion(cq_, true);
+  EXPECT_TRUE(done_op_called);
+  EXPECT_EQ(std::vector<std::string>{"0001"}, rows);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that the stream is cancelled if the consumer goes away.
+TEST_F(NoexTableAsyncReadRowsWithFlowControlTest, ConsumerAbandonsPromise) {
+  auto reader = new MockAsyncReadRowsReader;
+  std::unique_ptr<MockAsyncReadRowsReader> reader_deleter(reader);
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        AddRow(*r, "0001");
+        AddRow(*r, "0002");
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::CANCELLED, "cancelled");
+      }));
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  std::vector<std::string> rows;
+  std::unique_ptr<promise<bool>> consumer(new promise<bool>);
+  bool done_op_called = false;
+  table_.AsyncReadRowsWithFlowControl(
+      cq_,
+      [&rows, &consumer](CompletionQueue&, Row row) {
+        rows.push_back(row.row_key());
+        return consumer->get_future();
+      },
+      [&done_op_called](CompletionQueue&, bool&, grpc::Status const& status) {
+        EXPECT_TRUE(status.ok());
+        done_op_called = true;
+      },
+      bt::RowSet(), bt::RowReader::NO_ROWS_LIMIT, bt::Filter::PassAllFilter());
+
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == WAITING
+  EXPECT_EQ(std::vector<std::string>{"0001"}, rows);
+
+  // Abandoning the promise cancels the stream, instead of stalling it.
+  consumer.reset();
+  cq_impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  cq_impl_->SimulateCompletion(cq_, true);
+  EXPECT_TRUE(done_op_called);
+  EXPECT_EQ(std::vector<std::string>{"0001"}, rows);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+/// @test Verify that retries resume after the last delivered row.
+TEST_F(NoexTableAsyncReadRowsWithFlowControlTest, ReadRowsWithRetry) {
+  auto reader1 = new MockAsyncReadRowsReader;
+  std::unique_ptr<MockAsyncReadRowsReader> reader_deleter1(reader1);
+  auto reader2 = new MockAsyncReadRowsReader;
+  std::unique_ptr<MockAsyncReadRowsReader> reader_deleter2(reader2);
+
+  EXPECT_CALL(*reader1, Read(_, _))
+      .WillOnce(Invoke(
+          [](btproto::ReadRowsResponse* r, void*) { AddRow(*r, "0001"); }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader1, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try again");
+      }));
+  EXPECT_CALL(*reader2, Read(_, _))
+      .WillOnce(Invoke(
+          [](btproto::ReadRowsResponse* r, void*) { AddRow(*r, "0002"); }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader2, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter1](grpc::ClientContext*,
+                                          btproto::ReadRowsRequest const& r,
+                                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ("0000", r.rows().row_ranges(0).start_key_closed());
+        return std::move(reader_deleter1);
+      }))
+      .WillOnce(Invoke([&reader_deleter2](grpc::ClientContext*,
+                                          btproto::ReadRowsRequest const& r,
+                                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ("0001", r.rows().row_ranges(0).start_key_open());
+        EXPECT_EQ("0005", r.rows().row_ranges(0).end_key_open());
+        return std::move(reader_deleter2);
+      }));
+
+  std::vector<std::string> rows;
+  bool done_op_called = false;
+  table_.AsyncReadRowsWithFlowControl(
+      cq_,
+      [&rows](CompletionQueue&, Row row) {
+        rows.push_back(row.row_key());
+        return make_ready_future(true);
+      },
+      [&done_op_called](CompletionQueue&, bool& response,
+                        grpc::Status const& status) {
+        EXPECT_TRUE(response);
+        EXPECT_TRUE(status.ok());
+        done_op_called = true;
+      },
+      bt::RowSet(bt::RowRange::Range("0000", "0005")),
+      bt::RowReader::NO_ROWS_LIMIT, bt::Filter::PassAllFilter());
+
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, 1 read
+  cq_impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  cq_impl_->SimulateCompletion(cq_, true);
+  // finished, scheduled timer
+  cq_impl_->SimulateCompletion(cq_, true);
+  // timer finished, retry
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  cq_impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, 1 read
+  cq_impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  EXPECT_FALSE(done_op_called);
+  cq_impl_->SimulateCompletion(cq_, true);
+  EXPECT_TRUE(done_op_called);
+  EXPECT_EQ((std::vector<std::string>{"0001", "0002"}), rows);
+}
+
+}  // namespace
+}  // namespace noex
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
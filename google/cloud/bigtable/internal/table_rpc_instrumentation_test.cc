@@ -0,0 +1,293 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
+#include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/rpc_latency_histogram.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/bigtable/testing/mock_data_client.h"
+#include "google/cloud/bigtable/testing/mock_mutate_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace noex {
+namespace {
+namespace btproto = google::bigtable::v2;
+using namespace google::cloud::testing_util::chrono_literals;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+/// Record the events as strings, to verify their order.
+class RecordingInstrumentation : public RpcInstrumentation {
+ public:
+  void OnStart(RpcOperation operation) override {
+    events.push_back(std::string("start ") + RpcOperationName(operation));
+  }
+  void OnAttempt(RpcAttempt const& attempt) override {
+    events.push_back("attempt " + std::to_string(attempt.attempt) + " " +
+                     std::to_string(static_cast<int>(attempt.status)));
+    attempts.push_back(attempt);
+  }
+  void OnBackoff(RpcBackoff const& backoff) override {
+    events.push_back("backoff " + std::to_string(backoff.attempt));
+  }
+  void OnFinish(RpcFinish const& finish) override {
+    events.push_back("finish " + std::to_string(finish.attempts) + " " +
+                     std::to_string(static_cast<int>(finish.status)));
+    finishes.push_back(finish);
+  }
+
+  std::vector<std::string> events;
+  std::vector<RpcAttempt> attempts;
+  std::vector<RpcFinish> finishes;
+};
+
+/// A mock client configured with some instrumentation.
+class InstrumentedDataClient : public testing::MockDataClient {
+ public:
+  explicit InstrumentedDataClient(
+      std::shared_ptr<RpcInstrumentation> instrumentation)
+      : instrumentation_(std::move(instrumentation)) {}
+
+  std::shared_ptr<RpcInstrumentation> rpc_instrumentation() const override {
+    return instrumentation_;
+  }
+
+ private:
+  std::shared_ptr<RpcInstrumentation> instrumentation_;
+};
+
+class TableRpcInstrumentationTest : public ::testing::Test {
+ protected:
+  TableRpcInstrumentationTest()
+      : recording_(std::make_shared<RecordingInstrumentation>()),
+        client_(std::make_shared<InstrumentedDataClient>(recording_)) {
+    EXPECT_CALL(*client_, project_id()).WillRepeatedly(ReturnRef(project_id_));
+    EXPECT_CALL(*client_, instance_id())
+        .WillRepeatedly(ReturnRef(instance_id_));
+  }
+
+  std::string project_id_ = "foo-project";
+  std::string instance_id_ = "bar-instance";
+  std::shared_ptr<RecordingInstrumentation> recording_;
+  std::shared_ptr<InstrumentedDataClient> client_;
+};
+
+/// @test Verify that Table::Apply() reports each attempt and backoff.
+TEST_F(TableRpcInstrumentationTest, ApplyWithRetry) {
+  EXPECT_CALL(*client_, MutateRow(_, _, _))
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")))
+      .WillOnce(Invoke([](grpc::ClientContext* context,
+                          btproto::MutateRowRequest const&,
+                          btproto::MutateRowResponse*) {
+        // Simulate a client with a connection pool.
+        internal::RpcTracer::ReportChannel(*context, 3);
+        return grpc::Status::OK;
+      }));
+
+  Table table(client_, "baz-table");
+  auto failures = table.Apply(SingleRowMutation(
+      "bar", {bigtable::SetCell("fam", "col", 0_ms, "val")}));
+  EXPECT_TRUE(failures.empty());
+
+  EXPECT_THAT(recording_->events,
+              ElementsAre("start Apply", "attempt 1 14", "backoff 1",
+                          "attempt 2 0", "finish 2 0"));
+  ASSERT_EQ(2U, recording_->attempts.size());
+  EXPECT_EQ(RpcOperation::kApply, recording_->attempts[0].operation);
+  EXPECT_LT(0U, recording_->attempts[0].bytes_sent);
+  EXPECT_EQ(-1, recording_->attempts[0].channel_index);
+  EXPECT_EQ(3, recording_->attempts[1].channel_index);
+  ASSERT_EQ(1U, recording_->finishes.size());
+  auto const& finish = recording_->finishes[0];
+  EXPECT_LE(finish.attempt_latency + finish.backoff_latency, finish.latency);
+}
+
+/// @test Verify that permanent failures are reported.
+TEST_F(TableRpcInstrumentationTest, CheckAndMutateRowFailure) {
+  EXPECT_CALL(*client_, CheckAndMutateRow(_, _, _))
+      .WillOnce(Return(
+          grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh")));
+
+  Table table(client_, "baz-table");
+  grpc::Status status;
+  table.CheckAndMutateRow("foo", Filter::PassAllFilter(),
+                          {bigtable::SetCell("fam", "col", 0_ms, "it was set")},
+                          {}, status);
+  EXPECT_FALSE(status.ok());
+
+  EXPECT_THAT(recording_->events,
+              ElementsAre("start CheckAndMutateRow", "attempt 1 7",
+                          "finish 1 7"));
+}
+
+/// @test Verify that Table::BulkApply() counts the bytes in the stream.
+TEST_F(TableRpcInstrumentationTest, BulkApply) {
+  auto reader = google::cloud::internal::make_unique<
+      bigtable::testing::MockMutateRowsReader>();
+  EXPECT_CALL(*reader, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        auto& e = *r->add_entries();
+        e.set_index(0);
+        e.mutable_status()->set_code(grpc::StatusCode::OK);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto histogram = std::make_shared<RpcLatencyHistogram>();
+  auto client = std::make_shared<InstrumentedDataClient>(histogram);
+  EXPECT_CALL(*client, project_id()).WillRepeatedly(ReturnRef(project_id_));
+  EXPECT_CALL(*client, instance_id()).WillRepeatedly(ReturnRef(instance_id_));
+  EXPECT_CALL(*client, MutateRows(_, _))
+      .WillOnce(Invoke(reader.release()->MakeMockReturner()));
+
+  Table table(client, "baz-table");
+  grpc::Status status;
+  auto failures = table.BulkApply(
+      BulkMutation(SingleRowMutation(
+          "foo", {bigtable::SetCell("fam", "col", 0_ms, "baz")})),
+      status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_TRUE(failures.empty());
+
+  auto stats = histogram->Stats(RpcOperation::kBulkApply);
+  EXPECT_EQ(1U, stats.operations);
+  EXPECT_EQ(0U, stats.failed_operations);
+  EXPECT_EQ(1U, stats.attempts);
+  EXPECT_LT(0U, stats.bytes_sent);
+  EXPECT_LT(0U, stats.bytes_received);
+  EXPECT_EQ(1U, stats.latency.count());
+  EXPECT_EQ(0U, histogram->Stats(RpcOperation::kApply).operations);
+}
+
+/// @test Verify that the operation of a RowReader ends with the stream.
+TEST_F(TableRpcInstrumentationTest, ReadRows) {
+  auto stream = new bigtable::testing::MockReadRowsReader;
+  EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+
+  Table table(client_, "baz-table");
+  auto reader = table.ReadRows(RowSet(), Filter::PassAllFilter());
+  EXPECT_THAT(recording_->events, ElementsAre("start ReadRows"));
+  EXPECT_EQ(reader.end(), reader.begin());
+  EXPECT_THAT(recording_->events,
+              ElementsAre("start ReadRows", "attempt 1 0", "finish 1 0"));
+}
+
+/// @test Verify that RowReader reports abandoned reads as cancelled.
+TEST_F(TableRpcInstrumentationTest, ReadRowsNotConsumed) {
+  Table table(client_, "baz-table");
+  {
+    auto reader = table.ReadRows(RowSet(), Filter::PassAllFilter());
+  }
+  EXPECT_THAT(recording_->events, ElementsAre("start ReadRows", "finish 0 1"));
+}
+
+/// @test Verify that Table::AsyncApply() reports each attempt and backoff.
+TEST_F(TableRpcInstrumentationTest, AsyncApplyWithRetry) {
+  auto impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  bigtable::CompletionQueue cq(impl);
+
+  auto r1 = google::cloud::internal::make_unique<
+      bigtable::testing::MockAsyncApplyReader>();
+  EXPECT_CALL(*r1, Finish(_, _, _))
+      .WillOnce(Invoke(
+          [](btproto::MutateRowResponse*, grpc::Status* status, void*) {
+            *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+          }));
+  auto r2 = google::cloud::internal::make_unique<
+      bigtable::testing::MockAsyncApplyReader>();
+  EXPECT_CALL(*r2, Finish(_, _, _))
+      .WillOnce(Invoke(
+          [](btproto::MutateRowResponse*, grpc::Status* status, void*) {
+            *status = grpc::Status::OK;
+          }));
+
+  EXPECT_CALL(*client_, AsyncMutateRow(_, _, _))
+      .WillOnce(
+          Invoke([&r1](grpc::ClientContext*, btproto::MutateRowRequest const&,
+                       grpc::CompletionQueue*) {
+            // This is safe, see comments in MockAsyncResponseReader.
+            return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                btproto::MutateRowResponse>>(r1.get());
+          }))
+      .WillOnce(
+          Invoke([&r2](grpc::ClientContext* context,
+                       btproto::MutateRowRequest const&,
+                       grpc::CompletionQueue*) {
+            internal::RpcTracer::ReportChannel(*context, 2);
+            // This is safe, see comments in MockAsyncResponseReader.
+            return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                btproto::MutateRowResponse>>(r2.get());
+          }));
+
+  Table table(client_, "baz-table");
+  bool op_called = false;
+  table.AsyncApply(
+      cq,
+      [&op_called](CompletionQueue&, btproto::MutateRowResponse&,
+                   grpc::Status const& status) {
+        op_called = true;
+        EXPECT_TRUE(status.ok());
+      },
+      SingleRowMutation("bar",
+                        {bigtable::SetCell("fam", "col", 0_ms, "val")}));
+
+  // Complete r1, the backoff timer, and r2.
+  impl->SimulateCompletion(cq, true);
+  impl->SimulateCompletion(cq, true);
+  impl->SimulateCompletion(cq, true);
+  EXPECT_TRUE(op_called);
+  EXPECT_TRUE(impl->empty());
+
+  EXPECT_THAT(recording_->events,
+              ElementsAre("start AsyncApply", "attempt 1 14", "backoff 1",
+                          "attempt 2 0", "finish 2 0"));
+  ASSERT_EQ(2U, recording_->attempts.size());
+  EXPECT_EQ(-1, recording_->attempts[0].channel_index);
+  EXPECT_EQ(2, recording_->attempts[1].channel_index);
+}
+
+/// @test Verify that tables without instrumentation work as usual.
+TEST_F(TableRpcInstrumentationTest, Disabled) {
+  auto client = std::make_shared<testing::MockDataClient>();
+  EXPECT_CALL(*client, project_id()).WillRepeatedly(ReturnRef(project_id_));
+  EXPECT_CALL(*client, instance_id()).WillRepeatedly(ReturnRef(instance_id_));
+  EXPECT_CALL(*client, MutateRow(_, _, _)).WillOnce(Return(grpc::Status::OK));
+
+  Table table(client, "baz-table");
+  auto failures = table.Apply(SingleRowMutation(
+      "bar", {bigtable::SetCell("fam", "col", 0_ms, "val")}));
+  EXPECT_TRUE(failures.empty());
+  EXPECT_TRUE(recording_->events.empty());
+}
+
+}  // namespace
+}  // namespace noex
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_UNARY_CLIENT_UTILS_H_
 
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
@@ -117,6 +118,7 @@ struct UnaryClientUtils {
    * @param function the pointer to the member function to call.
    * @param request an initialized request parameter for the RPC.
    * @param error_message include this message in any exception or error log.
+   * @param tracer if not null, report each attempt and backoff to it.
    * @return the return parameter from the RPC.
    * @throw std::exception with a description of the last RPC error.
    */
@@ -131,10 +133,10 @@ struct UnaryClientUtils {
            MemberFunction function,
            typename CheckSignature<MemberFunction>::RequestType const& request,
            char const* error_message, grpc::Status& status,
-           bool retry_on_failure) {
+           bool retry_on_failure, RpcTracer* tracer = nullptr) {
     return MakeCall(client, *rpc_policy, *backoff_policy,
                     metadata_update_policy, function, request, error_message,
-                    status, retry_on_failure);
+                    status, retry_on_failure, tracer);
   }
 
   /**
@@ -155,6 +157,7 @@ struct UnaryClientUtils {
    * @param function the pointer to the member function to call.
    * @param request an initialized request parameter for the RPC.
    * @param error_message include this message in any exception or error log.
+   * @param tracer if not null, report each attempt and backoff to it.
    * @return the return parameter from the RPC.
    * @throw std::exception with a description of the last RPC error.
    */
@@ -168,16 +171,23 @@ struct UnaryClientUtils {
            MemberFunction function,
            typename CheckSignature<MemberFunction>::RequestType const& request,
            char const* error_message, grpc::Status& status,
-           bool retry_on_failure) {
+           bool retry_on_failure, RpcTracer* tracer = nullptr) {
     typename CheckSignature<MemberFunction>::ResponseType response;
+    RpcTracer disabled;
+    RpcTracer& t = tracer != nullptr ? *tracer : disabled;
     do {
       grpc::ClientContext client_context;
       rpc_policy.Setup(client_context);
       backoff_policy.Setup(client_context);
       metadata_update_policy.Setup(client_context);
+      t.AttemptStart(client_context);
+      t.RequestSent(request);
       // Call the pointer to member function.
       status = (client.*function)(&client_context, request, &response);
+      t.ResponseReceived(response);
+      t.AttemptEnd(status);
       if (status.ok()) {
+        rpc_policy.OnSuccess();
         break;
       }
       if (!rpc_policy.OnFailure(status)) {
@@ -189,6 +199,7 @@ struct UnaryClientUtils {
         break;
       }
       auto delay = backoff_policy.OnCompletion(status);
+      t.Backoff(delay);
       std::this_thread::sleep_for(delay);
     } while (retry_on_failure);
     return response;
@@ -214,6 +225,7 @@ struct UnaryClientUtils {
    * @param function the pointer to the member function to call.
    * @param request an initialized request parameter for the RPC.
    * @param error_message include this message in any exception or error log.
+   * @param tracer if not null, report the attempt to it.
    * @return the return parameter from the RPC.
    * @throw std::exception with a description of the last RPC error.
    */
@@ -226,16 +238,23 @@ struct UnaryClientUtils {
       bigtable::MetadataUpdatePolicy const& metadata_update_policy,
       MemberFunction function,
       typename CheckSignature<MemberFunction>::RequestType const& request,
-      char const* error_message, grpc::Status& status) {
+      char const* error_message, grpc::Status& status,
+      RpcTracer* tracer = nullptr) {
     typename CheckSignature<MemberFunction>::ResponseType response;
+    RpcTracer disabled;
+    RpcTracer& t = tracer != nullptr ? *tracer : disabled;
 
     grpc::ClientContext client_context;
 
     // Policies can set timeouts so allowing them to update context
     rpc_policy->Setup(client_context);
     metadata_update_policy.Setup(client_context);
+    t.AttemptStart(client_context);
+    t.RequestSent(request);
     // Call the pointer to member function.
     status = (client.*function)(&client_context, request, &response);
+    t.ResponseReceived(response);
+    t.AttemptEnd(status);
 
     if (!status.ok()) {
       std::string full_message = error_message;
@@ -0,0 +1,143 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/work_stealing_pool.h"
+#include "google/cloud/internal/make_unique.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+/// Identify the pool and queue of the current thread, if it is a worker.
+struct CurrentWorker {
+  WorkStealingPool const* pool;
+  std::size_t index;
+};
+thread_local CurrentWorker current_worker = {nullptr, 0};
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t thread_count)
+    : next_queue_(0), pending_(0), idle_(0), shutdown_(false) {
+  if (thread_count == 0) {
+    thread_count = 1;
+  }
+  queues_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    queues_.push_back(google::cloud::internal::make_unique<WorkQueue>());
+  }
+  threads_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    threads_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() { Shutdown(); }
+
+void WorkStealingPool::Submit(std::function<void()> task) {
+  // Count the task before it becomes visible, so `pending_` never underflows.
+  // A worker may wake up before the task is queued, it simply tries again.
+  pending_.fetch_add(1);
+  // Workers only exit once `shutdown_` is set and `pending_` is zero. If
+  // `shutdown_` is not set yet, some worker will see the count above and run
+  // the task. Otherwise the workers may be gone already.
+  if (shutdown_.load()) {
+    pending_.fetch_sub(1);
+    task();
+    return;
+  }
+  if (current_worker.pool == this) {
+    auto& queue = *queues_[current_worker.index];
+    std::lock_guard<std::mutex> lk(queue.mu);
+    queue.tasks.push_back(std::move(task));
+  } else {
+    auto& queue = *queues_[next_queue_.fetch_add(1) % queues_.size()];
+    std::lock_guard<std::mutex> lk(queue.mu);
+    queue.tasks.push_back(std::move(task));
+  }
+  // Workers increment `idle_` before checking `pending_`, and we incremented
+  // `pending_` before checking `idle_`, so either the worker sees the new task
+  // or we see the idle worker.
+  if (idle_.load() != 0) {
+    std::lock_guard<std::mutex> lk(mu_);
+    cv_.notify_one();
+  }
+}
+
+void WorkStealingPool::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& t : threads_) {
+    t.join();
+  }
+  threads_.clear();
+}
+
+void WorkStealingPool::WorkerLoop(std::size_t index) {
+  current_worker = CurrentWorker{this, index};
+  std::function<void()> task;
+  for (;;) {
+    if (TryPop(index, task) || TrySteal(index, task)) {
+      pending_.fetch_sub(1);
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lk(mu_);
+    idle_.fetch_add(1);
+    cv_.wait(lk, [this] { return pending_.load() != 0 || shutdown_; });
+    idle_.fetch_sub(1);
+    if (shutdown_ && pending_.load() == 0) {
+      break;
+    }
+  }
+  current_worker = CurrentWorker{nullptr, 0};
+}
+
+bool WorkStealingPool::TryPop(std::size_t index, std::function<void()>& task) {
+  auto& queue = *queues_[index];
+  std::lock_guard<std::mutex> lk(queue.mu);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingPool::TrySteal(std::size_t index,
+                                std::function<void()>& task) {
+  auto const size = queues_.size();
+  for (std::size_t i = 1; i != size; ++i) {
+    auto& queue = *queues_[(index + i) % size];
+    std::lock_guard<std::mutex> lk(queue.mu);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
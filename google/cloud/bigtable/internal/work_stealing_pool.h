@@ -0,0 +1,101 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_WORK_STEALING_POOL_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_WORK_STEALING_POOL_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * A fixed size pool of threads running tasks, with work stealing.
+ *
+ * Each worker thread has its own queue. Tasks submitted from a worker thread
+ * go to the back of its queue and are run in LIFO order, which keeps the data
+ * for continuations hot in the caches of the thread. Tasks submitted from any
+ * other thread are distributed across the queues in round-robin order. Idle
+ * workers steal from the front of the other queues, so a single busy worker
+ * does not delay the tasks behind it.
+ *
+ * Workers only block when there are no tasks in any queue.
+ */
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(std::size_t thread_count);
+  ~WorkStealingPool();
+
+  WorkStealingPool(WorkStealingPool const&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+  /**
+   * Schedule @p task to run on one of the worker threads.
+   *
+   * Once `Shutdown()` is called there may be no workers left to run the task,
+   * it runs on the calling thread instead.
+   */
+  void Submit(std::function<void()> task);
+
+  /**
+   * Run the tasks already submitted, then stop and join the worker threads.
+   *
+   * It is safe to call this function more than once, but it must not be called
+   * from one of the worker threads.
+   */
+  void Shutdown();
+
+  std::size_t thread_count() const { return queues_.size(); }
+
+ private:
+  struct WorkQueue {
+    std::mutex mu;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void WorkerLoop(std::size_t index);
+  bool TryPop(std::size_t index, std::function<void()>& task);
+  bool TrySteal(std::size_t index, std::function<void()>& task);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<std::size_t> next_queue_;
+  /// The number of tasks in all the queues.
+  std::atomic<std::size_t> pending_;
+  /// The number of workers blocked (or about to block) on `cv_`.
+  std::atomic<std::size_t> idle_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  /// Only changed while holding `mu_`, but `Submit()` reads it without the
+  /// lock.
+  std::atomic<bool> shutdown_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_WORK_STEALING_POOL_H_
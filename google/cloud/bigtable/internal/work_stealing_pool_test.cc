@@ -0,0 +1,106 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/work_stealing_pool.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// @test Verify that all the submitted tasks run before Shutdown() returns.
+TEST(WorkStealingPoolTest, RunsAllTasks) {
+  WorkStealingPool pool(4);
+  EXPECT_EQ(4U, pool.thread_count());
+  std::atomic<int> count(0);
+  int const kTaskCount = 1000;
+  for (int i = 0; i != kTaskCount; ++i) {
+    pool.Submit([&count] { ++count; });
+  }
+  pool.Shutdown();
+  EXPECT_EQ(kTaskCount, count.load());
+}
+
+/// @test Verify that tasks can submit more tasks.
+TEST(WorkStealingPoolTest, NestedSubmit) {
+  WorkStealingPool pool(2);
+  std::atomic<int> count(0);
+  std::function<void(int)> fanout = [&](int depth) {
+    ++count;
+    if (depth == 0) {
+      return;
+    }
+    pool.Submit([&fanout, depth] { fanout(depth - 1); });
+    pool.Submit([&fanout, depth] { fanout(depth - 1); });
+  };
+  pool.Submit([&fanout] { fanout(9); });
+  pool.Shutdown();
+  // A full binary tree with 10 levels.
+  EXPECT_EQ(1023, count.load());
+}
+
+/// @test Verify that idle workers steal tasks from a blocked worker.
+TEST(WorkStealingPoolTest, StealsFromBlockedWorker) {
+  WorkStealingPool pool(2);
+  std::promise<void> unblock;
+  std::shared_future<void> blocked = unblock.get_future().share();
+  std::promise<void> done;
+  pool.Submit([&pool, blocked, &done] {
+    // Queued in this worker's queue, but this worker is busy until the other
+    // worker runs the task.
+    pool.Submit([&done] { done.set_value(); });
+    blocked.wait();
+  });
+  auto f = done.get_future();
+  EXPECT_EQ(std::future_status::ready, f.wait_for(std::chrono::seconds(5)));
+  unblock.set_value();
+  pool.Shutdown();
+}
+
+/// @test Verify that the tasks run on the worker threads.
+TEST(WorkStealingPoolTest, RunsOnWorkerThreads) {
+  WorkStealingPool pool(3);
+  std::mutex mu;
+  std::set<std::thread::id> ids;
+  for (int i = 0; i != 100; ++i) {
+    pool.Submit([&mu, &ids] {
+      std::lock_guard<std::mutex> lk(mu);
+      ids.insert(std::this_thread::get_id());
+    });
+  }
+  pool.Shutdown();
+  EXPECT_EQ(0U, ids.count(std::this_thread::get_id()));
+  EXPECT_GE(3U, ids.size());
+}
+
+/// @test Verify that tasks submitted after Shutdown() are not lost.
+TEST(WorkStealingPoolTest, SubmitAfterShutdown) {
+  WorkStealingPool pool(2);
+  pool.Shutdown();
+  std::thread::id id;
+  pool.Submit([&id] { id = std::this_thread::get_id(); });
+  EXPECT_EQ(std::this_thread::get_id(), id);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,200 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_batcher.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+// Cloud Bigtable rejects requests with more than 100,000 mutations, smaller
+// batches reduce the latency and the cost of retrying a failed batch.
+std::size_t constexpr kDefaultMaxMutationsPerBatch = 1000;
+std::size_t constexpr kDefaultMaxSizePerBatch = 4 * 1024 * 1024;
+std::size_t constexpr kDefaultMaxBatches = 8;
+std::size_t constexpr kDefaultMaxOutstandingSize = 64 * 1024 * 1024;
+}  // namespace
+
+MutationBatcher::Options::Options()
+    : max_mutations_per_batch(kDefaultMaxMutationsPerBatch),
+      max_size_per_batch(kDefaultMaxSizePerBatch),
+      max_batches(kDefaultMaxBatches),
+      max_outstanding_size(kDefaultMaxOutstandingSize) {}
+
+MutationBatcher::Options& MutationBatcher::Options::SetMaxMutationsPerBatch(
+    std::size_t max_mutations_per_batch_arg) {
+  max_mutations_per_batch = max_mutations_per_batch_arg;
+  return *this;
+}
+
+MutationBatcher::Options& MutationBatcher::Options::SetMaxSizePerBatch(
+    std::size_t max_size_per_batch_arg) {
+  max_size_per_batch = max_size_per_batch_arg;
+  return *this;
+}
+
+MutationBatcher::Options& MutationBatcher::Options::SetMaxBatches(
+    std::size_t max_batches_arg) {
+  max_batches = max_batches_arg;
+  return *this;
+}
+
+MutationBatcher::Options& MutationBatcher::Options::SetMaxOutstandingSize(
+    std::size_t max_outstanding_size_arg) {
+  max_outstanding_size = max_outstanding_size_arg;
+  return *this;
+}
+
+MutationBatcher::PendingSingleRowMutation::PendingSingleRowMutation(
+    SingleRowMutation mut, promise<grpc::Status> p)
+    : completion_promise(std::move(p)) {
+  mut.MoveTo(&entry);
+  num_mutations = static_cast<std::size_t>(entry.mutations_size());
+  request_size = entry.ByteSizeLong();
+}
+
+std::pair<future<void>, future<grpc::Status>> MutationBatcher::AsyncApply(
+    CompletionQueue& cq, SingleRowMutation mut) {
+  promise<grpc::Status> completion;
+  auto completion_future = completion.get_future();
+  PendingSingleRowMutation pending(std::move(mut), std::move(completion));
+  auto admission_future = pending.admission_promise.get_future();
+
+  if (pending.num_mutations > options_.max_mutations_per_batch ||
+      pending.request_size > options_.max_size_per_batch) {
+    // This mutation would never fit in a batch, reject it instead of blocking
+    // all the mutations behind it.
+    pending.admission_promise.set_value();
+    pending.completion_promise.set_value(grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        "Mutation exceeds the MutationBatcher limits, mutations=" +
+            std::to_string(pending.num_mutations) +
+            ", size=" + std::to_string(pending.request_size)));
+    return std::make_pair(std::move(admission_future),
+                          std::move(completion_future));
+  }
+
+  Actions actions;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++num_requests_pending_;
+    pending_mutations_.push_back(std::move(pending));
+    AdmitAndFlush(actions);
+  }
+  Execute(cq, std::move(actions));
+  return std::make_pair(std::move(admission_future),
+                        std::move(completion_future));
+}
+
+future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (num_requests_pending_ == 0) {
+    return make_ready_future();
+  }
+  no_more_pending_promises_.emplace_back();
+  return no_more_pending_promises_.back().get_future();
+}
+
+bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
+  // Always admit something when nothing is outstanding, otherwise a mutation
+  // larger than `max_outstanding_size` would block forever.
+  bool const fits_outstanding =
+      outstanding_size_ == 0 ||
+      outstanding_size_ + mut.request_size <= options_.max_outstanding_size;
+  return fits_outstanding &&
+         cur_batch_->requests_size + mut.request_size <=
+             options_.max_size_per_batch &&
+         cur_batch_->num_mutations + mut.num_mutations <=
+             options_.max_mutations_per_batch;
+}
+
+void MutationBatcher::Admit(PendingSingleRowMutation mut, Actions& actions) {
+  outstanding_size_ += mut.request_size;
+  cur_batch_->requests_size += mut.request_size;
+  cur_batch_->num_mutations += mut.num_mutations;
+  cur_batch_->requests.emplace_back(SingleRowMutation(std::move(mut.entry)));
+  cur_batch_->completion_promises.emplace_back(
+      std::move(mut.completion_promise));
+  actions.admitted.emplace_back(std::move(mut.admission_promise));
+}
+
+void MutationBatcher::AdmitAndFlush(Actions& actions) {
+  for (;;) {
+    // Admit mutations in order, a large mutation at the front of the queue
+    // blocks smaller ones, otherwise it may never be admitted.
+    while (!pending_mutations_.empty() &&
+           HasSpaceFor(pending_mutations_.front())) {
+      Admit(std::move(pending_mutations_.front()), actions);
+      pending_mutations_.pop_front();
+    }
+    if (cur_batch_->completion_promises.empty() ||
+        num_outstanding_batches_ >= options_.max_batches) {
+      return;
+    }
+    ++num_outstanding_batches_;
+    actions.to_flush.emplace_back(std::move(cur_batch_));
+    cur_batch_ = std::make_shared<Batch>();
+  }
+}
+
+void MutationBatcher::OnBulkApplyDone(CompletionQueue& cq, Batch& batch,
+                                      std::vector<FailedMutation>& failed) {
+  // Any mutation not reported as failed succeeded, the failed mutations
+  // include the ones that were never confirmed before the retries stopped.
+  std::vector<grpc::Status> statuses(batch.completion_promises.size());
+  for (auto& f : failed) {
+    auto const index = static_cast<std::size_t>(f.original_index());
+    if (index < statuses.size()) {
+      statuses[index] = f.status();
+    }
+  }
+
+  Actions actions;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    outstanding_size_ -= batch.requests_size;
+    --num_outstanding_batches_;
+    num_requests_pending_ -= batch.completion_promises.size();
+    AdmitAndFlush(actions);
+    if (num_requests_pending_ == 0) {
+      actions.no_more_pending.swap(no_more_pending_promises_);
+    }
+  }
+  for (std::size_t i = 0; i != statuses.size(); ++i) {
+    batch.completion_promises[i].set_value(std::move(statuses[i]));
+  }
+  Execute(cq, std::move(actions));
+}
+
+void MutationBatcher::Execute(CompletionQueue& cq, Actions actions) {
+  for (auto& p : actions.admitted) {
+    p.set_value();
+  }
+  for (auto& batch : actions.to_flush) {
+    table_.impl_.AsyncBulkApply(
+        cq,
+        [this, batch](CompletionQueue& cq, std::vector<FailedMutation>& failed,
+                      grpc::Status&) { OnBulkApplyDone(cq, *batch, failed); },
+        std::move(batch->requests));
+  }
+  for (auto& p : actions.no_more_pending) {
+    p.set_value();
+  }
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
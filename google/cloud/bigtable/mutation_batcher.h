@@ -0,0 +1,181 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BATCHER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BATCHER_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Batches single row mutations into bulk mutations, with flow control.
+ *
+ * Applications that write many small, independent mutations (e.g. ingestion
+ * pipelines) get better throughput if the mutations are packed into larger
+ * `MutateRows` requests. This class accepts `SingleRowMutation`s from any
+ * number of threads, groups them into batches bounded by the number of
+ * mutations and their size, and sends the batches using `AsyncBulkApply()`.
+ *
+ * The number of batches in flight is limited. While all the batches are in
+ * flight new mutations accumulate in the next batch, which is sent as soon as
+ * one of the outstanding batches completes. The total size of the mutations
+ * admitted but not yet completed is also limited, mutations that do not fit
+ * wait until enough of the outstanding mutations complete.
+ *
+ * @warning This is an early version of the asynchronous APIs for Cloud
+ *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+ *     is not subject to any SLA or deprecation policy.
+ *
+ * @note The application must keep this object alive until all the mutations
+ *     complete, see `AsyncWaitForNoPendingRequests()`.
+ */
+class MutationBatcher {
+ public:
+  /// Configure the limits for a `MutationBatcher`.
+  struct Options {
+    Options();
+
+    /// A single batch contains at most this many mutations.
+    Options& SetMaxMutationsPerBatch(std::size_t max_mutations_per_batch_arg);
+
+    /// The serialized size of a batch does not exceed this many bytes.
+    Options& SetMaxSizePerBatch(std::size_t max_size_per_batch_arg);
+
+    /**
+     * There are at most this many batches in flight.
+     *
+     * Each `DataClient` spreads the requests across its connection pool, a
+     * small multiple of `ClientOptions::connection_pool_size()` keeps all the
+     * channels busy without queueing requests in gRPC.
+     */
+    Options& SetMaxBatches(std::size_t max_batches_arg);
+
+    /// Mutations are not admitted if they would exceed this many bytes.
+    Options& SetMaxOutstandingSize(std::size_t max_outstanding_size_arg);
+
+    std::size_t max_mutations_per_batch;
+    std::size_t max_size_per_batch;
+    std::size_t max_batches;
+    std::size_t max_outstanding_size;
+  };
+
+  explicit MutationBatcher(Table table, Options options = Options())
+      : table_(std::move(table)),
+        options_(options),
+        num_outstanding_batches_(),
+        outstanding_size_(),
+        num_requests_pending_(),
+        cur_batch_(std::make_shared<Batch>()) {}
+
+  /**
+   * Asynchronously apply a mutation.
+   *
+   * The first future in the result is satisfied when the mutation is admitted
+   * by the flow control, i.e. when the application can send more mutations
+   * without exceeding the limits in `Options`. The second future is satisfied
+   * with the result of this mutation once the batch containing it completes.
+   *
+   * Mutations larger than `max_size_per_batch`, or with more than
+   * `max_mutations_per_batch` changes, are rejected with
+   * `INVALID_ARGUMENT`.
+   *
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @param mut the mutation to apply.
+   */
+  std::pair<future<void>, future<grpc::Status>> AsyncApply(
+      CompletionQueue& cq, SingleRowMutation mut);
+
+  /**
+   * Return a future satisfied when all the pending mutations complete.
+   *
+   * Mutations admitted after this call are also waited for.
+   */
+  future<void> AsyncWaitForNoPendingRequests();
+
+ private:
+  /// A mutation waiting to be admitted, or admitted and waiting for results.
+  struct PendingSingleRowMutation {
+    PendingSingleRowMutation(SingleRowMutation mut, promise<grpc::Status> p);
+
+    google::bigtable::v2::MutateRowsRequest::Entry entry;
+    std::size_t num_mutations;
+    std::size_t request_size;
+    promise<grpc::Status> completion_promise;
+    promise<void> admission_promise;
+  };
+
+  /// The mutations in a batch and the promises to satisfy when it completes.
+  struct Batch {
+    Batch() : num_mutations(), requests_size() {}
+
+    std::size_t num_mutations;
+    std::size_t requests_size;
+    BulkMutation requests;
+    std::vector<promise<grpc::Status>> completion_promises;
+  };
+
+  /**
+   * The side effects of a state change, executed without holding the lock.
+   *
+   * Satisfying a promise may run continuations, and those may call back into
+   * this class, so no promise is satisfied (and no request is sent) while
+   * holding `mu_`.
+   */
+  struct Actions {
+    std::vector<promise<void>> admitted;
+    std::vector<promise<void>> no_more_pending;
+    std::vector<std::shared_ptr<Batch>> to_flush;
+  };
+
+  bool HasSpaceFor(PendingSingleRowMutation const& mut) const;
+  void Admit(PendingSingleRowMutation mut, Actions& actions);
+  void AdmitAndFlush(Actions& actions);
+  void OnBulkApplyDone(CompletionQueue& cq, Batch& batch,
+                       std::vector<FailedMutation>& failed);
+  void Execute(CompletionQueue& cq, Actions actions);
+
+  Table table_;
+  Options const options_;
+
+  std::mutex mu_;
+  std::size_t num_outstanding_batches_;
+  std::size_t outstanding_size_;
+  /// Mutations accepted by `AsyncApply()` that have not completed.
+  std::size_t num_requests_pending_;
+  std::shared_ptr<Batch> cur_batch_;
+  /// Mutations waiting for the flow control to admit them, in order.
+  std::deque<PendingSingleRowMutation> pending_mutations_;
+  std::vector<promise<void>> no_more_pending_promises_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BATCHER_H_
@@ -0,0 +1,246 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using namespace google::cloud::testing_util::chrono_literals;
+using ::testing::_;
+using ::testing::Invoke;
+using MockAsyncMutateRowsReader =
+    bigtable::testing::MockClientAsyncReaderInterface<
+        btproto::MutateRowsResponse>;
+
+/// Create a reader that returns @p codes as the result of each mutation.
+std::unique_ptr<
+    grpc::ClientAsyncReaderInterface<btproto::MutateRowsResponse>>
+MakeReader(std::vector<grpc::StatusCode> codes) {
+  auto reader =
+      google::cloud::internal::make_unique<MockAsyncMutateRowsReader>();
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([codes](btproto::MutateRowsResponse* r, void*) {
+        for (std::size_t i = 0; i != codes.size(); ++i) {
+          auto& e = *r->add_entries();
+          e.set_index(static_cast<std::int64_t>(i));
+          e.mutable_status()->set_code(codes[i]);
+        }
+      }))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+  return std::unique_ptr<
+      grpc::ClientAsyncReaderInterface<btproto::MutateRowsResponse>>(
+      reader.release());
+}
+
+SingleRowMutation MakeMutation(std::string row_key) {
+  return SingleRowMutation(std::move(row_key),
+                           {SetCell("fam", "col", "value")});
+}
+
+class MutationBatcherTest : public bigtable::testing::TableTestFixture {
+ protected:
+  MutationBatcherTest()
+      : cq_impl_(std::make_shared<bigtable::testing::MockCompletionQueue>()),
+        cq_(cq_impl_) {}
+
+  /// Run all the in-flight `MutateRows` streams through a successful attempt.
+  void FinishInFlightBatches() {
+    cq_impl_->SimulateCompletion(cq_, true);
+    // state == PROCESSING
+    cq_impl_->SimulateCompletion(cq_, true);
+    // state == PROCESSING, 1 read
+    cq_impl_->SimulateCompletion(cq_, false);
+    // state == FINISHING
+    cq_impl_->SimulateCompletion(cq_, false);
+  }
+
+  std::shared_ptr<bigtable::testing::MockCompletionQueue> cq_impl_;
+  CompletionQueue cq_;
+};
+
+/// @test Verify that a single mutation is sent right away.
+TEST_F(MutationBatcherTest, Simple) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.entries_size());
+        EXPECT_EQ("foo", r.entries(0).row_key());
+        return MakeReader({grpc::StatusCode::OK});
+      }));
+
+  MutationBatcher batcher(table_);
+  auto res = batcher.AsyncApply(cq_, MakeMutation("foo"));
+  auto no_more_pending = batcher.AsyncWaitForNoPendingRequests();
+  EXPECT_EQ(std::future_status::ready, res.first.wait_for(0_ms));
+  EXPECT_EQ(std::future_status::timeout, res.second.wait_for(0_ms));
+  EXPECT_EQ(std::future_status::timeout, no_more_pending.wait_for(0_ms));
+
+  FinishInFlightBatches();
+  ASSERT_EQ(std::future_status::ready, res.second.wait_for(0_ms));
+  EXPECT_TRUE(res.second.get().ok());
+  EXPECT_EQ(std::future_status::ready, no_more_pending.wait_for(0_ms));
+  EXPECT_TRUE(cq_impl_->empty());
+}
+
+/// @test Verify that mutations accumulate while the batches are in flight.
+TEST_F(MutationBatcherTest, BatchesWhileInFlight) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.entries_size());
+        return MakeReader({grpc::StatusCode::OK});
+      }))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(2, r.entries_size());
+        EXPECT_EQ("bar", r.entries(0).row_key());
+        EXPECT_EQ("baz", r.entries(1).row_key());
+        return MakeReader({grpc::StatusCode::OK, grpc::StatusCode::OK});
+      }))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.entries_size());
+        EXPECT_EQ("qux", r.entries(0).row_key());
+        return MakeReader({grpc::StatusCode::OK});
+      }));
+
+  MutationBatcher batcher(table_, MutationBatcher::Options()
+                                      .SetMaxBatches(1)
+                                      .SetMaxMutationsPerBatch(2));
+  auto r1 = batcher.AsyncApply(cq_, MakeMutation("foo"));
+  auto r2 = batcher.AsyncApply(cq_, MakeMutation("bar"));
+  auto r3 = batcher.AsyncApply(cq_, MakeMutation("baz"));
+  auto r4 = batcher.AsyncApply(cq_, MakeMutation("qux"));
+  // The fourth mutation does not fit in the batch waiting to be sent.
+  EXPECT_EQ(std::future_status::ready, r3.first.wait_for(0_ms));
+  EXPECT_EQ(std::future_status::timeout, r4.first.wait_for(0_ms));
+
+  FinishInFlightBatches();
+  EXPECT_TRUE(r1.second.get().ok());
+  EXPECT_EQ(std::future_status::ready, r4.first.wait_for(0_ms));
+  EXPECT_EQ(std::future_status::timeout, r2.second.wait_for(0_ms));
+
+  FinishInFlightBatches();
+  EXPECT_TRUE(r2.second.get().ok());
+  EXPECT_TRUE(r3.second.get().ok());
+  EXPECT_EQ(std::future_status::timeout, r4.second.wait_for(0_ms));
+
+  FinishInFlightBatches();
+  EXPECT_TRUE(r4.second.get().ok());
+  EXPECT_TRUE(cq_impl_->empty());
+}
+
+/// @test Verify that each mutation gets its own result.
+TEST_F(MutationBatcherTest, PerMutationFailures) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        return MakeReader({grpc::StatusCode::OK});
+      }))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(2, r.entries_size());
+        return MakeReader(
+            {grpc::StatusCode::PERMISSION_DENIED, grpc::StatusCode::OK});
+      }));
+
+  MutationBatcher batcher(table_, MutationBatcher::Options().SetMaxBatches(1));
+  auto r1 = batcher.AsyncApply(cq_, MakeMutation("foo"));
+  auto r2 = batcher.AsyncApply(cq_, MakeMutation("bar"));
+  auto r3 = batcher.AsyncApply(cq_, MakeMutation("baz"));
+  FinishInFlightBatches();
+  FinishInFlightBatches();
+  EXPECT_TRUE(r1.second.get().ok());
+  EXPECT_EQ(grpc::StatusCode::PERMISSION_DENIED, r2.second.get().error_code());
+  EXPECT_TRUE(r3.second.get().ok());
+}
+
+/// @test Verify that the outstanding size limits the admitted mutations.
+TEST_F(MutationBatcherTest, FlowControl) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.entries_size());
+        EXPECT_EQ("foo", r.entries(0).row_key());
+        return MakeReader({grpc::StatusCode::OK});
+      }))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.entries_size());
+        EXPECT_EQ("bar", r.entries(0).row_key());
+        return MakeReader({grpc::StatusCode::OK});
+      }));
+
+  // The limit only fits one of these mutations at a time.
+  MutationBatcher batcher(
+      table_, MutationBatcher::Options().SetMaxOutstandingSize(30));
+  auto r1 = batcher.AsyncApply(cq_, MakeMutation("foo"));
+  auto r2 = batcher.AsyncApply(cq_, MakeMutation("bar"));
+  EXPECT_EQ(std::future_status::ready, r1.first.wait_for(0_ms));
+  EXPECT_EQ(std::future_status::timeout, r2.first.wait_for(0_ms));
+  auto no_more_pending = batcher.AsyncWaitForNoPendingRequests();
+
+  FinishInFlightBatches();
+  EXPECT_TRUE(r1.second.get().ok());
+  EXPECT_EQ(std::future_status::ready, r2.first.wait_for(0_ms));
+  EXPECT_EQ(std::future_status::timeout, no_more_pending.wait_for(0_ms));
+
+  FinishInFlightBatches();
+  EXPECT_TRUE(r2.second.get().ok());
+  EXPECT_EQ(std::future_status::ready, no_more_pending.wait_for(0_ms));
+}
+
+/// @test Verify that mutations exceeding the batch limits are rejected.
+TEST_F(MutationBatcherTest, RejectTooLarge) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _)).Times(0);
+
+  MutationBatcher batcher(
+      table_, MutationBatcher::Options().SetMaxMutationsPerBatch(1));
+  auto res = batcher.AsyncApply(
+      cq_, SingleRowMutation("foo", {SetCell("fam", "c1", "v1"),
+                                     SetCell("fam", "c2", "v2")}));
+  EXPECT_EQ(std::future_status::ready, res.first.wait_for(0_ms));
+  ASSERT_EQ(std::future_status::ready, res.second.wait_for(0_ms));
+  EXPECT_EQ(grpc::StatusCode::INVALID_ARGUMENT, res.second.get().error_code());
+  EXPECT_EQ(std::future_status::ready,
+            batcher.AsyncWaitForNoPendingRequests().wait_for(0_ms));
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
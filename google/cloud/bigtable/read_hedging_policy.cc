@@ -0,0 +1,104 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_hedging_policy.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+/// The number of recent latencies used to compute the percentile.
+std::size_t const kLatencySamples = 1024;
+/// Recompute the delay after this many new latencies.
+std::size_t const kUpdateInterval = 64;
+/// The number of hedged requests allowed in a burst.
+double const kMaxBudget = 10.0;
+}  // namespace
+
+ReadHedgingPolicy::ReadHedgingPolicy(double percentile,
+                                     std::chrono::milliseconds initial_delay,
+                                     double max_hedge_ratio)
+    : percentile_(percentile),
+      max_hedge_ratio_(max_hedge_ratio),
+      hedge_count_(0),
+      hedge_win_count_(0),
+      delay_(initial_delay),
+      budget_(0.0),
+      next_latency_(0),
+      samples_since_update_(0) {
+  if (percentile <= 0.0 || percentile > 1.0) {
+    google::cloud::internal::ThrowInvalidArgument(
+        "ReadHedgingPolicy percentile must be in the (0.0, 1.0] range");
+  }
+  if (max_hedge_ratio < 0.0 || max_hedge_ratio > 1.0) {
+    google::cloud::internal::ThrowInvalidArgument(
+        "ReadHedgingPolicy max_hedge_ratio must be in the [0.0, 1.0] range");
+  }
+  latencies_.reserve(kLatencySamples);
+}
+
+std::chrono::microseconds ReadHedgingPolicy::delay() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return delay_;
+}
+
+void ReadHedgingPolicy::OnRequest() {
+  std::lock_guard<std::mutex> lk(mu_);
+  budget_ = (std::min)(kMaxBudget, budget_ + max_hedge_ratio_);
+}
+
+bool ReadHedgingPolicy::AcquireHedge() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (budget_ < 1.0) {
+    return false;
+  }
+  budget_ -= 1.0;
+  lk.unlock();
+  ++hedge_count_;
+  return true;
+}
+
+void ReadHedgingPolicy::OnCompletion(std::chrono::microseconds latency,
+                                     bool hedge_won) {
+  if (hedge_won) {
+    ++hedge_win_count_;
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  if (latencies_.size() < kLatencySamples) {
+    latencies_.push_back(latency.count());
+  } else {
+    latencies_[next_latency_] = latency.count();
+    next_latency_ = (next_latency_ + 1) % kLatencySamples;
+  }
+  if (++samples_since_update_ >= kUpdateInterval) {
+    UpdateDelay();
+  }
+}
+
+void ReadHedgingPolicy::UpdateDelay() {
+  samples_since_update_ = 0;
+  std::vector<std::int64_t> sorted(latencies_);
+  auto index = static_cast<std::size_t>(
+      percentile_ * static_cast<double>(sorted.size() - 1));
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  delay_ = std::chrono::microseconds(sorted[index]);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,117 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_HEDGING_POLICY_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_HEDGING_POLICY_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configure hedged requests for `Table::ReadRow()`.
+ *
+ * A hedged request is a second copy of a read, sent when the first copy has
+ * not completed after a delay. The first successful response is used, and the
+ * other request is cancelled. Hedging trims the tail latency of point lookups
+ * caused by a slow server or channel, at the cost of some additional load.
+ *
+ * @code
+ * auto hedging = std::make_shared<bigtable::ReadHedgingPolicy>(
+ *     0.95, std::chrono::milliseconds(10), 0.05);
+ * bigtable::Table table(client, "my-table", hedging);
+ * @endcode
+ *
+ * The delay tracks a percentile of the recent `ReadRow()` latencies. Until
+ * enough latencies are recorded, `initial_delay` is used.
+ *
+ * To prevent a slow cluster from doubling its own load, the hedged requests
+ * are limited to a fraction of all the requests, with a small allowance for
+ * bursts.
+ *
+ * The policy is thread-safe, and can be shared by many `Table` objects. It
+ * keeps the latency statistics, so sharing it between tables with very
+ * different latencies is not recommended.
+ */
+class ReadHedgingPolicy {
+ public:
+  /**
+   * Create a policy.
+   *
+   * @param percentile send the hedged request once the original request takes
+   *     longer than this percentile of the recent latencies, must be in the
+   *     `(0.0, 1.0]` range.
+   * @param initial_delay the delay used until enough latencies are recorded.
+   * @param max_hedge_ratio the maximum fraction of the requests that can be
+   *     hedged, must be in the `[0.0, 1.0]` range.
+   */
+  ReadHedgingPolicy(double percentile, std::chrono::milliseconds initial_delay,
+                    double max_hedge_ratio);
+
+  double percentile() const { return percentile_; }
+  double max_hedge_ratio() const { return max_hedge_ratio_; }
+
+  /// The current hedging delay.
+  std::chrono::microseconds delay() const;
+
+  /// The number of hedged requests sent.
+  std::int64_t hedge_count() const { return hedge_count_.load(); }
+
+  /// The number of hedged requests that completed before the original.
+  std::int64_t hedge_win_count() const { return hedge_win_count_.load(); }
+
+  //@{
+  /// @name Called by `Table`, applications do not need these functions.
+
+  /// Record a new request, accumulating budget for hedged requests.
+  void OnRequest();
+
+  /// Return true and consume budget if a hedged request can be sent.
+  bool AcquireHedge();
+
+  /// Record the latency of a successful request.
+  void OnCompletion(std::chrono::microseconds latency, bool hedge_won);
+  //@}
+
+ private:
+  /// Recompute the delay, `mu_` must be held.
+  void UpdateDelay();
+
+  double const percentile_;
+  double const max_hedge_ratio_;
+  std::atomic<std::int64_t> hedge_count_;
+  std::atomic<std::int64_t> hedge_win_count_;
+
+  mutable std::mutex mu_;
+  std::chrono::microseconds delay_;
+  double budget_;
+  /// The most recent latencies, in microseconds, used as a circular buffer.
+  std::vector<std::int64_t> latencies_;
+  std::size_t next_latency_;
+  std::size_t samples_since_update_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_HEDGING_POLICY_H_
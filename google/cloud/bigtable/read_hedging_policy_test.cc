@@ -0,0 +1,101 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_hedging_policy.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+using namespace google::cloud::testing_util::chrono_literals;
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/// @test Verify that the initial delay is used until there are enough samples.
+TEST(ReadHedgingPolicyTest, InitialDelay) {
+  ReadHedgingPolicy policy(0.9, 15_ms, 0.1);
+  EXPECT_DOUBLE_EQ(0.9, policy.percentile());
+  EXPECT_DOUBLE_EQ(0.1, policy.max_hedge_ratio());
+  EXPECT_EQ(std::chrono::microseconds(15000), policy.delay());
+  for (int i = 0; i != 10; ++i) {
+    policy.OnCompletion(std::chrono::microseconds(100), false);
+  }
+  EXPECT_EQ(std::chrono::microseconds(15000), policy.delay());
+}
+
+/// @test Verify that the delay tracks the requested percentile.
+TEST(ReadHedgingPolicyTest, Percentile) {
+  ReadHedgingPolicy policy(0.9, 15_ms, 0.1);
+  for (int i = 0; i != 1000; ++i) {
+    policy.OnCompletion(std::chrono::microseconds(i), false);
+  }
+  // The delay is only recomputed every few samples, so it may lag a bit.
+  auto const delay = policy.delay().count();
+  EXPECT_LE(850, delay);
+  EXPECT_GE(950, delay);
+}
+
+/// @test Verify that the hedged requests are limited by the ratio.
+TEST(ReadHedgingPolicyTest, Budget) {
+  ReadHedgingPolicy policy(0.9, 15_ms, 0.25);
+  EXPECT_FALSE(policy.AcquireHedge());
+  int hedges = 0;
+  for (int i = 0; i != 100; ++i) {
+    policy.OnRequest();
+    if (policy.AcquireHedge()) {
+      ++hedges;
+    }
+  }
+  EXPECT_EQ(25, hedges);
+  EXPECT_EQ(25, policy.hedge_count());
+}
+
+/// @test Verify that unused budget only allows small bursts.
+TEST(ReadHedgingPolicyTest, BoundedBurst) {
+  ReadHedgingPolicy policy(0.9, 15_ms, 1.0);
+  for (int i = 0; i != 1000; ++i) {
+    policy.OnRequest();
+  }
+  int hedges = 0;
+  while (policy.AcquireHedge()) {
+    ++hedges;
+  }
+  EXPECT_EQ(10, hedges);
+}
+
+/// @test Verify that the hedge wins are counted.
+TEST(ReadHedgingPolicyTest, HedgeWins) {
+  ReadHedgingPolicy policy(0.9, 15_ms, 1.0);
+  policy.OnCompletion(std::chrono::microseconds(10), true);
+  policy.OnCompletion(std::chrono::microseconds(10), false);
+  EXPECT_EQ(1, policy.hedge_win_count());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that invalid parameters are rejected.
+TEST(ReadHedgingPolicyTest, InvalidParameters) {
+  EXPECT_THROW(ReadHedgingPolicy(0.0, 15_ms, 0.1), std::invalid_argument);
+  EXPECT_THROW(ReadHedgingPolicy(1.5, 15_ms, 0.1), std::invalid_argument);
+  EXPECT_THROW(ReadHedgingPolicy(0.9, 15_ms, -0.1), std::invalid_argument);
+  EXPECT_THROW(ReadHedgingPolicy(0.9, 15_ms, 1.1), std::invalid_argument);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,130 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_cache.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+RowCache::RowCache(std::size_t max_entries, std::chrono::milliseconds ttl)
+    : max_entries_(max_entries),
+      ttl_(ttl),
+      hit_count_(0),
+      miss_count_(0) {
+  generations_.fill(0);
+}
+
+std::size_t RowCache::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return entries_.size();
+}
+
+void RowCache::Invalidate(std::string const& table_name,
+                          std::string const& row_key) {
+  auto const key = CacheKey(table_name, row_key);
+  std::lock_guard<std::mutex> lk(mu_);
+  ++Generation(key);
+  auto row = index_.find(key);
+  if (row == index_.end()) {
+    return;
+  }
+  for (auto& kv : row->second) {
+    entries_.erase(kv.second);
+  }
+  index_.erase(row);
+}
+
+void RowCache::Clear() {
+  std::lock_guard<std::mutex> lk(mu_);
+  for (auto& g : generations_) {
+    ++g;
+  }
+  entries_.clear();
+  index_.clear();
+}
+
+bool RowCache::Lookup(std::string const& table_name,
+                      std::string const& row_key,
+                      std::string const& filter_key, Value& value,
+                      std::uint64_t& generation) {
+  auto const key = CacheKey(table_name, row_key);
+  std::unique_lock<std::mutex> lk(mu_);
+  generation = Generation(key);
+  auto row = index_.find(key);
+  if (row != index_.end()) {
+    auto loc = row->second.find(filter_key);
+    if (loc != row->second.end()) {
+      auto it = loc->second;
+      if (Clock::now() < it->expiration) {
+        // Move the entry to the front of the LRU list.
+        entries_.splice(entries_.begin(), entries_, it);
+        value = it->value;
+        lk.unlock();
+        ++hit_count_;
+        return true;
+      }
+      Erase(it);
+    }
+  }
+  lk.unlock();
+  ++miss_count_;
+  return false;
+}
+
+void RowCache::Insert(std::string const& table_name,
+                      std::string const& row_key,
+                      std::string const& filter_key, Value const& value,
+                      std::uint64_t generation) {
+  if (max_entries_ == 0) {
+    return;
+  }
+  auto key = CacheKey(table_name, row_key);
+  auto const expiration = Clock::now() + ttl_;
+  std::lock_guard<std::mutex> lk(mu_);
+  if (generation != Generation(key)) {
+    return;
+  }
+  auto& filters = index_[key];
+  auto loc = filters.find(filter_key);
+  if (loc != filters.end()) {
+    // Another thread read the same row concurrently, keep the newest result.
+    auto it = loc->second;
+    it->expiration = expiration;
+    it->value = value;
+    entries_.splice(entries_.begin(), entries_, it);
+    return;
+  }
+  entries_.push_front(Entry{std::move(key), filter_key, expiration, value});
+  filters.emplace(filter_key, entries_.begin());
+  while (entries_.size() > max_entries_) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+void RowCache::Erase(EntryList::iterator it) {
+  auto row = index_.find(it->key);
+  if (row != index_.end()) {
+    row->second.erase(it->filter_key);
+    if (row->second.empty()) {
+      index_.erase(row);
+    }
+  }
+  entries_.erase(it);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
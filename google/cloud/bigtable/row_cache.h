@@ -0,0 +1,173 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H_
+
+#include "google/cloud/bigtable/row.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace noex {
+class Table;
+}  // namespace noex
+
+/**
+ * A client-side cache for the results of `Table::ReadRow()`.
+ *
+ * Applications reading a small set of hot rows many times per second can
+ * avoid most of the round-trips to Cloud Bigtable by passing a cache to the
+ * `Table` constructor:
+ *
+ * @code
+ * auto cache = std::make_shared<bigtable::RowCache>(
+ *     10000, std::chrono::seconds(5));
+ * bigtable::Table table(client, "my-table", cache);
+ * @endcode
+ *
+ * The results are cached by table, row key, and filter, including the results
+ * for rows that do not exist. The cache holds at most `max_entries()` results,
+ * evicting the least recently used, and a result is discarded after `ttl()`.
+ *
+ * `Apply()`, `BulkApply()`, `CheckAndMutateRow()` and `ReadModifyWriteRow()`
+ * on a `Table` using the cache invalidate the rows they modify. Changes made
+ * by other clients, by other `Table` objects without this cache, or by the
+ * asynchronous mutation functions, are only visible after the cached result
+ * expires. Choose the TTL with that staleness bound in mind.
+ *
+ * The cache is thread-safe, and can be shared by many `Table` objects, for the
+ * same or for different tables.
+ */
+class RowCache {
+ public:
+  RowCache(std::size_t max_entries, std::chrono::milliseconds ttl);
+
+  std::size_t max_entries() const { return max_entries_; }
+  std::chrono::milliseconds ttl() const { return ttl_; }
+
+  /// The number of `ReadRow()` calls served from the cache.
+  std::int64_t hit_count() const { return hit_count_.load(); }
+
+  /// The number of `ReadRow()` calls that had to contact the server.
+  std::int64_t miss_count() const { return miss_count_.load(); }
+
+  /// The number of cached results, including expired ones not yet evicted.
+  std::size_t size() const;
+
+  /**
+   * Discard all the cached results for @p row_key in @p table_name.
+   *
+   * @param table_name the full name of the table, as in `Table::table_name()`.
+   * @param row_key the row to discard.
+   */
+  void Invalidate(std::string const& table_name, std::string const& row_key);
+
+  /// Discard all the cached results.
+  void Clear();
+
+ private:
+  friend class noex::Table;
+  friend struct RowCacheTestTraits;
+
+  using Clock = std::chrono::steady_clock;
+  using Value = std::pair<bool, Row>;
+
+  /**
+   * Find a cached result.
+   *
+   * Updates the hit and miss counters. On a miss, @p generation receives the
+   * value to pass to `Insert()` once the result is read.
+   */
+  bool Lookup(std::string const& table_name, std::string const& row_key,
+              std::string const& filter_key, Value& value,
+              std::uint64_t& generation);
+
+  /**
+   * Cache a result read from the server.
+   *
+   * The result is discarded if the row, or any other row sharing its
+   * generation counter, was invalidated since the `Lookup()` returning
+   * @p generation. The read may have raced with a local mutation.
+   */
+  void Insert(std::string const& table_name, std::string const& row_key,
+              std::string const& filter_key, Value const& value,
+              std::uint64_t generation);
+
+  /// Combine the table name and row key, table names never contain a NUL.
+  static std::string CacheKey(std::string const& table_name,
+                              std::string const& row_key) {
+    std::string key;
+    key.reserve(table_name.size() + 1 + row_key.size());
+    key.append(table_name);
+    key.push_back('\0');
+    key.append(row_key);
+    return key;
+  }
+
+  /**
+   * The generation counter for @p key.
+   *
+   * Invalidating a row only discards the reads in progress for rows sharing
+   * its counter, instead of all the reads in progress. Keeping a counter per
+   * row would need memory for rows that are not cached.
+   */
+  std::uint64_t& Generation(std::string const& key) {
+    return generations_[std::hash<std::string>()(key) % kGenerationCount];
+  }
+
+  struct Entry {
+    std::string key;
+    std::string filter_key;
+    Clock::time_point expiration;
+    Value value;
+  };
+  using EntryList = std::list<Entry>;
+  using FilterIndex = std::unordered_map<std::string, EntryList::iterator>;
+
+  /// Remove @p it from the LRU list and the index, `mu_` must be held.
+  void Erase(EntryList::iterator it);
+
+  std::size_t const max_entries_;
+  std::chrono::milliseconds const ttl_;
+  std::atomic<std::int64_t> hit_count_;
+  std::atomic<std::int64_t> miss_count_;
+
+  mutable std::mutex mu_;
+  /// Most recently used first.
+  EntryList entries_;
+  /// Entries by cache key, then by filter.
+  std::unordered_map<std::string, FilterIndex> index_;
+  static std::size_t constexpr kGenerationCount = 64;
+  std::array<std::uint64_t, kGenerationCount> generations_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H_
@@ -0,0 +1,228 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_cache.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <thread>
+
+using namespace google::cloud::testing_util::chrono_literals;
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+struct RowCacheTestTraits {
+  static bool Lookup(RowCache& cache, std::string const& table_name,
+                     std::string const& row_key, std::string const& filter_key,
+                     std::pair<bool, Row>& value, std::uint64_t& generation) {
+    return cache.Lookup(table_name, row_key, filter_key, value, generation);
+  }
+
+  static void Insert(RowCache& cache, std::string const& table_name,
+                     std::string const& row_key, std::string const& filter_key,
+                     std::pair<bool, Row> const& value,
+                     std::uint64_t generation) {
+    cache.Insert(table_name, row_key, filter_key, value, generation);
+  }
+
+  static bool SameGeneration(RowCache& cache, std::string const& table_name,
+                             std::string const& a, std::string const& b) {
+    return &cache.Generation(RowCache::CacheKey(table_name, a)) ==
+           &cache.Generation(RowCache::CacheKey(table_name, b));
+  }
+};
+
+namespace {
+auto const* const kTable = "projects/p/instances/i/tables/t";
+
+std::pair<bool, Row> MakeRow(std::string const& row_key,
+                             std::string const& value) {
+  return std::make_pair(
+      true, Row(row_key, {Cell(row_key, "fam", "col", 0, value, {})}));
+}
+
+/// Lookup @p row_key and, if it is missing, insert a row with @p value.
+bool LookupOrInsert(RowCache& cache, std::string const& row_key,
+                    std::string const& value) {
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  if (RowCacheTestTraits::Lookup(cache, kTable, row_key, "", result,
+                                 generation)) {
+    return true;
+  }
+  RowCacheTestTraits::Insert(cache, kTable, row_key, "",
+                             MakeRow(row_key, value), generation);
+  return false;
+}
+
+/// @test Verify that cached results are returned and counted.
+TEST(RowCacheTest, HitAndMiss) {
+  RowCache cache(10, std::chrono::minutes(10));
+  EXPECT_EQ(10U, cache.max_entries());
+  EXPECT_EQ(std::chrono::milliseconds(std::chrono::minutes(10)), cache.ttl());
+
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_EQ(1U, cache.size());
+
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  ASSERT_TRUE(
+      RowCacheTestTraits::Lookup(cache, kTable, "r1", "", result, generation));
+  EXPECT_TRUE(result.first);
+  EXPECT_EQ("r1", result.second.row_key());
+  ASSERT_EQ(1U, result.second.cells().size());
+  EXPECT_EQ("v1", result.second.cells().at(0).value());
+
+  // A different filter is a different entry.
+  EXPECT_FALSE(RowCacheTestTraits::Lookup(cache, kTable, "r1", "other", result,
+                                          generation));
+
+  EXPECT_EQ(1, cache.hit_count());
+  EXPECT_EQ(2, cache.miss_count());
+}
+
+/// @test Verify that missing rows are cached too.
+TEST(RowCacheTest, MissingRow) {
+  RowCache cache(10, std::chrono::minutes(10));
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  EXPECT_FALSE(
+      RowCacheTestTraits::Lookup(cache, kTable, "r1", "", result, generation));
+  RowCacheTestTraits::Insert(cache, kTable, "r1", "",
+                             std::make_pair(false, Row("r1", {})), generation);
+
+  result = MakeRow("r1", "not-this-one");
+  ASSERT_TRUE(
+      RowCacheTestTraits::Lookup(cache, kTable, "r1", "", result, generation));
+  EXPECT_FALSE(result.first);
+}
+
+/// @test Verify that the least recently used entries are evicted.
+TEST(RowCacheTest, EvictsLeastRecentlyUsed) {
+  RowCache cache(2, std::chrono::minutes(10));
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_FALSE(LookupOrInsert(cache, "r2", "v2"));
+  // Make "r1" the most recently used, so "r2" is evicted.
+  EXPECT_TRUE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_FALSE(LookupOrInsert(cache, "r3", "v3"));
+  EXPECT_EQ(2U, cache.size());
+
+  EXPECT_TRUE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_TRUE(LookupOrInsert(cache, "r3", "v3"));
+  EXPECT_FALSE(LookupOrInsert(cache, "r2", "v2"));
+}
+
+/// @test Verify that a cache with no capacity caches nothing.
+TEST(RowCacheTest, ZeroCapacity) {
+  RowCache cache(0, std::chrono::minutes(10));
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_EQ(0U, cache.size());
+}
+
+/// @test Verify that expired entries are not returned.
+TEST(RowCacheTest, Expiration) {
+  RowCache cache(10, 10_ms);
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  std::this_thread::sleep_for(20_ms);
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_EQ(1U, cache.size());
+}
+
+/// @test Verify that Invalidate() and Clear() discard the results.
+TEST(RowCacheTest, InvalidateAndClear) {
+  RowCache cache(10, std::chrono::minutes(10));
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  EXPECT_FALSE(LookupOrInsert(cache, "r2", "v2"));
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  EXPECT_FALSE(RowCacheTestTraits::Lookup(cache, kTable, "r1", "filter", result,
+                                          generation));
+  RowCacheTestTraits::Insert(cache, kTable, "r1", "filter",
+                             MakeRow("r1", "v1"), generation);
+  EXPECT_EQ(3U, cache.size());
+
+  cache.Invalidate(kTable, "r1");
+  EXPECT_EQ(1U, cache.size());
+  EXPECT_TRUE(LookupOrInsert(cache, "r2", "v2"));
+  // Invalidating a missing row is not an error.
+  cache.Invalidate(kTable, "r1");
+
+  cache.Clear();
+  EXPECT_EQ(0U, cache.size());
+  EXPECT_FALSE(LookupOrInsert(cache, "r2", "v2"));
+}
+
+/// @test Verify that results read while a row is modified are not cached.
+TEST(RowCacheTest, InvalidateDuringRead) {
+  RowCache cache(10, std::chrono::minutes(10));
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  EXPECT_FALSE(
+      RowCacheTestTraits::Lookup(cache, kTable, "r1", "", result, generation));
+  // Simulate a mutation completing while the read is in progress.
+  cache.Invalidate(kTable, "r1");
+  RowCacheTestTraits::Insert(cache, kTable, "r1", "", MakeRow("r1", "old"),
+                             generation);
+  EXPECT_EQ(0U, cache.size());
+}
+
+/// @test Verify that the results for different tables are separate.
+TEST(RowCacheTest, SeparateTables) {
+  auto const* const other = "projects/p/instances/i/tables/other";
+  RowCache cache(10, std::chrono::minutes(10));
+  EXPECT_FALSE(LookupOrInsert(cache, "r1", "v1"));
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  EXPECT_FALSE(
+      RowCacheTestTraits::Lookup(cache, other, "r1", "", result, generation));
+  RowCacheTestTraits::Insert(cache, other, "r1", "", MakeRow("r1", "other"),
+                             generation);
+  EXPECT_EQ(2U, cache.size());
+
+  cache.Invalidate(other, "r1");
+  EXPECT_EQ(1U, cache.size());
+  EXPECT_TRUE(LookupOrInsert(cache, "r1", "v1"));
+}
+
+/// @test Verify that invalidating a row does not discard unrelated reads.
+TEST(RowCacheTest, InvalidateOtherRowDuringRead) {
+  RowCache cache(10, std::chrono::minutes(10));
+  // Find a row that does not share the generation counter with "r1".
+  std::string other;
+  for (int i = 0; i != 1000; ++i) {
+    other = "other-" + std::to_string(i);
+    if (!RowCacheTestTraits::SameGeneration(cache, kTable, "r1", other)) {
+      break;
+    }
+  }
+  ASSERT_FALSE(RowCacheTestTraits::SameGeneration(cache, kTable, "r1", other));
+
+  std::pair<bool, Row> result(false, Row("", {}));
+  std::uint64_t generation;
+  EXPECT_FALSE(
+      RowCacheTestTraits::Lookup(cache, kTable, "r1", "", result, generation));
+  cache.Invalidate(kTable, other);
+  RowCacheTestTraits::Insert(cache, kTable, "r1", "", MakeRow("r1", "v1"),
+                             generation);
+  EXPECT_EQ(1U, cache.size());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -172,6 +172,8 @@ void RowReader::MakeRequest() {
   retry_policy_->Setup(*context_);
   backoff_policy_->Setup(*context_);
   metadata_update_policy_.Setup(*context_);
+  tracer_.AttemptStart(*context_);
+  tracer_.RequestSent(request);
   stream_ = client_->ReadRows(context_.get(), request);
   stream_is_open_ = true;
 
@@ -187,6 +189,7 @@ bool RowReader::NextChunk() {
       response_ = {};
       return false;
     }
+    tracer_.ResponseReceived(response_);
   }
   return true;
 }
@@ -196,14 +199,22 @@ void RowReader::Advance(internal::OptionalRow& row) {
     grpc::Status status;
     status_ = status = AdvanceOrFail(row);
     if (status.ok()) {
+      if (!row.has_value()) {
+        // The stream finished successfully.
+        retry_policy_->OnSuccess();
+        tracer_.AttemptEnd(status);
+        tracer_.Finish(status);
+      }
       return;
     }
+    tracer_.AttemptEnd(status);
 
     // In the unlikely case when we have already reached the requested
     // number of rows and still receive an error (the parser can throw
     // an error at end of stream for example), there is no need to
     // retry and we have no good value for rows_limit anyway.
     if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
+      tracer_.Finish(status);
       return;
     }
 
@@ -215,10 +226,12 @@ void RowReader::Advance(internal::OptionalRow& row) {
 
     // If we receive an error, but the retriable set is empty, stop.
     if (row_set_.IsEmpty()) {
+      tracer_.Finish(status);
       return;
     }
 
     if (!status.ok() && !retry_policy_->OnFailure(status)) {
+      tracer_.Finish(status);
       if (raise_on_error_) {
         google::cloud::internal::ThrowRuntimeError("Unretriable error: " +
                                                    status.error_message());
@@ -228,6 +241,7 @@ void RowReader::Advance(internal::OptionalRow& row) {
     }
 
     auto delay = backoff_policy_->OnCompletion(status);
+    tracer_.Backoff(delay);
     std::this_thread::sleep_for(delay);
 
     // If we reach this place, we failed and need to restart the call.
@@ -287,11 +301,16 @@ void RowReader::Cancel() {
 
   stream_is_open_ = false;
   (void)stream_->Finish();  // ignore errors
+  grpc::Status cancelled(grpc::StatusCode::CANCELLED, "RowReader::Cancel()");
+  tracer_.AttemptEnd(cancelled);
+  tracer_.Finish(cancelled);
 }
 
 RowReader::~RowReader() {
   // Make sure we don't leave open streams.
   Cancel();
+  // A no-op if the read completed, otherwise the application stopped reading.
+  tracer_.Finish(grpc::Status::CANCELLED);
   if (!raise_on_error_ && !error_retrieved_ && !status_.ok()) {
     GCP_LOG(ERROR)
         << "Exceptions are disabled, RowReader has an error,"
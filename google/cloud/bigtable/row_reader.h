@@ -20,6 +20,7 @@
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
+#include "google/cloud/bigtable/internal/rpc_tracer.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/row_set.h"
@@ -88,6 +89,8 @@ class RowReader {
 
   using iterator = internal::RowReaderIterator;
   friend class internal::RowReaderIterator;
+  /// Sets `tracer_`, the tracer is not part of the public constructors.
+  friend class noex::Table;
 
   /**
    * Input iterator over rows in the response.
@@ -184,6 +187,8 @@ class RowReader {
   grpc::Status status_;
   bool raise_on_error_;
   bool error_retrieved_;
+
+  internal::RpcTracer tracer_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
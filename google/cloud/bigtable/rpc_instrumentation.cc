@@ -0,0 +1,52 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/rpc_instrumentation.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+char const* RpcOperationName(RpcOperation operation) {
+  switch (operation) {
+    case RpcOperation::kApply:
+      return "Apply";
+    case RpcOperation::kBulkApply:
+      return "BulkApply";
+    case RpcOperation::kReadRows:
+      return "ReadRows";
+    case RpcOperation::kCheckAndMutateRow:
+      return "CheckAndMutateRow";
+    case RpcOperation::kReadModifyWriteRow:
+      return "ReadModifyWriteRow";
+    case RpcOperation::kSampleRowKeys:
+      return "SampleRowKeys";
+    case RpcOperation::kAsyncApply:
+      return "AsyncApply";
+    case RpcOperation::kAsyncBulkApply:
+      return "AsyncBulkApply";
+    case RpcOperation::kAsyncReadRows:
+      return "AsyncReadRows";
+    case RpcOperation::kAsyncCheckAndMutateRow:
+      return "AsyncCheckAndMutateRow";
+    case RpcOperation::kAsyncSampleRowKeys:
+      return "AsyncSampleRowKeys";
+  }
+  return "Unknown";
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
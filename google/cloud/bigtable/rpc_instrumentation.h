@@ -0,0 +1,139 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RPC_INSTRUMENTATION_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RPC_INSTRUMENTATION_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/// The `Table` operations reported to `RpcInstrumentation`.
+enum class RpcOperation {
+  kApply,
+  kBulkApply,
+  kReadRows,
+  kCheckAndMutateRow,
+  kReadModifyWriteRow,
+  kSampleRowKeys,
+  kAsyncApply,
+  kAsyncBulkApply,
+  kAsyncReadRows,
+  kAsyncCheckAndMutateRow,
+  kAsyncSampleRowKeys,
+};
+
+/// The number of values in `RpcOperation`.
+constexpr std::size_t kRpcOperationCount =
+    static_cast<std::size_t>(RpcOperation::kAsyncSampleRowKeys) + 1;
+
+/// Return the name of @p operation, for example, "Apply".
+char const* RpcOperationName(RpcOperation operation);
+
+/// Describe one attempt, that is, one RPC, of an operation.
+struct RpcAttempt {
+  RpcOperation operation;
+  /// The attempt number, starting at 1.
+  int attempt;
+  /// The time from sending the request until the RPC completed.
+  std::chrono::microseconds latency;
+  grpc::StatusCode status;
+  /**
+   * The index of the channel in the `DataClient` pool.
+   *
+   * Only the clients created by `CreateDefaultDataClient()` report the
+   * channel, other `DataClient` implementations report -1.
+   */
+  int channel_index;
+  /// The size of the request and response protos, summed for streams.
+  std::size_t bytes_sent;
+  std::size_t bytes_received;
+};
+
+/// Describe the wait before retrying an operation.
+struct RpcBackoff {
+  RpcOperation operation;
+  /// The attempt that failed and will be retried.
+  int attempt;
+  std::chrono::milliseconds delay;
+};
+
+/**
+ * Describe a completed operation.
+ *
+ * The total latency is split in the time spent in RPCs, the time waiting
+ * before retries, and the remaining client-side time, which includes the time
+ * waiting for a completion queue thread to start the first attempt.
+ */
+struct RpcFinish {
+  RpcOperation operation;
+  int attempts;
+  grpc::StatusCode status;
+  /// The time from the start of the operation until it completed.
+  std::chrono::microseconds latency;
+  /// The time from the start of the operation until the first attempt.
+  std::chrono::microseconds queue_latency;
+  /// The sum of the latencies of all the attempts.
+  std::chrono::microseconds attempt_latency;
+  /// The sum of the backoff delays.
+  std::chrono::microseconds backoff_latency;
+};
+
+/**
+ * Receive the events for each `Table` operation and its retries.
+ *
+ * Configure an instance via `ClientOptions::set_rpc_instrumentation()`, all
+ * the `Table` objects using the resulting `DataClient` report their
+ * operations to it. Use `RpcLatencyHistogram` for a ready to use
+ * implementation.
+ *
+ * The member functions are called from the threads making the requests and
+ * from the threads running the completion queue. Implementations must be
+ * thread-safe, and should return quickly, as they run in the critical path of
+ * each request.
+ *
+ * @par Limitations
+ * - Asynchronous operations do not report the number of bytes transferred.
+ * - For `ReadRows()` the attempt latency includes the time the application
+ *   takes to consume the rows.
+ * - Hedged `ReadRow()` requests, see `ReadHedgingPolicy`, are not reported.
+ */
+class RpcInstrumentation {
+ public:
+  virtual ~RpcInstrumentation() = default;
+
+  /// Called when an operation starts, before any RPC is sent.
+  virtual void OnStart(RpcOperation) {}
+
+  /// Called after each RPC completes.
+  virtual void OnAttempt(RpcAttempt const&) {}
+
+  /// Called before waiting to retry a failed RPC.
+  virtual void OnBackoff(RpcBackoff const&) {}
+
+  /// Called once the operation completes, successfully or not.
+  virtual void OnFinish(RpcFinish const&) {}
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RPC_INSTRUMENTATION_H_
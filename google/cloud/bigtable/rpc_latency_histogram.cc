@@ -0,0 +1,74 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/rpc_latency_histogram.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+void RpcLatencyHistogram::OnAttempt(RpcAttempt const& attempt) {
+  auto& op = operations_[static_cast<std::size_t>(attempt.operation)];
+  op.attempts.fetch_add(1, std::memory_order_relaxed);
+  if (attempt.status != grpc::StatusCode::OK) {
+    op.failed_attempts.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (attempt.bytes_sent != 0) {
+    op.bytes_sent.fetch_add(attempt.bytes_sent, std::memory_order_relaxed);
+  }
+  if (attempt.bytes_received != 0) {
+    op.bytes_received.fetch_add(attempt.bytes_received,
+                                std::memory_order_relaxed);
+  }
+  op.attempt_latency.Record(attempt.latency);
+}
+
+void RpcLatencyHistogram::OnFinish(RpcFinish const& finish) {
+  auto& op = operations_[static_cast<std::size_t>(finish.operation)];
+  op.operations.fetch_add(1, std::memory_order_relaxed);
+  if (finish.status != grpc::StatusCode::OK) {
+    op.failed_operations.fetch_add(1, std::memory_order_relaxed);
+  }
+  op.latency.Record(finish.latency);
+  op.backoff_latency.Record(finish.backoff_latency);
+  auto overhead =
+      finish.latency - finish.attempt_latency - finish.backoff_latency;
+  // The backoff is the requested delay, the actual sleep may be shorter.
+  if (overhead.count() < 0) {
+    overhead = std::chrono::microseconds(0);
+  }
+  op.overhead_latency.Record(overhead);
+}
+
+RpcOperationStats RpcLatencyHistogram::Stats(RpcOperation operation) const {
+  auto const& op = operations_[static_cast<std::size_t>(operation)];
+  RpcOperationStats stats;
+  stats.operations = op.operations.load(std::memory_order_relaxed);
+  stats.failed_operations =
+      op.failed_operations.load(std::memory_order_relaxed);
+  stats.attempts = op.attempts.load(std::memory_order_relaxed);
+  stats.failed_attempts = op.failed_attempts.load(std::memory_order_relaxed);
+  stats.bytes_sent = op.bytes_sent.load(std::memory_order_relaxed);
+  stats.bytes_received = op.bytes_received.load(std::memory_order_relaxed);
+  stats.latency = op.latency.Snapshot();
+  stats.attempt_latency = op.attempt_latency.Snapshot();
+  stats.backoff_latency = op.backoff_latency.Snapshot();
+  stats.overhead_latency = op.overhead_latency.Snapshot();
+  return stats;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
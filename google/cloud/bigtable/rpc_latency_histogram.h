@@ -0,0 +1,119 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RPC_LATENCY_HISTOGRAM_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RPC_LATENCY_HISTOGRAM_H_
+
+#include "google/cloud/bigtable/rpc_instrumentation.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/latency_distribution.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A snapshot of a latency histogram.
+ *
+ * The bucket boundaries are powers of two (in microseconds), each split into
+ * 8 linear sub-buckets, so the reported values are within 12.5% of the actual
+ * latencies.
+ */
+using LatencyHistogram = google::cloud::internal::LatencyDistribution;
+
+/// The statistics for one `RpcOperation`.
+struct RpcOperationStats {
+  std::uint64_t operations;
+  std::uint64_t failed_operations;
+  std::uint64_t attempts;
+  std::uint64_t failed_attempts;
+  std::uint64_t bytes_sent;
+  std::uint64_t bytes_received;
+  /// The end-to-end latency of each operation.
+  LatencyHistogram latency;
+  /// The latency of each attempt, that is, the time spent in each RPC.
+  LatencyHistogram attempt_latency;
+  /// The total backoff time for each operation.
+  LatencyHistogram backoff_latency;
+  /**
+   * The time in each operation not spent in RPCs or backoff.
+   *
+   * This is mostly the time waiting for a thread to run the completion queue,
+   * and any other client-side processing.
+   */
+  LatencyHistogram overhead_latency;
+};
+
+/**
+ * An `RpcInstrumentation` keeping latency histograms for each operation.
+ *
+ * @par Example
+ * @code
+ * auto histogram = std::make_shared<bigtable::RpcLatencyHistogram>();
+ * auto client = bigtable::CreateDefaultDataClient(
+ *     project_id, instance_id,
+ *     bigtable::ClientOptions().set_rpc_instrumentation(histogram));
+ * bigtable::Table table(client, "my-table");
+ * // ... use `table` ...
+ * auto stats = histogram->Stats(bigtable::RpcOperation::kApply);
+ * std::cout << "p99=" << stats.latency.Percentile(0.99).count() << "us"
+ *           << " retries=" << stats.attempts - stats.operations
+ *           << " p99 (RPC)=" << stats.attempt_latency.Percentile(0.99).count()
+ *           << "us\n";
+ * @endcode
+ *
+ * Comparing the percentiles of the histograms attributes the tail latency to
+ * slow RPCs (`attempt_latency`), to retries (`backoff_latency`, and the number
+ * of attempts), or to the client (`overhead_latency`).
+ *
+ * Recording an event only uses relaxed atomic increments, it never blocks.
+ * `Stats()` can be called at any time, the results are not a consistent
+ * snapshot across counters, but each counter is accurate.
+ */
+class RpcLatencyHistogram : public RpcInstrumentation {
+ public:
+  RpcLatencyHistogram() = default;
+
+  void OnAttempt(RpcAttempt const& attempt) override;
+  void OnFinish(RpcFinish const& finish) override;
+
+  /// Return the statistics for @p operation.
+  RpcOperationStats Stats(RpcOperation operation) const;
+
+ private:
+  struct Operation {
+    std::atomic<std::uint64_t> operations = {0};
+    std::atomic<std::uint64_t> failed_operations = {0};
+    std::atomic<std::uint64_t> attempts = {0};
+    std::atomic<std::uint64_t> failed_attempts = {0};
+    std::atomic<std::uint64_t> bytes_sent = {0};
+    std::atomic<std::uint64_t> bytes_received = {0};
+    google::cloud::internal::AtomicLatencyHistogram latency;
+    google::cloud::internal::AtomicLatencyHistogram attempt_latency;
+    google::cloud::internal::AtomicLatencyHistogram backoff_latency;
+    google::cloud::internal::AtomicLatencyHistogram overhead_latency;
+  };
+
+  std::array<Operation, kRpcOperationCount> operations_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RPC_LATENCY_HISTOGRAM_H_
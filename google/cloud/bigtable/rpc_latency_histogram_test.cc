@@ -0,0 +1,131 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/rpc_latency_histogram.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+using us = std::chrono::microseconds;
+
+/// @test Verify that the percentiles are within the expected error.
+TEST(LatencyHistogramTest, Percentile) {
+  RpcLatencyHistogram histogram;
+  for (int i = 1; i <= 1000; ++i) {
+    histogram.OnFinish(RpcFinish{RpcOperation::kApply, 1, grpc::StatusCode::OK,
+                                 us(i * 100), us(0), us(i * 100), us(0)});
+  }
+  auto stats = histogram.Stats(RpcOperation::kApply);
+  EXPECT_EQ(1000U, stats.operations);
+  EXPECT_EQ(1000U, stats.latency.count());
+  EXPECT_EQ(50050, stats.latency.mean().count());
+
+  for (double p : {0.5, 0.9, 0.99, 0.999}) {
+    auto const expected = static_cast<double>(p * 100000);
+    auto const actual =
+        static_cast<double>(stats.latency.Percentile(p).count());
+    EXPECT_NEAR(expected, actual, expected / 8) << "p=" << p;
+  }
+  EXPECT_GE(stats.latency.Percentile(1.0), us(100000 * 7 / 8));
+}
+
+/// @test Verify that an empty histogram reports zeros.
+TEST(LatencyHistogramTest, Empty) {
+  RpcLatencyHistogram histogram;
+  auto stats = histogram.Stats(RpcOperation::kReadRows);
+  EXPECT_EQ(0U, stats.operations);
+  EXPECT_EQ(0U, stats.latency.count());
+  EXPECT_EQ(us(0), stats.latency.mean());
+  EXPECT_EQ(us(0), stats.latency.Percentile(0.99));
+  EXPECT_EQ(LatencyHistogram::kBucketCount,
+            stats.latency.bucket_counts().size());
+}
+
+/// @test Verify that attempts, failures and bytes are counted.
+TEST(RpcLatencyHistogramTest, Counters) {
+  RpcLatencyHistogram histogram;
+  histogram.OnAttempt(RpcAttempt{RpcOperation::kBulkApply, 1, us(1000),
+                                 grpc::StatusCode::UNAVAILABLE, 0, 100, 0});
+  histogram.OnAttempt(RpcAttempt{RpcOperation::kBulkApply, 2, us(2000),
+                                 grpc::StatusCode::OK, 1, 100, 20});
+  histogram.OnFinish(RpcFinish{RpcOperation::kBulkApply, 2,
+                               grpc::StatusCode::OK, us(4000), us(10), us(3000),
+                               us(500)});
+  histogram.OnFinish(RpcFinish{RpcOperation::kBulkApply, 1,
+                               grpc::StatusCode::PERMISSION_DENIED, us(100),
+                               us(0), us(90), us(0)});
+
+  auto stats = histogram.Stats(RpcOperation::kBulkApply);
+  EXPECT_EQ(2U, stats.operations);
+  EXPECT_EQ(1U, stats.failed_operations);
+  EXPECT_EQ(2U, stats.attempts);
+  EXPECT_EQ(1U, stats.failed_attempts);
+  EXPECT_EQ(200U, stats.bytes_sent);
+  EXPECT_EQ(20U, stats.bytes_received);
+  EXPECT_EQ(2U, stats.attempt_latency.count());
+  EXPECT_EQ(1500, stats.attempt_latency.mean().count());
+  EXPECT_EQ(250, stats.backoff_latency.mean().count());
+  // 4000 - 3000 - 500 and 100 - 90 - 0.
+  EXPECT_EQ(255, stats.overhead_latency.mean().count());
+
+  EXPECT_EQ(0U, histogram.Stats(RpcOperation::kApply).operations);
+}
+
+/// @test Verify that the overhead is never negative.
+TEST(RpcLatencyHistogramTest, OverheadClamped) {
+  RpcLatencyHistogram histogram;
+  histogram.OnFinish(RpcFinish{RpcOperation::kApply, 2, grpc::StatusCode::OK,
+                               us(1000), us(0), us(800), us(500)});
+  auto stats = histogram.Stats(RpcOperation::kApply);
+  EXPECT_EQ(1U, stats.overhead_latency.count());
+  EXPECT_EQ(1U, stats.overhead_latency.bucket_counts()[0]);
+}
+
+/// @test Verify that concurrent events are all counted.
+TEST(RpcLatencyHistogramTest, Concurrent) {
+  RpcLatencyHistogram histogram;
+  int const kThreads = 8;
+  int const kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&histogram, kIterations] {
+      for (int i = 0; i != kIterations; ++i) {
+        histogram.OnAttempt(RpcAttempt{RpcOperation::kAsyncApply, 1, us(i),
+                                       grpc::StatusCode::OK, -1, 0, 0});
+        histogram.OnFinish(RpcFinish{RpcOperation::kAsyncApply, 1,
+                                     grpc::StatusCode::OK, us(i), us(0), us(i),
+                                     us(0)});
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  std::uint64_t const expected = kThreads * kIterations;
+  auto stats = histogram.Stats(RpcOperation::kAsyncApply);
+  EXPECT_EQ(expected, stats.operations);
+  EXPECT_EQ(expected, stats.attempts);
+  EXPECT_EQ(expected, stats.latency.count());
+  EXPECT_EQ(expected, stats.attempt_latency.count());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
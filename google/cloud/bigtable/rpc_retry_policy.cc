@@ -55,6 +55,58 @@ bool LimitedTimeRetryPolicy::OnFailure(grpc::Status const& status) {
   return impl_.OnFailure(status);
 }
 
+/// Use a `RPCRetryPolicy` as the policy wrapped by the common decorator.
+class RetryBudgetPolicy::Adapter
+    : public google::cloud::internal::RetryPolicy<grpc::Status, SafeGrpcRetry> {
+ public:
+  using BaseType =
+      google::cloud::internal::RetryPolicy<grpc::Status, SafeGrpcRetry>;
+
+  explicit Adapter(std::unique_ptr<RPCRetryPolicy> policy)
+      : policy_(std::move(policy)) {}
+
+  std::unique_ptr<BaseType> clone() const override {
+    return std::unique_ptr<BaseType>(new Adapter(policy_->clone()));
+  }
+  bool IsExhausted() const override { return exhausted_; }
+  void OnSuccess() override { policy_->OnSuccess(); }
+
+  RPCRetryPolicy const& policy() const { return *policy_; }
+
+ protected:
+  void OnFailureImpl(grpc::Status const& status) override {
+    exhausted_ = !policy_->OnFailure(status);
+  }
+
+ private:
+  std::unique_ptr<RPCRetryPolicy> policy_;
+  bool exhausted_ = false;
+};
+
+RetryBudgetPolicy::RetryBudgetPolicy(std::shared_ptr<RetryBudget> budget,
+                                     RPCRetryPolicy const& policy)
+    : impl_(std::move(budget), Adapter(policy.clone())) {}
+
+std::unique_ptr<RPCRetryPolicy> RetryBudgetPolicy::clone() const {
+  return std::unique_ptr<RPCRetryPolicy>(
+      new RetryBudgetPolicy(impl_.budget(), wrapped()));
+}
+
+void RetryBudgetPolicy::Setup(grpc::ClientContext& context) const {
+  wrapped().Setup(context);
+}
+
+bool RetryBudgetPolicy::OnFailure(grpc::Status const& status) {
+  return impl_.OnFailure(status);
+}
+
+void RetryBudgetPolicy::OnSuccess() { impl_.OnSuccess(); }
+
+RPCRetryPolicy const& RetryBudgetPolicy::wrapped() const {
+  // `impl_` always wraps an `Adapter`, see the constructor.
+  return static_cast<Adapter const&>(impl_.policy()).policy();
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
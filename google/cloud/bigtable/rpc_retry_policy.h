@@ -17,6 +17,7 @@
 
 #include "google/cloud/bigtable/internal/rpc_policy_parameters.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/retry_budget.h"
 #include "google/cloud/internal/retry_policy.h"
 #include <grpcpp/grpcpp.h>
 #include <chrono>
@@ -87,6 +88,13 @@ class RPCRetryPolicy {
    */
   virtual bool OnFailure(grpc::Status const& status) = 0;
 
+  /**
+   * Handle the successful completion of the RPC operation.
+   *
+   * The default implementation does nothing.
+   */
+  virtual void OnSuccess() {}
+
   static bool IsPermanentFailure(grpc::Status const& status) {
     return SafeGrpcRetry::IsPermanentFailure(status);
   }
@@ -135,6 +143,47 @@ class LimitedTimeRetryPolicy : public RPCRetryPolicy {
   Impl impl_;
 };
 
+/// Limit the retries across all the operations sharing a budget.
+using RetryBudget = google::cloud::internal::RetryBudget;
+
+/**
+ * Decorate a retry policy to also consume a shared `RetryBudget`.
+ *
+ * Use this policy to limit the retries across all the `Table` objects (and all
+ * the threads) in the application, for example:
+ *
+ * @code
+ * auto budget = std::make_shared<bigtable::RetryBudget>(100, 0.1);
+ * bigtable::Table table(client, "my-table",
+ *     bigtable::RetryBudgetPolicy(
+ *         budget, bigtable::LimitedTimeRetryPolicy(std::chrono::minutes(1))));
+ * @endcode
+ *
+ * The wrapped policy controls the retries of each operation, and the budget
+ * can further limit them. The budget never prevents the first attempt of an
+ * operation. Only the successful operations deposit tokens in the budget, see
+ * `google::cloud::internal::RetryBudgetPolicy` for details.
+ */
+class RetryBudgetPolicy : public RPCRetryPolicy {
+ public:
+  RetryBudgetPolicy(std::shared_ptr<RetryBudget> budget,
+                    RPCRetryPolicy const& policy);
+
+  std::unique_ptr<RPCRetryPolicy> clone() const override;
+  void Setup(grpc::ClientContext& context) const override;
+  bool OnFailure(grpc::Status const& status) override;
+  void OnSuccess() override;
+
+ private:
+  class Adapter;
+  using Impl =
+      google::cloud::internal::RetryBudgetPolicy<grpc::Status, SafeGrpcRetry>;
+
+  RPCRetryPolicy const& wrapped() const;
+
+  Impl impl_;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
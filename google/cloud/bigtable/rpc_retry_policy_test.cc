@@ -111,3 +111,33 @@ TEST(LimitedErrorCountRetryPolicy, OnNonRetryable) {
   bigtable::LimitedErrorCountRetryPolicy tested(3);
   EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
 }
+
+/// @test Verify that RetryBudgetPolicy is limited by the shared budget.
+TEST(RetryBudgetPolicy, Simple) {
+  auto budget = std::make_shared<bigtable::RetryBudget>(4, 1.0);
+  bigtable::RetryBudgetPolicy prototype(
+      budget, bigtable::LimitedErrorCountRetryPolicy(3));
+  auto p1 = prototype.clone();
+  auto p2 = prototype.clone();
+  EXPECT_TRUE(p1->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(p2->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(p2->OnFailure(CreatePermanentError()));
+  EXPECT_DOUBLE_EQ(2.0, budget->tokens());
+  // Only successful operations deposit tokens.
+  p1->OnSuccess();
+  EXPECT_DOUBLE_EQ(3.0, budget->tokens());
+  p2.reset();
+  EXPECT_DOUBLE_EQ(3.0, budget->tokens());
+}
+
+/// @test Verify that RetryBudgetPolicy forwards Setup() to the wrapped policy.
+TEST(RetryBudgetPolicy, Setup) {
+  auto budget = std::make_shared<bigtable::RetryBudget>(4, 1.0);
+  bigtable::RetryBudgetPolicy prototype(
+      budget, bigtable::LimitedTimeRetryPolicy(kLimitedTimeTestPeriod));
+  auto tested = prototype.clone();
+  grpc::ClientContext context;
+  tested->Setup(context);
+  auto const remaining = context.deadline() - std::chrono::system_clock::now();
+  EXPECT_LE(remaining, kLimitedTimeTestPeriod);
+}
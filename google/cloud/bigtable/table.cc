@@ -96,6 +96,18 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                         true);
 }
 
+void Table::ParallelReadRows(RowSet row_set, Filter filter,
+                             std::size_t parallelism,
+                             std::function<void(Row)> const& consumer,
+                             bool ordered) {
+  grpc::Status status;
+  impl_.ParallelReadRows(std::move(row_set), std::move(filter), parallelism,
+                         ordered, consumer, status);
+  if (!status.ok()) {
+    bigtable::internal::ThrowRpcError(status, status.error_message());
+  }
+}
+
 std::pair<bool, Row> Table::ReadRow(std::string row_key, Filter filter) {
   grpc::Status status;
   auto result = impl_.ReadRow(std::move(row_key), std::move(filter), status);
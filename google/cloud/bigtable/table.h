@@ -116,9 +116,14 @@ class Table {
    *       request. You can also create your own policies that combine time and
    *       error counts.
    *
+   *     In addition, a `std::shared_ptr<RowCache>` enables caching the
+   *     results of `ReadRow()`, see `RowCache` for the consistency caveats,
+   *     and a `std::shared_ptr<ReadHedgingPolicy>` enables hedged requests
+   *     in `ReadRow()`.
+   *
    * @see SafeIdempotentMutationPolicy, AlwaysRetryMutationPolicy,
    *     ExponentialBackoffPolicy, LimitedErrorCountRetryPolicy,
-   *     LimitedTimeRetryPolicy.
+   *     LimitedTimeRetryPolicy, RowCache, ReadHedgingPolicy.
    */
   template <typename... Policies>
   Table(std::shared_ptr<DataClient> client, std::string const& table_id,
@@ -170,9 +175,14 @@ class Table {
    *       request. You can also create your own policies that combine time and
    *       error counts.
    *
+   *     In addition, a `std::shared_ptr<RowCache>` enables caching the
+   *     results of `ReadRow()`, see `RowCache` for the consistency caveats,
+   *     and a `std::shared_ptr<ReadHedgingPolicy>` enables hedged requests
+   *     in `ReadRow()`.
+   *
    * @see SafeIdempotentMutationPolicy, AlwaysRetryMutationPolicy,
    *     ExponentialBackoffPolicy, LimitedErrorCountRetryPolicy,
-   *     LimitedTimeRetryPolicy.
+   *     LimitedTimeRetryPolicy, RowCache, ReadHedgingPolicy.
    */
   template <typename... Policies>
   Table(std::shared_ptr<DataClient> client,
@@ -268,6 +278,30 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Reads a set of rows using multiple streams in parallel.
+   *
+   * Splits the table into (at most) @p parallelism shards of similar size,
+   * using the results of `SampleRows()`, and reads the rows in @p row_set
+   * from each shard in a separate thread. The `DataClient` spreads the
+   * streams across its connection pool, so large scans are not limited by the
+   * throughput of a single stream.
+   *
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param parallelism the maximum number of concurrent streams.
+   * @param consumer called once for each row. It must not throw.
+   * @param ordered if true, @p consumer is called from the calling thread
+   *     with the rows in key order. Otherwise @p consumer is called from
+   *     multiple threads, with the rows in no particular order, and it must be
+   *     thread-safe.
+   *
+   * @throws bigtable::GRpcError if any of the streams fails.
+   */
+  void ParallelReadRows(RowSet row_set, Filter filter, std::size_t parallelism,
+                        std::function<void(Row)> const& consumer,
+                        bool ordered = false);
+
   /**
    * Read and return a single row from the table.
    *
@@ -364,6 +398,7 @@ class Table {
   }
 
  private:
+  friend class MutationBatcher;
   noex::Table impl_;
 };
 
@@ -0,0 +1,204 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_sample_row_keys_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = ::google::bigtable::v2;
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::Return;
+using testing::SetArgPointee;
+
+/// Define helper types and functions for this test.
+namespace {
+class TableParallelReadRowsTest : public bigtable::testing::TableTestFixture {
+ protected:
+  /// Return samples that split the table in 3 shards: ["", b), [b, d), [d, )
+  void ExpectSampleRowKeys() {
+    auto reader = new bigtable::testing::MockSampleRowKeysReader;
+    EXPECT_CALL(*client_, SampleRowKeys(_, _))
+        .WillOnce(Invoke(reader->MakeMockReturner()));
+    EXPECT_CALL(*reader, Read(_))
+        .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+          r->set_row_key("b");
+          r->set_offset_bytes(100);
+          return true;
+        }))
+        .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+          r->set_row_key("d");
+          r->set_offset_bytes(200);
+          return true;
+        }))
+        .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+          r->set_row_key("");
+          r->set_offset_bytes(300);
+          return true;
+        }))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  /**
+   * Return a stream for each shard, selected by the start of the range.
+   *
+   * The shards are read from multiple threads, the order of the `ReadRows`
+   * calls is unspecified.
+   */
+  void ExpectReadRows(std::map<std::string, std::string> keys,
+                      std::string const& failed_shard = "-") {
+    std::map<std::string, bigtable::testing::MockReadRowsReader*> streams;
+    for (auto const& kv : keys) {
+      auto stream = new bigtable::testing::MockReadRowsReader;
+      if (kv.first == failed_shard) {
+        EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+        EXPECT_CALL(*stream, Finish())
+            .WillOnce(Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED,
+                                          "uh oh")));
+      } else {
+        btproto::ReadRowsResponse response;
+        auto& chunk = *response.add_chunks();
+        chunk.set_row_key(kv.second);
+        chunk.mutable_family_name()->set_value("fam");
+        chunk.mutable_qualifier()->set_value("qual");
+        chunk.set_value("value");
+        chunk.set_commit_row(true);
+        EXPECT_CALL(*stream, Read(_))
+            .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+      }
+      streams[kv.first] = stream;
+    }
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .Times(static_cast<int>(streams.size()))
+        .WillRepeatedly(Invoke([streams](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const& r) {
+          EXPECT_EQ(1, r.rows().row_ranges_size());
+          auto const& start = r.rows().row_ranges(0).start_key_closed();
+          auto it = streams.find(start);
+          EXPECT_NE(streams.end(), it) << "unexpected shard start=" << start;
+          return it->second->AsUniqueMocked();
+        }));
+  }
+};
+}  // anonymous namespace
+
+/// @test Verify that the rows from all the shards are delivered in order.
+TEST_F(TableParallelReadRowsTest, Ordered) {
+  ExpectSampleRowKeys();
+  ExpectReadRows({{"", "a"}, {"b", "c"}, {"d", "e"}});
+
+  std::vector<std::string> actual;
+  table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(), 3,
+      [&actual](bigtable::Row row) { actual.push_back(row.row_key()); },
+      true);
+  EXPECT_EQ((std::vector<std::string>{"a", "c", "e"}), actual);
+}
+
+/// @test Verify that the rows from all the shards are delivered.
+TEST_F(TableParallelReadRowsTest, Unordered) {
+  ExpectSampleRowKeys();
+  ExpectReadRows({{"", "a"}, {"b", "c"}, {"d", "e"}});
+
+  std::mutex mu;
+  std::vector<std::string> actual;
+  table_.ParallelReadRows(bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+                          3, [&mu, &actual](bigtable::Row row) {
+                            std::lock_guard<std::mutex> lk(mu);
+                            actual.push_back(row.row_key());
+                          });
+  std::sort(actual.begin(), actual.end());
+  EXPECT_EQ((std::vector<std::string>{"a", "c", "e"}), actual);
+}
+
+/// @test Verify that shards outside the RowSet are not read.
+TEST_F(TableParallelReadRowsTest, SkipsShardsOutsideRowSet) {
+  ExpectSampleRowKeys();
+  ExpectReadRows({{"b", "c"}});
+
+  std::vector<std::string> actual;
+  table_.ParallelReadRows(
+      bigtable::RowSet(bigtable::RowRange::Range("b", "c1")),
+      bigtable::Filter::PassAllFilter(), 3,
+      [&actual](bigtable::Row row) { actual.push_back(row.row_key()); },
+      true);
+  EXPECT_EQ((std::vector<std::string>{"c"}), actual);
+}
+
+/// @test Verify that a failure in any shard is reported.
+TEST_F(TableParallelReadRowsTest, ShardFailure) {
+  ExpectSampleRowKeys();
+  ExpectReadRows({{"", "a"}, {"b", "c"}, {"d", "e"}}, "b");
+
+  std::vector<std::string> actual;
+  auto read = [this, &actual] {
+    table_.ParallelReadRows(
+        bigtable::RowSet(), bigtable::Filter::PassAllFilter(), 3,
+        [&actual](bigtable::Row row) { actual.push_back(row.row_key()); },
+        true);
+  };
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(read(), std::exception);
+  EXPECT_EQ((std::vector<std::string>{"a"}), actual);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(read(), "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that exceptions raised by the consumer stop the ordered read.
+TEST_F(TableParallelReadRowsTest, OrderedConsumerThrows) {
+  ExpectSampleRowKeys();
+  ExpectReadRows({{"", "a"}, {"b", "c"}, {"d", "e"}});
+
+  std::vector<std::string> actual;
+  EXPECT_THROW(table_.ParallelReadRows(
+                   bigtable::RowSet(), bigtable::Filter::PassAllFilter(), 3,
+                   [&actual](bigtable::Row row) {
+                     if (row.row_key() == "c") {
+                       throw std::runtime_error("consumer failure");
+                     }
+                     actual.push_back(row.row_key());
+                   },
+                   true),
+               std::runtime_error);
+  EXPECT_EQ((std::vector<std::string>{"a"}), actual);
+}
+
+/// @test Verify that exceptions raised by the consumer reach the caller.
+TEST_F(TableParallelReadRowsTest, UnorderedConsumerThrows) {
+  ExpectSampleRowKeys();
+  ExpectReadRows({{"", "a"}, {"b", "c"}, {"d", "e"}});
+
+  EXPECT_THROW(table_.ParallelReadRows(bigtable::RowSet(),
+                                       bigtable::Filter::PassAllFilter(), 3,
+                                       [](bigtable::Row row) {
+                                         if (row.row_key() == "c") {
+                                           throw std::runtime_error(
+                                               "consumer failure");
+                                         }
+                                       }),
+               std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
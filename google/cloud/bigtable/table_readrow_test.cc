@@ -16,8 +16,12 @@
 #include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
 #include "google/cloud/bigtable/testing/table_test_fixture.h"
 #include "google/cloud/internal/make_unique.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <future>
+#include <thread>
 
 namespace bigtable = google::cloud::bigtable;
+using namespace google::cloud::testing_util::chrono_literals;
 
 /// Define helper types and functions for this test.
 namespace {
@@ -112,3 +116,213 @@ TEST_F(TableReadRowTest, UnrecoverableFailure) {
       "exceptions are disabled");
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
+
+TEST_F(TableReadRowTest, CachedReadRow) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+
+  auto make_stream = [&response] {
+    auto stream = google::cloud::internal::make_unique<MockReadRowsReader>();
+    EXPECT_CALL(*stream, Read(_))
+        .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+          *r = response;
+          return true;
+        }))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+    return stream.release()->AsUniqueMocked();
+  };
+
+  // The first ReadRow() and the ReadRow() after the mutation contact the
+  // server, the others are served from the cache.
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&make_stream](grpc::ClientContext*,
+                                btproto::ReadRowsRequest const&) {
+            return make_stream();
+          }));
+  EXPECT_CALL(*client_, MutateRow(_, _, _))
+      .WillOnce(Return(grpc::Status::OK));
+
+  auto cache =
+      std::make_shared<bigtable::RowCache>(100, std::chrono::minutes(10));
+  bigtable::Table table(client_, kTableId, cache);
+
+  for (int i = 0; i != 3; ++i) {
+    auto result = table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+    EXPECT_TRUE(std::get<0>(result));
+    EXPECT_EQ("r1", std::get<1>(result).row_key());
+    ASSERT_EQ(1U, std::get<1>(result).cells().size());
+    EXPECT_EQ("value", std::get<1>(result).cells().at(0).value());
+  }
+  EXPECT_EQ(2, cache->hit_count());
+  EXPECT_EQ(1, cache->miss_count());
+
+  table.Apply(bigtable::SingleRowMutation(
+      "r1", {bigtable::SetCell("fam", "col", 0_ms, "new-value")}));
+  EXPECT_EQ(0U, cache->size());
+
+  auto result = table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_TRUE(std::get<0>(result));
+  EXPECT_EQ(2, cache->miss_count());
+  EXPECT_EQ(1U, cache->size());
+}
+
+TEST_F(TableReadRowTest, HedgedReadRow) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+
+  // The original request blocks until the hedged request completes.
+  std::promise<void> hedge_done;
+  auto hedge_done_future = hedge_done.get_future().share();
+  auto original = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*original, Read(_))
+      .WillOnce(Invoke([hedge_done_future](btproto::ReadRowsResponse*) {
+        hedge_done_future.wait();
+        return false;
+      }));
+  EXPECT_CALL(*original, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::CANCELLED, "")));
+
+  auto hedged = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*hedged, Read(_))
+      .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+        *r = response;
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*hedged, Finish()).WillOnce(Invoke([&hedge_done] {
+    hedge_done.set_value();
+    return grpc::Status::OK;
+  }));
+
+  int call_count = 0;
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](grpc::ClientContext*,
+                                 btproto::ReadRowsRequest const& req) {
+        EXPECT_EQ(1, req.rows().row_keys_size());
+        EXPECT_EQ("r1", req.rows().row_keys(0));
+        EXPECT_EQ(1, req.rows_limit());
+        if (call_count++ == 0) {
+          return original.release()->AsUniqueMocked();
+        }
+        return hedged.release()->AsUniqueMocked();
+      }));
+
+  auto hedging =
+      std::make_shared<bigtable::ReadHedgingPolicy>(0.5, 1_ms, 1.0);
+  bigtable::Table table(client_, kTableId, hedging);
+
+  auto result = table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_TRUE(std::get<0>(result));
+  EXPECT_EQ("r1", std::get<1>(result).row_key());
+  EXPECT_EQ(1, hedging->hedge_count());
+  EXPECT_EQ(1, hedging->hedge_win_count());
+}
+
+TEST_F(TableReadRowTest, HedgedReadRowFastOriginal) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(
+          [&stream](grpc::ClientContext*, btproto::ReadRowsRequest const&) {
+            return stream.release()->AsUniqueMocked();
+          }));
+
+  // The original request completes well before the delay, there is no hedged
+  // request, and ReadRow() does not wait for the delay.
+  auto hedging = std::make_shared<bigtable::ReadHedgingPolicy>(
+      0.5, std::chrono::minutes(10), 1.0);
+  bigtable::Table table(client_, kTableId, hedging);
+
+  auto result = table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_FALSE(std::get<0>(result));
+  EXPECT_EQ(0, hedging->hedge_count());
+}
+
+TEST_F(TableReadRowTest, HedgedReadRowNoBudget) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*) {
+        std::this_thread::sleep_for(20_ms);
+        return false;
+      }));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(
+          [&stream](grpc::ClientContext*, btproto::ReadRowsRequest const&) {
+            return stream.release()->AsUniqueMocked();
+          }));
+
+  // A zero ratio never accumulates budget for hedged requests.
+  auto hedging =
+      std::make_shared<bigtable::ReadHedgingPolicy>(0.5, 1_ms, 0.0);
+  bigtable::Table table(client_, kTableId, hedging);
+
+  auto result = table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_FALSE(std::get<0>(result));
+  EXPECT_EQ(0, hedging->hedge_count());
+}
+
+TEST_F(TableReadRowTest, HedgedReadRowRetriesTransientFailures) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto failed = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*failed, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*failed, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try")));
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(
+          [&failed](grpc::ClientContext*, btproto::ReadRowsRequest const&) {
+            return failed.release()->AsUniqueMocked();
+          }))
+      .WillOnce(Invoke(
+          [&stream](grpc::ClientContext*, btproto::ReadRowsRequest const&) {
+            return stream.release()->AsUniqueMocked();
+          }));
+
+  auto hedging = std::make_shared<bigtable::ReadHedgingPolicy>(
+      0.5, std::chrono::minutes(10), 1.0);
+  bigtable::Table table(client_, kTableId, hedging);
+
+  auto result = table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_FALSE(std::get<0>(result));
+}
@@ -198,6 +198,18 @@ class promise final : private internal::promise_base<T> {
   using internal::promise_base<T>::set_exception;
 };
 
+/**
+ * Creates a `future<T>` whose shared state is already satisfied with @p value.
+ *
+ * Implements `make_ready_future()` as defined in ISO/IEC TS 19571:2016.
+ */
+template <typename T>
+future<typename std::decay<T>::type> make_ready_future(T&& value) {
+  promise<typename std::decay<T>::type> p;
+  p.set_value(std::forward<T>(value));
+  return p.get_future();
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
 }  // namespace google
@@ -612,6 +612,14 @@ TEST(FutureTestInt, conform_30_6_6_25_3) {
 // raise too. We do not need to test for that, exceptions are always propagated,
 // this is just giving implementors freedom.
 
+/// @test Verify make_ready_future() returns a satisfied future.
+TEST(FutureTestInt, MakeReadyFuture) {
+  auto f0 = make_ready_future(42);
+  EXPECT_TRUE(f0.valid());
+  EXPECT_TRUE(f0.is_ready());
+  EXPECT_EQ(42, f0.get());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
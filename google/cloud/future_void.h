@@ -184,6 +184,17 @@ class promise<void> final : private internal::promise_base<void> {
   using promise_base<void>::set_exception;
 };
 
+/**
+ * Creates a `future<void>` whose shared state is already satisfied.
+ *
+ * Implements `make_ready_future()` as defined in ISO/IEC TS 19571:2016.
+ */
+inline future<void> make_ready_future() {
+  promise<void> p;
+  p.set_value();
+  return p.get_future();
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
 }  // namespace google
@@ -621,6 +621,15 @@ TEST(FutureTestVoid, conform_30_6_6_25_3) {
 // raise too. We do not need to test for that, exceptions are always propagated,
 // this is just giving implementors freedom.
 
+/// @test Verify make_ready_future() returns a satisfied future.
+TEST(FutureTestVoid, MakeReadyFuture) {
+  auto f0 = make_ready_future();
+  EXPECT_TRUE(f0.valid());
+  EXPECT_TRUE(f0.is_ready());
+  f0.get();
+  EXPECT_FALSE(f0.valid());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -17,6 +17,7 @@
 """Automatically generated source lists for google_cloud_cpp_common - DO NOT EDIT."""
 
 google_cloud_cpp_common_hdrs = [
+    "async_log_backend.h",
     "future.h",
     "future_generic.h",
     "future_void.h",
@@ -35,10 +36,12 @@ google_cloud_cpp_common_hdrs = [
     "internal/future_then_meta.h",
     "internal/getenv.h",
     "internal/ios_flags_saver.h",
+    "internal/latency_distribution.h",
     "internal/make_unique.h",
     "internal/port_platform.h",
     "internal/random.h",
     "internal/invoke_result.h",
+    "internal/retry_budget.h",
     "internal/retry_policy.h",
     "internal/setenv.h",
     "internal/throw_delegate.h",
@@ -51,13 +54,16 @@ google_cloud_cpp_common_hdrs = [
 ]
 
 google_cloud_cpp_common_srcs = [
+    "async_log_backend.cc",
     "iam_bindings.cc",
     "iam_policy.cc",
     "internal/backoff_policy.cc",
     "internal/filesystem.cc",
     "internal/future_impl.cc",
     "internal/getenv.cc",
+    "internal/latency_distribution.cc",
     "internal/random.cc",
+    "internal/retry_budget.cc",
     "internal/setenv.cc",
     "internal/throw_delegate.cc",
     "log.cc",
@@ -17,6 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 google_cloud_cpp_common_unit_tests = [
+    "async_log_backend_test.cc",
     "future_generic_test.cc",
     "future_generic_then_test.cc",
     "future_void_test.cc",
@@ -27,7 +28,9 @@ google_cloud_cpp_common_unit_tests = [
     "internal/filesystem_test.cc",
     "internal/future_impl_test.cc",
     "internal/invoke_result_test.cc",
+    "internal/latency_distribution_test.cc",
     "internal/random_test.cc",
+    "internal/retry_budget_test.cc",
     "internal/retry_policy_test.cc",
     "internal/throw_delegate_test.cc",
     "log_test.cc",
@@ -164,7 +164,8 @@ class future_shared_state_base {
    * The destructor of `promise<T>` abandons the state. If it is satisfied this
    * has no effect, but otherwise the state is satisfied with an
    * `std::future_error` exception. The error code is
-   * `std::future_errc::broken_promise`.
+   * `std::future_errc::broken_promise`. As with any other exception, any
+   * continuation is invoked.
    */
   void abandon() {
     std::unique_lock<std::mutex> lk(mu_);
@@ -174,7 +175,7 @@ class future_shared_state_base {
     set_exception(std::make_exception_ptr(
                       std::future_error(std::future_errc::broken_promise)),
                   lk);
-    cv_.notify_all();
+    notify_now(std::move(lk));
   }
 
   void set_continuation(std::unique_ptr<continuation_base> c) {
@@ -256,6 +256,18 @@ TEST(FutureImplVoid, SetContinuation) {
   SUCCEED();
 }
 
+TEST(FutureImplVoid, AbandonCallsContinuation) {
+  future_shared_state<void> shared_state;
+
+  int execute_counter = 0;
+  shared_state.set_continuation(
+      google::cloud::internal::make_unique<TestContinuation>(&execute_counter));
+  EXPECT_EQ(0, execute_counter);
+  shared_state.abandon();
+  EXPECT_EQ(1, execute_counter);
+  EXPECT_TRUE(shared_state.is_ready());
+}
+
 TEST(FutureImplVoid, SetContinuationAlreadySet) {
   future_shared_state<void> shared_state;
   EXPECT_FALSE(shared_state.is_ready());
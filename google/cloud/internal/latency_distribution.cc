@@ -0,0 +1,131 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/latency_distribution.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+int const LatencyDistribution::kSubBucketBits;
+std::uint64_t const LatencyDistribution::kSubBucketCount;
+int const LatencyDistribution::kMaxLatencyBits;
+std::size_t const LatencyDistribution::kBucketCount;
+
+LatencyDistribution::LatencyDistribution(
+    std::vector<std::uint64_t> bucket_counts, std::uint64_t total_micros)
+    : bucket_counts_(std::move(bucket_counts)),
+      total_micros_(total_micros),
+      count_(std::accumulate(bucket_counts_.begin(), bucket_counts_.end(),
+                             std::uint64_t(0))) {}
+
+std::chrono::microseconds LatencyDistribution::mean() const {
+  if (count_ == 0) {
+    return std::chrono::microseconds(0);
+  }
+  return std::chrono::microseconds(total_micros_ / count_);
+}
+
+std::chrono::microseconds LatencyDistribution::Percentile(
+    double percentile) const {
+  if (count_ == 0) {
+    return std::chrono::microseconds(0);
+  }
+  auto rank = static_cast<std::uint64_t>(
+      std::ceil(percentile * static_cast<double>(count_)));
+  rank = (std::max)(std::uint64_t(1), (std::min)(rank, count_));
+  std::uint64_t cumulative = 0;
+  for (std::size_t i = 0; i != bucket_counts_.size(); ++i) {
+    cumulative += bucket_counts_[i];
+    if (cumulative < rank) {
+      continue;
+    }
+    // Report the middle of the bucket, that halves the worst case error.
+    auto const lower = BucketLowerBound(i);
+    if (i + 1 == bucket_counts_.size()) {
+      return lower;
+    }
+    return lower + (BucketLowerBound(i + 1) - lower) / 2;
+  }
+  return BucketLowerBound(bucket_counts_.size() - 1);
+}
+
+void LatencyDistribution::Merge(LatencyDistribution const& rhs) {
+  if (bucket_counts_.size() < rhs.bucket_counts_.size()) {
+    bucket_counts_.resize(rhs.bucket_counts_.size());
+  }
+  for (std::size_t i = 0; i != rhs.bucket_counts_.size(); ++i) {
+    bucket_counts_[i] += rhs.bucket_counts_[i];
+  }
+  total_micros_ += rhs.total_micros_;
+  count_ += rhs.count_;
+}
+
+std::chrono::microseconds LatencyDistribution::BucketLowerBound(
+    std::size_t index) {
+  if (index < kSubBucketCount) {
+    return std::chrono::microseconds(index);
+  }
+  auto const shift = index / kSubBucketCount - 1;
+  auto const sub_bucket = index % kSubBucketCount;
+  return std::chrono::microseconds(
+      static_cast<std::int64_t>((kSubBucketCount + sub_bucket) << shift));
+}
+
+std::size_t LatencyDistribution::BucketIndex(
+    std::chrono::microseconds latency) {
+  auto const micros =
+      latency.count() < 0 ? 0 : static_cast<std::uint64_t>(latency.count());
+  if (micros < kSubBucketCount) {
+    return static_cast<std::size_t>(micros);
+  }
+  int msb = 0;
+  for (auto v = micros; v > 1; v >>= 1) {
+    ++msb;
+  }
+  if (msb >= kMaxLatencyBits) {
+    return kBucketCount - 1;
+  }
+  // The values in [2^msb, 2^(msb+1)) are split in kSubBucketCount buckets.
+  int const shift = msb - kSubBucketBits;
+  auto const sub_bucket = (micros >> shift) - kSubBucketCount;
+  return static_cast<std::size_t>((shift + 1) * kSubBucketCount + sub_bucket);
+}
+
+void AtomicLatencyHistogram::Record(std::chrono::microseconds latency) {
+  buckets_[LatencyDistribution::BucketIndex(latency)].fetch_add(
+      1, std::memory_order_relaxed);
+  if (latency.count() > 0) {
+    total_micros_.fetch_add(static_cast<std::uint64_t>(latency.count()),
+                            std::memory_order_relaxed);
+  }
+}
+
+LatencyDistribution AtomicLatencyHistogram::Snapshot() const {
+  std::vector<std::uint64_t> counts(buckets_.size());
+  std::transform(buckets_.begin(), buckets_.end(), counts.begin(),
+                 [](std::atomic<std::uint64_t> const& b) {
+                   return b.load(std::memory_order_relaxed);
+                 });
+  return LatencyDistribution(std::move(counts),
+                             total_micros_.load(std::memory_order_relaxed));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
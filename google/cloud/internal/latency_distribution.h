@@ -0,0 +1,111 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_LATENCY_DISTRIBUTION_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_LATENCY_DISTRIBUTION_H_
+
+#include "google/cloud/version.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+/**
+ * The distribution of a set of latencies.
+ *
+ * The latencies are counted in buckets. The bucket boundaries are powers of
+ * two (in microseconds), each split into 8 linear sub-buckets, so any value
+ * reported by this class is within 12.5% of the actual latency.
+ */
+class LatencyDistribution {
+ public:
+  /// The number of linear sub-buckets in each power of two, log2.
+  static int const kSubBucketBits = 3;
+  static std::uint64_t const kSubBucketCount = 1U << kSubBucketBits;
+  /// Latencies of 2^kMaxLatencyBits microseconds (about 19 hours) or more
+  /// are counted in the last bucket.
+  static int const kMaxLatencyBits = 36;
+  static std::size_t const kBucketCount =
+      (kMaxLatencyBits - kSubBucketBits + 1) * kSubBucketCount;
+
+  LatencyDistribution() : total_micros_(0), count_(0) {}
+  LatencyDistribution(std::vector<std::uint64_t> bucket_counts,
+                      std::uint64_t total_micros);
+
+  /// The number of latencies recorded.
+  std::uint64_t count() const { return count_; }
+
+  /// The mean latency, or zero if no latencies were recorded.
+  std::chrono::microseconds mean() const;
+
+  /**
+   * Return the latency at the given percentile.
+   *
+   * @param percentile must be in the `[0.0, 1.0]` range, for example, use
+   *     `0.999` for the 99.9th percentile.
+   */
+  std::chrono::microseconds Percentile(double percentile) const;
+
+  /// The number of latencies in each bucket.
+  std::vector<std::uint64_t> const& bucket_counts() const {
+    return bucket_counts_;
+  }
+
+  /// Add the latencies counted in @p rhs to this distribution.
+  void Merge(LatencyDistribution const& rhs);
+
+  /// The smallest latency counted in the bucket at @p index.
+  static std::chrono::microseconds BucketLowerBound(std::size_t index);
+
+  /// The index of the bucket counting @p latency.
+  static std::size_t BucketIndex(std::chrono::microseconds latency);
+
+ private:
+  std::vector<std::uint64_t> bucket_counts_;
+  std::uint64_t total_micros_;
+  std::uint64_t count_;
+};
+
+/**
+ * Count latencies in the buckets of a `LatencyDistribution`.
+ *
+ * Recording a latency only uses relaxed atomic increments, it never blocks.
+ * `Snapshot()` can be called at any time, the result is not a consistent
+ * snapshot across buckets, but each bucket is accurate.
+ */
+class AtomicLatencyHistogram {
+ public:
+  AtomicLatencyHistogram() = default;
+
+  void Record(std::chrono::microseconds latency);
+  LatencyDistribution Snapshot() const;
+
+ private:
+  // Value-initialized, that sets all the counters to 0.
+  std::array<std::atomic<std::uint64_t>, LatencyDistribution::kBucketCount>
+      buckets_ = {};
+  std::atomic<std::uint64_t> total_micros_ = {0};
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_LATENCY_DISTRIBUTION_H_
@@ -0,0 +1,110 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/latency_distribution.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+using us = std::chrono::microseconds;
+
+/// @test Verify the bucket boundaries are consistent with the bucket index.
+TEST(LatencyDistributionTest, BucketBoundaries) {
+  for (std::size_t i = 0; i != LatencyDistribution::kBucketCount; ++i) {
+    auto const lower = LatencyDistribution::BucketLowerBound(i);
+    EXPECT_EQ(i, LatencyDistribution::BucketIndex(lower)) << "i=" << i;
+    if (i != 0) {
+      EXPECT_EQ(i - 1, LatencyDistribution::BucketIndex(lower - us(1)))
+          << "i=" << i;
+    }
+  }
+  EXPECT_EQ(0U, LatencyDistribution::BucketIndex(us(-10)));
+  EXPECT_EQ(LatencyDistribution::kBucketCount - 1,
+            LatencyDistribution::BucketIndex(us(std::int64_t(1) << 40)));
+}
+
+/// @test Verify the percentiles are within the bucket resolution.
+TEST(LatencyDistributionTest, Percentile) {
+  AtomicLatencyHistogram histogram;
+  for (int i = 1; i <= 1000; ++i) {
+    histogram.Record(us(i * 100));
+  }
+  auto distribution = histogram.Snapshot();
+  EXPECT_EQ(1000U, distribution.count());
+  EXPECT_EQ(us(50050), distribution.mean());
+  for (double p : {0.5, 0.9, 0.99, 0.999}) {
+    auto const expected = p * 100000;
+    auto const actual =
+        static_cast<double>(distribution.Percentile(p).count());
+    EXPECT_NEAR(expected, actual, expected / 8) << "p=" << p;
+  }
+  EXPECT_NEAR(100.0, static_cast<double>(distribution.Percentile(0.0).count()),
+              100.0 / 8);
+}
+
+/// @test Verify an empty distribution reports zeroes.
+TEST(LatencyDistributionTest, Empty) {
+  LatencyDistribution empty;
+  EXPECT_EQ(0U, empty.count());
+  EXPECT_EQ(us(0), empty.mean());
+  EXPECT_EQ(us(0), empty.Percentile(0.99));
+  EXPECT_EQ(LatencyDistribution::kBucketCount,
+            AtomicLatencyHistogram().Snapshot().bucket_counts().size());
+}
+
+/// @test Verify merging distributions adds their counts.
+TEST(LatencyDistributionTest, Merge) {
+  AtomicLatencyHistogram a;
+  a.Record(us(10));
+  a.Record(us(30));
+  AtomicLatencyHistogram b;
+  b.Record(us(20));
+
+  LatencyDistribution merged;
+  merged.Merge(a.Snapshot());
+  merged.Merge(b.Snapshot());
+  EXPECT_EQ(3U, merged.count());
+  EXPECT_EQ(us(20), merged.mean());
+  EXPECT_EQ(LatencyDistribution::kBucketCount, merged.bucket_counts().size());
+}
+
+/// @test Verify concurrent updates are not lost.
+TEST(LatencyDistributionTest, Concurrent) {
+  AtomicLatencyHistogram histogram;
+  int const kThreads = 4;
+  int const kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&histogram] {
+      for (int i = 0; i != kIterations; ++i) {
+        histogram.Record(us(i));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(static_cast<std::uint64_t>(kThreads * kIterations),
+            histogram.Snapshot().count());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,71 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/retry_budget.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+RetryBudget::RetryBudget(double max_tokens, double token_ratio,
+                         int failure_threshold,
+                         std::chrono::milliseconds open_period)
+    : max_tokens_(max_tokens),
+      token_ratio_(token_ratio),
+      failure_threshold_(failure_threshold),
+      open_period_(open_period),
+      tokens_(max_tokens),
+      consecutive_failures_(0) {}
+
+void RetryBudget::OnSuccess() {
+  std::unique_lock<std::mutex> lk(mu_);
+  tokens_ = (std::min)(max_tokens_, tokens_ + token_ratio_);
+  consecutive_failures_ = 0;
+  open_until_ = std::chrono::steady_clock::time_point();
+}
+
+bool RetryBudget::OnFailure() {
+  std::unique_lock<std::mutex> lk(mu_);
+  tokens_ = (std::max)(0.0, tokens_ - 1.0);
+  ++consecutive_failures_;
+  if (failure_threshold_ > 0 && consecutive_failures_ >= failure_threshold_ &&
+      !IsCircuitOpen(lk)) {
+    open_until_ = std::chrono::steady_clock::now() + open_period_;
+    // Once the circuit closes again it takes another `failure_threshold_`
+    // failures to open it.
+    consecutive_failures_ = 0;
+    return false;
+  }
+  return !IsCircuitOpen(lk) && tokens_ > max_tokens_ / 2;
+}
+
+double RetryBudget::tokens() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  return tokens_;
+}
+
+bool RetryBudget::IsCircuitOpen() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  return IsCircuitOpen(lk);
+}
+
+bool RetryBudget::IsCircuitOpen(std::unique_lock<std::mutex> const&) const {
+  return std::chrono::steady_clock::now() < open_until_;
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,159 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RETRY_BUDGET_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RETRY_BUDGET_H_
+
+#include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+/**
+ * Limit the retries across all the operations sharing this object.
+ *
+ * Each retry policy clones the application-provided prototype for every
+ * operation, so the retry limits apply to each operation independently. During
+ * a service brownout every operation retries, and the retries multiply the
+ * load on the service. A `RetryBudget` is shared by many policies to bound
+ * the ratio of retries to operations:
+ *
+ * - The budget starts with @p max_tokens tokens.
+ * - Each retryable failure consumes one token.
+ * - Each successful operation deposits @p token_ratio tokens, up to
+ *   @p max_tokens.
+ * - Retries are only allowed while there are more than `max_tokens / 2`
+ *   tokens.
+ *
+ * In steady state this allows about `token_ratio` retries per successful
+ * operation, while short bursts of failures can use the reserve.
+ *
+ * Optionally, the budget also implements a circuit breaker. After
+ * @p failure_threshold consecutive retryable failures the circuit opens, and
+ * no retries are allowed for @p open_period. Operations still make their first
+ * attempt while the circuit is open, these serve as probes, any successful
+ * operation closes the circuit.
+ *
+ * This class is thread-safe.
+ */
+class RetryBudget {
+ public:
+  RetryBudget(double max_tokens, double token_ratio)
+      : RetryBudget(max_tokens, token_ratio, 0, std::chrono::milliseconds(0)) {}
+
+  /**
+   * Create a budget with a circuit breaker.
+   *
+   * @param failure_threshold the number of consecutive retryable failures that
+   *     open the circuit, use 0 to disable the circuit breaker.
+   * @param open_period how long the circuit remains open.
+   */
+  RetryBudget(double max_tokens, double token_ratio, int failure_threshold,
+              std::chrono::milliseconds open_period);
+
+  /// Record an operation completed without a retryable failure.
+  void OnSuccess();
+
+  /// Record a retryable failure, returns true if the failure can be retried.
+  bool OnFailure();
+
+  /// The number of tokens currently available.
+  double tokens() const;
+
+  /// Return true if the circuit breaker is open.
+  bool IsCircuitOpen() const;
+
+ private:
+  bool IsCircuitOpen(std::unique_lock<std::mutex> const& lk) const;
+
+  double const max_tokens_;
+  double const token_ratio_;
+  int const failure_threshold_;
+  std::chrono::milliseconds const open_period_;
+
+  mutable std::mutex mu_;
+  double tokens_;
+  int consecutive_failures_;
+  std::chrono::steady_clock::time_point open_until_;
+};
+
+/**
+ * Decorate a retry policy to also consume a shared `RetryBudget`.
+ *
+ * The decorated policy controls the retries of each operation, as usual, and
+ * the budget can further limit them. The budget never prevents the first
+ * attempt of an operation.
+ *
+ * The retry loops report successful operations by calling `OnSuccess()`, which
+ * deposits tokens in the budget. Operations that fail, or that are abandoned
+ * before they complete, do not deposit any tokens.
+ *
+ * @tparam StatusType the type used to represent success/failures.
+ * @tparam RetryablePolicy the policy to decide if a status represents a
+ *     permanent failure.
+ */
+template <typename StatusType, typename RetryablePolicy>
+class RetryBudgetPolicy : public RetryPolicy<StatusType, RetryablePolicy> {
+ public:
+  using BaseType = RetryPolicy<StatusType, RetryablePolicy>;
+
+  RetryBudgetPolicy(std::shared_ptr<RetryBudget> budget, BaseType const& policy)
+      : RetryBudgetPolicy(std::move(budget), policy.clone()) {}
+
+  RetryBudgetPolicy(RetryBudgetPolicy const&) = delete;
+  RetryBudgetPolicy& operator=(RetryBudgetPolicy const&) = delete;
+
+  std::unique_ptr<BaseType> clone() const override {
+    return std::unique_ptr<BaseType>(
+        new RetryBudgetPolicy(budget_, policy_->clone()));
+  }
+  bool IsExhausted() const override {
+    return budget_exhausted_ || policy_->IsExhausted();
+  }
+  void OnSuccess() override {
+    budget_->OnSuccess();
+    policy_->OnSuccess();
+  }
+
+  std::shared_ptr<RetryBudget> const& budget() const { return budget_; }
+  BaseType const& policy() const { return *policy_; }
+
+ protected:
+  void OnFailureImpl(StatusType const& status) override {
+    policy_->OnFailureImpl(status);
+    // Always record the failure, even if the wrapped policy is exhausted.
+    budget_exhausted_ = !budget_->OnFailure();
+  }
+
+ private:
+  RetryBudgetPolicy(std::shared_ptr<RetryBudget> budget,
+                    std::unique_ptr<BaseType> policy)
+      : budget_(std::move(budget)), policy_(std::move(policy)) {}
+
+  std::shared_ptr<RetryBudget> budget_;
+  std::unique_ptr<BaseType> policy_;
+  bool budget_exhausted_ = false;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RETRY_BUDGET_H_
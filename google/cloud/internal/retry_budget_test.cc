@@ -0,0 +1,166 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/retry_budget.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace {
+struct Status {
+  bool is_retryable;
+  bool is_ok;
+};
+struct IsRetryablePolicy {
+  static bool IsPermanentFailure(Status const& s) {
+    return s.is_ok || !s.is_retryable;
+  }
+};
+
+Status CreateTransientError() { return Status{true, false}; }
+Status CreatePermanentError() { return Status{false, false}; }
+
+using google::cloud::internal::RetryBudget;
+using LimitedErrorCountRetryPolicyForTest =
+    google::cloud::internal::LimitedErrorCountRetryPolicy<Status,
+                                                          IsRetryablePolicy>;
+using RetryBudgetPolicyForTest =
+    google::cloud::internal::RetryBudgetPolicy<Status, IsRetryablePolicy>;
+
+}  // anonymous namespace
+
+/// @test Verify that retries stop when half the tokens are used.
+TEST(RetryBudget, Simple) {
+  RetryBudget tested(10, 0.5);
+  EXPECT_DOUBLE_EQ(10.0, tested.tokens());
+  for (int i = 0; i != 4; ++i) {
+    EXPECT_TRUE(tested.OnFailure()) << "i=" << i;
+  }
+  EXPECT_FALSE(tested.OnFailure());
+  EXPECT_DOUBLE_EQ(5.0, tested.tokens());
+  EXPECT_FALSE(tested.IsCircuitOpen());
+
+  // Each success deposits half a token.
+  tested.OnSuccess();
+  tested.OnSuccess();
+  tested.OnSuccess();
+  EXPECT_DOUBLE_EQ(6.5, tested.tokens());
+  EXPECT_TRUE(tested.OnFailure());
+  EXPECT_FALSE(tested.OnFailure());
+}
+
+/// @test Verify that successes never fill the budget past its maximum.
+TEST(RetryBudget, MaxTokens) {
+  RetryBudget tested(4, 1.0);
+  for (int i = 0; i != 10; ++i) {
+    tested.OnSuccess();
+  }
+  EXPECT_DOUBLE_EQ(4.0, tested.tokens());
+  for (int i = 0; i != 10; ++i) {
+    tested.OnFailure();
+  }
+  EXPECT_DOUBLE_EQ(0.0, tested.tokens());
+}
+
+/// @test Verify that the circuit breaker opens and closes.
+TEST(RetryBudget, CircuitBreaker) {
+  RetryBudget tested(100, 1.0, 3, std::chrono::milliseconds(20));
+  EXPECT_TRUE(tested.OnFailure());
+  EXPECT_TRUE(tested.OnFailure());
+  EXPECT_FALSE(tested.OnFailure());
+  EXPECT_TRUE(tested.IsCircuitOpen());
+  EXPECT_FALSE(tested.OnFailure());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_FALSE(tested.IsCircuitOpen());
+  EXPECT_TRUE(tested.OnFailure());
+
+  // A success closes the circuit immediately.
+  tested.OnFailure();
+  tested.OnFailure();
+  EXPECT_TRUE(tested.IsCircuitOpen());
+  tested.OnSuccess();
+  EXPECT_FALSE(tested.IsCircuitOpen());
+  EXPECT_TRUE(tested.OnFailure());
+}
+
+/// @test Verify that the policy is limited by both the budget and its policy.
+TEST(RetryBudgetPolicy, Simple) {
+  auto budget = std::make_shared<RetryBudget>(100, 1.0);
+  RetryBudgetPolicyForTest prototype(budget,
+                                     LimitedErrorCountRetryPolicyForTest(2));
+  auto tested = prototype.clone();
+  EXPECT_FALSE(tested->IsExhausted());
+  EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(tested->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(tested->IsExhausted());
+  EXPECT_DOUBLE_EQ(97.0, budget->tokens());
+
+  // Each clone starts with a fresh copy of the wrapped policy.
+  auto other = prototype.clone();
+  EXPECT_FALSE(other->IsExhausted());
+  EXPECT_FALSE(other->OnFailure(CreatePermanentError()));
+  EXPECT_DOUBLE_EQ(97.0, budget->tokens());
+}
+
+/// @test Verify that all the clones share the budget.
+TEST(RetryBudgetPolicy, SharedBudget) {
+  auto budget = std::make_shared<RetryBudget>(4, 1.0);
+  RetryBudgetPolicyForTest prototype(budget,
+                                     LimitedErrorCountRetryPolicyForTest(5));
+  auto p1 = prototype.clone();
+  auto p2 = prototype.clone();
+  EXPECT_TRUE(p1->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(p2->IsExhausted());
+  EXPECT_FALSE(p2->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(p2->IsExhausted());
+  // The budget never prevents the first attempt.
+  auto p3 = prototype.clone();
+  EXPECT_FALSE(p3->IsExhausted());
+}
+
+/// @test Verify that only successful operations deposit tokens.
+TEST(RetryBudgetPolicy, OnSuccess) {
+  auto budget = std::make_shared<RetryBudget>(10, 1.0);
+  RetryBudgetPolicyForTest prototype(budget,
+                                     LimitedErrorCountRetryPolicyForTest(1));
+  {
+    // A failed operation does not deposit any tokens.
+    auto tested = prototype.clone();
+    EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+    EXPECT_FALSE(tested->OnFailure(CreateTransientError()));
+  }
+  EXPECT_DOUBLE_EQ(8.0, budget->tokens());
+  {
+    // An operation abandoned after a retryable failure does not deposit any
+    // tokens either.
+    auto tested = prototype.clone();
+    EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+  }
+  EXPECT_DOUBLE_EQ(7.0, budget->tokens());
+  {
+    // The operation succeeded after retrying.
+    auto tested = prototype.clone();
+    EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+    tested->OnSuccess();
+  }
+  EXPECT_DOUBLE_EQ(7.0, budget->tokens());
+  {
+    // No failures at all.
+    auto tested = prototype.clone();
+    EXPECT_FALSE(tested->IsExhausted());
+    tested->OnSuccess();
+  }
+  EXPECT_DOUBLE_EQ(8.0, budget->tokens());
+}
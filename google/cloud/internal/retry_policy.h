@@ -23,6 +23,9 @@ namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+template <typename StatusType, typename RetryablePolicy>
+class RetryBudgetPolicy;
+
 /**
  * Define the interface for retry policies.
  *
@@ -41,13 +44,25 @@ class RetryPolicy {
     if (RetryablePolicy::IsPermanentFailure(status)) {
       return false;
     }
-    OnFailureImpl();
+    OnFailureImpl(status);
     return !IsExhausted();
   }
   virtual bool IsExhausted() const = 0;
 
+  /**
+   * Record that the operation using this policy completed successfully.
+   *
+   * The retry loops call this function once, when the operation succeeds. The
+   * default implementation does nothing.
+   */
+  virtual void OnSuccess() {}
+
  protected:
-  virtual void OnFailureImpl() = 0;
+  virtual void OnFailureImpl(StatusType const& status) = 0;
+
+ private:
+  // The decorator forwards the failures to the wrapped policy.
+  friend class RetryBudgetPolicy<StatusType, RetryablePolicy>;
 };
 
 /**
@@ -80,7 +95,7 @@ class LimitedErrorCountRetryPolicy
   }
 
  protected:
-  void OnFailureImpl() override { ++failure_count_; }
+  void OnFailureImpl(StatusType const&) override { ++failure_count_; }
 
  private:
   int failure_count_;
@@ -139,7 +154,7 @@ class LimitedTimeRetryPolicy : public RetryPolicy<StatusType, RetryablePolicy> {
   std::chrono::system_clock::time_point deadline() const { return deadline_; }
 
  protected:
-  void OnFailureImpl() override {}
+  void OnFailureImpl(StatusType const&) override {}
 
  private:
   std::chrono::milliseconds maximum_duration_;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/log.h"
+#include "google/cloud/async_log_backend.h"
 
 namespace google {
 namespace cloud {
@@ -42,7 +43,8 @@ LogSink::LogSink()
     : empty_(true),
       minimum_severity_(static_cast<int>(Severity::GCP_LS_LOWEST_ENABLED)),
       next_id_(0),
-      clog_backend_id_(0) {}
+      clog_backend_id_(0),
+      backends_(std::make_shared<BackendMap>()) {}
 
 LogSink& LogSink::Instance() {
   static LogSink instance;
@@ -61,36 +63,34 @@ void LogSink::RemoveBackend(long id) {
 
 void LogSink::ClearBackends() {
   std::unique_lock<std::mutex> lk(mu_);
-  backends_.clear();
+  std::atomic_store(&backends_, std::make_shared<BackendMap const>());
   clog_backend_id_ = 0;
-  empty_.store(backends_.empty());
+  empty_.store(true);
 }
 
 std::size_t LogSink::BackendCount() const {
-  std::unique_lock<std::mutex> lk(mu_);
-  return backends_.size();
+  return std::atomic_load(&backends_)->size();
 }
 
 void LogSink::Log(LogRecord log_record) {
-  // Make a copy of the backends because calling user-defined functions while
-  // holding a lock is a bad idea: the application may change the backends while
-  // we are holding this lock, and soon deadlock occurs.
-  auto copy = [this]() {
-    std::unique_lock<std::mutex> lk(mu_);
-    return backends_;
-  }();
-  if (copy.empty()) {
+  // Calling user-defined functions while holding a lock is a bad idea: the
+  // application may change the backends from the callback, and soon deadlock
+  // occurs. The backends are never modified in place, so holding a reference
+  // to the current map is enough, and the logging threads do not serialize on
+  // `mu_`.
+  auto copy = std::atomic_load(&backends_);
+  if (copy->empty()) {
     return;
   }
   // In general, we just give each backend a const-reference and the backends
   // must make a copy if needed.  But if there is only one backend we can give
   // the backend an opportunity to optimize things by transferring ownership of
   // the LogRecord to it.
-  if (1U == copy.size()) {
-    copy.begin()->second->ProcessWithOwnership(std::move(log_record));
+  if (1U == copy->size()) {
+    copy->begin()->second->ProcessWithOwnership(std::move(log_record));
     return;
   }
-  for (auto& kv : copy) {
+  for (auto& kv : *copy) {
     kv.second->Process(log_record);
   }
 }
@@ -110,12 +110,16 @@ class StdClogBackend : public LogBackend {
 };
 }  // namespace
 
-void LogSink::EnableStdClogImpl() {
+void LogSink::EnableStdClogImpl(bool async) {
   std::unique_lock<std::mutex> lk(mu_);
   if (clog_backend_id_ != 0) {
     return;
   }
-  clog_backend_id_ = AddBackendImpl(std::make_shared<StdClogBackend>());
+  std::shared_ptr<LogBackend> backend = std::make_shared<StdClogBackend>();
+  if (async) {
+    backend = std::make_shared<AsyncLogBackend>(std::move(backend));
+  }
+  clog_backend_id_ = AddBackendImpl(std::move(backend));
 }
 
 void LogSink::DisableStdClogImpl() {
@@ -129,18 +133,23 @@ void LogSink::DisableStdClogImpl() {
 
 long LogSink::AddBackendImpl(std::shared_ptr<LogBackend> backend) {
   long id = ++next_id_;
-  backends_.emplace(id, std::move(backend));
-  empty_.store(backends_.empty());
+  auto backends = std::make_shared<BackendMap>(*backends_);
+  backends->emplace(id, std::move(backend));
+  empty_.store(backends->empty());
+  std::atomic_store(&backends_,
+                    std::shared_ptr<BackendMap const>(std::move(backends)));
   return id;
 }
 
 void LogSink::RemoveBackendImpl(long id) {
-  auto it = backends_.find(id);
-  if (backends_.end() == it) {
+  if (backends_->find(id) == backends_->end()) {
     return;
   }
-  backends_.erase(it);
-  empty_.store(backends_.empty());
+  auto backends = std::make_shared<BackendMap>(*backends_);
+  backends->erase(id);
+  empty_.store(backends->empty());
+  std::atomic_store(&backends_,
+                    std::shared_ptr<BackendMap const>(std::move(backends)));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -298,23 +298,42 @@ class LogSink {
   void Log(LogRecord log_record);
 
   /// Enable `std::clog` on `LogSink::Instance()`.
-  static void EnableStdClog() { Instance().EnableStdClogImpl(); }
+  static void EnableStdClog() { Instance().EnableStdClogImpl(false); }
+
+  /**
+   * Enable `std::clog` on `LogSink::Instance()`, writing from a background
+   * thread.
+   *
+   * The threads logging do not wait for (or serialize on) `std::clog`. Log
+   * records are dropped if they are produced faster than they can be written.
+   *
+   * @see AsyncLogBackend
+   */
+  static void EnableAsyncStdClog() { Instance().EnableStdClogImpl(true); }
 
   /// Disable `std::clog` on `LogSink::Instance()`.
   static void DisableStdClog() { Instance().DisableStdClogImpl(); }
 
  private:
-  void EnableStdClogImpl();
+  void EnableStdClogImpl(bool async);
   void DisableStdClogImpl();
   long AddBackendImpl(std::shared_ptr<LogBackend> backend);
   void RemoveBackendImpl(long id);
 
   std::atomic<bool> empty_;
   std::atomic<int> minimum_severity_;
+  using BackendMap = std::map<long, std::shared_ptr<LogBackend>>;
+
   std::mutex mutable mu_;
   long next_id_;
   long clog_backend_id_;
-  std::map<long, std::shared_ptr<LogBackend>> backends_;
+  /**
+   * The current backends.
+   *
+   * The map is never modified, changes replace it with a new map. `Log()`
+   * reads it with `std::atomic_load()`, without blocking on `mu_`.
+   */
+  std::shared_ptr<BackendMap const> backends_;
 };
 
 /**
@@ -136,6 +136,20 @@ TEST(LogSinkTest, ClogMultiple) {
   EXPECT_EQ(0U, LogSink::Instance().BackendCount());
 }
 
+TEST(LogSinkTest, LogToAsyncClog) {
+  LogSink::EnableAsyncStdClog();
+  EXPECT_FALSE(LogSink::Instance().empty());
+  EXPECT_EQ(1U, LogSink::Instance().BackendCount());
+  // Only one std::clog backend, synchronous or not, is enabled.
+  LogSink::EnableStdClog();
+  EXPECT_EQ(1U, LogSink::Instance().BackendCount());
+  LogSink::Instance().set_minimum_severity(Severity::GCP_LS_NOTICE);
+  GCP_LOG(NOTICE) << "test message";
+  LogSink::DisableStdClog();
+  EXPECT_TRUE(LogSink::Instance().empty());
+  EXPECT_EQ(0U, LogSink::Instance().BackendCount());
+}
+
 
 namespace {
 /// A class to count calls to IOStream operator.
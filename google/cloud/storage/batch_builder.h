@@ -0,0 +1,137 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_BUILDER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_BUILDER_H_
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Collects object metadata operations and executes them as batch requests.
+ *
+ * Many small metadata operations (deleting objects, fetching or patching their
+ * metadata) are dominated by the round-trip time to the service. This class
+ * sends up to 100 operations in each HTTP request, using the [batch endpoint].
+ * Larger batches are split into multiple requests.
+ *
+ * Each operation succeeds or fails independently, `Execute()` returns one
+ * result for each operation, in the order they were added. Operations that
+ * fail with a transient error are retried (in a new batch) if they are
+ * idempotent, using the retry and backoff policies of the client.
+ *
+ * [batch endpoint]:
+ * https://cloud.google.com/storage/docs/json_api/v1/how-tos/batch
+ *
+ * @par Example
+ * @code
+ * auto batch = client.Batch();
+ * batch.DeleteObject("my-bucket", "object-1", gcs::Generation(generation));
+ * batch.GetObjectMetadata("my-bucket", "object-2");
+ * StatusOr<std::vector<StatusOr<gcs::ObjectMetadata>>> results =
+ *     batch.Execute();
+ * @endcode
+ */
+class BatchBuilder {
+ public:
+  explicit BatchBuilder(std::shared_ptr<internal::RawClient> client)
+      : client_(std::move(client)) {}
+
+  /**
+   * Adds an operation to delete an object.
+   *
+   * The result for this operation contains an empty `ObjectMetadata` on
+   * success.
+   *
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `Generation`,
+   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, and `UserProject`.
+   */
+  template <typename... Options>
+  BatchBuilder& DeleteObject(std::string const& bucket_name,
+                             std::string const& object_name,
+                             Options&&... options) {
+    internal::DeleteObjectRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    request_.AddOperation(std::move(request));
+    return *this;
+  }
+
+  /**
+   * Adds an operation to fetch the metadata of an object.
+   *
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `Generation`,
+   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `Projection`, and `UserProject`.
+   */
+  template <typename... Options>
+  BatchBuilder& GetObjectMetadata(std::string const& bucket_name,
+                                  std::string const& object_name,
+                                  Options&&... options) {
+    internal::GetObjectMetadataRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    request_.AddOperation(std::move(request));
+    return *this;
+  }
+
+  /**
+   * Adds an operation to patch the metadata of an object.
+   *
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `PredefinedAcl`,
+   *     `PredefinedDefaultObjectAcl`, `Projection`, and `UserProject`.
+   */
+  template <typename... Options>
+  BatchBuilder& PatchObject(std::string const& bucket_name,
+                            std::string const& object_name,
+                            ObjectMetadataPatchBuilder const& builder,
+                            Options&&... options) {
+    internal::PatchObjectRequest request(bucket_name, object_name, builder);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    request_.AddOperation(std::move(request));
+    return *this;
+  }
+
+  /// The number of operations added so far.
+  std::size_t size() const { return request_.size(); }
+
+  /**
+   * Executes all the operations added so far.
+   *
+   * @return an error if the batch could not be executed at all, otherwise
+   *     the result of each operation, in the order they were added.
+   */
+  StatusOr<std::vector<StatusOr<ObjectMetadata>>> Execute();
+
+ private:
+  std::shared_ptr<internal::RawClient> client_;
+  internal::BatchRequest request_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_BUILDER_H_
@@ -55,6 +55,13 @@ run_example ./storage_throughput_benchmark \
       --object-count=8 \
       --object-chunk-count=10 \
       "${FAKE_REGION}"
+run_example ./storage_throughput_benchmark \
+      --enable-adaptive-download-buffer=true \
+      --download-buffer-size=1048576 \
+      --duration=5 \
+      --object-count=8 \
+      --object-chunk-count=10 \
+      "${FAKE_REGION}"
 
 if [ "${EXIT_STATUS}" = "0" ]; then
   TESTBENCH_DUMP_LOG=no
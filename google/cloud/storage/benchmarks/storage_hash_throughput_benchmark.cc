@@ -0,0 +1,233 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/version.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * A micro-benchmark for the hash validation in streaming downloads.
+ *
+ * This program simulates a single download stream: it "receives" the data by
+ * copying it into a buffer, optionally throttled to a given network speed, and
+ * then feeds each chunk to a `HashValidator`, just like `ObjectReadStream`
+ * does. It reports the throughput for several validator configurations:
+ *
+ * - `none`: no hashes, the baseline for the simulated transfer.
+ * - `crc32c`: only the CRC32C checksum.
+ * - `md5`: only the MD5 hash.
+ * - `both-inline`: CRC32C and MD5 in the receiving thread.
+ * - `both-pipelined`: CRC32C inline, MD5 in a background thread, the
+ *   configuration used by the client library for streaming transfers.
+ *
+ * When `both-pipelined` matches `none` (or `crc32c`) the hash computation is
+ * no longer the bottleneck for a single stream.
+ *
+ * No network access or GCP credentials are needed to run this benchmark.
+ */
+
+namespace {
+namespace gcs = google::cloud::storage;
+
+constexpr long kMiB = 1024 * 1024;
+constexpr long kDefaultObjectSize = 512 * kMiB;
+constexpr long kDefaultChunkSize = 128 * 1024;
+constexpr int kDefaultIterationCount = 3;
+
+struct Options {
+  long object_size;
+  long chunk_size;
+  long network_mibps;
+  int iteration_count;
+
+  Options()
+      : object_size(kDefaultObjectSize),
+        chunk_size(kDefaultChunkSize),
+        network_mibps(0),
+        iteration_count(kDefaultIterationCount) {}
+
+  void ParseArgs(int argc, char* argv[]);
+};
+
+using ValidatorFactory =
+    std::function<std::unique_ptr<gcs::internal::HashValidator>()>;
+
+struct Configuration {
+  char const* name;
+  ValidatorFactory factory;
+};
+
+std::vector<Configuration> MakeConfigurations();
+
+std::chrono::microseconds RunOnce(Options const& options,
+                                  std::string const& source,
+                                  ValidatorFactory const& factory);
+
+}  // namespace
+
+int main(int argc, char* argv[]) try {
+  Options options;
+  options.ParseArgs(argc, argv);
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  // Random data defeats any shortcut in the copy or hash functions.
+  std::string const source = google::cloud::internal::Sample(
+      generator, static_cast<int>(options.chunk_size),
+      "abcdefghijklmnopqrstuvwxyz"
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+      "0123456789");
+
+  std::string notes = gcs::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Object Size: " << options.object_size
+            << "\n# Chunk Size: " << options.chunk_size
+            << "\n# Simulated Network MiB/s: " << options.network_mibps
+            << "\n# Iteration Count: " << options.iteration_count
+            << "\n# Hardware Concurrency: "
+            << std::thread::hardware_concurrency()
+            << "\n# Build info: " << notes << std::endl;
+
+  std::cout << "Configuration,Bytes,ElapsedMicroseconds,MiBs" << std::endl;
+  for (auto const& config : MakeConfigurations()) {
+    for (int i = 0; i != options.iteration_count; ++i) {
+      auto elapsed = RunOnce(options, source, config.factory);
+      double mibs = static_cast<double>(options.object_size) / kMiB /
+                    (static_cast<double>(elapsed.count()) / 1000000.0);
+      std::cout << config.name << "," << options.object_size << ","
+                << elapsed.count() << "," << mibs << std::endl;
+    }
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
+
+namespace {
+void Options::ParseArgs(int argc, char* argv[]) {
+  auto usage = [argv] {
+    return std::string("Usage: ") + argv[0] +
+           " [--object-size=N] [--chunk-size=N] [--network-mibps=N]"
+           " [--iteration-count=N]";
+  };
+  long iterations = iteration_count;
+  for (int i = 1; i != argc; ++i) {
+    std::string arg = argv[i];
+    auto parse = [&arg](std::string const& prefix, long& value) {
+      if (arg.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+      }
+      value = std::stol(arg.substr(prefix.size()));
+      return true;
+    };
+    if (parse("--object-size=", object_size) ||
+        parse("--chunk-size=", chunk_size) ||
+        parse("--network-mibps=", network_mibps) ||
+        parse("--iteration-count=", iterations)) {
+      continue;
+    }
+    throw std::runtime_error("Unknown argument " + arg + "\n" + usage());
+  }
+  iteration_count = static_cast<int>(iterations);
+  if (object_size <= 0 || chunk_size <= 0 || network_mibps < 0 ||
+      iteration_count <= 0) {
+    throw std::runtime_error("Invalid argument value\n" + usage());
+  }
+}
+
+std::vector<Configuration> MakeConfigurations() {
+  using google::cloud::internal::make_unique;
+  using gcs::internal::CompositeValidator;
+  using gcs::internal::Crc32cHashValidator;
+  using gcs::internal::HashValidator;
+  using gcs::internal::MD5HashValidator;
+  using gcs::internal::NullHashValidator;
+  using gcs::internal::PipelinedHashValidator;
+  // Match the thresholds used by the client library.
+  std::size_t const min_background_bytes = kMiB / 4;
+
+  return {
+      {"none",
+       [] {
+         return std::unique_ptr<HashValidator>(new NullHashValidator);
+       }},
+      {"crc32c",
+       [] {
+         return std::unique_ptr<HashValidator>(new Crc32cHashValidator);
+       }},
+      {"md5",
+       [] { return std::unique_ptr<HashValidator>(new MD5HashValidator); }},
+      {"both-inline",
+       [] {
+         return std::unique_ptr<HashValidator>(new CompositeValidator(
+             make_unique<Crc32cHashValidator>(),
+             make_unique<MD5HashValidator>()));
+       }},
+      {"both-pipelined",
+       [=] {
+         return std::unique_ptr<HashValidator>(new CompositeValidator(
+             make_unique<Crc32cHashValidator>(),
+             make_unique<PipelinedHashValidator>(
+                 make_unique<MD5HashValidator>(), min_background_bytes)));
+       }},
+  };
+}
+
+std::chrono::microseconds RunOnce(Options const& options,
+                                  std::string const& source,
+                                  ValidatorFactory const& factory) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  auto const start = std::chrono::steady_clock::now();
+
+  auto validator = factory();
+  std::vector<char> buffer(static_cast<std::size_t>(options.chunk_size));
+  long received = 0;
+  while (received < options.object_size) {
+    auto n = static_cast<std::size_t>(
+        (std::min)(options.chunk_size, options.object_size - received));
+    // Simulate the transfer, data arrives at the configured speed, and libcurl
+    // copies it into the application buffer.
+    if (options.network_mibps != 0) {
+      auto const arrival =
+          start + microseconds((received + static_cast<long>(n)) * 1000000 /
+                               (options.network_mibps * kMiB));
+      std::this_thread::sleep_until(arrival);
+    }
+    std::memcpy(buffer.data(), source.data(), n);
+    validator->Update(buffer.data(), n);
+    received += static_cast<long>(n);
+  }
+  // Include the time to wait for any background work.
+  (void)std::move(*validator).Finish();
+  return duration_cast<microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+}  // namespace
@@ -0,0 +1,251 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/internal/object_metadata_stream_parser.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/version.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file
+ *
+ * A micro-benchmark for the parsing of `Objects: list` responses.
+ *
+ * This program parses the same `Objects: list` pages many times and reports
+ * the throughput (objects per second) for each parser:
+ *
+ * - `dom`: parse the page into a `nl::json` object, then copy each item into
+ *   `ObjectMetadata`, the original implementation.
+ * - `stream`: use the SAX-based `ObjectMetadataStreamParser`, the
+ *   implementation used by the client library.
+ *
+ * The pages can be recorded responses (one file per page, use `--page-file`
+ * multiple times), or synthetic pages with the same fields as the responses
+ * returned by the service.
+ *
+ * No network access or GCP credentials are needed to run this benchmark.
+ */
+
+namespace {
+namespace gcs = google::cloud::storage;
+
+constexpr int kDefaultObjectsPerPage = 1000;
+constexpr int kDefaultPageCount = 10;
+constexpr int kDefaultIterationCount = 3;
+
+struct Options {
+  int objects_per_page;
+  int page_count;
+  int iteration_count;
+  std::vector<std::string> page_files;
+
+  Options()
+      : objects_per_page(kDefaultObjectsPerPage),
+        page_count(kDefaultPageCount),
+        iteration_count(kDefaultIterationCount) {}
+
+  void ParseArgs(int argc, char* argv[]);
+};
+
+using Parser = std::function<std::size_t(std::string const&)>;
+
+struct Configuration {
+  char const* name;
+  Parser parser;
+};
+
+std::vector<Configuration> MakeConfigurations();
+
+std::vector<std::string> LoadPages(Options const& options);
+
+}  // namespace
+
+int main(int argc, char* argv[]) try {
+  Options options;
+  options.ParseArgs(argc, argv);
+
+  auto const pages = LoadPages(options);
+
+  std::string notes = gcs::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Page Count: " << pages.size()
+            << "\n# Recorded Pages: " << options.page_files.size()
+            << "\n# Objects per Synthetic Page: " << options.objects_per_page
+            << "\n# Iteration Count: " << options.iteration_count
+            << "\n# Build info: " << notes << std::endl;
+
+  std::cout << "Parser,Objects,Bytes,ElapsedMicroseconds,ObjectsPerSecond"
+            << std::endl;
+  for (auto const& config : MakeConfigurations()) {
+    for (int i = 0; i != options.iteration_count; ++i) {
+      using std::chrono::duration_cast;
+      using std::chrono::microseconds;
+      auto const start = std::chrono::steady_clock::now();
+      std::size_t objects = 0;
+      std::size_t bytes = 0;
+      for (auto const& page : pages) {
+        objects += config.parser(page);
+        bytes += page.size();
+      }
+      auto const elapsed = duration_cast<microseconds>(
+          std::chrono::steady_clock::now() - start);
+      double rate = static_cast<double>(objects) /
+                    (static_cast<double>(elapsed.count()) / 1000000.0);
+      std::cout << config.name << "," << objects << "," << bytes << ","
+                << elapsed.count() << "," << rate << std::endl;
+    }
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
+
+namespace {
+void Options::ParseArgs(int argc, char* argv[]) {
+  auto usage = [argv] {
+    return std::string("Usage: ") + argv[0] +
+           " [--objects-per-page=N] [--page-count=N] [--iteration-count=N]"
+           " [--page-file=FILENAME]...";
+  };
+  for (int i = 1; i != argc; ++i) {
+    std::string arg = argv[i];
+    auto parse = [&arg](std::string const& prefix, int& value) {
+      if (arg.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+      }
+      value = std::stoi(arg.substr(prefix.size()));
+      return true;
+    };
+    if (parse("--objects-per-page=", objects_per_page) ||
+        parse("--page-count=", page_count) ||
+        parse("--iteration-count=", iteration_count)) {
+      continue;
+    }
+    std::string const page_file = "--page-file=";
+    if (arg.compare(0, page_file.size(), page_file) == 0) {
+      page_files.push_back(arg.substr(page_file.size()));
+      continue;
+    }
+    throw std::runtime_error("Unknown argument " + arg + "\n" + usage());
+  }
+  if (objects_per_page <= 0 || page_count <= 0 || iteration_count <= 0) {
+    throw std::runtime_error("Invalid argument value\n" + usage());
+  }
+}
+
+std::vector<Configuration> MakeConfigurations() {
+  return {
+      {"dom",
+       [](std::string const& page) {
+         auto json = gcs::internal::nl::json::parse(page);
+         std::vector<gcs::ObjectMetadata> items;
+         for (auto const& kv : json["items"].items()) {
+           items.emplace_back(
+               gcs::internal::ObjectMetadataParser::FromJson(kv.value())
+                   .value());
+         }
+         return items.size();
+       }},
+      {"stream",
+       [](std::string const& page) {
+         return gcs::internal::ObjectMetadataStreamParser::ParseList(page)
+             .value()
+             .items.size();
+       }},
+  };
+}
+
+std::string MakeSyntheticPage(Options const& options, int page,
+                              google::cloud::internal::DefaultPRNG& gen) {
+  std::ostringstream os;
+  os << R"""({"kind": "storage#objects", "nextPageToken": ")"""
+     << google::cloud::internal::Sample(gen, 64, "abcdefghijklmnopqrstuvwxyz")
+     << R"""(", "items": [)""";
+  char const* sep = "";
+  for (int i = 0; i != options.objects_per_page; ++i) {
+    auto name = "some/prefix/" + std::to_string(page) + "/object-" +
+                google::cloud::internal::Sample(
+                    gen, 16, "abcdefghijklmnopqrstuvwxyz0123456789");
+    auto generation = std::to_string(1500000000000000L + page * 100000L + i);
+    os << sep << R"""({
+    "kind": "storage#object",
+    "id": "test-bucket/)"""
+       << name << "/" << generation << R"""(",
+    "selfLink": "https://www.googleapis.com/storage/v1/b/test-bucket/o/)"""
+       << name << R"""(",
+    "name": ")"""
+       << name << R"""(",
+    "bucket": "test-bucket",
+    "generation": ")"""
+       << generation << R"""(",
+    "metageneration": "1",
+    "contentType": "application/octet-stream",
+    "timeCreated": "2019-02-01T12:34:56.789Z",
+    "updated": "2019-02-01T12:34:56.789Z",
+    "storageClass": "STANDARD",
+    "timeStorageClassUpdated": "2019-02-01T12:34:56.789Z",
+    "size": ")"""
+       << (i * 1024) << R"""(",
+    "md5Hash": "1B2M2Y8AsgTpgAmY7PhCfg==",
+    "mediaLink": ")"""
+       << "https://www.googleapis.com/download/storage/v1/b/test-bucket/o/"
+       << name << "?generation=" << generation << R"""(&alt=media",
+    "metadata": {"origin": "benchmark", "page": ")"""
+       << page << R"""("},
+    "crc32c": "AAAAAA==",
+    "etag": "CJDUpe2Y1+ACEAE="
+  })""";
+    sep = ", ";
+  }
+  os << "]}";
+  return std::move(os).str();
+}
+
+std::vector<std::string> LoadPages(Options const& options) {
+  std::vector<std::string> pages;
+  for (auto const& filename : options.page_files) {
+    std::ifstream is(filename);
+    if (!is.is_open()) {
+      throw std::runtime_error("Cannot open page file " + filename);
+    }
+    pages.emplace_back(std::istreambuf_iterator<char>{is},
+                       std::istreambuf_iterator<char>{});
+  }
+  if (!pages.empty()) {
+    return pages;
+  }
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  for (int i = 0; i != options.page_count; ++i) {
+    pages.emplace_back(MakeSyntheticPage(options, i, generator));
+  }
+  return pages;
+}
+
+}  // namespace
@@ -57,6 +57,11 @@
  * Then the program removes all the objects in the bucket and reports the time
  * taken to delete each one.
  *
+ * The `--download-buffer-size` and `--enable-adaptive-download-buffer` options
+ * configure the buffers used in the downloads. To compare the adaptive buffers
+ * against fixed buffer sizes run the program once with each configuration and
+ * use `storage_throughput_compare.R` to compare the results.
+ *
  * A helper script in this directory can generate pretty graphs from the report.
  */
 
@@ -78,6 +83,8 @@ struct Options {
   int object_chunk_count;
   bool enable_connection_pool;
   bool enable_xml_api;
+  long download_buffer_size;
+  bool enable_adaptive_download_buffer;
 
   Options()
       : duration(kDefaultDuration),
@@ -85,7 +92,9 @@ struct Options {
         thread_count(1),
         object_chunk_count(kDefaultObjectChunkCount),
         enable_connection_pool(true),
-        enable_xml_api(true) {}
+        enable_xml_api(true),
+        download_buffer_size(0),
+        enable_adaptive_download_buffer(false) {}
 
   void ParseArgs(int& argc, char* argv[]);
   std::string ConsumeArg(int& argc, char* argv[], char const* arg_name);
@@ -141,6 +150,13 @@ int main(int argc, char* argv[]) try {
   if (!options.enable_connection_pool) {
     client_options->set_connection_pool_size(0);
   }
+  if (options.download_buffer_size != 0) {
+    client_options->SetDownloadBufferSize(
+        static_cast<std::size_t>(options.download_buffer_size));
+  }
+  client_options->set_enable_adaptive_download_buffer(
+      options.enable_adaptive_download_buffer);
+  auto const download_buffer_size = client_options->download_buffer_size();
   gcs::Client client(*std::move(client_options));
 
   google::cloud::internal::DefaultPRNG generator =
@@ -171,6 +187,9 @@ int main(int argc, char* argv[]) try {
             << "\n# Thread Count: " << options.thread_count
             << "\n# Enable connection pool: " << options.enable_connection_pool
             << "\n# Enable XML API: " << options.enable_xml_api
+            << "\n# Download Buffer Size: " << download_buffer_size
+            << "\n# Enable Adaptive Download Buffer: "
+            << options.enable_adaptive_download_buffer
             << "\n# Build info: " << notes << std::endl;
 
   std::vector<std::string> object_names =
@@ -515,6 +534,9 @@ std::string Options::ConsumeArg(int& argc, char* argv[], char const* arg_name) {
   std::string const thread_count = "--thread-count=";
   std::string const enable_connection_pool = "--enable-connection-pool=";
   std::string const enable_xml_api = "--enable-xml-api=";
+  std::string const download_buffer_size = "--download-buffer-size=";
+  std::string const enable_adaptive_download_buffer =
+      "--enable-adaptive-download-buffer=";
 
   std::string const usage = R""(
 [options] <region>
@@ -526,6 +548,10 @@ The options are:
     --thread-count: the number of threads to use in the benchmark.
     --enable-connection-pool: reuse connections across requests.
     --enable-xml-api: configure read+write operations to use XML API.
+    --download-buffer-size: the buffer size for downloads, in bytes. With
+       adaptive buffers this is the maximum size.
+    --enable-adaptive-download-buffer: adjust the download buffer size to the
+       observed throughput and latency.
 
     region: a Google Cloud Storage region where all the objects used in this
        test will be located.
@@ -585,6 +611,25 @@ The options are:
         error = "Invalid enable-xml-api argument (" + arg + ")";
         break;
       }
+    } else if (0 == argument.rfind(download_buffer_size, 0)) {
+      auto arg = argument.substr(download_buffer_size.size());
+      auto val = std::stol(arg);
+      if (val <= 0) {
+        error = "Invalid download-buffer-size argument (" + arg + ")";
+        break;
+      }
+      this->download_buffer_size = val;
+    } else if (0 == argument.rfind(enable_adaptive_download_buffer, 0)) {
+      auto arg = argument.substr(enable_adaptive_download_buffer.size());
+      if (arg == "true" or arg == "yes" or arg == "1") {
+        this->enable_adaptive_download_buffer = true;
+      } else if (arg == "false" or arg == "no" or arg == "0") {
+        this->enable_adaptive_download_buffer = false;
+      } else {
+        error = "Invalid enable-adaptive-download-buffer argument (" + arg +
+                ")";
+        break;
+      }
     } else {
       return argument;
     }
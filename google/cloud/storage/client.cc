@@ -14,13 +14,19 @@
 
 #include "google/cloud/storage/client.h"
 #include "google/cloud/internal/filesystem.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/log.h"
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/internal/metrics_client.h"
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
+#include <crc32c/crc32c.h>
 #include <openssl/md5.h>
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <thread>
 
 namespace google {
@@ -34,7 +40,13 @@ static_assert(std::is_copy_assignable<storage::Client>::value,
 
 std::shared_ptr<internal::RawClient> Client::CreateDefaultInternalClient(
     ClientOptions options) {
-  return internal::CurlClient::Create(std::move(options));
+  auto metrics = options.metrics();
+  auto client = internal::CurlClient::Create(std::move(options));
+  if (!metrics) {
+    return client;
+  }
+  return std::make_shared<internal::MetricsClient>(std::move(client),
+                                                   std::move(metrics));
 }
 
 StatusOr<Client> Client::CreateDefaultClient() {
@@ -100,6 +112,18 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
   // class checks before calling it.
   std::uint64_t source_size = google::cloud::internal::file_size(file_name);
 
+  // Restored sessions must continue using a single stream, parallel uploads
+  // only make sense for regular files, which have a well defined size.
+  bool const restore_session =
+      request.HasOption<UseResumableUploadSession>() &&
+      !request.GetOption<UseResumableUploadSession>().value().empty();
+  if (is_regular(status) && !restore_session &&
+      request.HasOption<ParallelUploadShards>() &&
+      request.GetOption<ParallelUploadShards>().value() > 1 &&
+      source_size > 1) {
+    return UploadFileParallel(file_name, source_size, request);
+  }
+
   return UploadStreamResumable(source, source_size, request);
 }
 
@@ -152,8 +176,350 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
   return internal::ObjectMetadataParser::FromString(upload_response->payload);
 }
 
+namespace {
+// GCS limits the number of source objects in a single compose request.
+constexpr std::size_t kMaxComposeSources = 32;
+
+/// Computes the CRC32C checksum of the [begin, end) range of a file.
+StatusOr<std::uint32_t> ComputeFileCrc32c(std::string const& file_name,
+                                          std::uint64_t begin,
+                                          std::uint64_t end,
+                                          std::size_t buffer_size) {
+  std::ifstream is(file_name, std::ios::binary);
+  if (!is.is_open()) {
+    return Status(StatusCode::kNotFound, "cannot open source file");
+  }
+  is.seekg(begin, std::ios::beg);
+  std::uint32_t checksum = 0;
+  std::string buffer(buffer_size, '\0');
+  for (std::uint64_t offset = begin; offset < end;) {
+    auto const count = static_cast<std::size_t>(
+        (std::min)(static_cast<std::uint64_t>(buffer.size()), end - offset));
+    is.read(&buffer[0], count);
+    if (static_cast<std::size_t>(is.gcount()) != count) {
+      return Status(StatusCode::kDataLoss, "short read from source file");
+    }
+    checksum = crc32c::Extend(
+        checksum, reinterpret_cast<std::uint8_t const*>(buffer.data()), count);
+    offset += count;
+  }
+  return checksum;
+}
+
+/// The result of uploading one shard in a parallel upload.
+struct UploadedShard {
+  std::uint32_t crc32c;
+  std::int64_t generation;
+};
+
+/**
+ * Uploads the [begin, end) range of a file into a (temporary) object.
+ *
+ * If @p resume is true, and the object already exists, and it contains the
+ * same data as the local file, the upload is skipped. This allows applications
+ * to resume a parallel upload that was interrupted.
+ */
+StatusOr<UploadedShard> UploadFileShard(
+    internal::RawClient& client,
+    internal::ResumableUploadRequest const& request,
+    std::string const& file_name, std::uint64_t begin, std::uint64_t end,
+    bool resume) {
+  auto const shard_size = end - begin;
+  auto const buffer_size = internal::UploadChunkRequest::RoundUpToQuantum(
+      client.client_options().upload_buffer_size());
+
+  StatusOr<ObjectMetadata> existing(
+      Status(StatusCode::kNotFound, "resume not requested"));
+  if (resume) {
+    internal::GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                                        request.object_name());
+    metadata_request.set_multiple_options(request.GetOption<EncryptionKey>(),
+                                          request.GetOption<UserProject>());
+    existing = client.GetObjectMetadata(metadata_request);
+  }
+  if (existing && existing->size() == shard_size) {
+    auto checksum = ComputeFileCrc32c(file_name, begin, end, buffer_size);
+    if (!checksum) {
+      return std::move(checksum).status();
+    }
+    if (existing->crc32c() == internal::FormatCrc32cChecksum(*checksum)) {
+      return UploadedShard{*checksum, existing->generation()};
+    }
+  }
+
+  std::ifstream is(file_name, std::ios::binary);
+  if (!is.is_open()) {
+    return Status(StatusCode::kNotFound, "cannot open source file");
+  }
+
+  auto session = client.CreateResumableSession(request);
+  if (!session) {
+    return std::move(session).status();
+  }
+
+  std::uint32_t checksum = 0;
+  std::string buffer;
+  StatusOr<internal::ResumableUploadResponse> response(
+      internal::ResumableUploadResponse{});
+  while (response->payload.empty()) {
+    auto const offset = (*session)->next_expected_byte();
+    if (offset > shard_size) {
+      return Status(StatusCode::kInternal,
+                    "the service committed more bytes than the shard size");
+    }
+    buffer.resize(static_cast<std::size_t>(
+        (std::min)(static_cast<std::uint64_t>(buffer_size),
+                   shard_size - offset)));
+    is.seekg(begin + offset, std::ios::beg);
+    is.read(&buffer[0], buffer.size());
+    if (static_cast<std::size_t>(is.gcount()) != buffer.size()) {
+      return Status(StatusCode::kDataLoss, "short read from source file");
+    }
+    response = (*session)->UploadChunk(buffer, shard_size);
+    if (!response) {
+      return std::move(response).status();
+    }
+    // Only the bytes committed by the service are part of the checksum, any
+    // other bytes are sent again in the next iteration.
+    auto const committed =
+        response->payload.empty()
+            ? (std::max)((*session)->next_expected_byte(), offset) - offset
+            : buffer.size();
+    checksum = crc32c::Extend(
+        checksum, reinterpret_cast<std::uint8_t const*>(buffer.data()),
+        static_cast<std::size_t>(committed));
+  }
+
+  auto metadata =
+      internal::ObjectMetadataParser::FromString(response->payload);
+  if (!metadata) {
+    return std::move(metadata).status();
+  }
+  return UploadedShard{checksum, metadata->generation()};
+}
+}  // namespace
+
+StatusOr<ObjectMetadata> Client::UploadFileParallel(
+    std::string const& file_name, std::uint64_t file_size,
+    internal::ResumableUploadRequest const& request) {
+  auto report_error = [&](char const* func, Status const& status,
+                          char const* what) {
+    std::ostringstream msg;
+    msg << func << "(" << request << ", " << file_name << "): " << what
+        << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  // The compose API cannot honor these options, reject them instead of
+  // silently ignoring them.
+  if (request.HasOption<IfGenerationNotMatch>() ||
+      request.HasOption<IfMetagenerationNotMatch>() ||
+      request.HasOption<Projection>()) {
+    return report_error(
+        __func__, Status(StatusCode::kInvalidArgument, "unsupported option"),
+        "IfGenerationNotMatch, IfMetagenerationNotMatch, and Projection are "
+        "not supported in parallel uploads");
+  }
+
+  auto const shard_count = static_cast<std::uint64_t>(
+      (std::min)(static_cast<std::uint64_t>(
+                     request.GetOption<ParallelUploadShards>().value()),
+                 file_size));
+  auto const shard_size = (file_size + shard_count - 1) / shard_count;
+
+  // Only uploads with an application-provided id can be resumed. Otherwise
+  // the temporary object names use a random id, so concurrent uploads of the
+  // same object never share them.
+  bool const resumable = !request.GetOption<ParallelUploadId>()
+                              .value_or(std::string{})
+                              .empty();
+  std::string upload_id;
+  if (resumable) {
+    upload_id = request.GetOption<ParallelUploadId>().value();
+  } else {
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    upload_id = google::cloud::internal::Sample(
+        generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789");
+  }
+  auto const prefix = request.object_name() + ".upload_" + upload_id;
+  auto shard_name = [&](std::uint64_t index) {
+    std::ostringstream os;
+    os << prefix << "_shard_" << index << "_of_" << shard_count;
+    return std::move(os).str();
+  };
+
+  std::vector<std::future<StatusOr<UploadedShard>>> tasks;
+  for (std::uint64_t i = 0; i != shard_count; ++i) {
+    auto const begin = i * shard_size;
+    auto const end = (std::min)(begin + shard_size, file_size);
+    if (begin >= end) {
+      break;
+    }
+    internal::ResumableUploadRequest shard_request(request.bucket_name(),
+                                                   shard_name(i));
+    shard_request.set_multiple_options(
+        request.GetOption<DisableCrc32cChecksum>(),
+        request.GetOption<DisableMD5Hash>(), request.GetOption<EncryptionKey>(),
+        request.GetOption<KmsKeyName>(), request.GetOption<UserProject>());
+    tasks.emplace_back(std::async(
+        std::launch::async, UploadFileShard, std::ref(*raw_client_),
+        std::move(shard_request), std::cref(file_name), begin, end, resumable));
+  }
+
+  // Wait for all the shards, even if one fails. The other shards are useful if
+  // the application resumes the upload, and must be deleted otherwise.
+  std::vector<ComposeSourceObject> sources;
+  std::uint32_t checksum = 0;
+  Status status;
+  for (std::size_t i = 0; i != tasks.size(); ++i) {
+    auto shard = tasks[i].get();
+    if (!shard) {
+      if (status.ok()) {
+        status = std::move(shard).status();
+      }
+      continue;
+    }
+    auto const begin = i * shard_size;
+    auto const end = (std::min)(begin + shard_size, file_size);
+    checksum = internal::Crc32cCombine(checksum, shard->crc32c, end - begin);
+    sources.push_back(ComposeSourceObject{
+        shard_name(i),
+        google::cloud::optional<long>(static_cast<long>(shard->generation)),
+        {}});
+  }
+
+  auto delete_object = [&](std::string const& object_name,
+                           std::int64_t generation) {
+    internal::DeleteObjectRequest delete_request(request.bucket_name(),
+                                                 object_name);
+    delete_request.set_multiple_options(Generation(generation),
+                                        request.GetOption<UserProject>());
+    auto result = raw_client_->DeleteObject(delete_request);
+    if (!result) {
+      GCP_LOG(WARNING) << "cannot delete object " << object_name
+                       << " from parallel upload of " << file_name << ": "
+                       << result.status();
+    }
+  };
+  std::vector<ComposeSourceObject> temporaries = sources;
+  auto delete_temporaries = [&] {
+    for (auto const& object : temporaries) {
+      delete_object(object.object_name, *object.generation);
+    }
+  };
+  // On errors, keep the temporary objects only if the upload can be resumed.
+  auto cleanup_on_error = [&] {
+    if (!resumable) {
+      delete_temporaries();
+    }
+  };
+
+  if (!status.ok()) {
+    cleanup_on_error();
+    return report_error(__func__, status, "cannot upload shard");
+  }
+
+  // Compose the shards in a tree, each intermediate node can have at most
+  // kMaxComposeSources children.
+  for (int level = 0; sources.size() > kMaxComposeSources; ++level) {
+    std::vector<ComposeSourceObject> parents;
+    for (std::size_t i = 0; i < sources.size(); i += kMaxComposeSources) {
+      auto const last = (std::min)(i + kMaxComposeSources, sources.size());
+      if (last - i == 1) {
+        parents.push_back(sources[i]);
+        continue;
+      }
+      std::ostringstream os;
+      os << prefix << "_compose_" << level << "_" << i / kMaxComposeSources;
+      internal::ComposeObjectRequest compose_request(
+          request.bucket_name(),
+          std::vector<ComposeSourceObject>(sources.begin() + i,
+                                           sources.begin() + last),
+          os.str());
+      compose_request.set_multiple_options(request.GetOption<EncryptionKey>(),
+                                           request.GetOption<KmsKeyName>(),
+                                           request.GetOption<UserProject>());
+      auto composed = raw_client_->ComposeObject(compose_request);
+      if (!composed) {
+        cleanup_on_error();
+        return report_error(__func__, composed.status(),
+                            "cannot compose intermediate object");
+      }
+      ComposeSourceObject parent{
+          composed->name(),
+          google::cloud::optional<long>(
+              static_cast<long>(composed->generation())),
+          {}};
+      temporaries.push_back(parent);
+      parents.push_back(std::move(parent));
+    }
+    sources = std::move(parents);
+  }
+
+  // The headers that would be sent with each upload must be part of the
+  // destination metadata in a compose request.
+  ObjectMetadata metadata;
+  if (request.HasOption<WithObjectMetadata>()) {
+    metadata = request.GetOption<WithObjectMetadata>().value();
+  }
+  if (request.HasOption<ContentType>()) {
+    metadata.set_content_type(request.GetOption<ContentType>().value());
+  }
+  if (request.HasOption<ContentEncoding>()) {
+    metadata.set_content_encoding(request.GetOption<ContentEncoding>().value());
+  }
+  internal::ComposeObjectRequest compose_request(
+      request.bucket_name(), std::move(sources), request.object_name());
+  compose_request.set_multiple_options(
+      request.GetOption<EncryptionKey>(), request.GetOption<KmsKeyName>(),
+      request.GetOption<IfGenerationMatch>(),
+      request.GetOption<IfMetagenerationMatch>(),
+      request.GetOption<UserProject>(),
+      WithObjectMetadata(std::move(metadata)));
+  if (request.HasOption<PredefinedAcl>()) {
+    compose_request.set_option(
+        DestinationPredefinedAcl(request.GetOption<PredefinedAcl>().value()));
+  }
+  auto composed = raw_client_->ComposeObject(compose_request);
+  if (!composed) {
+    cleanup_on_error();
+    return report_error(__func__, composed.status(),
+                        "cannot compose destination object");
+  }
+  delete_temporaries();
+
+  if (request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
+    return composed;
+  }
+  auto const computed = internal::FormatCrc32cChecksum(checksum);
+  auto const expected = request.HasOption<Crc32cChecksumValue>()
+                            ? request.GetOption<Crc32cChecksumValue>().value()
+                            : computed;
+  if (composed->crc32c() != computed || expected != computed) {
+    // Do not leave corrupted data in the destination object.
+    delete_object(composed->name(), composed->generation());
+    std::ostringstream msg;
+    msg << "mismatched CRC32C checksum, received=" << composed->crc32c()
+        << ", computed=" << computed << ", expected=" << expected;
+    return report_error(__func__, Status(StatusCode::kDataLoss, msg.str()),
+                        "invalid destination object");
+  }
+  return composed;
+}
+
 Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                                 std::string const& file_name) {
+  if (request.HasOption<ParallelDownloadSlices>() &&
+      !request.HasOption<ReadRange>() &&
+      request.GetOption<ParallelDownloadSlices>().value() > 1) {
+    return DownloadFileParallel(request, file_name);
+  }
+  return DownloadFileSequential(request, file_name);
+}
+
+Status Client::DownloadFileSequential(
+    internal::ReadObjectRangeRequest const& request,
+    std::string const& file_name) {
   // TODO(#1665) - use Status to report errors.
   std::unique_ptr<internal::ObjectReadStreambuf> streambuf =
       raw_client_->ReadObject(request).value();
@@ -198,6 +564,174 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
   return Status();
 }
 
+namespace {
+/**
+ * Downloads the [begin, end) range of an object into the same range of a file.
+ *
+ * The destination file must already exist, as multiple slices are written
+ * concurrently into it. Returns the CRC32C checksum of the slice.
+ */
+StatusOr<std::uint32_t> DownloadFileSlice(
+    internal::RawClient& client, internal::ReadObjectRangeRequest request,
+    std::string const& file_name, std::int64_t begin, std::int64_t end) {
+  request.set_option(ReadRange(begin, end));
+  auto streambuf = client.ReadObject(request);
+  if (!streambuf) {
+    return std::move(streambuf).status();
+  }
+  ObjectReadStream stream(std::move(*streambuf));
+  if (!stream.status().ok()) {
+    return stream.status();
+  }
+
+  std::fstream os(file_name, std::ios::binary | std::ios::in | std::ios::out);
+  if (!os.is_open()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "cannot open destination file");
+  }
+  os.seekp(begin, std::ios::beg);
+
+  std::uint32_t checksum = 0;
+  std::int64_t received = 0;
+  std::string buffer;
+  buffer.resize(client.client_options().download_buffer_size(), '\0');
+  do {
+    stream.read(&buffer[0], buffer.size());
+    auto const count = static_cast<std::size_t>(stream.gcount());
+    os.write(buffer.data(), count);
+    checksum = crc32c::Extend(
+        checksum, reinterpret_cast<std::uint8_t const*>(buffer.data()), count);
+    received += count;
+  } while (os.good() && stream.good());
+  os.close();
+  if (!os.good()) {
+    return Status(StatusCode::kUnknown, "cannot write to destination file");
+  }
+  if (!stream.status().ok()) {
+    return stream.status();
+  }
+  if (received != end - begin) {
+    std::ostringstream msg;
+    msg << "short read in slice [" << begin << ", " << end << "), received "
+        << received << " bytes";
+    return Status(StatusCode::kDataLoss, std::move(msg).str());
+  }
+  return checksum;
+}
+}  // namespace
+
+Status Client::DownloadFileParallel(
+    internal::ReadObjectRangeRequest const& request,
+    std::string const& file_name) {
+  auto report_error = [&](char const* func, Status const& status,
+                          char const* what) {
+    std::ostringstream msg;
+    msg << func << "(" << request << ", " << file_name << "): " << what
+        << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  // Find out the size, generation, and checksum of the object. The slices are
+  // all read from the same generation, otherwise a concurrent update to the
+  // object could produce a file with a mix of two (or more) versions.
+  internal::GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                                      request.object_name());
+  metadata_request.set_option(request.GetOption<EncryptionKey>());
+  metadata_request.set_option(request.GetOption<Generation>());
+  metadata_request.set_option(request.GetOption<IfGenerationMatch>());
+  metadata_request.set_option(request.GetOption<IfGenerationNotMatch>());
+  metadata_request.set_option(request.GetOption<IfMetagenerationMatch>());
+  metadata_request.set_option(request.GetOption<IfMetagenerationNotMatch>());
+  metadata_request.set_option(request.GetOption<UserProject>());
+  auto metadata = raw_client_->GetObjectMetadata(metadata_request);
+  if (!metadata) {
+    return report_error(__func__, metadata.status(),
+                        "cannot get object metadata");
+  }
+
+  // Range requests on compressed objects return the compressed bytes, so these
+  // objects are downloaded (and decompressed) using a single request.
+  if (metadata->content_encoding() == "gzip") {
+    return DownloadFileSequential(request, file_name);
+  }
+
+  auto const object_size = static_cast<std::int64_t>(metadata->size());
+  auto const slice_count = static_cast<std::int64_t>(
+      (std::min)(request.GetOption<ParallelDownloadSlices>().value(),
+                 static_cast<std::size_t>(metadata->size())));
+  if (slice_count <= 1) {
+    return DownloadFileSequential(request, file_name);
+  }
+  auto const slice_size = (object_size + slice_count - 1) / slice_count;
+
+  // Create the destination file with its final size, so each slice can be
+  // written at its own offset without coordinating with the other slices.
+  {
+    std::ofstream os(file_name, std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) {
+      std::ostringstream msg;
+      msg << __func__ << "(" << request << ", " << file_name << "): "
+          << "cannot open destination file";
+      return Status(StatusCode::kInvalidArgument, std::move(msg).str());
+    }
+    os.seekp(object_size - 1, std::ios::beg);
+    os.put('\0');
+    os.close();
+    if (!os.good()) {
+      std::ostringstream msg;
+      msg << __func__ << "(" << request << ", " << file_name << "): "
+          << "cannot allocate destination file";
+      return Status(StatusCode::kUnknown, std::move(msg).str());
+    }
+  }
+
+  internal::ReadObjectRangeRequest slice_request = request;
+  slice_request.set_option(Generation(metadata->generation()));
+  std::vector<std::future<StatusOr<std::uint32_t>>> slices;
+  for (std::int64_t begin = 0; begin < object_size; begin += slice_size) {
+    auto end = (std::min)(begin + slice_size, object_size);
+    slices.emplace_back(std::async(std::launch::async, DownloadFileSlice,
+                                   std::ref(*raw_client_), slice_request,
+                                   std::cref(file_name), begin, end));
+  }
+
+  // Wait for all the slices, even if one fails, as they all use `file_name`.
+  Status status;
+  std::uint32_t checksum = 0;
+  std::int64_t offset = 0;
+  for (auto& slice : slices) {
+    auto slice_checksum = slice.get();
+    auto length = (std::min)(slice_size, object_size - offset);
+    offset += length;
+    if (!slice_checksum) {
+      if (status.ok()) {
+        status = std::move(slice_checksum).status();
+      }
+      continue;
+    }
+    checksum = internal::Crc32cCombine(checksum, *slice_checksum,
+                                       static_cast<std::uint64_t>(length));
+  }
+  if (!status.ok()) {
+    return report_error(__func__, status, "error in download stream");
+  }
+
+  bool const disable_crc32c =
+      request.GetOption<DisableCrc32cChecksum>().value_or(false);
+  if (disable_crc32c || metadata->crc32c().empty()) {
+    return Status();
+  }
+  auto computed = internal::FormatCrc32cChecksum(checksum);
+  if (computed != metadata->crc32c()) {
+    std::ostringstream msg;
+    msg << __func__ << "(" << request << ", " << file_name << "): "
+        << "mismatched CRC32C checksum, received=" << metadata->crc32c()
+        << ", computed=" << computed;
+    return Status(StatusCode::kDataLoss, std::move(msg).str());
+  }
+  return Status();
+}
+
 StatusOr<std::string> Client::SignUrl(internal::SignUrlRequest const& request) {
   auto base_credentials = raw_client()->client_options().credentials();
   auto credentials = dynamic_cast<oauth2::ServiceAccountCredentials<>*>(
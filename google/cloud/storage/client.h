@@ -15,14 +15,18 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_H_
 
+#include "google/cloud/future.h"
 #include "google/cloud/internal/disjunction.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
+#include "google/cloud/storage/batch_builder.h"
 #include "google/cloud/storage/internal/logging_client.h"
+#include "google/cloud/storage/internal/parallel_list_objects.h"
 #include "google/cloud/storage/internal/retry_client.h"
 #include "google/cloud/storage/internal/signed_url_requests.h"
 #include "google/cloud/storage/list_buckets_reader.h"
+#include "google/cloud/storage/list_object_summaries_reader.h"
 #include "google/cloud/storage/list_objects_reader.h"
 #include "google/cloud/storage/notification_event_type.h"
 #include "google/cloud/storage/notification_payload_format.h"
@@ -775,7 +779,7 @@ class Client {
    * @param bucket_name the bucket containing the object.
    * @param object_name the object name.
    * @param options a list of optional query parameters and/or request headers.
-   *     Valid types for this operation include `Generation`,
+   *     Valid types for this operation include `EncryptionKey`, `Generation`,
    *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
    *     `IfMetagenerationNotMatch`, `Projection`, and `UserProject`.
    *
@@ -801,7 +805,7 @@ class Client {
    * @param options a list of optional query parameters and/or request headers.
    *     Valid types for this operation include
    *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
-   *     `Projection`, `Prefix`, and `Versions`.
+   *     `Projection`, `Prefix`, `Delimiter`, and `Versions`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
@@ -816,6 +820,72 @@ class Client {
                              std::forward<Options>(options)...);
   }
 
+  /**
+   * Lists all the objects in a bucket using multiple threads.
+   *
+   * Listing a bucket is a sequential operation, each page of results contains
+   * the token to fetch the next page. For buckets with many objects this
+   * function splits the key space using the "directories" of the bucket: each
+   * prefix returned by the service (when listing with a `Delimiter`) is listed
+   * independently, and up to @p concurrency prefixes are listed at the same
+   * time. All the objects, including those in nested prefixes, are passed to
+   * @p callback.
+   *
+   * The callback is never called concurrently, but it is called from threads
+   * created by this function, and the objects are not delivered in any
+   * particular order.
+   *
+   * @param bucket_name the name of the bucket to list.
+   * @param concurrency the maximum number of concurrent list requests.
+   * @param callback the function called for each object.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include
+   *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
+   *     `Projection`, `Prefix`, `Delimiter`, and `Versions`. The `Delimiter`
+   *     defaults to "/".
+   *
+   * @return the status of the first failed list request, if any. The listing
+   *     stops on the first error.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  Status ListObjectsParallel(std::string const& bucket_name,
+                             std::size_t concurrency,
+                             std::function<void(ObjectMetadata)> callback,
+                             Options&&... options) {
+    internal::ListObjectsRequest request(bucket_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return internal::ParallelListObjects(*raw_client_, std::move(request),
+                                         concurrency, std::move(callback));
+  }
+
+  /**
+   * Lists the objects in a bucket, returning only a summary for each object.
+   *
+   * Applications that need only the name, size, generation, CRC32C checksum,
+   * and update time of each object should prefer this function over
+   * `ListObjects()`. The service returns only these fields, which reduces the
+   * size of the responses and the work to parse them.
+   *
+   * @param bucket_name the name of the bucket to list.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include
+   *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
+   *     `Prefix`, `Delimiter`, and `Versions`. Setting `Fields` overrides the
+   *     fields requested from the service.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  ListObjectSummariesReader ListObjectSummaries(std::string const& bucket_name,
+                                                Options&&... options) {
+    return ListObjectSummariesReader(raw_client_, bucket_name,
+                                     std::forward<Options>(options)...);
+  }
+
   /**
    * Reads the contents of an object.
    *
@@ -827,6 +897,11 @@ class Client {
    * Applications can also set the exception mask on the returned stream, in
    * which case an exception is thrown if an error is detected.
    *
+   * Calls to `read()` with buffers at least as large as
+   * `ClientOptions::download_buffer_size()` receive the data directly from the
+   * transfer, without intermediate copies. Applications downloading large
+   * objects should prefer such reads over character or line-based extraction.
+   *
    * @param bucket_name the name of the bucket that contains the object.
    * @param object_name the name of the object to be read.
    * @param options a list of optional query parameters and/or request headers.
@@ -936,13 +1011,20 @@ class Client {
    *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
    *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
    *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
-   *   `MD5HashValue`, `PredefinedAcl`, `Projection`, `UserProject`, and
-   *   `WithObjectMetadata`.
+   *   `MD5HashValue`, `ParallelUploadId`, `ParallelUploadShards`,
+   *   `PredefinedAcl`, `Projection`, `UseResumableUploadSession`,
+   *   `UserProject`, and `WithObjectMetadata`.
    *
    * @par Idempotency
    * This operation is only idempotent if restricted by pre-conditions, in this
    * case, `IfGenerationMatch`.
    *
+   * @par Performance
+   * A single upload stream is often limited by the round-trip time to the
+   * service, and not by the available bandwidth. For large files consider
+   * using `ParallelUploadShards`, which uploads several portions of the file
+   * concurrently and then composes them into the destination object.
+   *
    * @par Example
    * @snippet storage_object_samples.cc upload file
    *
@@ -956,10 +1038,14 @@ class Client {
                                       Options&&... options) {
     // Determine, at compile time, which version of UploadFileImpl we should
     // call. This needs to be done at compile time because ObjectInsertMedia
-    // does not support (nor should it support) the UseResumableUploadSession
-    // option.
+    // does not support (nor should it support) the UseResumableUploadSession,
+    // ParallelUploadId, or ParallelUploadShards options.
     using HasUseResumableUpload = google::cloud::internal::disjunction<
-        std::is_same<UseResumableUploadSession, Options>...>;
+        std::is_same<UseResumableUploadSession,
+                     typename std::decay<Options>::type>...,
+        std::is_same<ParallelUploadId, typename std::decay<Options>::type>...,
+        std::is_same<ParallelUploadShards,
+                     typename std::decay<Options>::type>...>;
     return UploadFileImpl(file_name, bucket_name, object_name,
                           HasUseResumableUpload{},
                           std::forward<Options>(options)...);
@@ -973,13 +1059,20 @@ class Client {
    * @param file_name the name of the destination file that will have the object
    *   media.
    * @param options a list of optional query parameters and/or request headers.
-   *   Valid types for this operation include `IfGenerationMatch`,
-   *   `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *   `IfMetagenerationNotMatch`, `Generation`, `ReadRange`, and `UserProject`.
+   *   Valid types for this operation include `DisableCrc32cChecksum`,
+   *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
+   *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `Generation`,
+   *   `ParallelDownloadSlices`, `ReadRange`, and `UserProject`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
    *
+   * @par Performance
+   * A single download stream is often limited by the throughput of a single
+   * TCP connection. Use the `ParallelDownloadSlices` option to split large
+   * objects into multiple slices, downloaded in parallel, each over a separate
+   * connection.
+   *
    * @par Example
    * @snippet storage_object_samples.cc download file
    */
@@ -1317,6 +1410,155 @@ class Client {
                                std::string{}, std::forward<Options>(options)...)
         .Result();
   }
+
+  /**
+   * Creates a builder to execute object metadata operations in batches.
+   *
+   * Deleting objects, fetching their metadata, or patching their metadata are
+   * small operations, and their latency is dominated by the round-trip time
+   * to the service. The returned `BatchBuilder` sends up to 100 of these
+   * operations in each HTTP request, and returns a separate result for each
+   * one.
+   *
+   * @par Idempotency
+   * Each operation in the batch is retried (if it fails with a transient
+   * error) only if it would be retried when called individually.
+   *
+   * @par Example
+   * @code
+   * auto batch = client.Batch();
+   * for (auto const& name : names) {
+   *   batch.DeleteObject("my-bucket", name);
+   * }
+   * auto results = batch.Execute();
+   * @endcode
+   */
+  BatchBuilder Batch() { return BatchBuilder(raw_client_); }
+  //@}
+
+  //@{
+  /**
+   * @name Asynchronous object operations
+   *
+   * These functions start the operation and return immediately, the returned
+   * `future<>` is satisfied when the operation completes. The operations use
+   * the same retry, backoff, and idempotency policies as the synchronous
+   * versions, but no application thread is blocked while the request, or the
+   * backoff between attempts, is in progress. The work runs in a small pool of
+   * background threads owned by the client, see
+   * `ClientOptions::download_reactor_threads()`.
+   *
+   * Any continuations attached to the returned futures also run in those
+   * background threads, applications should avoid blocking in them.
+   *
+   * The client, or a copy of it, must remain alive until the returned futures
+   * are satisfied. Operations still pending when the last copy is destroyed
+   * fail with an error.
+   */
+  /**
+   * Creates an object given its name and contents, asynchronously.
+   *
+   * @param bucket_name the name of the bucket that will contain the object.
+   * @param object_name the name of the object to be created.
+   * @param contents the contents (media) for the new object.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `ContentEncoding`,
+   *     `ContentType`, `Crc32cChecksumValue`, `DisableCrc32cChecksum`,
+   *     `DisableMD5Hash`, `EncryptionKey`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `KmsKeyName`, `MD5HashValue`,
+   *     `PredefinedAcl`, `Projection`, `UserProject`, and `WithObjectMetadata`.
+   *
+   * @par Idempotency
+   * This operation is only idempotent if restricted by pre-conditions, in this
+   * case, `IfGenerationMatch`.
+   */
+  template <typename... Options>
+  future<StatusOr<ObjectMetadata>> AsyncInsertObject(
+      std::string const& bucket_name, std::string const& object_name,
+      std::string contents, Options&&... options) {
+    internal::InsertObjectMediaRequest request(bucket_name, object_name,
+                                               std::move(contents));
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncInsertObjectMedia(request);
+  }
+
+  /**
+   * Fetches the object metadata, asynchronously.
+   *
+   * @param bucket_name the bucket containing the object.
+   * @param object_name the object name.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `Generation`,
+   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `Projection`, and `UserProject`.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      std::string const& bucket_name, std::string const& object_name,
+      Options&&... options) {
+    internal::GetObjectMetadataRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncGetObjectMetadata(request);
+  }
+
+  /**
+   * Reads the contents of an object, asynchronously.
+   *
+   * Unlike `ReadObject()` the full contents (or the requested range) are
+   * returned at once, this is intended for small and medium sized objects.
+   * The checksums are validated before the future is satisfied, a mismatch is
+   * reported as a `StatusCode::kDataLoss` error.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `DisableCrc32cChecksum`,
+   *     `DisableMD5Hash`, `EncryptionKey`, `Generation`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `ReadRange`, and `UserProject`.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  future<StatusOr<std::string>> AsyncReadObject(std::string const& bucket_name,
+                                                std::string const& object_name,
+                                                Options&&... options) {
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncReadObject(request);
+  }
+
+  /**
+   * Deletes an object, asynchronously.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be deleted.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `Generation`,
+   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, and `UserProject`.
+   *
+   * @par Idempotency
+   * This operation is only idempotent if:
+   * - restricted by pre-conditions, in this case, `IfGenerationMatch`
+   * - or, if it applies to only one object version via `Generation`.
+   */
+  template <typename... Options>
+  future<Status> AsyncDeleteObject(std::string const& bucket_name,
+                                   std::string const& object_name,
+                                   Options&&... options) {
+    internal::DeleteObjectRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncDeleteObject(request).then(
+        [](future<StatusOr<internal::EmptyResponse>> f) {
+          return f.get().status();
+        });
+  }
   //@}
 
   //@{
@@ -2448,8 +2690,9 @@ class Client {
     return retry;
   }
 
-  // The version of UploadFile() where UseResumableUploadSession is one of the
-  // options. Note how this does not use InsertObjectMedia at all.
+  // The version of UploadFile() where UseResumableUploadSession,
+  // ParallelUploadId, or ParallelUploadShards is one of the options. Note how
+  // this does not use InsertObjectMedia at all.
   template <typename... Options>
   StatusOr<ObjectMetadata> UploadFileImpl(std::string const& file_name,
                                           std::string const& bucket_name,
@@ -2493,9 +2736,19 @@ class Client {
       std::istream& source, std::uint64_t source_size,
       internal::ResumableUploadRequest const& request);
 
+  StatusOr<ObjectMetadata> UploadFileParallel(
+      std::string const& file_name, std::uint64_t file_size,
+      internal::ResumableUploadRequest const& request);
+
   Status DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                           std::string const& file_name);
 
+  Status DownloadFileSequential(internal::ReadObjectRangeRequest const& request,
+                                std::string const& file_name);
+
+  Status DownloadFileParallel(internal::ReadObjectRangeRequest const& request,
+                              std::string const& file_name);
+
   StatusOr<std::string> SignUrl(internal::SignUrlRequest const& request);
 
   std::shared_ptr<internal::RawClient> raw_client_;
@@ -0,0 +1,155 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using ms = std::chrono::milliseconds;
+using testing::canonical_errors::PermanentError;
+using testing::canonical_errors::TransientError;
+
+/**
+ * Test the functions in Storage::Client related to batch requests.
+ *
+ * The mock uses the default `RawClient::ExecuteBatch()`, which executes each
+ * operation through the (mocked) individual calls.
+ */
+class BatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+  }
+  void TearDown() override { mock.reset(); }
+
+  std::shared_ptr<testing::MockClient> mock;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+ObjectMetadata CreateMetadata(std::string const& name) {
+  return internal::ObjectMetadataParser::FromString(
+             R"""({"bucket": "test-bucket-name", "name": ")""" + name +
+             R"""("})""")
+      .value();
+}
+
+TEST_F(BatchTest, Empty) {
+  Client client{std::shared_ptr<internal::RawClient>(mock)};
+  auto results = client.Batch().Execute();
+  ASSERT_TRUE(results.ok()) << "status=" << results.status();
+  EXPECT_TRUE(results->empty());
+}
+
+TEST_F(BatchTest, ResultsInOrder) {
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillOnce(Invoke([](internal::DeleteObjectRequest const& r) {
+        EXPECT_EQ("test-bucket-name", r.bucket_name());
+        EXPECT_EQ("object-1", r.object_name());
+        EXPECT_EQ(7, r.GetOption<Generation>().value());
+        return make_status_or(internal::EmptyResponse{});
+      }));
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([](internal::GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("object-2", r.object_name());
+        return make_status_or(CreateMetadata("object-2"));
+      }));
+  EXPECT_CALL(*mock, PatchObject(_))
+      .WillOnce(Invoke([](internal::PatchObjectRequest const& r) {
+        EXPECT_EQ("object-3", r.object_name());
+        EXPECT_THAT(r.payload(), ::testing::HasSubstr("text/plain"));
+        return make_status_or(CreateMetadata("object-3"));
+      }));
+
+  Client client{std::shared_ptr<internal::RawClient>(mock)};
+  auto batch = client.Batch();
+  batch.DeleteObject("test-bucket-name", "object-1", Generation(7))
+      .GetObjectMetadata("test-bucket-name", "object-2")
+      .PatchObject("test-bucket-name", "object-3",
+                   ObjectMetadataPatchBuilder().SetContentType("text/plain"));
+  EXPECT_EQ(3U, batch.size());
+  auto results = batch.Execute();
+  ASSERT_TRUE(results.ok()) << "status=" << results.status();
+  ASSERT_EQ(3U, results->size());
+  for (auto const& r : *results) {
+    EXPECT_TRUE(r.ok()) << "status=" << r.status();
+  }
+  EXPECT_EQ(ObjectMetadata{}, *(*results)[0]);
+  EXPECT_EQ("object-2", (*results)[1]->name());
+  EXPECT_EQ("object-3", (*results)[2]->name());
+}
+
+TEST_F(BatchTest, RetryOnlyTransientIdempotentFailures) {
+  // The delete is idempotent (it has a generation), the patch is not, and the
+  // get fails with a permanent error. Only the delete should be retried.
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillOnce(Return(StatusOr<internal::EmptyResponse>(TransientError())))
+      .WillOnce(Return(make_status_or(internal::EmptyResponse{})));
+  EXPECT_CALL(*mock, PatchObject(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())));
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                LimitedErrorCountRetryPolicy(3),
+                ExponentialBackoffPolicy(ms(1), ms(1), 2.0),
+                StrictIdempotencyPolicy()};
+  auto batch = client.Batch();
+  batch.DeleteObject("test-bucket-name", "object-1", Generation(7))
+      .PatchObject("test-bucket-name", "object-2",
+                   ObjectMetadataPatchBuilder().SetContentType("text/plain"))
+      .GetObjectMetadata("test-bucket-name", "object-3");
+  auto results = batch.Execute();
+  ASSERT_TRUE(results.ok()) << "status=" << results.status();
+  ASSERT_EQ(3U, results->size());
+  EXPECT_TRUE((*results)[0].ok()) << "status=" << (*results)[0].status();
+  EXPECT_EQ(TransientError().code(), (*results)[1].status().code());
+  EXPECT_EQ(PermanentError().code(), (*results)[2].status().code());
+}
+
+TEST_F(BatchTest, RetryPolicyExhausted) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(3)
+      .WillRepeatedly(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                LimitedErrorCountRetryPolicy(2),
+                ExponentialBackoffPolicy(ms(1), ms(1), 2.0)};
+  auto batch = client.Batch();
+  batch.GetObjectMetadata("test-bucket-name", "object-1");
+  auto results = batch.Execute();
+  ASSERT_TRUE(results.ok()) << "status=" << results.status();
+  ASSERT_EQ(1U, results->size());
+  EXPECT_EQ(TransientError().code(), (*results)[0].status().code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,94 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/client_metrics.h"
+#include "google/cloud/storage/internal/metrics_recorder.h"
+#include <cstring>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+using internal::MetricsRecorder;
+
+std::size_t const ClientMetrics::kMaxOperations;
+
+ClientMetrics::ClientMetrics() : overflow_(new MetricsRecorder("other")) {
+  for (std::size_t i = 0; i != kMaxOperations; ++i) {
+    names_[i].store(nullptr, std::memory_order_relaxed);
+    recorders_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+ClientMetrics::~ClientMetrics() {
+  for (auto& r : recorders_) {
+    delete r.load();
+  }
+  delete overflow_;
+}
+
+std::vector<OperationMetrics> ClientMetrics::Snapshot() const {
+  std::vector<OperationMetrics> result;
+  for (auto const& r : recorders_) {
+    auto const* recorder = r.load(std::memory_order_acquire);
+    if (recorder != nullptr) {
+      result.push_back(recorder->Snapshot());
+    }
+  }
+  auto overflow = overflow_->Snapshot();
+  if (overflow.latency.count() != 0) {
+    result.push_back(std::move(overflow));
+  }
+  return result;
+}
+
+MetricsRecorder& ClientMetrics::Recorder(char const* operation) {
+  // FNV-1a, hashing the name avoids allocating a `std::string`.
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (auto const* c = operation; *c != '\0'; ++c) {
+    hash = (hash ^ static_cast<unsigned char>(*c)) * 1099511628211ULL;
+  }
+  auto const start = static_cast<std::size_t>(hash % kMaxOperations);
+  for (std::size_t probe = 0; probe != kMaxOperations; ++probe) {
+    auto const i = (start + probe) % kMaxOperations;
+    auto const* name = names_[i].load(std::memory_order_acquire);
+    if (name == nullptr) {
+      if (names_[i].compare_exchange_strong(name, operation)) {
+        auto* recorder = new MetricsRecorder(operation);
+        recorders_[i].store(recorder, std::memory_order_release);
+        return *recorder;
+      }
+      // Another thread claimed the slot, `name` now holds its operation.
+    }
+    if (name != operation && std::strcmp(name, operation) != 0) {
+      continue;
+    }
+    // The thread that claimed the slot may not have created the recorder yet.
+    MetricsRecorder* recorder;
+    while ((recorder = recorders_[i].load(std::memory_order_acquire)) ==
+           nullptr) {
+      std::this_thread::yield();
+    }
+    return *recorder;
+  }
+  // The table is full, this only happens if the RawClient interface grows
+  // past kMaxOperations functions.
+  return *overflow_;
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,122 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_METRICS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_METRICS_H_
+
+#include "google/cloud/internal/latency_distribution.h"
+#include "google/cloud/status.h"
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+class MetricsRecorder;
+}  // namespace internal
+
+/**
+ * The distribution of the latencies for one operation.
+ *
+ * The latencies are counted in buckets. The bucket boundaries are powers of
+ * two, each split into 8 linear sub-buckets, so any value reported by this
+ * class is within 12.5% of the actual latency.
+ */
+using LatencyDistribution = google::cloud::internal::LatencyDistribution;
+
+/// The metrics for one `RawClient` operation, such as `GetObjectMetadata`.
+struct OperationMetrics {
+  std::string name;
+  /// The latency of each request, retried requests are counted separately.
+  LatencyDistribution latency;
+  /// The number of requests that failed, by error code.
+  std::map<StatusCode, std::uint64_t> errors;
+  std::uint64_t bytes_sent;
+  std::uint64_t bytes_received;
+};
+
+/**
+ * Collect per-operation metrics for a `storage::Client`.
+ *
+ * @par Example
+ * @code
+ * auto metrics = std::make_shared<gcs::ClientMetrics>();
+ * auto options = gcs::ClientOptions::CreateDefaultClientOptions();
+ * gcs::Client client(options->set_metrics(metrics));
+ * // ... use `client` ...
+ * for (auto const& m : metrics->Snapshot()) {
+ *   std::cout << m.name << " p99=" << m.latency.Percentile(0.99).count()
+ *             << "us\n";
+ * }
+ * @endcode
+ *
+ * The metrics record each request sent to the service, retried requests are
+ * counted separately, including their errors. Recording a request does not
+ * acquire any locks, each thread updates one of several shards of the
+ * counters. `Snapshot()` merges the shards and can be called at any time,
+ * for example, from a background thread exporting the metrics to a monitoring
+ * system.
+ *
+ * The bytes transferred are recorded for simple uploads, resumable upload
+ * chunks, and downloads. Streaming downloads and uploads via
+ * `ObjectReadStream` and `ObjectWriteStream` are recorded when the stream is
+ * closed, their latency includes the time to transfer the data.
+ */
+class ClientMetrics {
+ public:
+  ClientMetrics();
+  ~ClientMetrics();
+
+  ClientMetrics(ClientMetrics const&) = delete;
+  ClientMetrics& operator=(ClientMetrics const&) = delete;
+
+  /// Return the metrics for all the operations used so far.
+  std::vector<OperationMetrics> Snapshot() const;
+
+  /**
+   * Return the recorder for the @p operation.
+   *
+   * Used by the library to record metrics, applications do not need to call
+   * this function. @p operation must be a string with static storage
+   * duration, such as `__func__`.
+   */
+  internal::MetricsRecorder& Recorder(char const* operation);
+
+ private:
+  static std::size_t const kMaxOperations = 128;
+
+  /**
+   * An open addressing hash table, indexed by the operation name.
+   *
+   * Slots are only added, never removed, so finding the recorder for an
+   * operation does not need any locks.
+   */
+  std::atomic<char const*> names_[kMaxOperations];
+  std::atomic<internal::MetricsRecorder*> recorders_[kMaxOperations];
+  internal::MetricsRecorder* overflow_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_METRICS_H_
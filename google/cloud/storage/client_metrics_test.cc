@@ -0,0 +1,126 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/client_metrics.h"
+#include "google/cloud/storage/internal/metrics_recorder.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using internal::MetricsRecorder;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+using us = std::chrono::microseconds;
+
+/// @test Verify the percentiles are within the bucket resolution.
+TEST(ClientMetricsTest, Percentile) {
+  MetricsRecorder recorder("test");
+  for (int i = 1; i <= 1000; ++i) {
+    recorder.Record(us(i * 100), StatusCode::kOk, 0, 0);
+  }
+  auto metrics = recorder.Snapshot();
+  EXPECT_EQ("test", metrics.name);
+  EXPECT_EQ(1000U, metrics.latency.count());
+  EXPECT_EQ(us(50050), metrics.latency.mean());
+  auto within = [](us expected, us actual) {
+    return std::abs(static_cast<double>((actual - expected).count())) <=
+           static_cast<double>(expected.count()) / 8;
+  };
+  EXPECT_TRUE(within(us(50000), metrics.latency.Percentile(0.5)))
+      << metrics.latency.Percentile(0.5).count();
+  EXPECT_TRUE(within(us(99000), metrics.latency.Percentile(0.99)))
+      << metrics.latency.Percentile(0.99).count();
+  EXPECT_TRUE(within(us(100), metrics.latency.Percentile(0.0)))
+      << metrics.latency.Percentile(0.0).count();
+}
+
+/// @test Verify an empty distribution reports zeroes.
+TEST(ClientMetricsTest, EmptyDistribution) {
+  LatencyDistribution empty;
+  EXPECT_EQ(0U, empty.count());
+  EXPECT_EQ(us(0), empty.mean());
+  EXPECT_EQ(us(0), empty.Percentile(0.99));
+}
+
+/// @test Verify errors and bytes are recorded.
+TEST(ClientMetricsTest, ErrorsAndBytes) {
+  MetricsRecorder recorder("test");
+  recorder.Record(us(10), StatusCode::kOk, 100, 0);
+  recorder.Record(us(10), StatusCode::kUnavailable, 100, 0);
+  recorder.Record(us(10), StatusCode::kUnavailable, 0, 200);
+  recorder.Record(us(10), StatusCode::kNotFound, 0, 0);
+  auto metrics = recorder.Snapshot();
+  EXPECT_EQ(4U, metrics.latency.count());
+  EXPECT_EQ(200U, metrics.bytes_sent);
+  EXPECT_EQ(200U, metrics.bytes_received);
+  EXPECT_THAT(metrics.errors, ElementsAre(Pair(StatusCode::kNotFound, 1U),
+                                          Pair(StatusCode::kUnavailable, 2U)));
+}
+
+/// @test Verify concurrent lookups of the same operation share a recorder.
+TEST(ClientMetricsTest, ConcurrentRecorders) {
+  ClientMetrics metrics;
+  char const* names[] = {"A", "B", "C", "D"};
+  int const kThreads = 8;
+  int const kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&metrics, &names] {
+      for (int i = 0; i != kIterations; ++i) {
+        metrics.Recorder(names[i % 4]).Record(us(i), StatusCode::kOk, 1, 0);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto const expected = static_cast<std::uint64_t>(kThreads * kIterations / 4);
+  auto snapshot = metrics.Snapshot();
+  ASSERT_EQ(4U, snapshot.size());
+  for (auto const& m : snapshot) {
+    EXPECT_EQ(expected, m.latency.count()) << m.name;
+    EXPECT_EQ(expected, m.bytes_sent) << m.name;
+  }
+}
+
+/// @test Verify operations beyond the table capacity are still recorded.
+TEST(ClientMetricsTest, Overflow) {
+  ClientMetrics metrics;
+  std::vector<std::string> names;
+  for (int i = 0; i != 200; ++i) {
+    names.push_back("op-" + std::to_string(i));
+  }
+  for (auto const& n : names) {
+    metrics.Recorder(n.c_str()).Record(us(1), StatusCode::kOk, 0, 0);
+  }
+  auto snapshot = metrics.Snapshot();
+  std::uint64_t total = 0;
+  bool has_other = false;
+  for (auto const& m : snapshot) {
+    total += m.latency.count();
+    has_other = has_other || m.name == "other";
+  }
+  EXPECT_EQ(200U, total);
+  EXPECT_TRUE(has_other);
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
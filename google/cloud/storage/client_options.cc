@@ -78,6 +78,7 @@ ClientOptions::ClientOptions(std::shared_ptr<oauth2::Credentials> credentials)
       connection_pool_size_(DefaultConnectionPoolSize()),
       download_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_BUFFER_SIZE),
       upload_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_BUFFER_SIZE),
+      download_reactor_threads_(0),
       maximum_simple_upload_size_(
           GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MAXIMUM_SIMPLE_UPLOAD_SIZE) {
   auto emulator =
@@ -92,7 +93,11 @@ void ClientOptions::SetupFromEnvironment() {
   auto enable_clog =
       google::cloud::internal::GetEnv("CLOUD_STORAGE_ENABLE_CLOG");
   if (enable_clog.has_value()) {
-    google::cloud::LogSink::EnableStdClog();
+    if (*enable_clog == "async") {
+      google::cloud::LogSink::EnableAsyncStdClog();
+    } else {
+      google::cloud::LogSink::EnableStdClog();
+    }
   }
   // This is overkill right now, eventually we will have different components
   // that can be traced (http being the first), so we parse the environment
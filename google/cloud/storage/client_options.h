@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H_
 
 #include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/client_metrics.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include <memory>
 
@@ -34,7 +35,8 @@ inline namespace STORAGE_CLIENT_NS {
  *   `AnonymousCredentials` object instead of loading Application Default
  *   %Credentials.
  * - `CLOUD_STORAGE_ENABLE_CLOG`: if set, enable std::clog as a backend for
- *   `google::cloud::LogSink`.
+ *   `google::cloud::LogSink`. If set to `async`, the log records are written
+ *   from a background thread, see `google::cloud::AsyncLogBackend`.
  * - `CLOUD_STORAGE_ENABLE_TRACING`: if set, this is the list of components that
  *   will have logging enabled, the component this is:
  *   - `http`: trace all http request / responses.
@@ -101,9 +103,64 @@ class ClientOptions {
   std::size_t download_buffer_size() const { return download_buffer_size_; }
   ClientOptions& SetDownloadBufferSize(std::size_t size);
 
+  /**
+   * Adjust the download buffer size of each stream to its performance.
+   *
+   * If false (the default), each `ObjectReadStream` waits until it receives
+   * `download_buffer_size()` bytes, or the end of the download, before
+   * returning data to the application. If true, each stream starts with a
+   * small buffer, to reduce the time to receive the first bytes, and then
+   * adjusts the size to the observed throughput and latency of the download.
+   * In this case `download_buffer_size()` is the maximum buffer size.
+   */
+  bool enable_adaptive_download_buffer() const {
+    return enable_adaptive_download_buffer_;
+  }
+  ClientOptions& set_enable_adaptive_download_buffer(bool v) {
+    enable_adaptive_download_buffer_ = v;
+    return *this;
+  }
+
   std::size_t upload_buffer_size() const { return upload_buffer_size_; }
   ClientOptions& SetUploadBufferSize(std::size_t size);
 
+  /**
+   * Overlap the upload of each chunk with filling the next buffer.
+   *
+   * If false (the default), each `ObjectWriteStream` using resumable uploads
+   * blocks while each chunk of `upload_buffer_size()` bytes is uploaded. If
+   * true, the chunk is uploaded (and its hashes computed) in a background
+   * thread, while the application writes into a second buffer. This doubles
+   * the memory used by each stream, and improves the throughput when the
+   * application produces data at least as fast as the network sends it.
+   */
+  bool enable_pipelined_uploads() const { return enable_pipelined_uploads_; }
+  ClientOptions& set_enable_pipelined_uploads(bool v) {
+    enable_pipelined_uploads_ = v;
+    return *this;
+  }
+
+  /**
+   * The number of threads used to run downloads.
+   *
+   * If zero (the default), each download is performed by the thread reading
+   * from the `ObjectReadStream`. Otherwise all the downloads for a client run
+   * in a shared pool with this many threads, and the threads reading from each
+   * `ObjectReadStream` only wait for data. Use this option when the
+   * application keeps many downloads in progress at the same time.
+   *
+   * The asynchronous operations, such as `Client::AsyncReadObject()`, always
+   * run in a separate pool. That pool uses the same number of threads, or a
+   * single thread if this value is zero.
+   */
+  std::size_t download_reactor_threads() const {
+    return download_reactor_threads_;
+  }
+  ClientOptions& set_download_reactor_threads(std::size_t v) {
+    download_reactor_threads_ = v;
+    return *this;
+  }
+
   std::string const& user_agent_prefix() const { return user_agent_prefix_; }
   ClientOptions& add_user_agent_prefx(std::string const& v) {
     std::string prefix = v;
@@ -135,6 +192,22 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Record per-operation metrics in @p metrics.
+   *
+   * If null (the default), no metrics are recorded. The same object can be
+   * shared by many clients, the metrics are then aggregated across clients.
+   * Only clients created from a `ClientOptions` record metrics, clients
+   * created from a `RawClient` are not decorated.
+   *
+   * @see ClientMetrics
+   */
+  std::shared_ptr<ClientMetrics> const& metrics() const { return metrics_; }
+  ClientOptions& set_metrics(std::shared_ptr<ClientMetrics> metrics) {
+    metrics_ = std::move(metrics);
+    return *this;
+  }
+
  private:
   void SetupFromEnvironment();
 
@@ -147,10 +220,14 @@ class ClientOptions {
   std::string project_id_;
   std::size_t connection_pool_size_;
   std::size_t download_buffer_size_;
+  bool enable_adaptive_download_buffer_ = false;
   std::size_t upload_buffer_size_;
+  bool enable_pipelined_uploads_ = false;
+  std::size_t download_reactor_threads_;
   std::string user_agent_prefix_;
   std::size_t maximum_simple_upload_size_;
   bool enable_ssl_locking_callbacks_ = true;
+  std::shared_ptr<ClientMetrics> metrics_;
 };
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -0,0 +1,424 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <crc32c/crc32c.h>
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using testing::canonical_errors::PermanentError;
+
+/// A read streambuf returning a fixed string, used to mock downloads.
+class StringReadStreambuf : public internal::ObjectReadStreambuf {
+ public:
+  explicit StringReadStreambuf(std::string contents)
+      : contents_(std::move(contents)) {
+    setg(&contents_[0], &contents_[0], &contents_[0] + contents_.size());
+  }
+
+  void Close() override { is_open_ = false; }
+  bool IsOpen() const override { return is_open_; }
+  Status const& status() const override { return status_; }
+  std::string const& received_hash() const override { return hash_; }
+  std::string const& computed_hash() const override { return hash_; }
+  std::multimap<std::string, std::string> const& headers() const override {
+    return headers_;
+  }
+
+ private:
+  std::string contents_;
+  bool is_open_ = true;
+  Status status_;
+  std::string hash_;
+  std::multimap<std::string, std::string> headers_;
+};
+
+class ParallelTransferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{std::shared_ptr<internal::RawClient>(mock)});
+
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    file_name = "parallel-transfer-test-" +
+                google::cloud::internal::Sample(
+                    generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789") +
+                ".bin";
+  }
+  void TearDown() override {
+    client.reset();
+    mock.reset();
+    std::remove(file_name.c_str());
+  }
+
+  static std::string MakeContents(std::size_t size) {
+    std::string contents;
+    for (std::size_t i = 0; i != size; ++i) {
+      contents.push_back(static_cast<char>('a' + i % 26));
+    }
+    return contents;
+  }
+
+  static std::string Crc32c(std::string const& contents) {
+    return internal::FormatCrc32cChecksum(crc32c::Crc32c(contents));
+  }
+
+  static ObjectMetadata MakeMetadata(std::string const& contents,
+                                     std::string const& crc32c) {
+    std::ostringstream os;
+    os << R"""({"bucket": "test-bucket", "name": "test-object",)"""
+       << R"""("generation": "12345", "size": ")""" << contents.size()
+       << R"""(", "crc32c": ")""" << crc32c << R"""("})""";
+    return internal::ObjectMetadataParser::FromString(os.str()).value();
+  }
+
+  /// Mock ReadObject() returning the requested range of @p contents.
+  void ExpectSlices(std::string const& contents, int count) {
+    EXPECT_CALL(*mock, ReadObject(_))
+        .Times(count)
+        .WillRepeatedly(
+            Invoke([this, contents](internal::ReadObjectRangeRequest const& r) {
+              EXPECT_TRUE(r.HasOption<Generation>());
+              EXPECT_EQ(12345, r.GetOption<Generation>().value());
+              EXPECT_TRUE(r.HasOption<ReadRange>());
+              auto const range = r.GetOption<ReadRange>().value();
+              {
+                std::lock_guard<std::mutex> lk(mu);
+                ranges.emplace(range.begin, range.end);
+              }
+              auto const begin = static_cast<std::size_t>(range.begin);
+              auto const end = static_cast<std::size_t>(range.end);
+              std::unique_ptr<internal::ObjectReadStreambuf> streambuf(
+                  new StringReadStreambuf(contents.substr(begin, end - begin)));
+              return make_status_or(std::move(streambuf));
+            }));
+  }
+
+  void ExpectShards(int count, Status const& error);
+  void ExpectDeletes(int count);
+  void WriteFile(std::string const& contents) const;
+
+  std::string ReadFile() const {
+    std::ifstream is(file_name, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>{is}, {});
+  }
+
+  std::shared_ptr<testing::MockClient> mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+  std::string file_name;
+
+  std::mutex mu;
+  std::set<std::pair<std::int64_t, std::int64_t>> ranges;
+  std::map<std::string, std::string> shards;
+  std::set<std::string> deleted;
+};
+
+/// @test Verify that DownloadToFile() splits the object into ranges.
+TEST_F(ParallelTransferTest, DownloadSlices) {
+  auto const contents = MakeContents(1000);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&](internal::GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("test-bucket", r.bucket_name());
+        EXPECT_EQ("test-object", r.object_name());
+        return make_status_or(MakeMetadata(contents, Crc32c(contents)));
+      }));
+  ExpectSlices(contents, 3);
+
+  auto status = client->DownloadToFile("test-bucket", "test-object", file_name,
+                                       ParallelDownloadSlices(3));
+  ASSERT_TRUE(status.ok()) << "status=" << status;
+  std::set<std::pair<std::int64_t, std::int64_t>> expected{
+      {0, 334}, {334, 668}, {668, 1000}};
+  EXPECT_EQ(expected, ranges);
+  EXPECT_EQ(contents, ReadFile());
+}
+
+/// @test Verify that small objects use at most one slice per byte.
+TEST_F(ParallelTransferTest, DownloadMoreSlicesThanBytes) {
+  auto const contents = MakeContents(2);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(MakeMetadata(contents, Crc32c(contents)));
+      }));
+  ExpectSlices(contents, 2);
+
+  auto status = client->DownloadToFile("test-bucket", "test-object", file_name,
+                                       ParallelDownloadSlices(8));
+  ASSERT_TRUE(status.ok()) << "status=" << status;
+  std::set<std::pair<std::int64_t, std::int64_t>> expected{{0, 1}, {1, 2}};
+  EXPECT_EQ(expected, ranges);
+  EXPECT_EQ(contents, ReadFile());
+}
+
+/// @test Verify that the combined CRC32C checksum is validated.
+TEST_F(ParallelTransferTest, DownloadChecksumMismatch) {
+  auto const contents = MakeContents(1000);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(MakeMetadata(contents, Crc32c("wrong")));
+      }));
+  ExpectSlices(contents, 4);
+
+  auto status = client->DownloadToFile("test-bucket", "test-object", file_name,
+                                       ParallelDownloadSlices(4));
+  EXPECT_EQ(StatusCode::kDataLoss, status.code());
+  EXPECT_THAT(status.message(), ::testing::HasSubstr("CRC32C"));
+}
+
+/// @test Verify that the CRC32C checksum validation can be disabled.
+TEST_F(ParallelTransferTest, DownloadChecksumDisabled) {
+  auto const contents = MakeContents(1000);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(MakeMetadata(contents, Crc32c("wrong")));
+      }));
+  ExpectSlices(contents, 4);
+
+  auto status = client->DownloadToFile("test-bucket", "test-object", file_name,
+                                       ParallelDownloadSlices(4),
+                                       DisableCrc32cChecksum(true));
+  ASSERT_TRUE(status.ok()) << "status=" << status;
+  EXPECT_EQ(contents, ReadFile());
+}
+
+/// @test Verify that the encryption key is used to fetch the metadata.
+TEST_F(ParallelTransferTest, DownloadEncrypted) {
+  auto const contents = MakeContents(1000);
+  auto const key = EncryptionDataFromBinaryKey(std::string(32, 'k'));
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&](internal::GetObjectMetadataRequest const& r) {
+        EXPECT_TRUE(r.HasOption<EncryptionKey>());
+        EXPECT_EQ(key.key, r.GetOption<EncryptionKey>().value().key);
+        return make_status_or(MakeMetadata(contents, Crc32c(contents)));
+      }));
+  ExpectSlices(contents, 2);
+
+  auto status = client->DownloadToFile("test-bucket", "test-object", file_name,
+                                       ParallelDownloadSlices(2),
+                                       EncryptionKey(key));
+  ASSERT_TRUE(status.ok()) << "status=" << status;
+  EXPECT_EQ(contents, ReadFile());
+}
+
+/// Mock CreateResumableSession() to record the data uploaded to each shard.
+void ParallelTransferTest::ExpectShards(int count, Status const& error) {
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .Times(count)
+      .WillRepeatedly(Invoke([this, error](
+                                 internal::ResumableUploadRequest const& r) {
+        auto const name = r.object_name();
+        auto session = std::unique_ptr<testing::MockResumableUploadSession>(
+            new testing::MockResumableUploadSession);
+        EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Return(0));
+        EXPECT_CALL(*session, UploadChunk(_, _))
+            .WillOnce(Invoke([this, name, error](std::string const& buffer,
+                                                 std::uint64_t size) {
+              std::lock_guard<std::mutex> lk(mu);
+              auto const index = shards.size();
+              shards[name] = buffer;
+              if (!error.ok() && index == 0) {
+                return StatusOr<internal::ResumableUploadResponse>(error);
+              }
+              std::ostringstream os;
+              os << R"""({"bucket": "test-bucket", "name": ")""" << name
+                 << R"""(", "generation": ")""" << 100 + index
+                 << R"""(", "size": ")""" << size << R"""("})""";
+              return make_status_or(
+                  internal::ResumableUploadResponse{"", size - 1, os.str()});
+            }));
+        return make_status_or(
+            std::unique_ptr<internal::ResumableUploadSession>(
+                std::move(session)));
+      }));
+}
+
+/// Mock DeleteObject() to record the deleted objects.
+void ParallelTransferTest::ExpectDeletes(int count) {
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .Times(count)
+      .WillRepeatedly(Invoke([this](internal::DeleteObjectRequest const& r) {
+        EXPECT_TRUE(r.HasOption<Generation>());
+        std::lock_guard<std::mutex> lk(mu);
+        deleted.insert(r.object_name());
+        return make_status_or(internal::EmptyResponse{});
+      }));
+}
+
+void ParallelTransferTest::WriteFile(std::string const& contents) const {
+  std::ofstream os(file_name, std::ios::binary);
+  os.write(contents.data(), contents.size());
+}
+
+/// @test Verify that UploadFile() uploads shards and composes them.
+TEST_F(ParallelTransferTest, UploadShards) {
+  auto const contents = MakeContents(1000);
+  WriteFile(contents);
+  ExpectShards(3, Status());
+  EXPECT_CALL(*mock, ComposeObject(_))
+      .WillOnce(Invoke([&](internal::ComposeObjectRequest const& r) {
+        EXPECT_EQ("test-object", r.object_name());
+        EXPECT_EQ(3U, r.source_objects().size());
+        std::string composed;
+        for (auto const& source : r.source_objects()) {
+          EXPECT_EQ(1U, shards.count(source.object_name));
+          EXPECT_TRUE(source.generation.has_value());
+          composed += shards[source.object_name];
+        }
+        EXPECT_EQ(contents, composed);
+        EXPECT_TRUE(r.HasOption<IfGenerationMatch>());
+        return make_status_or(MakeMetadata(contents, Crc32c(contents)));
+      }));
+  ExpectDeletes(3);
+
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket", "test-object",
+                         ParallelUploadShards(3), IfGenerationMatch(0));
+  ASSERT_TRUE(metadata.ok()) << "status=" << metadata.status();
+  EXPECT_EQ("test-object", metadata->name());
+
+  std::set<std::string> names;
+  for (auto const& kv : shards) {
+    names.insert(kv.first);
+    EXPECT_EQ(0U, kv.first.find("test-object.upload_")) << kv.first;
+  }
+  EXPECT_EQ(3U, names.size());
+  EXPECT_EQ(names, deleted);
+}
+
+/// @test Verify that concurrent uploads of the same object use unique names.
+TEST_F(ParallelTransferTest, UploadUniqueNames) {
+  auto const contents = MakeContents(100);
+  WriteFile(contents);
+  ExpectShards(4, Status());
+  EXPECT_CALL(*mock, ComposeObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](internal::ComposeObjectRequest const&) {
+        return make_status_or(MakeMetadata(contents, Crc32c(contents)));
+      }));
+  ExpectDeletes(4);
+
+  for (int i = 0; i != 2; ++i) {
+    auto metadata = client->UploadFile(file_name, "test-bucket", "test-object",
+                                       ParallelUploadShards(2));
+    ASSERT_TRUE(metadata.ok()) << "status=" << metadata.status();
+  }
+  EXPECT_EQ(4U, shards.size());
+  EXPECT_EQ(4U, deleted.size());
+}
+
+/// @test Verify that failed uploads delete their temporary objects.
+TEST_F(ParallelTransferTest, UploadFailureDeletesShards) {
+  auto const contents = MakeContents(1000);
+  WriteFile(contents);
+  ExpectShards(3, PermanentError());
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+  ExpectDeletes(2);
+
+  auto metadata = client->UploadFile(file_name, "test-bucket", "test-object",
+                                     ParallelUploadShards(3));
+  EXPECT_EQ(PermanentError().code(), metadata.status().code());
+  EXPECT_EQ(2U, deleted.size());
+  for (auto const& name : deleted) {
+    EXPECT_EQ(1U, shards.count(name)) << name;
+  }
+}
+
+/// @test Verify that failed uploads with a ParallelUploadId keep the shards.
+TEST_F(ParallelTransferTest, UploadFailureWithIdKeepsShards) {
+  auto const contents = MakeContents(1000);
+  WriteFile(contents);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([](internal::GetObjectMetadataRequest const&) {
+        return StatusOr<ObjectMetadata>(
+            Status(StatusCode::kNotFound, "not found"));
+      }));
+  ExpectShards(3, PermanentError());
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+  EXPECT_CALL(*mock, DeleteObject(_)).Times(0);
+
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket", "test-object",
+                         ParallelUploadShards(3), ParallelUploadId("my-id"));
+  EXPECT_EQ(PermanentError().code(), metadata.status().code());
+  for (auto const& kv : shards) {
+    EXPECT_EQ(0U, kv.first.find("test-object.upload_my-id_shard_"))
+        << kv.first;
+  }
+}
+
+/// @test Verify that a destination with a bad checksum is deleted.
+TEST_F(ParallelTransferTest, UploadChecksumMismatch) {
+  auto const contents = MakeContents(1000);
+  WriteFile(contents);
+  ExpectShards(3, Status());
+  EXPECT_CALL(*mock, ComposeObject(_))
+      .WillOnce(Invoke([&](internal::ComposeObjectRequest const&) {
+        return make_status_or(MakeMetadata(contents, Crc32c("wrong")));
+      }));
+  ExpectDeletes(4);
+
+  auto metadata = client->UploadFile(file_name, "test-bucket", "test-object",
+                                     ParallelUploadShards(3));
+  EXPECT_EQ(StatusCode::kDataLoss, metadata.status().code());
+  EXPECT_EQ(1U, deleted.count("test-object"));
+}
+
+/// @test Verify that options the compose API cannot honor are rejected.
+TEST_F(ParallelTransferTest, UploadUnsupportedOptions) {
+  auto const contents = MakeContents(1000);
+  WriteFile(contents);
+  EXPECT_CALL(*mock, CreateResumableSession(_)).Times(0);
+
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket", "test-object",
+                         ParallelUploadShards(3), IfGenerationNotMatch(7));
+  EXPECT_EQ(StatusCode::kInvalidArgument, metadata.status().code());
+  metadata =
+      client->UploadFile(file_name, "test-bucket", "test-object",
+                         ParallelUploadShards(3), IfMetagenerationNotMatch(7));
+  EXPECT_EQ(StatusCode::kInvalidArgument, metadata.status().code());
+  metadata = client->UploadFile(file_name, "test-bucket", "test-object",
+                                ParallelUploadShards(3), Projection::Full());
+  EXPECT_EQ(StatusCode::kInvalidArgument, metadata.status().code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
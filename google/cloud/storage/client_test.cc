@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/internal/metrics_client.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
@@ -144,6 +145,25 @@ TEST_F(ClientTest, DefaultDecorators) {
   ASSERT_TRUE(curl != nullptr);
 }
 
+TEST_F(ClientTest, MetricsDecorator) {
+  auto metrics = std::make_shared<ClientMetrics>();
+  Client tested(ClientOptions(oauth2::CreateAnonymousCredentials())
+                    .set_metrics(metrics));
+
+  auto retry = dynamic_cast<internal::RetryClient*>(tested.raw_client().get());
+  ASSERT_TRUE(retry != nullptr);
+
+  auto logging = dynamic_cast<internal::LoggingClient*>(retry->client().get());
+  ASSERT_TRUE(logging != nullptr);
+
+  auto recorder =
+      dynamic_cast<internal::MetricsClient*>(logging->client().get());
+  ASSERT_TRUE(recorder != nullptr);
+
+  auto curl = dynamic_cast<internal::CurlClient*>(recorder->client().get());
+  ASSERT_TRUE(curl != nullptr);
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
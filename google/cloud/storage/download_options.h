@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_DOWNLOAD_OPTIONS_H_
 
 #include "google/cloud/storage/internal/complex_option.h"
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -47,6 +48,25 @@ inline std::ostream& operator<<(std::ostream& os, ReadRangeData const& rhs) {
             << "}";
 }
 
+/**
+ * Download an object using multiple range requests in parallel.
+ *
+ * When this option is used in `Client::DownloadToFile()` the object is split
+ * into (at most) this many slices. Each slice is downloaded in a separate
+ * thread, using its own connection, and written directly to its position in
+ * the destination file. The CRC32C checksums of the slices are combined and
+ * compared against the checksum of the full object.
+ *
+ * The option is ignored if its value is less than 2, or if the download also
+ * uses the `ReadRange` option. Objects stored with `Content-Encoding: gzip` are
+ * always downloaded with a single request.
+ */
+struct ParallelDownloadSlices
+    : public internal::ComplexOption<ParallelDownloadSlices, std::size_t> {
+  using ComplexOption<ParallelDownloadSlices, std::size_t>::ComplexOption;
+  static char const* name() { return "parallel-download-slices"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
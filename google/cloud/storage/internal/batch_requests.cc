@@ -0,0 +1,372 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include "google/cloud/storage/internal/curl_handle.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Formats the query parameters and headers of an embedded request.
+ *
+ * Implements the same `AddOption()` overloads as `CurlRequestBuilder`, so the
+ * options in each request are sent exactly as they would be in a standalone
+ * request.
+ */
+class BatchPartBuilder {
+ public:
+  template <typename P>
+  BatchPartBuilder& AddOption(WellKnownParameter<P, std::string> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), p.value());
+    }
+    return *this;
+  }
+
+  template <typename P>
+  BatchPartBuilder& AddOption(WellKnownParameter<P, std::int64_t> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), std::to_string(p.value()));
+    }
+    return *this;
+  }
+
+  template <typename P>
+  BatchPartBuilder& AddOption(WellKnownParameter<P, bool> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), p.value() ? "true" : "false");
+    }
+    return *this;
+  }
+
+  template <typename P>
+  BatchPartBuilder& AddOption(WellKnownHeader<P, std::string> const& p) {
+    if (p.has_value()) {
+      AddHeader(std::string(p.header_name()) + ": " + p.value());
+    }
+    return *this;
+  }
+
+  BatchPartBuilder& AddOption(CustomHeader const& p) {
+    if (p.has_value()) {
+      AddHeader(p.custom_header_name() + ": " + p.value());
+    }
+    return *this;
+  }
+
+  BatchPartBuilder& AddOption(EncryptionKey const& p) {
+    if (p.has_value()) {
+      AddHeader(std::string(p.prefix()) + "algorithm: " + p.value().algorithm);
+      AddHeader(std::string(p.prefix()) + "key: " + p.value().key);
+      AddHeader(std::string(p.prefix()) + "key-sha256: " + p.value().sha256);
+    }
+    return *this;
+  }
+
+  template <typename Option, typename T>
+  BatchPartBuilder& AddOption(ComplexOption<Option, T> const&) {
+    return *this;
+  }
+
+  void AddQueryParameter(std::string const& key, std::string const& value) {
+    query_ += query_.empty() ? "?" : "&";
+    query_ += Escape(key) + "=" + Escape(value);
+  }
+
+  void AddHeader(std::string header) {
+    headers_ += std::move(header) + "\r\n";
+  }
+
+  std::string Escape(std::string const& value) {
+    return std::string(handle_.MakeEscapedString(value).get());
+  }
+
+  template <typename Request>
+  std::string Format(char const* method, std::string const& api_path,
+                     Request const& request, std::string const& payload) {
+    request.AddOptionsToHttpRequest(*this);
+    if (request.template HasOption<UserIp>() &&
+        !request.template GetOption<UserIp>().value().empty()) {
+      AddQueryParameter(UserIp::name(),
+                        request.template GetOption<UserIp>().value());
+    }
+    if (!payload.empty()) {
+      AddHeader("Content-Type: application/json; charset=UTF-8");
+      AddHeader("Content-Length: " + std::to_string(payload.size()));
+    }
+    return std::string(method) + " " + api_path + "/b/" +
+           request.bucket_name() + "/o/" + Escape(request.object_name()) +
+           query_ + " HTTP/1.1\r\n" + headers_ + "\r\n" + payload;
+  }
+
+ private:
+  CurlHandle handle_;
+  std::string query_;
+  std::string headers_;
+};
+
+/// Returns the position of the blank line separating headers from the body.
+std::size_t FindEndOfHeaders(std::string const& text, std::size_t pos) {
+  return text.find("\r\n\r\n", pos);
+}
+
+/// Parses `Name: value` header lines in @p text, names are lowercase.
+std::multimap<std::string, std::string> ParseHeaders(std::string const& text) {
+  std::multimap<std::string, std::string> headers;
+  std::istringstream is(text);
+  std::string line;
+  while (std::getline(is, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    auto colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    auto name = line.substr(0, colon);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](char c) { return static_cast<char>(std::tolower(c)); });
+    auto value = line.substr(colon + 1);
+    auto begin = value.find_first_not_of(' ');
+    headers.emplace(std::move(name), begin == std::string::npos
+                                         ? std::string{}
+                                         : value.substr(begin));
+  }
+  return headers;
+}
+
+/// Parses the HTTP response embedded in one part of a batch response.
+StatusOr<HttpResponse> ParseEmbeddedResponse(std::string const& text) {
+  auto end_of_status_line = text.find("\r\n");
+  if (text.compare(0, 5, "HTTP/") != 0 ||
+      end_of_status_line == std::string::npos) {
+    return Status(StatusCode::kInternal,
+                  "invalid status line in batch response part");
+  }
+  auto space = text.find(' ');
+  HttpResponse response;
+  response.status_code = std::strtol(text.c_str() + space + 1, nullptr, 10);
+  auto end_of_headers = FindEndOfHeaders(text, end_of_status_line);
+  if (end_of_headers == std::string::npos) {
+    // A response without a body, only the empty line is missing.
+    response.headers = ParseHeaders(text.substr(end_of_status_line + 2));
+    return response;
+  }
+  response.headers = ParseHeaders(text.substr(
+      end_of_status_line + 2, end_of_headers - end_of_status_line - 2));
+  response.payload = text.substr(end_of_headers + 4);
+  return response;
+}
+
+/// Converts the embedded response for @p operation to the result type.
+StatusOr<ObjectMetadata> ParseOperationResult(BatchOperation const& operation,
+                                              HttpResponse const& response) {
+  if (response.status_code >= 300) {
+    return AsStatus(response);
+  }
+  if (operation.type == BatchOperation::kDeleteObject) {
+    return ObjectMetadata{};
+  }
+  return ObjectMetadataParser::FromString(response.payload);
+}
+
+std::string BoundaryFromContentType(std::string const& content_type) {
+  auto pos = content_type.find("boundary=");
+  if (pos == std::string::npos) {
+    return std::string{};
+  }
+  auto boundary = content_type.substr(pos + 9);
+  boundary = boundary.substr(0, boundary.find(';'));
+  if (boundary.size() >= 2 && boundary.front() == '"' &&
+      boundary.back() == '"') {
+    boundary = boundary.substr(1, boundary.size() - 2);
+  }
+  return boundary;
+}
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, BatchOperation const& r) {
+  switch (r.type) {
+    case BatchOperation::kDeleteObject:
+      return os << r.delete_object;
+    case BatchOperation::kGetObjectMetadata:
+      return os << r.get_object_metadata;
+    case BatchOperation::kPatchObject:
+      return os << r.patch_object;
+  }
+  return os;
+}
+
+void BatchRequest::AddOperation(DeleteObjectRequest request) {
+  BatchOperation operation{};
+  operation.type = BatchOperation::kDeleteObject;
+  operation.delete_object = std::move(request);
+  AddOperation(std::move(operation));
+}
+
+void BatchRequest::AddOperation(GetObjectMetadataRequest request) {
+  BatchOperation operation{};
+  operation.type = BatchOperation::kGetObjectMetadata;
+  operation.get_object_metadata = std::move(request);
+  AddOperation(std::move(operation));
+}
+
+void BatchRequest::AddOperation(PatchObjectRequest request) {
+  BatchOperation operation{};
+  operation.type = BatchOperation::kPatchObject;
+  operation.patch_object = std::move(request);
+  AddOperation(std::move(operation));
+}
+
+std::ostream& operator<<(std::ostream& os, BatchRequest const& r) {
+  os << "BatchRequest={operations=[";
+  char const* sep = "";
+  for (auto const& operation : r.operations()) {
+    os << sep << operation;
+    sep = ", ";
+  }
+  return os << "]}";
+}
+
+std::string FormatBatchOperation(BatchOperation const& operation,
+                                 std::string const& api_path) {
+  BatchPartBuilder builder;
+  switch (operation.type) {
+    case BatchOperation::kDeleteObject:
+      return builder.Format("DELETE", api_path, operation.delete_object,
+                            std::string{});
+    case BatchOperation::kGetObjectMetadata:
+      return builder.Format("GET", api_path, operation.get_object_metadata,
+                            std::string{});
+    case BatchOperation::kPatchObject:
+      return builder.Format("PATCH", api_path, operation.patch_object,
+                            operation.patch_object.payload());
+  }
+  return std::string{};
+}
+
+std::string FormatBatchPayload(std::vector<std::string> const& parts,
+                               std::string const& boundary) {
+  std::string crlf = "\r\n";
+  std::string marker = "--" + boundary;
+  std::string payload;
+  for (std::size_t i = 0; i != parts.size(); ++i) {
+    payload += marker + crlf;
+    payload += "Content-Type: application/http" + crlf;
+    payload += "Content-ID: <item-" + std::to_string(i) + ">" + crlf;
+    payload += crlf;
+    payload += parts[i] + crlf;
+  }
+  payload += marker + "--" + crlf;
+  return payload;
+}
+
+StatusOr<BatchResponse> BatchResponse::FromHttpResponse(
+    BatchRequest const& request, HttpResponse const& response) {
+  if (response.status_code >= 300) {
+    return AsStatus(response);
+  }
+  auto content_type = response.headers.find("content-type");
+  auto boundary = content_type == response.headers.end()
+                      ? std::string{}
+                      : BoundaryFromContentType(content_type->second);
+  if (boundary.empty()) {
+    return Status(StatusCode::kInternal,
+                  "missing multipart boundary in batch response");
+  }
+
+  std::vector<StatusOr<ObjectMetadata>> results(
+      request.size(),
+      StatusOr<ObjectMetadata>(
+          Status(StatusCode::kInternal,
+                 "missing operation result in batch response")));
+  std::string const& payload = response.payload;
+  std::string const marker = "--" + boundary;
+  auto pos = payload.find(marker);
+  while (pos != std::string::npos) {
+    auto begin = pos + marker.size();
+    if (payload.compare(begin, 2, "--") == 0) {
+      break;  // The closing delimiter.
+    }
+    auto end = payload.find(marker, begin);
+    auto part = payload.substr(
+        begin, end == std::string::npos ? std::string::npos : end - begin);
+    pos = end;
+
+    // Each part has its own headers, followed by the embedded HTTP response,
+    // and a CRLF that belongs to the next delimiter.
+    auto end_of_headers = FindEndOfHeaders(part, 0);
+    if (end_of_headers == std::string::npos) {
+      continue;
+    }
+    auto part_headers = ParseHeaders(part.substr(0, end_of_headers));
+    auto content_id = part_headers.find("content-id");
+    if (content_id == part_headers.end()) {
+      continue;
+    }
+    std::string const prefix = "response-item-";
+    auto id = content_id->second.find(prefix);
+    if (id == std::string::npos) {
+      continue;
+    }
+    auto index = static_cast<std::size_t>(
+        std::strtoul(content_id->second.c_str() + id + prefix.size(), nullptr,
+                     10));
+    if (index >= results.size()) {
+      continue;
+    }
+    auto body = part.substr(end_of_headers + 4);
+    if (body.size() >= 2 && body.compare(body.size() - 2, 2, "\r\n") == 0) {
+      body.resize(body.size() - 2);
+    }
+    auto embedded = ParseEmbeddedResponse(body);
+    if (!embedded) {
+      results[index] = StatusOr<ObjectMetadata>(std::move(embedded).status());
+      continue;
+    }
+    results[index] =
+        ParseOperationResult(request.operations()[index], *embedded);
+  }
+  return BatchResponse{std::move(results)};
+}
+
+std::ostream& operator<<(std::ostream& os, BatchResponse const& r) {
+  os << "BatchResponse={results=[";
+  char const* sep = "";
+  for (auto const& result : r.results) {
+    os << sep;
+    if (result) {
+      os << *result;
+    } else {
+      os << result.status();
+    }
+    sep = ", ";
+  }
+  return os << "]}";
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,120 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H_
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/object_metadata.h"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/// The maximum number of operations the service accepts in a batch request.
+constexpr std::size_t kMaxBatchSize = 100;
+
+/**
+ * One of the operations in a batch request.
+ *
+ * Only the request matching `type` is initialized.
+ */
+struct BatchOperation {
+  enum Type { kDeleteObject, kGetObjectMetadata, kPatchObject };
+
+  Type type;
+  DeleteObjectRequest delete_object;
+  GetObjectMetadataRequest get_object_metadata;
+  PatchObjectRequest patch_object;
+};
+
+std::ostream& operator<<(std::ostream& os, BatchOperation const& r);
+
+/**
+ * Represents a request to the JSON API batch endpoint.
+ *
+ * The batch endpoint combines multiple API calls in a single HTTP request,
+ * each call is sent as one part of a `multipart/mixed` payload, see:
+ *     https://cloud.google.com/storage/docs/json_api/v1/how-tos/batch
+ */
+class BatchRequest {
+ public:
+  BatchRequest() = default;
+
+  void AddOperation(BatchOperation operation) {
+    operations_.push_back(std::move(operation));
+  }
+  void AddOperation(DeleteObjectRequest request);
+  void AddOperation(GetObjectMetadataRequest request);
+  void AddOperation(PatchObjectRequest request);
+
+  std::vector<BatchOperation> const& operations() const { return operations_; }
+  std::size_t size() const { return operations_.size(); }
+  bool empty() const { return operations_.empty(); }
+
+ private:
+  std::vector<BatchOperation> operations_;
+};
+
+std::ostream& operator<<(std::ostream& os, BatchRequest const& r);
+
+/**
+ * Formats @p operation as an HTTP request embedded in a batch request.
+ *
+ * @param operation the operation to format.
+ * @param api_path the path of the JSON API in the service, for example,
+ *     `/storage/v1`.
+ */
+std::string FormatBatchOperation(BatchOperation const& operation,
+                                 std::string const& api_path);
+
+/**
+ * Formats the `multipart/mixed` payload for a batch request.
+ *
+ * The i-th element of @p parts becomes the part with `Content-ID: <item-i>`,
+ * the service returns its response in the part with
+ * `Content-ID: <response-item-i>`.
+ */
+std::string FormatBatchPayload(std::vector<std::string> const& parts,
+                               std::string const& boundary);
+
+/**
+ * The results of a batch request.
+ *
+ * `results[i]` contains the result of the i-th operation in the request.
+ * Successful deletes return an empty `ObjectMetadata`.
+ */
+struct BatchResponse {
+  static StatusOr<BatchResponse> FromHttpResponse(BatchRequest const& request,
+                                                  HttpResponse const& response);
+
+  std::vector<StatusOr<ObjectMetadata>> results;
+};
+
+std::ostream& operator<<(std::ostream& os, BatchResponse const& r);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H_
@@ -0,0 +1,193 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::HasSubstr;
+using ::testing::Not;
+using ::testing::StartsWith;
+
+BatchOperation MakeOperation(DeleteObjectRequest r) {
+  BatchRequest request;
+  request.AddOperation(std::move(r));
+  return request.operations().front();
+}
+
+TEST(BatchRequestsTest, AddOperation) {
+  BatchRequest request;
+  EXPECT_TRUE(request.empty());
+  request.AddOperation(DeleteObjectRequest("my-bucket", "obj-1"));
+  request.AddOperation(GetObjectMetadataRequest("my-bucket", "obj-2"));
+  request.AddOperation(
+      PatchObjectRequest("my-bucket", "obj-3",
+                         ObjectMetadataPatchBuilder().SetContentType("a/b")));
+  ASSERT_EQ(3U, request.size());
+  EXPECT_EQ(BatchOperation::kDeleteObject, request.operations()[0].type);
+  EXPECT_EQ("obj-1", request.operations()[0].delete_object.object_name());
+  EXPECT_EQ(BatchOperation::kGetObjectMetadata, request.operations()[1].type);
+  EXPECT_EQ("obj-2", request.operations()[1].get_object_metadata.object_name());
+  EXPECT_EQ(BatchOperation::kPatchObject, request.operations()[2].type);
+  EXPECT_EQ("obj-3", request.operations()[2].patch_object.object_name());
+
+  std::ostringstream os;
+  os << request;
+  EXPECT_THAT(os.str(), HasSubstr("DeleteObjectRequest={"));
+  EXPECT_THAT(os.str(), HasSubstr("GetObjectMetadataRequest={"));
+  EXPECT_THAT(os.str(), HasSubstr("PatchObjectRequest={"));
+}
+
+TEST(BatchRequestsTest, FormatDelete) {
+  DeleteObjectRequest r("my-bucket", "dir/obj 1");
+  r.set_multiple_options(Generation(7), UserProject("my-project"),
+                         CustomHeader("x-test-header", "v"));
+  auto actual =
+      FormatBatchOperation(MakeOperation(std::move(r)), "/storage/v1");
+  EXPECT_THAT(actual,
+              StartsWith("DELETE /storage/v1/b/my-bucket/o/dir%2Fobj%201"
+                         "?generation=7&userProject=my-project HTTP/1.1\r\n"));
+  EXPECT_THAT(actual, HasSubstr("\r\nx-test-header: v\r\n"));
+  EXPECT_THAT(actual, Not(HasSubstr("Content-Type")));
+}
+
+TEST(BatchRequestsTest, FormatPatch) {
+  BatchRequest request;
+  request.AddOperation(PatchObjectRequest(
+      "my-bucket", "obj", ObjectMetadataPatchBuilder().SetContentType("a/b")));
+  auto const& patch = request.operations().front().patch_object;
+  auto actual = FormatBatchOperation(request.operations().front(), "/v1");
+  EXPECT_THAT(actual, StartsWith("PATCH /v1/b/my-bucket/o/obj HTTP/1.1\r\n"));
+  EXPECT_THAT(actual, HasSubstr("Content-Type: application/json"));
+  EXPECT_THAT(actual,
+              HasSubstr("Content-Length: " +
+                        std::to_string(patch.payload().size()) + "\r\n"));
+  EXPECT_THAT(actual, HasSubstr("\r\n\r\n" + patch.payload()));
+}
+
+TEST(BatchRequestsTest, FormatPayload) {
+  auto actual =
+      FormatBatchPayload({"GET /a HTTP/1.1\r\n\r\n", "GET /b"}, "xyz");
+  EXPECT_EQ(
+      "--xyz\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <item-0>\r\n"
+      "\r\n"
+      "GET /a HTTP/1.1\r\n\r\n\r\n"
+      "--xyz\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <item-1>\r\n"
+      "\r\n"
+      "GET /b\r\n"
+      "--xyz--\r\n",
+      actual);
+}
+
+TEST(BatchRequestsTest, ParseResponse) {
+  BatchRequest request;
+  request.AddOperation(DeleteObjectRequest("my-bucket", "obj-1"));
+  request.AddOperation(GetObjectMetadataRequest("my-bucket", "obj-2"));
+  request.AddOperation(GetObjectMetadataRequest("my-bucket", "obj-3"));
+  request.AddOperation(GetObjectMetadataRequest("my-bucket", "obj-4"));
+
+  // The parts are out of order, and the result for obj-4 is missing.
+  std::string payload =
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item-1>\r\n"
+      "\r\n"
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: application/json; charset=UTF-8\r\n"
+      "\r\n"
+      R"""({"bucket": "my-bucket", "name": "obj-2"})"""
+      "\r\n"
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item-0>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n"
+      "\r\n"
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item-2>\r\n"
+      "\r\n"
+      "HTTP/1.1 404 Not Found\r\n"
+      "\r\n"
+      "No such object\r\n"
+      "--batch_abc--\r\n";
+  HttpResponse response{
+      200,
+      payload,
+      {{"content-type", "multipart/mixed; boundary=batch_abc"}}};
+  auto actual = BatchResponse::FromHttpResponse(request, response);
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  ASSERT_EQ(4U, actual->results.size());
+  ASSERT_TRUE(actual->results[0].ok()) << actual->results[0].status();
+  EXPECT_EQ(ObjectMetadata{}, *actual->results[0]);
+  ASSERT_TRUE(actual->results[1].ok()) << actual->results[1].status();
+  EXPECT_EQ("obj-2", actual->results[1]->name());
+  EXPECT_EQ(StatusCode::kNotFound, actual->results[2].status().code());
+  EXPECT_EQ("No such object", actual->results[2].status().message());
+  EXPECT_EQ(StatusCode::kInternal, actual->results[3].status().code());
+
+  std::ostringstream os;
+  os << *actual;
+  EXPECT_THAT(os.str(), HasSubstr("BatchResponse={results=["));
+  EXPECT_THAT(os.str(), HasSubstr("obj-2"));
+}
+
+TEST(BatchRequestsTest, ParseResponseQuotedBoundary) {
+  BatchRequest request;
+  request.AddOperation(DeleteObjectRequest("my-bucket", "obj-1"));
+  HttpResponse response{200,
+                        "--b\r\n"
+                        "Content-ID: <response-item-0>\r\n"
+                        "\r\n"
+                        "HTTP/1.1 503 Service Unavailable\r\n"
+                        "\r\n"
+                        "try again\r\n"
+                        "--b--\r\n",
+                        {{"content-type", "multipart/mixed; boundary=\"b\""}}};
+  auto actual = BatchResponse::FromHttpResponse(request, response);
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  ASSERT_EQ(1U, actual->results.size());
+  EXPECT_EQ(StatusCode::kUnavailable, actual->results[0].status().code());
+}
+
+TEST(BatchRequestsTest, ParseResponseErrors) {
+  BatchRequest request;
+  request.AddOperation(DeleteObjectRequest("my-bucket", "obj-1"));
+
+  auto actual = BatchResponse::FromHttpResponse(
+      request, HttpResponse{401, "unauthorized", {}});
+  EXPECT_EQ(StatusCode::kUnauthenticated, actual.status().code());
+
+  actual = BatchResponse::FromHttpResponse(
+      request, HttpResponse{200, "", {{"content-type", "text/plain"}}});
+  EXPECT_EQ(StatusCode::kInternal, actual.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
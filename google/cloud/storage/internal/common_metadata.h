@@ -19,6 +19,7 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/internal/metadata_parser.h"
 #include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/internal/parse_rfc3339.h"
 #include <chrono>
 #include <map>
 #include <vector>
@@ -95,6 +96,61 @@ class CommonMetadata {
     result.updated_ = ParseTimestampField(json, "updated");
     return Status();
   }
+  /**
+   * Sets one of the common fields from a scalar JSON value.
+   *
+   * Used by parsers that do not create a JSON DOM. Numbers and booleans are
+   * passed in their JSON text form, @p parent is the name of the enclosing
+   * object for nested fields (e.g. "owner"), or empty for top-level fields.
+   *
+   * @return true if @p key names one of the common fields, or an error if its
+   *     value cannot be parsed.
+   */
+  static StatusOr<bool> SetField(CommonMetadata<Derived>& result,
+                                 std::string const& parent,
+                                 std::string const& key, std::string& value) {
+    if (parent == "owner") {
+      if (!result.owner_.has_value()) {
+        result.owner_ = Owner{};
+      }
+      if (key == "entity") {
+        result.owner_->entity = std::move(value);
+      } else if (key == "entityId") {
+        result.owner_->entity_id = std::move(value);
+      }
+      return true;
+    }
+    if (!parent.empty()) {
+      return false;
+    }
+    if (key == "etag") {
+      result.etag_ = std::move(value);
+    } else if (key == "id") {
+      result.id_ = std::move(value);
+    } else if (key == "kind") {
+      result.kind_ = std::move(value);
+    } else if (key == "metageneration") {
+      auto parsed = ParseLongValue(value, "metageneration");
+      if (!parsed) {
+        return std::move(parsed).status();
+      }
+      result.metageneration_ = *parsed;
+    } else if (key == "name") {
+      result.name_ = std::move(value);
+    } else if (key == "selfLink") {
+      result.self_link_ = std::move(value);
+    } else if (key == "storageClass") {
+      result.storage_class_ = std::move(value);
+    } else if (key == "timeCreated") {
+      result.time_created_ = ParseRfc3339(value);
+    } else if (key == "updated") {
+      result.updated_ = ParseRfc3339(value);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
   static StatusOr<CommonMetadata> ParseFromString(std::string const& payload) {
     auto json = internal::nl::json::parse(payload);
     return ParseFromJson(json);
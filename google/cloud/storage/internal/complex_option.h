@@ -18,6 +18,7 @@
 #include "google/cloud/optional.h"
 #include "google/cloud/storage/version.h"
 #include <iostream>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -47,6 +48,10 @@ class ComplexOption {
   char const* option_name() const { return Derived::name(); }
   bool has_value() const { return value_.has_value(); }
   T const& value() const { return value_.value(); }
+  template <typename U>
+  T value_or(U&& default_value) const {
+    return value_.value_or(std::forward<U>(default_value));
+  }
 
  private:
   google::cloud::optional<T> value_;
@@ -21,6 +21,7 @@
 #include "google/cloud/storage/internal/curl_streambuf.h"
 #include "google/cloud/storage/internal/generate_message_boundary.h"
 #include "google/cloud/storage/object_stream.h"
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -29,15 +30,16 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 namespace {
 
-extern "C" void CurlShareLockCallback(CURL*, curl_lock_data, curl_lock_access,
-                                      void* userptr) {
+extern "C" void CurlShareLockCallback(CURL*, curl_lock_data data,
+                                      curl_lock_access, void* userptr) {
   auto* client = reinterpret_cast<CurlClient*>(userptr);
-  client->LockShared();
+  client->LockShared(data);
 }
 
-extern "C" void CurlShareUnlockCallback(CURL*, curl_lock_data, void* userptr) {
+extern "C" void CurlShareUnlockCallback(CURL*, curl_lock_data data,
+                                        void* userptr) {
   auto* client = reinterpret_cast<CurlClient*>(userptr);
-  client->UnlockShared();
+  client->UnlockShared(data);
 }
 
 std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
@@ -49,37 +51,81 @@ std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
       options.connection_pool_size());
 }
 
+// Downloads using an adaptive buffer start with this size, or with the
+// maximum size if it is smaller.
+constexpr std::size_t kMinimumAdaptiveDownloadBufferSize = 16 * 1024;
+
+/// Create the streambuf for a download, using the buffer size options.
+std::unique_ptr<CurlReadStreambuf> CreateReadStreambuf(
+    ClientOptions const& options, CurlRequestBuilder& builder,
+    std::unique_ptr<HashValidator> hash_validator) {
+  auto const maximum = options.download_buffer_size();
+  if (!options.enable_adaptive_download_buffer()) {
+    builder.SetInitialBufferSize(maximum);
+    return google::cloud::internal::make_unique<CurlReadStreambuf>(
+        builder.BuildDownloadRequest(std::string{}), maximum,
+        std::move(hash_validator));
+  }
+  auto sizer = google::cloud::internal::make_unique<DownloadBufferSizer>(
+      (std::min)(kMinimumAdaptiveDownloadBufferSize, maximum), maximum);
+  builder.SetInitialBufferSize(sizer->buffer_size());
+  return google::cloud::internal::make_unique<CurlReadStreambuf>(
+      builder.BuildDownloadRequest(std::string{}), maximum,
+      std::move(hash_validator), std::move(sizer));
+}
+
+// Streaming transfers compute the MD5 hash of chunks at least this large in
+// background threads, smaller chunks are not worth the hand off.
+constexpr std::size_t kMinBackgroundHashBytes = 256 * 1024;
+
+/**
+ * Create the validator for the given options.
+ *
+ * When @p pipelined is true the MD5 hash of large chunks is computed in a
+ * background thread, in parallel with the CRC32C checksum. Use this for
+ * streaming transfers, where the data arrives in large chunks. The CRC32C
+ * checksum uses the SSE4.2 or ARMv8 CRC instructions when available, it is
+ * faster than MD5, so it always runs inline.
+ */
 std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
-                                                   bool disable_crc32c) {
+                                                   bool disable_crc32c,
+                                                   bool pipelined) {
   if (disable_md5 && disable_crc32c) {
     return google::cloud::internal::make_unique<NullHashValidator>();
   }
   if (disable_md5) {
     return google::cloud::internal::make_unique<Crc32cHashValidator>();
   }
+  std::unique_ptr<HashValidator> md5 =
+      google::cloud::internal::make_unique<MD5HashValidator>();
+  if (pipelined) {
+    md5 = google::cloud::internal::make_unique<PipelinedHashValidator>(
+        std::move(md5), kMinBackgroundHashBytes);
+  }
   if (disable_crc32c) {
-    return google::cloud::internal::make_unique<MD5HashValidator>();
+    return md5;
   }
   return google::cloud::internal::make_unique<CompositeValidator>(
       google::cloud::internal::make_unique<Crc32cHashValidator>(),
-      google::cloud::internal::make_unique<MD5HashValidator>());
+      std::move(md5));
 }
 
 /// Create a HashValidator for a download request.
 std::unique_ptr<HashValidator> CreateHashValidator(
-    ReadObjectRangeRequest const& request) {
+    ReadObjectRangeRequest const& request, bool pipelined = true) {
   if (request.HasOption<ReadRange>()) {
     return google::cloud::internal::make_unique<NullHashValidator>();
   }
   return CreateHashValidator(request.HasOption<DisableMD5Hash>(),
-                             request.HasOption<DisableCrc32cChecksum>());
+                             request.HasOption<DisableCrc32cChecksum>(),
+                             pipelined);
 }
 
 /// Create a HashValidator for an upload request.
 std::unique_ptr<HashValidator> CreateHashValidator(
     InsertObjectStreamingRequest const& request) {
   return CreateHashValidator(request.HasOption<DisableMD5Hash>(),
-                             request.HasOption<DisableCrc32cChecksum>());
+                             request.HasOption<DisableCrc32cChecksum>(), true);
 }
 
 /// Create a HashValidator for an insert request.
@@ -153,6 +199,48 @@ StatusOr<ReturnType> ParseFromHttpResponse(StatusOr<HttpResponse> response) {
   return ReturnType::FromHttpResponse(std::move(*response));
 }
 
+/**
+ * Formats the multipart payload of an InsertObjectMedia request.
+ *
+ * Returns the text before and after the object contents: the first part (the
+ * object metadata), the headers of the second part, and the final separator.
+ */
+std::pair<std::string, std::string> MultipartUploadEnvelope(
+    InsertObjectMediaRequest const& request, std::string const& boundary) {
+  nl::json metadata = nl::json::object();
+  if (request.HasOption<WithObjectMetadata>()) {
+    metadata = ObjectMetadataJsonForUpdate(
+        request.GetOption<WithObjectMetadata>().value());
+  }
+  if (request.HasOption<MD5HashValue>()) {
+    metadata["md5Hash"] = request.GetOption<MD5HashValue>().value();
+  } else {
+    metadata["md5Hash"] = ComputeMD5Hash(request.contents());
+  }
+
+  if (request.HasOption<Crc32cChecksumValue>()) {
+    metadata["crc32c"] = request.GetOption<Crc32cChecksumValue>().value();
+  } else {
+    metadata["crc32c"] = ComputeCrc32cChecksum(request.contents());
+  }
+
+  std::string content_type = "application/octet-stream";
+  if (request.HasOption<ContentType>()) {
+    content_type = request.GetOption<ContentType>().value();
+  } else if (metadata.count("contentType") != 0) {
+    content_type = metadata.value("contentType", content_type);
+  }
+
+  std::string const crlf = "\r\n";
+  std::string const marker = "--" + boundary;
+  // The first part has the metadata, the second part has the contents.
+  auto header = marker + crlf +
+                "content-type: application/json; charset=UTF-8" + crlf + crlf +
+                metadata.dump() + crlf + marker + crlf +
+                "content-type: " + content_type + crlf + crlf;
+  auto trailer = crlf + marker + "--" + crlf;
+  return {std::move(header), std::move(trailer)};
+}
 }  // namespace
 
 Status CurlClient::SetupBuilderCommon(CurlRequestBuilder& builder,
@@ -269,6 +357,11 @@ CurlClient::CurlClient(ClientOptions options)
   curl_share_setopt(share_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
 
   CurlInitializeOnce(options.enable_ssl_locking_callbacks());
+
+  if (options_.download_reactor_threads() != 0) {
+    reactor_ =
+        std::make_shared<CurlMultiReactor>(options_.download_reactor_threads());
+  }
 }
 
 StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
@@ -559,10 +652,9 @@ StatusOr<std::unique_ptr<ObjectReadStreambuf>> CurlClient::ReadObject(
     builder.AddHeader("Cache-Control: no-transform");
   }
 
-  std::unique_ptr<CurlReadStreambuf> buf(new CurlReadStreambuf(
-      builder.BuildDownloadRequest(std::string{}),
-      client_options().download_buffer_size(), CreateHashValidator(request)));
-  return std::unique_ptr<ObjectReadStreambuf>(std::move(buf));
+  builder.SetReactor(reactor_);
+  return std::unique_ptr<ObjectReadStreambuf>(CreateReadStreambuf(
+      client_options(), builder, CreateHashValidator(request)));
 }
 
 StatusOr<std::unique_ptr<ObjectWriteStreambuf>> CurlClient::WriteObject(
@@ -1053,9 +1145,218 @@ StatusOr<EmptyResponse> CurlClient::DeleteNotification(
   return ReturnEmptyResponse(builder.BuildRequest().MakeRequest(std::string{}));
 }
 
-void CurlClient::LockShared() { mu_.lock(); }
+future<StatusOr<ObjectMetadata>> CurlClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  CurlRequestBuilder builder(
+      upload_endpoint_ + "/b/" + request.bucket_name() + "/o", upload_factory_);
+  auto status = SetupBuilder(builder, request, "POST");
+  if (!status.ok()) {
+    return make_ready_future(StatusOr<ObjectMetadata>(std::move(status)));
+  }
+  builder.AddQueryParameter("name", request.object_name());
+
+  std::string payload;
+  if (request.HasOption<WithObjectMetadata>() ||
+      (!request.HasOption<DisableMD5Hash>() &&
+       !request.HasOption<DisableCrc32cChecksum>())) {
+    // Use the same format as InsertObjectMediaMultipart(), but assemble the
+    // payload in memory, the contents are already there anyway.
+    auto boundary = PickBoundary(request.contents());
+    builder.AddHeader("content-type: multipart/related; boundary=" + boundary);
+    builder.AddQueryParameter("uploadType", "multipart");
+    auto envelope = MultipartUploadEnvelope(request, boundary);
+    payload = std::move(envelope.first);
+    payload += request.contents();
+    payload += envelope.second;
+  } else {
+    // Same as InsertObjectMediaSimple().
+    if (!request.HasOption<ContentType>()) {
+      builder.AddHeader("content-type: application/octet-stream");
+    }
+    builder.AddQueryParameter("uploadType", "media");
+    payload = request.contents();
+  }
+  builder.AddHeader("Content-Length: " + std::to_string(payload.size()));
+  return builder.BuildRequest()
+      .MakeRequestAsync(std::move(payload), AsyncReactor())
+      .then([](future<StatusOr<HttpResponse>> f) {
+        return CheckedFromString<ObjectMetadataParser>(f.get());
+      });
+}
+
+future<StatusOr<ListObjectsResponse>> CurlClient::AsyncListObjects(
+    ListObjectsRequest const& request) {
+  CurlRequestBuilder builder(
+      storage_endpoint_ + "/b/" + request.bucket_name() + "/o",
+      storage_factory_);
+  auto status = SetupBuilder(builder, request, "GET");
+  if (!status.ok()) {
+    return make_ready_future(StatusOr<ListObjectsResponse>(std::move(status)));
+  }
+  builder.AddQueryParameter("pageToken", request.page_token());
+  return builder.BuildRequest()
+      .MakeRequestAsync(std::string{}, AsyncReactor())
+      .then([](future<StatusOr<HttpResponse>> f) {
+        return ParseFromHttpResponse<ListObjectsResponse>(f.get());
+      });
+}
+
+future<StatusOr<ObjectMetadata>> CurlClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
+                                 "/o/" + UrlEscapeString(request.object_name()),
+                             storage_factory_);
+  auto status = SetupBuilder(builder, request, "GET");
+  if (!status.ok()) {
+    return make_ready_future(StatusOr<ObjectMetadata>(std::move(status)));
+  }
+  return builder.BuildRequest()
+      .MakeRequestAsync(std::string{}, AsyncReactor())
+      .then([](future<StatusOr<HttpResponse>> f) {
+        return CheckedFromString<ObjectMetadataParser>(f.get());
+      });
+}
+
+future<StatusOr<std::string>> CurlClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
+                                 "/o/" + UrlEscapeString(request.object_name()),
+                             storage_factory_);
+  auto status = SetupBuilder(builder, request, "GET");
+  if (!status.ok()) {
+    return make_ready_future(StatusOr<std::string>(std::move(status)));
+  }
+  builder.AddQueryParameter("alt", "media");
+  if (request.HasOption<ReadRange>()) {
+    auto range = request.GetOption<ReadRange>().value();
+    builder.AddHeader("Range: bytes=" + std::to_string(range.begin) + "-" +
+                      std::to_string(range.end - 1));
+    // See ReadObject() for why decompression is disabled for range reads.
+    builder.AddHeader("Cache-Control: no-transform");
+  }
+  // std::function<> requires copyable functors, wrap the validator in a
+  // shared_ptr. The payload is hashed in a single call, there is nothing to
+  // overlap with a background thread.
+  std::shared_ptr<HashValidator> validator =
+      CreateHashValidator(request, false);
+  return builder.BuildRequest()
+      .MakeRequestAsync(std::string{}, AsyncReactor())
+      .then([validator](future<StatusOr<HttpResponse>> f)
+                -> StatusOr<std::string> {
+        auto response = f.get();
+        if (!response.ok()) {
+          return std::move(response).status();
+        }
+        if (response->status_code >= 300) {
+          return AsStatus(*response);
+        }
+        for (auto const& kv : response->headers) {
+          validator->ProcessHeader(kv.first, kv.second);
+        }
+        validator->Update(response->payload);
+        auto result = std::move(*validator).Finish();
+        if (result.is_mismatch) {
+          return Status(StatusCode::kDataLoss,
+                        "AsyncReadObject() - mismatched hashes in download"
+                        ", expected=" +
+                            result.computed + ", received=" + result.received);
+        }
+        return std::move(response->payload);
+      });
+}
+
+future<StatusOr<EmptyResponse>> CurlClient::AsyncDeleteObject(
+    DeleteObjectRequest const& request) {
+  CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
+                                 "/o/" + UrlEscapeString(request.object_name()),
+                             storage_factory_);
+  auto status = SetupBuilder(builder, request, "DELETE");
+  if (!status.ok()) {
+    return make_ready_future(StatusOr<EmptyResponse>(std::move(status)));
+  }
+  return builder.BuildRequest()
+      .MakeRequestAsync(std::string{}, AsyncReactor())
+      .then([](future<StatusOr<HttpResponse>> f) {
+        return ReturnEmptyResponse(f.get());
+      });
+}
+
+StatusOr<BatchResponse> CurlClient::ExecuteBatch(BatchRequest const& request) {
+  // The service limits the number of operations in each batch, larger
+  // requests are sent as multiple batches. A failure in one of these batches
+  // is reported as the result of each operation in it, the operations in other
+  // batches may have succeeded.
+  std::string const api_path = "/storage/" + options_.version();
+  std::string const url =
+      options_.endpoint() + "/batch/storage/" + options_.version();
+  auto const& operations = request.operations();
+  BatchResponse response;
+  response.results.reserve(operations.size());
+  for (std::size_t offset = 0; offset < operations.size();
+       offset += kMaxBatchSize) {
+    auto const count = (std::min)(kMaxBatchSize, operations.size() - offset);
+    BatchRequest chunk;
+    std::vector<std::string> parts;
+    std::string all_parts;
+    for (std::size_t i = offset; i != offset + count; ++i) {
+      chunk.AddOperation(operations[i]);
+      parts.push_back(FormatBatchOperation(operations[i], api_path));
+      all_parts += parts.back();
+    }
+
+    auto chunk_response = [&]() -> StatusOr<BatchResponse> {
+      CurlRequestBuilder builder(url, storage_factory_);
+      auto status = SetupBuilderCommon(builder, "POST");
+      if (!status.ok()) {
+        return status;
+      }
+      auto boundary = PickBoundary(all_parts);
+      builder.AddHeader("Content-Type: multipart/mixed; boundary=" + boundary);
+      auto http_response = builder.BuildRequest().MakeRequest(
+          FormatBatchPayload(parts, boundary));
+      if (!http_response.ok()) {
+        return std::move(http_response).status();
+      }
+      return BatchResponse::FromHttpResponse(chunk, *http_response);
+    }();
+    if (!chunk_response) {
+      response.results.insert(
+          response.results.end(), count,
+          StatusOr<ObjectMetadata>(std::move(chunk_response).status()));
+      continue;
+    }
+    for (auto& result : chunk_response->results) {
+      response.results.push_back(std::move(result));
+    }
+  }
+  return response;
+}
+
+StatusOr<ListObjectSummariesResponse> CurlClient::ListObjectSummaries(
+    ListObjectsRequest const& request) {
+  // Assume the bucket name is validated by the caller.
+  CurlRequestBuilder builder(
+      storage_endpoint_ + "/b/" + request.bucket_name() + "/o",
+      storage_factory_);
+  auto status = SetupBuilder(builder, request, "GET");
+  if (!status.ok()) {
+    return status;
+  }
+  builder.AddQueryParameter("pageToken", request.page_token());
+  if (!request.HasOption<Fields>()) {
+    builder.AddQueryParameter("fields", kObjectSummaryFields);
+  }
+  return ParseFromHttpResponse<ListObjectSummariesResponse>(
+      builder.BuildRequest().MakeRequest(std::string{}));
+}
+
+void CurlClient::LockShared(curl_lock_data data) {
+  share_mu_[static_cast<std::size_t>(data) % share_mu_.size()].lock();
+}
 
-void CurlClient::UnlockShared() { mu_.unlock(); }
+void CurlClient::UnlockShared(curl_lock_data data) {
+  share_mu_[static_cast<std::size_t>(data) % share_mu_.size()].unlock();
+}
 
 StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
     InsertObjectMediaRequest const& request) {
@@ -1199,10 +1500,9 @@ StatusOr<std::unique_ptr<ObjectReadStreambuf>> CurlClient::ReadObjectXml(
     builder.AddHeader("Cache-Control: no-transform");
   }
 
-  std::unique_ptr<CurlReadStreambuf> buf(new CurlReadStreambuf(
-      builder.BuildDownloadRequest(std::string{}),
-      client_options().download_buffer_size(), CreateHashValidator(request)));
-  return std::unique_ptr<ObjectReadStreambuf>(std::move(buf));
+  builder.SetReactor(reactor_);
+  return std::unique_ptr<ObjectReadStreambuf>(CreateReadStreambuf(
+      client_options(), builder, CreateHashValidator(request)));
 }
 
 StatusOr<std::unique_ptr<ObjectWriteStreambuf>> CurlClient::WriteObjectXml(
@@ -1298,44 +1598,12 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
                                        CreateHashValidator(request)));
   ObjectWriteStream writer(std::move(buf));
 
-  nl::json metadata = nl::json::object();
-  if (request.HasOption<WithObjectMetadata>()) {
-    metadata = ObjectMetadataJsonForUpdate(
-        request.GetOption<WithObjectMetadata>().value());
-  }
-  if (request.HasOption<MD5HashValue>()) {
-    metadata["md5Hash"] = request.GetOption<MD5HashValue>().value();
-  } else {
-    metadata["md5Hash"] = ComputeMD5Hash(request.contents());
-  }
+  // 4. Format the first part, including the separators and the headers, the
+  //    second part with all the contents, and the final separator.
+  auto envelope = MultipartUploadEnvelope(request, boundary);
+  writer << envelope.first << request.contents() << envelope.second;
 
-  if (request.HasOption<Crc32cChecksumValue>()) {
-    metadata["crc32c"] = request.GetOption<Crc32cChecksumValue>().value();
-  } else {
-    metadata["crc32c"] = ComputeCrc32cChecksum(request.contents());
-  }
-
-  std::string crlf = "\r\n";
-  std::string marker = "--" + boundary;
-
-  // 4. Format the first part, including the separators and the headers.
-  writer << marker << crlf << "content-type: application/json; charset=UTF-8"
-         << crlf << crlf << metadata.dump() << crlf << marker << crlf;
-
-  // 5. Format the second part, which includes all the contents and a final
-  //    separator.
-  if (request.HasOption<ContentType>()) {
-    writer << "content-type: " << request.GetOption<ContentType>().value()
-           << crlf;
-  } else if (metadata.count("contentType") != 0) {
-    writer << "content-type: "
-           << metadata.value("contentType", "application/octet-stream") << crlf;
-  } else {
-    writer << "content-type: application/octet-stream" << crlf;
-  }
-  writer << crlf << request.contents() << crlf << marker << "--" << crlf;
-
-  // 6. Return the results as usual.
+  // 5. Return the results as usual.
   writer.Close();
   return std::move(writer).metadata();
 }
@@ -1413,10 +1681,19 @@ CurlClient::WriteObjectResumable(InsertObjectStreamingRequest const& request) {
   auto buf =
       google::cloud::internal::make_unique<internal::CurlResumableStreambuf>(
           std::move(session).value(), client_options().upload_buffer_size(),
-          CreateHashValidator(request));
+          CreateHashValidator(request),
+          client_options().enable_pipelined_uploads());
   return std::unique_ptr<internal::ObjectWriteStreambuf>(std::move(buf));
 }
 
+CurlMultiReactor& CurlClient::AsyncReactor() {
+  std::call_once(async_reactor_once_, [this] {
+    async_reactor_ = google::cloud::internal::make_unique<CurlMultiReactor>(
+        options_.download_reactor_threads());
+  });
+  return *async_reactor_;
+}
+
 StatusOr<std::string> CurlClient::AuthorizationHeader(
     std::shared_ptr<google::cloud::storage::oauth2::Credentials> const&
         credentials) {
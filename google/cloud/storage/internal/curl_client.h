@@ -17,9 +17,11 @@
 
 #include "google/cloud/internal/random.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/internal/curl_multi_reactor.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/oauth2/credentials.h"
+#include <array>
 #include <mutex>
 
 namespace google {
@@ -166,11 +168,35 @@ class CurlClient : public RawClient,
   StatusOr<EmptyResponse> DeleteNotification(
       DeleteNotificationRequest const&) override;
 
+  bool SupportsAsync() const override { return true; }
+  future<StatusOr<ListObjectsResponse>> AsyncListObjects(
+      ListObjectsRequest const& request) override;
+  future<StatusOr<ObjectMetadata>> AsyncInsertObjectMedia(
+      InsertObjectMediaRequest const& request) override;
+  future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      GetObjectMetadataRequest const& request) override;
+  future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const& request) override;
+  future<StatusOr<EmptyResponse>> AsyncDeleteObject(
+      DeleteObjectRequest const& request) override;
+
+  StatusOr<BatchResponse> ExecuteBatch(BatchRequest const& request) override;
+  StatusOr<ListObjectSummariesResponse> ListObjectSummaries(
+      ListObjectsRequest const& request) override;
+
   StatusOr<std::string> AuthorizationHeader(
       std::shared_ptr<google::cloud::storage::oauth2::Credentials> const&);
 
-  void LockShared();
-  void UnlockShared();
+  /**
+   * Locks the data shared between the CURL* handles.
+   *
+   * libcurl calls these functions from the CURLSH* lock callbacks. Each type of
+   * shared data (the connection cache, the TLS sessions, the DNS cache, etc.)
+   * has its own mutex: libcurl may lock more than one type at a time, and
+   * requests that only touch one of them do not block each other.
+   */
+  void LockShared(curl_lock_data data);
+  void UnlockShared(curl_lock_data data);
 
  protected:
   // The constructor is private because the class must always be created
@@ -214,15 +240,21 @@ class CurlClient : public RawClient,
   StatusOr<std::unique_ptr<ResumableUploadSession>>
   CreateResumableSessionGeneric(RequestType const& request);
 
+  /// Returns the reactor for asynchronous operations, creating it if needed.
+  CurlMultiReactor& AsyncReactor();
+
   ClientOptions options_;
   std::string storage_endpoint_;
   std::string upload_endpoint_;
   std::string xml_upload_endpoint_;
   std::string xml_download_endpoint_;
 
+  // The mutexes for each type of data in share_, indexed by curl_lock_data.
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> share_mu_;
+  CurlShare share_ /* GUARDED_BY(share_mu_) */;
+
   std::mutex mu_;
-  CurlShare share_ /* GUARDED_BY(mu_) */;
-  google::cloud::internal::DefaultPRNG generator_;
+  google::cloud::internal::DefaultPRNG generator_ /* GUARDED_BY(mu_) */;
 
   // The factories must be listed *after* the CurlShare. libcurl keeps a
   // usage count on each CURLSH* handle, which is only released once the CURL*
@@ -233,6 +265,15 @@ class CurlClient : public RawClient,
   std::shared_ptr<CurlHandleFactory> upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_download_factory_;
+
+  // Runs the download requests, if configured. It is also listed after the
+  // CurlShare, as it may hold CURL* handles that use it.
+  std::shared_ptr<CurlMultiReactor> reactor_;
+
+  // Runs the asynchronous operations, created on first use. Destroying it
+  // terminates any pending operations, so it is listed last.
+  std::once_flag async_reactor_once_;
+  std::unique_ptr<CurlMultiReactor> async_reactor_;
 };
 
 }  // namespace internal
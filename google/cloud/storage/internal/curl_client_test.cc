@@ -401,6 +401,21 @@ TEST_P(CurlClientTest, DeleteNotification) {
   TestCorrectFailureStatus(status_or_foo.status());
 }
 
+/// @test Verify that each type of shared data is locked independently.
+TEST(CurlClientShareTest, IndependentLocks) {
+  auto client = CurlClient::Create(
+      ClientOptions(oauth2::CreateAnonymousCredentials()));
+  // libcurl may lock more than one type of data at a time, for example, the
+  // DNS cache while holding the connection cache lock.
+  client->LockShared(CURL_LOCK_DATA_CONNECT);
+  client->LockShared(CURL_LOCK_DATA_DNS);
+  client->LockShared(CURL_LOCK_DATA_SSL_SESSION);
+  client->UnlockShared(CURL_LOCK_DATA_SSL_SESSION);
+  client->UnlockShared(CURL_LOCK_DATA_DNS);
+  client->UnlockShared(CURL_LOCK_DATA_CONNECT);
+  SUCCEED();
+}
+
 INSTANTIATE_TEST_CASE_P(CredentialsFailure, CurlClientTest,
                         ::testing::Values("credentials-failure"));
 
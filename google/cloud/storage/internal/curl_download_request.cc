@@ -31,13 +31,24 @@ namespace internal {
 CurlDownloadRequest::CurlDownloadRequest(std::size_t initial_buffer_size)
     : headers_(nullptr, &curl_slist_free_all),
       multi_(nullptr, &curl_multi_cleanup),
+      reactor_loop_(0),
+      in_reactor_(false),
+      paused_(false),
+      transfer_done_(false),
+      transfer_result_(CURLE_OK),
       closing_(false),
       curl_closed_(false),
-      initial_buffer_size_(initial_buffer_size) {
+      initial_buffer_size_(initial_buffer_size),
+      user_buffer_(nullptr),
+      user_buffer_size_(0),
+      user_buffer_offset_(0) {
   buffer_.reserve(initial_buffer_size);
 }
 
 StatusOr<HttpResponse> CurlDownloadRequest::Close() {
+  if (reactor_) {
+    return CloseInReactor();
+  }
   // Set the the closing_ flag to trigger a return 0 from the next read
   // callback, see the comments in the header file for more details.
   closing_ = true;
@@ -46,6 +57,8 @@ StatusOr<HttpResponse> CurlDownloadRequest::Close() {
   if (!status.ok()) {
     return status;
   }
+  // Discard any data not returned by GetMore().
+  buffer_.clear();
 
   // Now remove the handle from the CURLM* interface and wait for the response.
   auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
@@ -63,8 +76,20 @@ StatusOr<HttpResponse> CurlDownloadRequest::Close() {
 }
 
 StatusOr<HttpResponse> CurlDownloadRequest::GetMore(std::string& buffer) {
+  if (reactor_) {
+    return GetMoreFromReactor(buffer);
+  }
   handle_.FlushDebug(__func__);
-  auto status = Wait([this] {
+  Status status;
+  if (paused_ && buffer_.size() < initial_buffer_size_) {
+    // The buffer size grew since the transfer was paused.
+    paused_ = false;
+    status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  status = Wait([this] {
     return curl_closed_ || buffer_.size() >= initial_buffer_size_;
   });
   if (!status.ok()) {
@@ -73,28 +98,16 @@ StatusOr<HttpResponse> CurlDownloadRequest::GetMore(std::string& buffer) {
   GCP_LOG(DEBUG) << __func__ << "(), curl.size=" << buffer_.size()
                  << ", closing=" << closing_ << ", closed=" << curl_closed_;
   if (curl_closed_) {
-    // Remove the handle from the CURLM* interface and wait for the response.
-    auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
-    status = AsStatus(error, __func__);
-    if (!status.ok()) {
-      return status;
-    }
-
     buffer_.swap(buffer);
     buffer_.clear();
-    StatusOr<long> http_code = handle_.GetResponseCode();
-    if (!http_code.ok()) {
-      return std::move(http_code).status();
-    }
     GCP_LOG(DEBUG) << __func__ << "(), size=" << buffer.size()
-                   << ", closing=" << closing_ << ", closed=" << curl_closed_
-                   << ", code=" << *http_code;
-    return HttpResponse{http_code.value(), std::string{},
-                        std::move(received_headers_)};
+                   << ", closing=" << closing_ << ", closed=" << curl_closed_;
+    return Finish();
   }
   buffer_.swap(buffer);
   buffer_.clear();
   buffer_.reserve(initial_buffer_size_);
+  paused_ = false;
   status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
   if (!status.ok()) {
     return status;
@@ -105,8 +118,57 @@ StatusOr<HttpResponse> CurlDownloadRequest::GetMore(std::string& buffer) {
   return HttpResponse{100, {}, {}};
 }
 
+StatusOr<HttpResponse> CurlDownloadRequest::GetMore(char* buffer,
+                                                    std::size_t size,
+                                                    std::size_t& bytes_read) {
+  if (reactor_) {
+    return GetMoreFromReactor(buffer, size, bytes_read);
+  }
+  handle_.FlushDebug(__func__);
+  bytes_read = DrainBuffer(buffer, size);
+  if (bytes_read < size && !curl_closed_) {
+    // The write callback runs in this thread, from Wait(), no locking needed.
+    user_buffer_ = buffer + bytes_read;
+    user_buffer_size_ = size - bytes_read;
+    user_buffer_offset_ = 0;
+    Status status;
+    if (paused_) {
+      paused_ = false;
+      status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
+    }
+    if (status.ok()) {
+      status = Wait([this] { return curl_closed_ || UserBufferFull(); });
+    }
+    bytes_read += user_buffer_offset_;
+    user_buffer_ = nullptr;
+    user_buffer_size_ = 0;
+    user_buffer_offset_ = 0;
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  GCP_LOG(DEBUG) << __func__ << "(), size=" << bytes_read
+                 << ", curl.size=" << buffer_.size() << ", closing=" << closing_
+                 << ", closed=" << curl_closed_;
+  if (curl_closed_ && buffer_.empty()) {
+    return Finish();
+  }
+  return HttpResponse{100, {}, {}};
+}
+
+void CurlDownloadRequest::SetBufferSize(std::size_t size) {
+  // With a reactor the write callback reads this value in the reactor thread.
+  std::lock_guard<std::mutex> lk(mu_);
+  initial_buffer_size_ = size;
+}
+
 Status CurlDownloadRequest::SetOptions() {
   ResetOptions();
+  if (reactor_) {
+    // The transfer starts on the first call to GetMore() or Close(), the
+    // request may still be moved before that.
+    return Status();
+  }
   auto error = curl_multi_add_handle(multi_.get(), handle_.handle_.get());
   return AsStatus(error, __func__);
 }
@@ -144,15 +206,184 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   // any pending work, and will return the handle_ pointer from
   // curl_multi_info_read() in PerformWork(). That is the point where
   // `curl_closed_` is set.
+  std::unique_lock<std::mutex> lk(mu_);
   if (closing_) {
     return 0;
   }
+  auto const* data = static_cast<char const*>(ptr);
+  auto const count = size * nmemb;
+  if (user_buffer_ != nullptr && !UserBufferFull()) {
+    // Copy the data straight into the caller's buffer, libcurl does not
+    // support partial writes, so any excess is kept in `buffer_`.
+    auto const n = (std::min)(count, user_buffer_size_ - user_buffer_offset_);
+    std::memcpy(user_buffer_ + user_buffer_offset_, data, n);
+    user_buffer_offset_ += n;
+    buffer_.append(data + n, count - n);
+    lk.unlock();
+    cv_.notify_one();
+    return count;
+  }
   if (buffer_.size() >= initial_buffer_size_) {
+    paused_ = true;
     return CURL_READFUNC_PAUSE;
   }
 
-  buffer_.append(static_cast<char const*>(ptr), size * nmemb);
-  return size * nmemb;
+  buffer_.append(data, count);
+  lk.unlock();
+  cv_.notify_one();
+  return count;
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::GetMoreFromReactor(
+    std::string& buffer) {
+  StartInReactor();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (paused_ && buffer_.size() < initial_buffer_size_) {
+    // The buffer size grew since the transfer was paused.
+    paused_ = false;
+    lk.unlock();
+    reactor_->Unpause(reactor_loop_, handle_.handle_.get());
+    lk.lock();
+  }
+  cv_.wait(lk, [this] {
+    return transfer_done_ || buffer_.size() >= initial_buffer_size_;
+  });
+  buffer_.swap(buffer);
+  buffer_.clear();
+  if (transfer_done_) {
+    lk.unlock();
+    return FinishInReactor();
+  }
+  buffer_.reserve(initial_buffer_size_);
+  bool const resume = paused_;
+  paused_ = false;
+  lk.unlock();
+  if (resume) {
+    reactor_->Unpause(reactor_loop_, handle_.handle_.get());
+  }
+  return HttpResponse{100, {}, {}};
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::GetMoreFromReactor(
+    char* buffer, std::size_t size, std::size_t& bytes_read) {
+  StartInReactor();
+  std::unique_lock<std::mutex> lk(mu_);
+  bytes_read = DrainBuffer(buffer, size);
+  if (bytes_read < size && !transfer_done_) {
+    user_buffer_ = buffer + bytes_read;
+    user_buffer_size_ = size - bytes_read;
+    user_buffer_offset_ = 0;
+    bool const resume = paused_;
+    paused_ = false;
+    lk.unlock();
+    if (resume) {
+      reactor_->Unpause(reactor_loop_, handle_.handle_.get());
+    }
+    lk.lock();
+    cv_.wait(lk, [this] { return transfer_done_ || UserBufferFull(); });
+    bytes_read += user_buffer_offset_;
+    user_buffer_ = nullptr;
+    user_buffer_size_ = 0;
+    user_buffer_offset_ = 0;
+  }
+  if (transfer_done_ && buffer_.empty()) {
+    lk.unlock();
+    return FinishInReactor();
+  }
+  return HttpResponse{100, {}, {}};
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::Finish() {
+  // Remove the handle from the CURLM* interface and wait for the response.
+  auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
+  auto status = AsStatus(error, __func__);
+  if (!status.ok()) {
+    return status;
+  }
+  StatusOr<long> http_code = handle_.GetResponseCode();
+  if (!http_code.ok()) {
+    return std::move(http_code).status();
+  }
+  GCP_LOG(DEBUG) << __func__ << "(), code=" << *http_code;
+  return HttpResponse{http_code.value(), std::string{},
+                      std::move(received_headers_)};
+}
+
+std::size_t CurlDownloadRequest::DrainBuffer(char* buffer, std::size_t size) {
+  auto const n = (std::min)(size, buffer_.size());
+  if (n == 0) {
+    return 0;
+  }
+  std::memcpy(buffer, buffer_.data(), n);
+  buffer_.erase(0, n);
+  return n;
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::CloseInReactor() {
+  StartInReactor();
+  std::unique_lock<std::mutex> lk(mu_);
+  // Set the the closing_ flag to trigger a return 0 from the next write
+  // callback, a paused transfer must be resumed to get that callback.
+  closing_ = true;
+  bool const resume = paused_;
+  paused_ = false;
+  lk.unlock();
+  if (resume) {
+    reactor_->Unpause(reactor_loop_, handle_.handle_.get());
+  }
+  lk.lock();
+  cv_.wait(lk, [this] { return transfer_done_; });
+  // Discard any data not returned by GetMore().
+  buffer_.clear();
+  lk.unlock();
+  return FinishInReactor();
+}
+
+void CurlDownloadRequest::StartInReactor() {
+  // Only the thread calling GetMore() or Close() uses in_reactor_ and
+  // curl_closed_.
+  if (in_reactor_ || curl_closed_) {
+    return;
+  }
+  reactor_loop_ = reactor_->PickLoop();
+  in_reactor_ = true;
+  reactor_->AddHandle(reactor_loop_, handle_.handle_.get(),
+                      [this](CURLcode result) {
+                        GCP_LOG(DEBUG) << "transfer completed, result=["
+                                       << result << "]="
+                                       << curl_easy_strerror(result);
+                        {
+                          std::lock_guard<std::mutex> lk(mu_);
+                          transfer_done_ = true;
+                          transfer_result_ = result;
+                        }
+                        cv_.notify_one();
+                      });
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::FinishInReactor() {
+  curl_closed_ = true;
+  if (in_reactor_) {
+    reactor_->RemoveHandle(reactor_loop_, handle_.handle_.get());
+    in_reactor_ = false;
+  }
+  CURLcode result;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    result = transfer_result_;
+  }
+  // A transport error in the middle of the body must not look like the end of
+  // the download. Errors caused by Close() terminating the transfer are
+  // expected.
+  if (result != CURLE_OK && !closing_) {
+    return handle_.AsStatus(result, __func__);
+  }
+  StatusOr<long> http_code = handle_.GetResponseCode();
+  if (!http_code.ok()) {
+    return std::move(http_code).status();
+  }
+  return HttpResponse{http_code.value(), std::string{},
+                      std::move(received_headers_)};
 }
 
 StatusOr<int> CurlDownloadRequest::PerformWork() {
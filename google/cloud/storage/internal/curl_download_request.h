@@ -16,8 +16,11 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H_
 
 #include "google/cloud/log.h"
+#include "google/cloud/storage/internal/curl_multi_reactor.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -31,6 +34,11 @@ namespace internal {
  * payload is streamed, and the total size is not known. Under the hood this
  * uses chunked transfer encoding.
  *
+ * If the request is created with a `CurlMultiReactor` the transfer runs in
+ * one of the reactor threads, and the callers of `GetMore()` and `Close()` just
+ * wait for the reactor to produce data. Otherwise the transfer is performed by
+ * the thread calling these functions.
+ *
  * @see `CurlRequest` for simpler transfers where the size of the payload is
  *     known and relatively small.
  */
@@ -42,10 +50,18 @@ class CurlDownloadRequest {
     if (!factory_) {
       return;
     }
+    if (reactor_ && in_reactor_) {
+      reactor_->RemoveHandle(reactor_loop_, handle_.handle_.get());
+    }
     factory_->CleanupHandle(std::move(handle_.handle_));
-    factory_->CleanupMultiHandle(std::move(multi_));
+    if (multi_) {
+      factory_->CleanupMultiHandle(std::move(multi_));
+    }
   }
 
+  // Moving a request is only supported before the transfer starts, in
+  // particular, before it is added to a reactor.
+
   CurlDownloadRequest(CurlDownloadRequest&& rhs) noexcept(false)
       : url_(std::move(rhs.url_)),
         headers_(std::move(rhs.headers_)),
@@ -55,9 +71,18 @@ class CurlDownloadRequest {
         handle_(std::move(rhs.handle_)),
         multi_(std::move(rhs.multi_)),
         factory_(std::move(rhs.factory_)),
+        reactor_(std::move(rhs.reactor_)),
+        reactor_loop_(rhs.reactor_loop_),
+        in_reactor_(rhs.in_reactor_),
+        paused_(rhs.paused_),
+        transfer_done_(rhs.transfer_done_),
+        transfer_result_(rhs.transfer_result_),
         closing_(rhs.closing_),
         curl_closed_(rhs.curl_closed_),
-        initial_buffer_size_(rhs.initial_buffer_size_) {
+        initial_buffer_size_(rhs.initial_buffer_size_),
+        user_buffer_(rhs.user_buffer_),
+        user_buffer_size_(rhs.user_buffer_size_),
+        user_buffer_offset_(rhs.user_buffer_offset_) {
     ResetOptions();
   }
 
@@ -70,14 +95,24 @@ class CurlDownloadRequest {
     handle_ = std::move(rhs.handle_);
     multi_ = std::move(rhs.multi_);
     factory_ = std::move(rhs.factory_);
+    reactor_ = std::move(rhs.reactor_);
+    reactor_loop_ = rhs.reactor_loop_;
+    in_reactor_ = rhs.in_reactor_;
+    paused_ = rhs.paused_;
+    transfer_done_ = rhs.transfer_done_;
+    transfer_result_ = rhs.transfer_result_;
     closing_ = rhs.closing_;
     curl_closed_ = rhs.curl_closed_;
     initial_buffer_size_ = rhs.initial_buffer_size_;
+    user_buffer_ = rhs.user_buffer_;
+    user_buffer_size_ = rhs.user_buffer_size_;
+    user_buffer_offset_ = rhs.user_buffer_offset_;
     ResetOptions();
     return *this;
   }
 
-  bool IsOpen() const { return !curl_closed_; }
+  /// Returns true while the transfer is running or has data not yet returned.
+  bool IsOpen() const { return !curl_closed_ || !buffer_.empty(); }
   StatusOr<HttpResponse> Close();
 
   /**
@@ -92,6 +127,34 @@ class CurlDownloadRequest {
    */
   StatusOr<HttpResponse> GetMore(std::string& buffer);
 
+  /**
+   * Waits for additional data or the end of the transfer, the data is written
+   * directly into a caller-provided buffer.
+   *
+   * While this function blocks the libcurl callbacks copy any new data straight
+   * into @p buffer, avoiding the intermediate copies made by the
+   * `GetMore(std::string&)` overload. Only data received before the call, or
+   * that does not fit in @p buffer, is held in the internal buffer.
+   *
+   * This operation blocks until @p size bytes have been received or the
+   * transfer is completed.
+   *
+   * @param buffer the location to return the new data.
+   * @param size the number of bytes available in @p buffer.
+   * @param bytes_read set to the number of bytes written into @p buffer.
+   * @returns 100-Continue if the transfer is not yet completed.
+   */
+  StatusOr<HttpResponse> GetMore(char* buffer, std::size_t size,
+                                 std::size_t& bytes_read);
+
+  /**
+   * Changes the amount of data that `GetMore(std::string&)` waits for.
+   *
+   * The new size applies to the following calls to `GetMore()`. The transfer
+   * is paused while the internal buffer holds this much data.
+   */
+  void SetBufferSize(std::size_t size);
+
  private:
   friend class CurlRequestBuilder;
   /// Set the underlying CurlHandle options initially.
@@ -103,6 +166,33 @@ class CurlDownloadRequest {
   /// Called by libcurl to show that more data is available in the download.
   std::size_t WriteCallback(void* ptr, std::size_t size, std::size_t nmemb);
 
+  /// Implements GetMore() when the transfer runs in a reactor.
+  StatusOr<HttpResponse> GetMoreFromReactor(std::string& buffer);
+
+  /// Implements GetMore() into a caller buffer when using a reactor.
+  StatusOr<HttpResponse> GetMoreFromReactor(char* buffer, std::size_t size,
+                                            std::size_t& bytes_read);
+
+  /// Removes the completed transfer from `multi_` and returns the response.
+  StatusOr<HttpResponse> Finish();
+
+  /// Moves up to @p size bytes from `buffer_` into @p buffer.
+  std::size_t DrainBuffer(char* buffer, std::size_t size);
+
+  /// Returns true if the caller-provided buffer, if any, is full.
+  bool UserBufferFull() const {
+    return user_buffer_ != nullptr && user_buffer_offset_ == user_buffer_size_;
+  }
+
+  /// Implements Close() when the transfer runs in a reactor.
+  StatusOr<HttpResponse> CloseInReactor();
+
+  /// Adds the transfer to the reactor, if it was not added already.
+  void StartInReactor();
+
+  /// Removes the transfer from the reactor and returns the response.
+  StatusOr<HttpResponse> FinishInReactor();
+
   /// Wait until a condition is met.
   template <typename Predicate>
   Status Wait(Predicate&& predicate) {
@@ -151,6 +241,23 @@ class CurlDownloadRequest {
   CurlHandle handle_;
   CurlMulti multi_;
   std::shared_ptr<CurlHandleFactory> factory_;
+  std::shared_ptr<CurlMultiReactor> reactor_;
+  std::size_t reactor_loop_;
+  // Set while the handle is registered with reactor_.
+  bool in_reactor_;
+
+  // When using a reactor the callbacks run in the reactor thread, this mutex
+  // protects the members shared with the thread calling GetMore() or Close().
+  std::mutex mu_;
+  std::condition_variable cv_;
+  // Set when the write callback pauses the transfer.
+  bool paused_;
+  // Set by the reactor when the transfer completes. Note that curl_closed_ is
+  // only set once the data received before completion is returned by
+  // GetMore().
+  bool transfer_done_;
+  // The result of the transfer, set by the reactor when it completes.
+  CURLcode transfer_result_;
 
   std::string buffer_;
   // Closing the handle happens in two steps.
@@ -166,6 +273,12 @@ class CurlDownloadRequest {
   bool curl_closed_;
 
   std::size_t initial_buffer_size_;
+
+  // Set while GetMore(char*, ...) waits for data, the write callback copies the
+  // data directly into this buffer. Protected by mu_ when using a reactor.
+  char* user_buffer_;
+  std::size_t user_buffer_size_;
+  std::size_t user_buffer_offset_;
 };
 
 }  // namespace internal
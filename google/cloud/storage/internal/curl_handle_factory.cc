@@ -19,6 +19,24 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+namespace {
+/**
+ * Configure a pooled handle to keep its connections open.
+ *
+ * With the default settings libcurl keeps only a handful of idle connections
+ * per handle (or per multi handle), and closes the rest as soon as a request
+ * completes. The connections (and their TLS sessions) are shared by all the
+ * handles in a `CurlClient`, so we let the connection cache grow to the size
+ * of the pool, and enable TCP keep-alive so idle connections are not dropped
+ * by the network.
+ */
+void SetPooledHandleOptions(CURL* handle, std::size_t maximum_size) {
+  (void)curl_easy_setopt(handle, CURLOPT_MAXCONNECTS,
+                         static_cast<long>(maximum_size));
+  (void)curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+}
+}  // namespace
+
 std::once_flag default_curl_handle_factory_initialized;
 std::shared_ptr<CurlHandleFactory> default_curl_handle_factory;
 
@@ -72,26 +90,34 @@ CurlPtr PooledCurlHandleFactory::CreateHandle() {
     // Clear all the options in the handle so we do not leak its previous state.
     (void)curl_easy_reset(handle);
     handles_.pop_back();
+    SetPooledHandleOptions(handle, maximum_size_);
     return CurlPtr(handle, &curl_easy_cleanup);
   }
-  return CurlPtr(curl_easy_init(), &curl_easy_cleanup);
+  lk.unlock();
+  CurlPtr handle(curl_easy_init(), &curl_easy_cleanup);
+  SetPooledHandleOptions(handle.get(), maximum_size_);
+  return handle;
 }
 
 void PooledCurlHandleFactory::CleanupHandle(CurlPtr&& h) {
-  std::unique_lock<std::mutex> lk(mu_);
   char* ip;
   auto res = curl_easy_getinfo(h.get(), CURLINFO_LOCAL_IP, &ip);
+  CurlPtr evicted(nullptr, &curl_easy_cleanup);
+  std::unique_lock<std::mutex> lk(mu_);
   if (res == CURLE_OK && ip != nullptr) {
     last_client_ip_address_ = ip;
   }
   if (handles_.size() >= maximum_size_) {
-    CURL* tmp = handles_.front();
+    evicted.reset(handles_.front());
     handles_.erase(handles_.begin());
-    curl_easy_cleanup(tmp);
   }
   handles_.push_back(h.get());
   // The handles_ vector now has ownership, so release it.
   (void)h.release();
+  lk.unlock();
+  // Release the evicted handle, if any, without holding the lock, this may
+  // need to lock the shared connection cache.
+  evicted.reset();
 }
 
 CurlMulti PooledCurlHandleFactory::CreateMultiHandle() {
@@ -101,7 +127,11 @@ CurlMulti PooledCurlHandleFactory::CreateMultiHandle() {
     multi_handles_.pop_back();
     return CurlMulti(m, &curl_multi_cleanup);
   }
-  return CurlMulti(curl_multi_init(), &curl_multi_cleanup);
+  lk.unlock();
+  CurlMulti m(curl_multi_init(), &curl_multi_cleanup);
+  (void)curl_multi_setopt(m.get(), CURLMOPT_MAXCONNECTS,
+                          static_cast<long>(maximum_size_));
+  return m;
 }
 
 void PooledCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m) {
@@ -0,0 +1,402 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_multi_reactor.h"
+#include "google/cloud/log.h"
+#include <curl/multi.h>
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// curl_multi_poll() and curl_multi_wakeup() were introduced in libcurl 7.68.0,
+// with older versions the event loop uses curl_multi_wait() and wakes up
+// periodically to check for new work.
+#if LIBCURL_VERSION_NUM >= 0x074400
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_POLL 1
+#else
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_POLL 0
+#endif  // LIBCURL_VERSION_NUM >= 0x074400
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Runs one `CURLM*` handle and the transfers assigned to it.
+ *
+ * The `callbacks_` and `timers_` maps, and the `CURLM*` handle are only used by
+ * the thread running `Run()`, other threads communicate with it using
+ * `Post()`. The thread keeps a reference to the event loop until `Run()`
+ * returns, so the event loop can be released by any thread, including itself.
+ */
+class CurlMultiReactor::EventLoop {
+ public:
+  EventLoop()
+      : multi_(curl_multi_init(), &curl_multi_cleanup),
+        shutting_down_(false),
+        shutdown_(false),
+        exited_(false) {}
+
+  void Run() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      thread_id_ = std::this_thread::get_id();
+    }
+    std::vector<std::function<void()>> pending;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        // Block while there are no transfers, the multi handle has no sockets
+        // to wait on in that case.
+        auto ready = [this] {
+          return shutdown_ || !pending_.empty() || !callbacks_.empty();
+        };
+        if (timers_.empty()) {
+          cv_.wait(lk, ready);
+        } else {
+          cv_.wait_until(lk, timers_.begin()->first, ready);
+        }
+        if (shutdown_) {
+          lk.unlock();
+          Drain();
+          return;
+        }
+        pending.swap(pending_);
+      }
+      for (auto& f : pending) {
+        f();
+      }
+      pending.clear();
+      RunExpiredTimers();
+      if (callbacks_.empty()) {
+        continue;
+      }
+      PerformWork();
+      WaitForWork();
+    }
+  }
+
+  /// Stops the event loop, the caller must not be the event loop thread.
+  void Shutdown() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    Wakeup();
+  }
+
+  /// Stops the event loop from one of its own callbacks.
+  void ShutdownFromLoop() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    Drain();
+  }
+
+  void AddHandle(CURL* handle, CompletionCallback callback,
+                 bool remove_on_completion) {
+    // std::function<> requires copyable functors, wrap the callback in a
+    // shared_ptr to move it into the event loop.
+    auto cb = std::make_shared<CompletionCallback>(std::move(callback));
+    Post([this, handle, cb, remove_on_completion] {
+      if (shutting_down_) {
+        (*cb)(CURLE_ABORTED_BY_CALLBACK);
+        return;
+      }
+      auto e = curl_multi_add_handle(multi_.get(), handle);
+      if (e != CURLM_OK) {
+        GCP_LOG(ERROR) << "curl_multi_add_handle() failed with [" << e
+                       << "]=" << curl_multi_strerror(e);
+        (*cb)(CURLE_FAILED_INIT);
+        return;
+      }
+      callbacks_.emplace(handle,
+                         Transfer{std::move(*cb), remove_on_completion});
+    });
+  }
+
+  void Unpause(CURL* handle) {
+    Post([handle] { (void)curl_easy_pause(handle, CURLPAUSE_RECV_CONT); });
+  }
+
+  void RemoveHandle(CURL* handle) {
+    auto remove = [this, handle] {
+      (void)curl_multi_remove_handle(multi_.get(), handle);
+      callbacks_.erase(handle);
+    };
+    if (InLoopThread()) {
+      remove();
+      return;
+    }
+    // If the event loop has exited Post() runs the function inline, so this
+    // never blocks forever.
+    std::promise<void> done;
+    Post([&done, &remove] {
+      remove();
+      done.set_value();
+    });
+    done.get_future().get();
+  }
+
+  void Schedule(std::chrono::milliseconds delay, TimerCallback callback) {
+    auto deadline = std::chrono::steady_clock::now() + delay;
+    Post([this, deadline, callback] {
+      if (shutting_down_) {
+        callback();
+        return;
+      }
+      timers_.emplace(deadline, std::move(callback));
+    });
+  }
+
+ private:
+  bool InLoopThread() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return thread_id_ == std::this_thread::get_id();
+  }
+
+  /**
+   * Runs @p f in the event loop thread.
+   *
+   * Once the event loop has exited nothing else uses its state, and @p f runs
+   * in the calling thread.
+   */
+  void Post(std::function<void()> f) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (!exited_) {
+        pending_.push_back(std::move(f));
+        f = nullptr;
+      }
+    }
+    if (f) {
+      f();
+      return;
+    }
+    Wakeup();
+  }
+
+  void Wakeup() {
+    cv_.notify_one();
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_POLL
+    (void)curl_multi_wakeup(multi_.get());
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_POLL
+  }
+
+  /**
+   * Terminates all the work in the event loop.
+   *
+   * Running transfers are aborted and pending timers fire early. The callbacks
+   * may post more work, the loop repeats until there is nothing left.
+   */
+  void Drain() {
+    shutting_down_ = true;
+    while (true) {
+      std::vector<std::function<void()>> pending;
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        pending.swap(pending_);
+        // Check for more work and mark the loop as exited atomically, any
+        // work posted after this point runs inline.
+        if (pending.empty() && callbacks_.empty() && timers_.empty()) {
+          exited_ = true;
+          return;
+        }
+      }
+      for (auto& f : pending) {
+        f();
+      }
+      while (!callbacks_.empty()) {
+        auto i = callbacks_.begin();
+        auto callback = std::move(i->second.callback);
+        (void)curl_multi_remove_handle(multi_.get(), i->first);
+        callbacks_.erase(i);
+        callback(CURLE_ABORTED_BY_CALLBACK);
+      }
+      while (!timers_.empty()) {
+        auto callback = std::move(timers_.begin()->second);
+        timers_.erase(timers_.begin());
+        callback();
+      }
+    }
+  }
+
+  void RunExpiredTimers() {
+    auto const now = std::chrono::steady_clock::now();
+    while (!timers_.empty() && timers_.begin()->first <= now) {
+      auto callback = std::move(timers_.begin()->second);
+      timers_.erase(timers_.begin());
+      callback();
+    }
+  }
+
+  void PerformWork() {
+    int running_handles = 0;
+    CURLMcode result;
+    do {
+      result = curl_multi_perform(multi_.get(), &running_handles);
+    } while (result == CURLM_CALL_MULTI_PERFORM);
+    if (result != CURLM_OK) {
+      GCP_LOG(ERROR) << "curl_multi_perform() failed with [" << result
+                     << "]=" << curl_multi_strerror(result);
+    }
+
+    int remaining;
+    while (auto msg = curl_multi_info_read(multi_.get(), &remaining)) {
+      if (msg->msg != CURLMSG_DONE) {
+        continue;
+      }
+      auto i = callbacks_.find(msg->easy_handle);
+      if (i == callbacks_.end()) {
+        continue;
+      }
+      // Unless requested otherwise, the handle remains in the multi handle
+      // until the owner calls RemoveHandle(), but it will not make any more
+      // progress.
+      auto callback = std::move(i->second.callback);
+      auto const result = msg->data.result;
+      if (i->second.remove_on_completion) {
+        (void)curl_multi_remove_handle(multi_.get(), i->first);
+      }
+      callbacks_.erase(i);
+      callback(result);
+    }
+  }
+
+  void WaitForWork() {
+    // The timeout is only relevant when there are no socket events, libcurl
+    // shortens it if any of the transfers has a pending timer.
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_POLL
+    auto const timeout_ms = WaitTimeout(1000);
+    auto result =
+        curl_multi_poll(multi_.get(), nullptr, 0, timeout_ms, nullptr);
+#else
+    // Without curl_multi_wakeup() the work posted by other threads is only
+    // noticed when curl_multi_wait() returns, the wait is bounded to keep that
+    // latency low. Use the libcurl timeout if it is shorter.
+    auto timeout_ms = WaitTimeout(10);
+    long curl_timeout_ms = -1;
+    if (curl_multi_timeout(multi_.get(), &curl_timeout_ms) == CURLM_OK &&
+        curl_timeout_ms >= 0 && curl_timeout_ms < timeout_ms) {
+      timeout_ms = static_cast<int>(curl_timeout_ms);
+    }
+    int numfds = 0;
+    auto result =
+        curl_multi_wait(multi_.get(), nullptr, 0, timeout_ms, &numfds);
+    // curl_multi_wait() returns immediately if there are no sockets to wait
+    // on, sleep to avoid spinning in that case.
+    if (result == CURLM_OK && numfds == 0 && timeout_ms > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+    }
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_POLL
+    if (result != CURLM_OK) {
+      GCP_LOG(ERROR) << "waiting on curl multi handle failed with [" << result
+                     << "]=" << curl_multi_strerror(result);
+    }
+  }
+
+  /// Returns @p max_ms, or less if a timer expires before that.
+  int WaitTimeout(int max_ms) const {
+    if (timers_.empty()) {
+      return max_ms;
+    }
+    auto const next = std::chrono::duration_cast<std::chrono::milliseconds>(
+        timers_.begin()->first - std::chrono::steady_clock::now());
+    return static_cast<int>(std::max<std::chrono::milliseconds::rep>(
+        0, std::min<std::chrono::milliseconds::rep>(max_ms, next.count())));
+  }
+
+  struct Transfer {
+    CompletionCallback callback;
+    bool remove_on_completion;
+  };
+
+  CurlMulti multi_;
+  std::map<CURL*, Transfer> callbacks_;
+  std::multimap<std::chrono::steady_clock::time_point, TimerCallback> timers_;
+  bool shutting_down_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::vector<std::function<void()>> pending_;
+  bool shutdown_;
+  // Set once the event loop has exited and released all its transfers.
+  bool exited_;
+  std::thread::id thread_id_;
+};
+
+CurlMultiReactor::CurlMultiReactor(std::size_t thread_count) : next_loop_(0) {
+  if (thread_count == 0) {
+    thread_count = 1;
+  }
+  loops_.reserve(thread_count);
+  threads_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    auto loop = std::make_shared<EventLoop>();
+    threads_.emplace_back(&EventLoop::Run, loop);
+    loops_.push_back(std::move(loop));
+  }
+}
+
+CurlMultiReactor::~CurlMultiReactor() {
+  for (std::size_t i = 0; i != loops_.size(); ++i) {
+    if (threads_[i].get_id() == std::this_thread::get_id()) {
+      // The last reference to the reactor was released by a callback running
+      // in this event loop, joining the thread would deadlock. Terminate the
+      // work inline, the thread exits once the callback returns.
+      loops_[i]->ShutdownFromLoop();
+      threads_[i].detach();
+      continue;
+    }
+    loops_[i]->Shutdown();
+    threads_[i].join();
+  }
+}
+
+std::size_t CurlMultiReactor::PickLoop() {
+  return next_loop_.fetch_add(1) % loops_.size();
+}
+
+void CurlMultiReactor::AddHandle(std::size_t loop, CURL* handle,
+                                 CompletionCallback callback) {
+  loops_.at(loop)->AddHandle(handle, std::move(callback), false);
+}
+
+void CurlMultiReactor::AddTransfer(CURL* handle, CompletionCallback callback) {
+  loops_.at(PickLoop())->AddHandle(handle, std::move(callback), true);
+}
+
+void CurlMultiReactor::Unpause(std::size_t loop, CURL* handle) {
+  loops_.at(loop)->Unpause(handle);
+}
+
+void CurlMultiReactor::RemoveHandle(std::size_t loop, CURL* handle) {
+  loops_.at(loop)->RemoveHandle(handle);
+}
+
+void CurlMultiReactor::Schedule(std::chrono::milliseconds delay,
+                                TimerCallback callback) {
+  loops_.at(PickLoop())->Schedule(delay, std::move(callback));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,123 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_REACTOR_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_REACTOR_H_
+
+#include "google/cloud/storage/internal/curl_wrappers.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Drives many concurrent libcurl transfers with a fixed number of threads.
+ *
+ * Each thread in the reactor owns a `CURLM*` handle and runs an event loop for
+ * all the transfers assigned to it. Transfers are assigned to the event loops
+ * in round-robin order. Once a transfer is added to an event loop all the
+ * libcurl calls for that transfer, including the invocation of its callbacks,
+ * happen in the thread running that event loop.
+ *
+ * The `CURLM*` handles are not thread-safe, callers never touch them directly,
+ * all the operations are queued and executed by the event loop thread.
+ *
+ * Destroying the reactor terminates any transfers still running, their
+ * completion callbacks are invoked with `CURLE_ABORTED_BY_CALLBACK`. This is
+ * safe even if the reactor is destroyed by one of its own callbacks.
+ */
+class CurlMultiReactor {
+ public:
+  /// Called from the event loop thread when a transfer completes.
+  using CompletionCallback = std::function<void(CURLcode)>;
+
+  /// Called from the event loop thread when a timer expires.
+  using TimerCallback = std::function<void()>;
+
+  explicit CurlMultiReactor(std::size_t thread_count);
+  ~CurlMultiReactor();
+
+  CurlMultiReactor(CurlMultiReactor const&) = delete;
+  CurlMultiReactor& operator=(CurlMultiReactor const&) = delete;
+
+  /// Returns the number of event loops (and threads) in this reactor.
+  std::size_t size() const { return loops_.size(); }
+
+  /// Selects the event loop for a new transfer.
+  std::size_t PickLoop();
+
+  /**
+   * Starts a transfer in the given event loop.
+   *
+   * @param loop the event loop, as returned by `PickLoop()`.
+   * @param handle the transfer, the caller retains ownership, and must keep
+   *     the handle alive until `RemoveHandle()` returns.
+   * @param callback invoked, from the event loop thread, when the transfer
+   *     completes.
+   */
+  void AddHandle(std::size_t loop, CURL* handle, CompletionCallback callback);
+
+  /**
+   * Starts a transfer that is released by the reactor when it completes.
+   *
+   * Unlike `AddHandle()` the event loop removes @p handle before invoking
+   * @p callback, the callback can release or reuse the handle, and there is
+   * no need to call `RemoveHandle()`.
+   */
+  void AddTransfer(CURL* handle, CompletionCallback callback);
+
+  /// Resumes a transfer paused by one of its callbacks.
+  void Unpause(std::size_t loop, CURL* handle);
+
+  /**
+   * Removes a transfer from its event loop.
+   *
+   * This function blocks until the event loop has released the handle, after
+   * it returns the caller can safely reuse or release @p handle. If the
+   * transfer has not completed it is terminated, without invoking its
+   * completion callback. If the event loop has already exited, or if called
+   * from the event loop thread, the handle is removed inline.
+   */
+  void RemoveHandle(std::size_t loop, CURL* handle);
+
+  /**
+   * Runs @p callback, from one of the event loop threads, after @p delay.
+   *
+   * If the reactor is destroyed before the timer expires the callback runs
+   * (early) while the reactor shuts down.
+   */
+  void Schedule(std::chrono::milliseconds delay, TimerCallback callback);
+
+ private:
+  class EventLoop;
+
+  std::vector<std::shared_ptr<EventLoop>> loops_;
+  std::vector<std::thread> threads_;
+  std::atomic<std::size_t> next_loop_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_REACTOR_H_
@@ -0,0 +1,256 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_multi_reactor.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <fstream>
+#include <future>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+class CurlMultiReactorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    file_name_ = ::testing::TempDir() + "curl-multi-reactor-" +
+                 google::cloud::internal::Sample(
+                     generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789");
+    contents_ = google::cloud::internal::Sample(generator, 64 * 1024,
+                                                "abcdefghijklmnopqrstuvwxyz"
+                                                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                                "0123456789");
+    std::ofstream(file_name_, std::ios::binary) << contents_;
+  }
+
+  void TearDown() override { std::remove(file_name_.c_str()); }
+
+  /// Use `file://` URLs so the tests do not depend on any network services.
+  CurlDownloadRequest MakeRequest(
+      std::shared_ptr<CurlMultiReactor> const& reactor) {
+    CurlRequestBuilder builder("file://" + file_name_,
+                               GetDefaultCurlHandleFactory());
+    // Pausing file:// transfers is not reliable in libcurl, use a buffer
+    // larger than the file to avoid pauses.
+    builder.SetInitialBufferSize(2 * contents_.size());
+    builder.SetReactor(reactor);
+    return builder.BuildDownloadRequest(std::string{});
+  }
+
+  std::string file_name_;
+  std::string contents_;
+};
+
+TEST_F(CurlMultiReactorTest, PickLoop) {
+  CurlMultiReactor reactor(3);
+  EXPECT_EQ(3U, reactor.size());
+  EXPECT_EQ(0U, reactor.PickLoop());
+  EXPECT_EQ(1U, reactor.PickLoop());
+  EXPECT_EQ(2U, reactor.PickLoop());
+  EXPECT_EQ(0U, reactor.PickLoop());
+}
+
+TEST_F(CurlMultiReactorTest, ZeroThreads) {
+  CurlMultiReactor reactor(0);
+  EXPECT_EQ(1U, reactor.size());
+}
+
+TEST_F(CurlMultiReactorTest, Download) {
+  auto reactor = std::make_shared<CurlMultiReactor>(2);
+  auto download = MakeRequest(reactor);
+
+  std::string actual;
+  std::string buffer;
+  StatusOr<HttpResponse> response;
+  do {
+    response = download.GetMore(buffer);
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    actual += buffer;
+  } while (response->status_code == 100);
+
+  EXPECT_FALSE(download.IsOpen());
+  EXPECT_EQ(contents_, actual);
+}
+
+TEST_F(CurlMultiReactorTest, DownloadError) {
+  auto reactor = std::make_shared<CurlMultiReactor>(1);
+  CurlRequestBuilder builder("file://" + file_name_ + ".not-found",
+                             GetDefaultCurlHandleFactory());
+  builder.SetReactor(reactor);
+  auto download = builder.BuildDownloadRequest(std::string{});
+
+  // Transport errors are reported, and not confused with the end of the data.
+  std::string buffer;
+  auto response = download.GetMore(buffer);
+  EXPECT_FALSE(response.ok());
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST_F(CurlMultiReactorTest, ConcurrentDownloads) {
+  auto reactor = std::make_shared<CurlMultiReactor>(2);
+  int const download_count = 16;
+  std::vector<std::unique_ptr<CurlDownloadRequest>> downloads;
+  std::vector<std::string> actual(download_count);
+  for (int i = 0; i != download_count; ++i) {
+    downloads.emplace_back(new CurlDownloadRequest(MakeRequest(reactor)));
+  }
+
+  // Interleave the reads from many transfers sharing the reactor threads.
+  std::string buffer;
+  int open_count = download_count;
+  while (open_count != 0) {
+    open_count = 0;
+    for (int i = 0; i != download_count; ++i) {
+      if (!downloads[i]->IsOpen()) {
+        continue;
+      }
+      auto response = downloads[i]->GetMore(buffer);
+      ASSERT_TRUE(response.ok()) << "status=" << response.status();
+      actual[i] += buffer;
+      if (response->status_code == 100) {
+        ++open_count;
+      }
+    }
+  }
+
+  for (int i = 0; i != download_count; ++i) {
+    EXPECT_EQ(contents_, actual[i]) << "i=" << i;
+  }
+}
+
+TEST_F(CurlMultiReactorTest, DownloadIntoBuffer) {
+  auto reactor = std::make_shared<CurlMultiReactor>(2);
+  auto download = MakeRequest(reactor);
+
+  // Use a buffer smaller than the file, and not aligned with the chunks
+  // returned by libcurl.
+  std::vector<char> buffer(10000);
+  std::string actual;
+  StatusOr<HttpResponse> response;
+  do {
+    std::size_t bytes_read = 0;
+    response = download.GetMore(buffer.data(), buffer.size(), bytes_read);
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    ASSERT_LE(bytes_read, buffer.size());
+    actual.append(buffer.data(), bytes_read);
+  } while (response->status_code == 100);
+
+  EXPECT_FALSE(download.IsOpen());
+  EXPECT_EQ(contents_, actual);
+}
+
+TEST_F(CurlMultiReactorTest, CloseWithoutReading) {
+  auto reactor = std::make_shared<CurlMultiReactor>(1);
+  auto download = MakeRequest(reactor);
+  EXPECT_TRUE(download.IsOpen());
+
+  auto response = download.Close();
+  ASSERT_TRUE(response.ok()) << "status=" << response.status();
+  EXPECT_FALSE(download.IsOpen());
+}
+
+TEST_F(CurlMultiReactorTest, DestroyWithoutClose) {
+  auto reactor = std::make_shared<CurlMultiReactor>(1);
+  {
+    auto download = MakeRequest(reactor);
+    std::string buffer;
+    auto response = download.GetMore(buffer);
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+  }
+  // The reactor must still be usable after the transfer is discarded.
+  auto download = MakeRequest(reactor);
+  std::string actual;
+  std::string buffer;
+  StatusOr<HttpResponse> response;
+  do {
+    response = download.GetMore(buffer);
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    actual += buffer;
+  } while (response->status_code == 100);
+  EXPECT_EQ(contents_, actual);
+}
+
+TEST_F(CurlMultiReactorTest, Schedule) {
+  CurlMultiReactor reactor(2);
+  std::promise<void> done;
+  auto const start = std::chrono::steady_clock::now();
+  reactor.Schedule(std::chrono::milliseconds(50),
+                   [&done] { done.set_value(); });
+  done.get_future().get();
+  EXPECT_LE(std::chrono::milliseconds(50),
+            std::chrono::steady_clock::now() - start);
+}
+
+TEST_F(CurlMultiReactorTest, ScheduleFiresOnShutdown) {
+  std::promise<void> done;
+  auto fired = done.get_future();
+  {
+    CurlMultiReactor reactor(1);
+    reactor.Schedule(std::chrono::hours(1), [&done] { done.set_value(); });
+  }
+  EXPECT_EQ(std::future_status::ready, fired.wait_for(std::chrono::seconds(0)));
+}
+
+TEST_F(CurlMultiReactorTest, DestroyFromCallback) {
+  auto reactor = std::make_shared<CurlMultiReactor>(2);
+  // Hold the only reference in the callback, so the reactor is destroyed by
+  // one of its own threads.
+  auto holder = std::make_shared<std::shared_ptr<CurlMultiReactor>>(reactor);
+  std::promise<void> done;
+  reactor->Schedule(std::chrono::milliseconds(20), [holder, &done] {
+    holder->reset();
+    done.set_value();
+  });
+  reactor.reset();
+  done.get_future().get();
+}
+
+TEST_F(CurlMultiReactorTest, MakeRequestAsync) {
+  CurlMultiReactor reactor(2);
+  std::vector<future<StatusOr<HttpResponse>>> pending;
+  for (int i = 0; i != 8; ++i) {
+    CurlRequestBuilder builder("file://" + file_name_,
+                               GetDefaultCurlHandleFactory());
+    pending.push_back(
+        builder.BuildRequest().MakeRequestAsync(std::string{}, reactor));
+  }
+  for (auto& f : pending) {
+    auto response = f.get();
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    EXPECT_EQ(contents_, response->payload);
+  }
+}
+
+TEST_F(CurlMultiReactorTest, MakeRequestAsyncError) {
+  CurlMultiReactor reactor(1);
+  CurlRequestBuilder builder("file://" + file_name_ + ".not-found",
+                             GetDefaultCurlHandleFactory());
+  auto response =
+      builder.BuildRequest().MakeRequestAsync(std::string{}, reactor).get();
+  EXPECT_FALSE(response.ok());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -27,7 +27,38 @@ StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
     handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.length());
     handle_.SetOption(CURLOPT_POSTFIELDS, payload.c_str());
   }
-  auto status = handle_.EasyPerform();
+  return OnTransferDone(handle_.EasyPerform());
+}
+
+future<StatusOr<HttpResponse>> CurlRequest::MakeRequestAsync(
+    std::string payload, CurlMultiReactor& reactor) && {
+  // The request, and the payload, must remain at a stable address until the
+  // transfer completes, move them to the heap.
+  struct State {
+    State(CurlRequest r, std::string p)
+        : request(std::move(r)), payload(std::move(p)) {}
+
+    CurlRequest request;
+    std::string payload;
+    promise<StatusOr<HttpResponse>> done;
+  };
+  auto state = std::make_shared<State>(std::move(*this), std::move(payload));
+  auto& handle = state->request.handle_;
+  if (!state->payload.empty()) {
+    handle.SetOption(CURLOPT_POSTFIELDSIZE, state->payload.length());
+    handle.SetOption(CURLOPT_POSTFIELDS, state->payload.c_str());
+  }
+  auto result = state->done.get_future();
+  reactor.AddTransfer(handle.handle_.get(), [state](CURLcode e) {
+    auto& request = state->request;
+    auto response = request.OnTransferDone(
+        request.handle_.AsStatus(e, "MakeRequestAsync"));
+    state->done.set_value(std::move(response));
+  });
+  return result;
+}
+
+StatusOr<HttpResponse> CurlRequest::OnTransferDone(Status const& status) {
   if (!status.ok()) {
     return status;
   }
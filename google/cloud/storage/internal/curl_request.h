@@ -16,7 +16,9 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H_
 
 #include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/future.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/internal/curl_multi_reactor.h"
 #include "google/cloud/storage/internal/http_response.h"
 
 namespace google {
@@ -79,10 +81,24 @@ class CurlRequest {
    */
   StatusOr<HttpResponse> MakeRequest(std::string const& payload);
 
+  /**
+   * Makes the prepared request without blocking the calling thread.
+   *
+   * The request is consumed by this call, and runs in one of the @p reactor
+   * threads. The returned future is satisfied from that thread, and it is
+   * satisfied with an error if the reactor is destroyed before the request
+   * completes.
+   */
+  future<StatusOr<HttpResponse>> MakeRequestAsync(std::string payload,
+                                                  CurlMultiReactor& reactor) &&;
+
  private:
   friend class CurlRequestBuilder;
   void ResetOptions();
 
+  /// Collects the response after the transfer for this request is done.
+  StatusOr<HttpResponse> OnTransferDone(Status const& status);
+
   std::string url_;
   CurlHeaders headers_;
   std::string user_agent_;
@@ -71,7 +71,11 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   request.user_agent_ = user_agent_prefix_ + UserAgentSuffix();
   request.payload_ = std::move(payload);
   request.handle_ = std::move(handle_);
-  request.multi_ = factory_->CreateMultiHandle();
+  if (reactor_) {
+    request.reactor_ = std::move(reactor_);
+  } else {
+    request.multi_ = factory_->CreateMultiHandle();
+  }
   request.factory_ = factory_;
   request.logging_enabled_ = logging_enabled_;
   request.SetOptions();
@@ -128,6 +132,13 @@ CurlRequestBuilder& CurlRequestBuilder::SetInitialBufferSize(std::size_t size) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetReactor(
+    std::shared_ptr<CurlMultiReactor> reactor) {
+  ValidateBuilderState(__func__);
+  reactor_ = std::move(reactor);
+  return *this;
+}
+
 std::string CurlRequestBuilder::UserAgentSuffix() const {
   ValidateBuilderState(__func__);
   // Pre-compute and cache the user agent string:
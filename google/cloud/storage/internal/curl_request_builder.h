@@ -160,6 +160,14 @@ class CurlRequestBuilder {
 
   CurlRequestBuilder& SetInitialBufferSize(std::size_t size);
 
+  /**
+   * Sets the reactor used to run download requests.
+   *
+   * If not set (or set to `nullptr`) each download request runs its own
+   * `CURLM*` handle in the thread that consumes the data.
+   */
+  CurlRequestBuilder& SetReactor(std::shared_ptr<CurlMultiReactor> reactor);
+
   /// Gets the user-agent suffix.
   std::string UserAgentSuffix() const;
 
@@ -189,6 +197,8 @@ class CurlRequestBuilder {
   bool logging_enabled_;
 
   std::size_t initial_buffer_size_;
+
+  std::shared_ptr<CurlMultiReactor> reactor_;
 };
 
 }  // namespace internal
@@ -23,12 +23,45 @@ namespace internal {
 
 CurlResumableStreambuf::CurlResumableStreambuf(
     std::unique_ptr<ResumableUploadSession> upload_session,
-    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator)
+    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator,
+    bool pipelined)
     : upload_session_(std::move(upload_session)),
+      session_id_(upload_session_->session_id()),
+      next_expected_byte_(upload_session_->next_expected_byte()),
       max_buffer_size_(UploadChunkRequest::RoundUpToQuantum(max_buffer_size)),
       hash_validator_(std::move(hash_validator)),
+      pipelined_(pipelined),
       last_response_{400} {
   current_ios_buffer_.reserve(max_buffer_size_);
+  if (pipelined_) {
+    pending_buffer_.reserve(max_buffer_size_);
+    worker_ = std::thread(&CurlResumableStreambuf::UploadLoop, this);
+  }
+}
+
+CurlResumableStreambuf::~CurlResumableStreambuf() {
+  if (!pipelined_) {
+    return;
+  }
+  bool in_flight;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    in_flight = chunk_pending_ || has_result_;
+  }
+  // The background upload uses the session and the buffers, wait for it. Nobody
+  // else can report its result at this point.
+  auto last = WaitForPendingChunk();
+  if (in_flight && !last.ok()) {
+    GCP_LOG(WARNING) << "Error uploading a chunk in resumable upload session <"
+                     << session_id_ << ">, the data in the chunk is lost: "
+                     << last.status();
+  }
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
 }
 
 bool CurlResumableStreambuf::IsOpen() const {
@@ -91,12 +124,18 @@ StatusOr<HttpResponse> CurlResumableStreambuf::Flush(bool final_chunk) {
   // Shorten the buffer to the actual used size.
   auto actual_size = static_cast<std::size_t>(pptr() - pbase());
   if (actual_size == 0) {
-    return last_response_;
+    return final_chunk ? WaitForPendingChunk() : last_response_;
   }
   if (actual_size <= max_buffer_size_ && !final_chunk) {
     return last_response_;
   }
 
+  // The chunks must be uploaded in order, wait for the previous one.
+  auto previous = WaitForPendingChunk();
+  if (!previous.ok()) {
+    return previous;
+  }
+
   std::string trailing;
   std::size_t upload_size = 0U;
   if (final_chunk) {
@@ -107,12 +146,29 @@ StatusOr<HttpResponse> CurlResumableStreambuf::Flush(bool final_chunk) {
     trailing = current_ios_buffer_.substr(max_buffer_size_);
     current_ios_buffer_.resize(max_buffer_size_);
   }
-  hash_validator_->Update(current_ios_buffer_);
-
-  auto result = upload_session_->UploadChunk(current_ios_buffer_, upload_size);
-  if (!result.ok()) {
-    // This was an unrecoverable error, time to signal an error.
-    return std::move(result).status();
+  if (pipelined_) {
+    // Upload the chunk in the background, and let the application fill the
+    // other buffer in the meantime.
+    pending_buffer_.swap(current_ios_buffer_);
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      pending_upload_size_ = upload_size;
+      chunk_pending_ = true;
+    }
+    cv_.notify_all();
+  } else {
+    hash_validator_->Update(current_ios_buffer_);
+    auto result =
+        upload_session_->UploadChunk(current_ios_buffer_, upload_size);
+    SaveSessionState();
+    if (!result.ok()) {
+      // This was an unrecoverable error, time to signal an error.
+      return std::move(result).status();
+    }
+    // If `result.ok() == false` we never get to this point, so the last
+    // response was actually successful, represent that by a HTTP 200 status
+    // code.
+    last_response_ = HttpResponse{200, std::move(result).value().payload, {}};
   }
   current_ios_buffer_.clear();
   current_ios_buffer_.reserve(max_buffer_size_);
@@ -121,15 +177,60 @@ StatusOr<HttpResponse> CurlResumableStreambuf::Flush(bool final_chunk) {
   pbump(static_cast<int>(trailing.size()));
 
   if (final_chunk) {
+    auto last = WaitForPendingChunk();
+    if (!last.ok()) {
+      return last;
+    }
     upload_session_.reset();
   }
+  return last_response_;
+}
 
-  // If `result.ok() == false` we never get to this point, so the last response
-  // was actually successful, represent that by a HTTP 200 status code.
-  last_response_ = HttpResponse{200, std::move(result).value().payload, {}};
+StatusOr<HttpResponse> CurlResumableStreambuf::WaitForPendingChunk() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return !chunk_pending_; });
+  if (has_result_) {
+    has_result_ = false;
+    auto result = std::move(pending_result_);
+    lk.unlock();
+    SaveSessionState();
+    if (!result.ok()) {
+      // The data in the chunk is lost, so the error is final.
+      pending_status_ = std::move(result).status();
+    } else {
+      last_response_ = HttpResponse{200, std::move(result).value().payload, {}};
+    }
+  }
+  if (!pending_status_.ok()) {
+    return pending_status_;
+  }
   return last_response_;
 }
 
+void CurlResumableStreambuf::UploadLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    cv_.wait(lk, [this] { return shutdown_ || chunk_pending_; });
+    if (shutdown_) {
+      return;
+    }
+    auto const upload_size = pending_upload_size_;
+    lk.unlock();
+    hash_validator_->Update(pending_buffer_);
+    auto result = upload_session_->UploadChunk(pending_buffer_, upload_size);
+    lk.lock();
+    pending_result_ = std::move(result);
+    chunk_pending_ = false;
+    has_result_ = true;
+    cv_.notify_all();
+  }
+}
+
+void CurlResumableStreambuf::SaveSessionState() {
+  session_id_ = upload_session_->session_id();
+  next_expected_byte_ = upload_session_->next_expected_byte();
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -18,7 +18,10 @@
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -28,15 +31,27 @@ class ObjectMetadata;
 namespace internal {
 /**
  * Implement a wrapper for libcurl-based resumable uploads.
+ *
+ * If @p pipelined is true the upload of each chunk runs in a background
+ * thread, while the application fills the next buffer. Each object owns one
+ * such thread for its lifetime. The chunks must be uploaded in order, so at
+ * most one chunk is in flight, and the application blocks if it fills the next
+ * buffer before the previous upload completes. The hash of each chunk is also
+ * computed in the background thread. Any error uploading a chunk is reported
+ * by the next call that flushes the buffer, or when the stream is closed. If
+ * the stream is destroyed without closing it, such errors are logged.
+ *
+ * The session id and the next expected byte reflect the last chunk that
+ * completed, they never block waiting for a chunk in flight.
  */
 class CurlResumableStreambuf : public ObjectWriteStreambuf {
  public:
   explicit CurlResumableStreambuf(
       std::unique_ptr<ResumableUploadSession> upload_session,
       std::size_t max_buffer_size,
-      std::unique_ptr<HashValidator> hash_validator);
+      std::unique_ptr<HashValidator> hash_validator, bool pipelined = false);
 
-  ~CurlResumableStreambuf() override = default;
+  ~CurlResumableStreambuf() override;
 
   bool IsOpen() const override;
   bool ValidateHash(ObjectMetadata const& meta) override;
@@ -47,10 +62,10 @@ class CurlResumableStreambuf : public ObjectWriteStreambuf {
     return hash_validator_result_.computed;
   }
   std::string const& resumable_session_id() const override {
-    return upload_session_->session_id();
+    return session_id_;
   }
   std::uint64_t next_expected_byte() const override {
-    return upload_session_->next_expected_byte();
+    return next_expected_byte_;
   }
 
  protected:
@@ -63,7 +78,18 @@ class CurlResumableStreambuf : public ObjectWriteStreambuf {
   /// Flush the libcurl buffer and swap it with the iostream buffer.
   StatusOr<HttpResponse> Flush(bool final_chunk);
 
+  /// Wait until the chunk in flight (if any) is uploaded.
+  StatusOr<HttpResponse> WaitForPendingChunk();
+
+  /// Upload the chunks in `pending_buffer_`, runs in `worker_`.
+  void UploadLoop();
+
+  /// Save the session state, only call when no chunk is in flight.
+  void SaveSessionState();
+
   std::unique_ptr<ResumableUploadSession> upload_session_;
+  std::string session_id_;
+  std::uint64_t next_expected_byte_;
 
   std::string current_ios_buffer_;
   std::size_t max_buffer_size_;
@@ -71,6 +97,20 @@ class CurlResumableStreambuf : public ObjectWriteStreambuf {
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
 
+  bool pipelined_;
+  // The chunk in flight, and its result. `mu_` protects the flags and the
+  // result, the buffer is owned by `worker_` while `chunk_pending_` is set.
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool chunk_pending_ = false;
+  bool has_result_ = false;
+  bool shutdown_ = false;
+  std::uint64_t pending_upload_size_ = 0;
+  std::string pending_buffer_;
+  StatusOr<ResumableUploadResponse> pending_result_;
+  std::thread worker_;
+
+  Status pending_status_;
   HttpResponse last_response_;
 };
 
@@ -0,0 +1,240 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_resumable_streambuf.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/capture_log_lines_backend.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <future>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::google::cloud::internal::make_unique;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using testing::canonical_errors::TransientError;
+
+std::string ExpectedHash(std::string const& data) {
+  MD5HashValidator validator;
+  validator.Update(data);
+  return std::move(validator).Finish().computed;
+}
+
+/// @test Verify that the chunks are uploaded in order, without pipelining.
+TEST(CurlResumableStreambufTest, Simple) {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const a(quantum, 'A');
+  std::string const b(quantum, 'B');
+  std::string const c(10, 'C');
+
+  auto session = make_unique<testing::MockResumableUploadSession>();
+  std::string const id = "test-session-id";
+  EXPECT_CALL(*session, session_id()).WillRepeatedly(ReturnRef(id));
+  std::uint64_t next_byte = 0;
+  auto upload = [&next_byte](std::string const& buffer, std::uint64_t) {
+    next_byte += buffer.size();
+    return make_status_or(ResumableUploadResponse{"", next_byte - 1, "{}"});
+  };
+  EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Invoke([&] {
+    return next_byte;
+  }));
+  EXPECT_CALL(*session, UploadChunk(a, 0)).WillOnce(Invoke(upload));
+  EXPECT_CALL(*session, UploadChunk(b, 0)).WillOnce(Invoke(upload));
+  EXPECT_CALL(*session, UploadChunk(c, 2 * quantum + 10))
+      .WillOnce(Invoke(upload));
+
+  CurlResumableStreambuf tested(std::move(session), quantum,
+                                make_unique<MD5HashValidator>());
+  tested.sputn(a.data(), a.size());
+  tested.sputn(b.data(), b.size());
+  tested.sputn(c.data(), c.size());
+  auto response = tested.Close();
+  ASSERT_TRUE(response.ok()) << response.status();
+  EXPECT_EQ(200, response->status_code);
+  EXPECT_EQ("{}", response->payload);
+  EXPECT_FALSE(tested.IsOpen());
+
+  EXPECT_TRUE(tested.ValidateHash(ObjectMetadata()));
+  EXPECT_EQ(ExpectedHash(a + b + c), tested.computed_hash());
+}
+
+/// @test Verify that the application fills a buffer while a chunk uploads.
+TEST(CurlResumableStreambufTest, Pipelined) {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const a(quantum, 'A');
+  std::string const b(quantum, 'B');
+  std::string const c(10, 'C');
+
+  auto session = make_unique<testing::MockResumableUploadSession>();
+  std::string const id = "test-session-id";
+  EXPECT_CALL(*session, session_id()).WillRepeatedly(ReturnRef(id));
+  std::promise<void> first_chunk_started;
+  std::promise<void> release_first_chunk;
+  auto release = release_first_chunk.get_future();
+  std::uint64_t next_byte = 0;
+  auto upload = [&next_byte](std::string const& buffer, std::uint64_t) {
+    next_byte += buffer.size();
+    return make_status_or(ResumableUploadResponse{"", next_byte - 1, "{}"});
+  };
+  EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Invoke([&] {
+    return next_byte;
+  }));
+  EXPECT_CALL(*session, UploadChunk(a, 0))
+      .WillOnce(Invoke([&](std::string const& buffer, std::uint64_t size) {
+        first_chunk_started.set_value();
+        release.wait();
+        return upload(buffer, size);
+      }));
+  EXPECT_CALL(*session, UploadChunk(b, 0)).WillOnce(Invoke(upload));
+  EXPECT_CALL(*session, UploadChunk(c, 2 * quantum + 10))
+      .WillOnce(Invoke(upload));
+
+  CurlResumableStreambuf tested(std::move(session), quantum,
+                                make_unique<MD5HashValidator>(), true);
+  tested.sputn(a.data(), a.size());
+  tested.sputn(b.data(), b.size());
+  // This starts the upload of the first chunk, without the pipeline it would
+  // block forever.
+  tested.sputn(c.data(), c.size());
+  first_chunk_started.get_future().wait();
+  release_first_chunk.set_value();
+
+  auto response = tested.Close();
+  ASSERT_TRUE(response.ok()) << response.status();
+  EXPECT_EQ(200, response->status_code);
+  EXPECT_EQ("{}", response->payload);
+  EXPECT_FALSE(tested.IsOpen());
+
+  EXPECT_TRUE(tested.ValidateHash(ObjectMetadata()));
+  EXPECT_EQ(ExpectedHash(a + b + c), tested.computed_hash());
+}
+
+/// @test Verify that errors in the background upload are reported.
+TEST(CurlResumableStreambufTest, PipelinedError) {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const a(quantum, 'A');
+  std::string const b(10, 'B');
+
+  auto session = make_unique<testing::MockResumableUploadSession>();
+  std::string const id = "test-session-id";
+  EXPECT_CALL(*session, session_id()).WillRepeatedly(ReturnRef(id));
+  EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*session, UploadChunk(a, 0))
+      .WillOnce(Invoke([](std::string const&, std::uint64_t) {
+        return StatusOr<ResumableUploadResponse>(TransientError());
+      }));
+
+  CurlResumableStreambuf tested(std::move(session), quantum,
+                                make_unique<MD5HashValidator>(), true);
+  tested.sputn(a.data(), a.size());
+  EXPECT_EQ(static_cast<std::streamsize>(b.size()),
+            tested.sputn(b.data(), b.size()));
+
+  auto response = tested.Close();
+  EXPECT_EQ(TransientError().code(), response.status().code());
+  // The data in the failed chunk is lost, the error is permanent.
+  response = tested.Close();
+  EXPECT_EQ(TransientError().code(), response.status().code());
+}
+
+/// @test Verify that the session state does not wait for a chunk in flight.
+TEST(CurlResumableStreambufTest, PipelinedSessionState) {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const a(quantum, 'A');
+  std::string const b(10, 'B');
+
+  auto session = make_unique<testing::MockResumableUploadSession>();
+  std::string const id = "test-session-id";
+  EXPECT_CALL(*session, session_id()).WillRepeatedly(ReturnRef(id));
+  std::promise<void> first_chunk_started;
+  std::promise<void> release_first_chunk;
+  auto release = release_first_chunk.get_future();
+  std::uint64_t next_byte = 0;
+  EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Invoke([&] {
+    return next_byte;
+  }));
+  EXPECT_CALL(*session, UploadChunk(a, 0))
+      .WillOnce(Invoke([&](std::string const& buffer, std::uint64_t) {
+        first_chunk_started.set_value();
+        release.wait();
+        next_byte += buffer.size();
+        return make_status_or(ResumableUploadResponse{"", next_byte - 1, ""});
+      }));
+
+  CurlResumableStreambuf tested(std::move(session), quantum,
+                                make_unique<MD5HashValidator>(), true);
+  tested.sputn(a.data(), a.size());
+  tested.sputn(b.data(), b.size());
+  first_chunk_started.get_future().wait();
+  EXPECT_EQ(id, tested.resumable_session_id());
+  EXPECT_EQ(0U, tested.next_expected_byte());
+  release_first_chunk.set_value();
+
+  // Flushing waits for the chunk and updates the session state.
+  tested.pubsync();
+  EXPECT_EQ(quantum, tested.next_expected_byte());
+}
+
+/// @test Verify that errors are logged if the stream is not closed.
+TEST(CurlResumableStreambufTest, PipelinedErrorInDestructor) {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const a(quantum, 'A');
+  std::string const b(10, 'B');
+
+  auto backend = std::make_shared<testing_util::CaptureLogLinesBackend>();
+  auto id = LogSink::Instance().AddBackend(backend);
+
+  auto session = make_unique<testing::MockResumableUploadSession>();
+  std::string const session_id = "test-session-id";
+  EXPECT_CALL(*session, session_id()).WillRepeatedly(ReturnRef(session_id));
+  EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*session, UploadChunk(a, 0))
+      .WillOnce(Invoke([](std::string const&, std::uint64_t) {
+        return StatusOr<ResumableUploadResponse>(TransientError());
+      }));
+
+  {
+    CurlResumableStreambuf tested(std::move(session), quantum,
+                                  make_unique<MD5HashValidator>(), true);
+    tested.sputn(a.data(), a.size());
+    tested.sputn(b.data(), b.size());
+  }
+  LogSink::Instance().RemoveBackend(id);
+
+  auto count = std::count_if(
+      backend->log_lines.begin(), backend->log_lines.end(),
+      [&session_id](std::string const& line) {
+        return line.find(session_id) != std::string::npos &&
+               line.find("the data in the chunk is lost") != std::string::npos;
+      });
+  EXPECT_EQ(1, count);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
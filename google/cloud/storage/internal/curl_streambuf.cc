@@ -14,6 +14,8 @@
 
 #include "google/cloud/storage/internal/curl_streambuf.h"
 #include "google/cloud/storage/object_stream.h"
+#include <algorithm>
+#include <cstring>
 
 namespace google {
 namespace cloud {
@@ -23,10 +25,12 @@ namespace internal {
 
 CurlReadStreambuf::CurlReadStreambuf(
     CurlDownloadRequest&& download, std::size_t target_buffer_size,
-    std::unique_ptr<HashValidator> hash_validator)
+    std::unique_ptr<HashValidator> hash_validator,
+    std::unique_ptr<DownloadBufferSizer> buffer_sizer)
     : download_(std::move(download)),
       target_buffer_size_(target_buffer_size),
-      hash_validator_(std::move(hash_validator)) {
+      hash_validator_(std::move(hash_validator)),
+      buffer_sizer_(std::move(buffer_sizer)) {
   // Start with an empty read area, to force an underflow() on the first
   // extraction.
   current_ios_buffer_.push_back('\0');
@@ -77,10 +81,17 @@ CurlReadStreambuf::int_type CurlReadStreambuf::underflow() {
   }
 
   current_ios_buffer_.reserve(target_buffer_size_);
+  auto const start = std::chrono::steady_clock::now();
   StatusOr<HttpResponse> response = download_.GetMore(current_ios_buffer_);
   if (!response.ok()) {
     return ReportError(std::move(response).status());
   }
+  if (buffer_sizer_) {
+    buffer_sizer_->Update(current_ios_buffer_.size(),
+                          std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start));
+    download_.SetBufferSize(buffer_sizer_->buffer_size());
+  }
   for (auto const& kv : response->headers) {
     hash_validator_->ProcessHeader(kv.first, kv.second);
     headers_.emplace(kv.first, kv.second);
@@ -107,6 +118,49 @@ CurlReadStreambuf::int_type CurlReadStreambuf::underflow() {
   return traits_type::eof();
 }
 
+std::streamsize CurlReadStreambuf::xsgetn(char* s, std::streamsize count) {
+  // Small reads go through the read area, large reads are worth the overhead
+  // of having libcurl write straight into the application's buffer.
+  if (count < static_cast<std::streamsize>(target_buffer_size_)) {
+    return ObjectReadStreambuf::xsgetn(s, count);
+  }
+
+  // Consume any data already in the read area first.
+  std::streamsize offset = (std::min)(count, egptr() - gptr());
+  if (offset > 0) {
+    std::memcpy(s, gptr(), static_cast<std::size_t>(offset));
+    gbump(static_cast<int>(offset));
+  }
+  while (offset < count && IsOpen()) {
+    std::size_t bytes_read = 0;
+    auto response = download_.GetMore(
+        s + offset, static_cast<std::size_t>(count - offset), bytes_read);
+    if (!response.ok()) {
+      ReportError(std::move(response).status());
+      return offset;
+    }
+    for (auto const& kv : response->headers) {
+      hash_validator_->ProcessHeader(kv.first, kv.second);
+      headers_.emplace(kv.first, kv.second);
+    }
+    if (response->status_code >= 300) {
+      // The data just received is the error payload, not part of the object,
+      // do not return it to the application.
+      response->payload.assign(s + offset, bytes_read);
+      ReportError(AsStatus(*response));
+      return offset;
+    }
+    hash_validator_->Update(s + offset, bytes_read);
+    offset += static_cast<std::streamsize>(bytes_read);
+  }
+  if (offset < count) {
+    // The download completed, underflow() verifies the checksums and reports
+    // any mismatch.
+    underflow();
+  }
+  return offset;
+}
+
 CurlReadStreambuf::int_type CurlReadStreambuf::ReportError(Status status) {
   // The only way to report errors from a std::basic_streambuf<> (which this
   // class derives from) is to throw exceptions:
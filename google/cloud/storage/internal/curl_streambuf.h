@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/curl_download_request.h"
 #include "google/cloud/storage/internal/curl_upload_request.h"
+#include "google/cloud/storage/internal/download_buffer_sizer.h"
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
 
@@ -27,12 +28,18 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 /**
  * Makes streaming download requests using libcurl.
+ *
+ * If @p buffer_sizer is not null it sets the amount of data requested from
+ * @p download on each `underflow()`, based on the performance of the previous
+ * calls.
  */
 class CurlReadStreambuf : public ObjectReadStreambuf {
  public:
   explicit CurlReadStreambuf(CurlDownloadRequest&& download,
                              std::size_t target_buffer_size,
-                             std::unique_ptr<HashValidator> hash_validator);
+                             std::unique_ptr<HashValidator> hash_validator,
+                             std::unique_ptr<DownloadBufferSizer> buffer_sizer =
+                                 std::unique_ptr<DownloadBufferSizer>());
 
   ~CurlReadStreambuf() override = default;
 
@@ -51,6 +58,7 @@ class CurlReadStreambuf : public ObjectReadStreambuf {
 
  protected:
   int_type underflow() override;
+  std::streamsize xsgetn(char* s, std::streamsize count) override;
 
   int_type ReportError(Status status);
 
@@ -63,6 +71,7 @@ class CurlReadStreambuf : public ObjectReadStreambuf {
 
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
+  std::unique_ptr<DownloadBufferSizer> buffer_sizer_;
   Status status_;
   std::multimap<std::string, std::string> headers_;
 };
@@ -0,0 +1,72 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_buffer_sizer.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// Very short round-trip estimates would bring back the frequent wakeups, very
+// long estimates (say because the first request was slow) would make the
+// buffers grow too much.
+constexpr std::chrono::microseconds kMinimumRoundTrip(1000);
+constexpr std::chrono::microseconds kMaximumRoundTrip(100000);
+}  // namespace
+
+DownloadBufferSizer::DownloadBufferSizer(std::size_t minimum_size,
+                                         std::size_t maximum_size)
+    : minimum_size_(minimum_size),
+      maximum_size_((std::max)(minimum_size, maximum_size)),
+      buffer_size_(minimum_size),
+      round_trip_(0),
+      bytes_per_microsecond_(0) {}
+
+void DownloadBufferSizer::Update(std::size_t bytes,
+                                 std::chrono::microseconds elapsed) {
+  if (bytes == 0) {
+    return;
+  }
+  std::size_t target;
+  if (elapsed.count() <= 0) {
+    // The data was already available, the application reads slower than the
+    // network delivers, larger reads have less overhead.
+    target = 2 * buffer_size_;
+  } else {
+    if (round_trip_.count() == 0) {
+      round_trip_ =
+          (std::min)(kMaximumRoundTrip, (std::max)(kMinimumRoundTrip, elapsed));
+    }
+    double rate = static_cast<double>(bytes) / elapsed.count();
+    if (bytes_per_microsecond_ == 0) {
+      bytes_per_microsecond_ = rate;
+    } else {
+      bytes_per_microsecond_ = (bytes_per_microsecond_ + rate) / 2;
+    }
+    target = static_cast<std::size_t>(bytes_per_microsecond_ *
+                                      round_trip_.count());
+  }
+  target = (std::min)(target, 2 * buffer_size_);
+  target = (std::max)(target, buffer_size_ / 2);
+  buffer_size_ = (std::min)(maximum_size_, (std::max)(minimum_size_, target));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,68 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_BUFFER_SIZER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_BUFFER_SIZER_H_
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Computes the buffer size for a download from its observed performance.
+ *
+ * A streaming download waits until its buffer is full (or the download
+ * completes) before returning any data to the application. Small buffers
+ * result in too many wakeups on fast networks, large buffers delay the first
+ * bytes of small objects, and of slow downloads.
+ *
+ * This class starts with @p minimum_size and, after each read, moves the
+ * buffer size towards the bandwidth-delay product of the download, that is,
+ * the data received in one round-trip. The round-trip time is estimated from
+ * the first read, which includes the latency of the request. The throughput is
+ * a moving average over all the reads. The size changes by at most a factor of
+ * two on each read and is always in the [@p minimum_size, @p maximum_size]
+ * range.
+ */
+class DownloadBufferSizer {
+ public:
+  DownloadBufferSizer(std::size_t minimum_size, std::size_t maximum_size);
+
+  /// The buffer size for the next read.
+  std::size_t buffer_size() const { return buffer_size_; }
+
+  /// Update the estimates after reading @p bytes in @p elapsed time.
+  void Update(std::size_t bytes, std::chrono::microseconds elapsed);
+
+ private:
+  std::size_t minimum_size_;
+  std::size_t maximum_size_;
+  std::size_t buffer_size_;
+  // Zero until the first read completes.
+  std::chrono::microseconds round_trip_;
+  double bytes_per_microsecond_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_BUFFER_SIZER_H_
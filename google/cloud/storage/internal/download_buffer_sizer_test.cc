@@ -0,0 +1,110 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_buffer_sizer.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using std::chrono::microseconds;
+
+std::size_t const kMinimum = 16 * 1024;
+std::size_t const kMaximum = 8 * 1024 * 1024;
+
+/// Simulate reading a full buffer at @p bytes_per_microsecond.
+void ReadFullBuffer(DownloadBufferSizer& tested,
+                    std::size_t bytes_per_microsecond) {
+  auto const size = tested.buffer_size();
+  tested.Update(size, microseconds(size / bytes_per_microsecond));
+}
+
+TEST(DownloadBufferSizerTest, StartsWithMinimum) {
+  DownloadBufferSizer tested(kMinimum, kMaximum);
+  EXPECT_EQ(kMinimum, tested.buffer_size());
+}
+
+TEST(DownloadBufferSizerTest, MaximumBelowMinimum) {
+  DownloadBufferSizer tested(kMinimum, kMinimum / 2);
+  EXPECT_EQ(kMinimum, tested.buffer_size());
+  tested.Update(kMinimum, microseconds(0));
+  EXPECT_EQ(kMinimum, tested.buffer_size());
+}
+
+TEST(DownloadBufferSizerTest, IgnoresEmptyReads) {
+  DownloadBufferSizer tested(kMinimum, kMaximum);
+  tested.Update(0, microseconds(0));
+  tested.Update(0, microseconds(1000));
+  EXPECT_EQ(kMinimum, tested.buffer_size());
+}
+
+TEST(DownloadBufferSizerTest, GrowsOnFastNetwork) {
+  DownloadBufferSizer tested(kMinimum, kMaximum);
+  // The first read includes the round-trip of the request, 2ms in this test.
+  tested.Update(kMinimum, microseconds(2000));
+  EXPECT_EQ(kMinimum, tested.buffer_size());
+
+  // At ~10GB/s the bandwidth-delay product is ~20MB, above the maximum.
+  for (int i = 0; i != 20; ++i) {
+    auto const previous = tested.buffer_size();
+    ReadFullBuffer(tested, 10000);
+    EXPECT_GE(tested.buffer_size(), previous);
+    EXPECT_LE(tested.buffer_size(), 2 * previous);
+  }
+  EXPECT_EQ(kMaximum, tested.buffer_size());
+}
+
+TEST(DownloadBufferSizerTest, ConvergesToBandwidthDelayProduct) {
+  DownloadBufferSizer tested(kMinimum, kMaximum);
+  tested.Update(kMinimum, microseconds(2000));
+  // At 100 bytes per microsecond the bandwidth-delay product is 200,000 bytes.
+  for (int i = 0; i != 40; ++i) {
+    ReadFullBuffer(tested, 100);
+  }
+  EXPECT_LE(150000U, tested.buffer_size());
+  EXPECT_GE(250000U, tested.buffer_size());
+}
+
+TEST(DownloadBufferSizerTest, ShrinksOnSlowNetwork) {
+  DownloadBufferSizer tested(kMinimum, kMaximum);
+  tested.Update(kMinimum, microseconds(2000));
+  for (int i = 0; i != 20; ++i) {
+    ReadFullBuffer(tested, 10000);
+  }
+  ASSERT_EQ(kMaximum, tested.buffer_size());
+
+  for (int i = 0; i != 20; ++i) {
+    auto const previous = tested.buffer_size();
+    ReadFullBuffer(tested, 1);
+    EXPECT_LE(tested.buffer_size(), previous);
+    EXPECT_GE(tested.buffer_size(), previous / 2);
+  }
+  EXPECT_EQ(kMinimum, tested.buffer_size());
+}
+
+TEST(DownloadBufferSizerTest, GrowsWhenDataIsBuffered) {
+  DownloadBufferSizer tested(kMinimum, kMaximum);
+  tested.Update(kMinimum, microseconds(0));
+  EXPECT_EQ(2 * kMinimum, tested.buffer_size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -19,6 +19,11 @@
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/status.h"
 #include <crc32c/crc32c.h>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -26,9 +31,23 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
-void CompositeValidator::Update(std::string const& payload) {
-  left_->Update(payload);
-  right_->Update(payload);
+void CompositeValidator::Update(char const* buf, std::size_t n) {
+  // Start any background updates first, so they run in parallel with the
+  // inline updates.
+  bool const left_started = left_->StartUpdate(buf, n);
+  bool const right_started = right_->StartUpdate(buf, n);
+  if (!left_started) {
+    left_->Update(buf, n);
+  }
+  if (!right_started) {
+    right_->Update(buf, n);
+  }
+  if (left_started) {
+    left_->WaitForUpdate();
+  }
+  if (right_started) {
+    right_->WaitForUpdate();
+  }
 }
 
 void CompositeValidator::ProcessMetadata(ObjectMetadata const& meta) {
@@ -56,8 +75,8 @@ HashValidator::Result CompositeValidator::Finish() && {
 
 MD5HashValidator::MD5HashValidator() : context_{} { MD5_Init(&context_); }
 
-void MD5HashValidator::Update(std::string const& payload) {
-  MD5_Update(&context_, payload.c_str(), payload.size());
+void MD5HashValidator::Update(char const* buf, std::size_t n) {
+  MD5_Update(&context_, buf, n);
 }
 
 void MD5HashValidator::ProcessMetadata(ObjectMetadata const& meta) {
@@ -97,10 +116,9 @@ HashValidator::Result MD5HashValidator::Finish() && {
 
 Crc32cHashValidator::Crc32cHashValidator() : current_(0) {}
 
-void Crc32cHashValidator::Update(std::string const& payload) {
-  current_ = crc32c::Extend(
-      current_, reinterpret_cast<std::uint8_t const*>(payload.data()),
-      payload.size());
+void Crc32cHashValidator::Update(char const* buf, std::size_t n) {
+  current_ =
+      crc32c::Extend(current_, reinterpret_cast<std::uint8_t const*>(buf), n);
 }
 
 void Crc32cHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
@@ -131,13 +149,179 @@ void Crc32cHashValidator::ProcessHeader(std::string const& key,
 }
 
 HashValidator::Result Crc32cHashValidator::Finish() && {
-  std::uint32_t big_endian = google::cloud::internal::ToBigEndian(current_);
+  auto computed = FormatCrc32cChecksum(current_);
+  bool is_mismatch = !received_hash_.empty() && (received_hash_ != computed);
+  return Result{std::move(received_hash_), std::move(computed), is_mismatch};
+}
+
+namespace {
+/**
+ * The threads used by all the `PipelinedHashValidator` objects.
+ */
+class HashThreadPool {
+ public:
+  HashThreadPool() {
+    auto const count = (std::max)(2U, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i != count; ++i) {
+      std::thread([this] { Run(); }).detach();
+    }
+  }
+
+  void Submit(std::function<void()> task) {
+    std::unique_lock<std::mutex> lk(mu_);
+    tasks_.push_back(std::move(task));
+    lk.unlock();
+    cv_.notify_one();
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+      cv_.wait(lk, [this] { return !tasks_.empty(); });
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      lk.unlock();
+      task();
+      lk.lock();
+    }
+  }
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+};
+
+HashThreadPool& DefaultHashThreadPool() {
+  // Never deleted, the threads may be waiting when the program exits.
+  static auto* const pool = new HashThreadPool;
+  return *pool;
+}
+}  // namespace
+
+PipelinedHashValidator::PipelinedHashValidator(
+    std::unique_ptr<HashValidator> validator, std::size_t min_background_bytes)
+    : validator_(std::move(validator)),
+      min_background_bytes_(min_background_bytes),
+      running_(false) {}
+
+PipelinedHashValidator::~PipelinedHashValidator() { WaitForUpdate(); }
+
+void PipelinedHashValidator::Update(char const* buf, std::size_t n) {
+  WaitForUpdate();
+  validator_->Update(buf, n);
+}
+
+bool PipelinedHashValidator::StartUpdate(char const* buf, std::size_t n) {
+  if (n < min_background_bytes_) {
+    return false;
+  }
+  WaitForUpdate();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    running_ = true;
+  }
+  DefaultHashThreadPool().Submit([this, buf, n] {
+    validator_->Update(buf, n);
+    // Notify while holding the lock, once WaitForUpdate() returns this object
+    // may be deleted.
+    std::lock_guard<std::mutex> lk(mu_);
+    running_ = false;
+    cv_.notify_all();
+  });
+  return true;
+}
+
+void PipelinedHashValidator::WaitForUpdate() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return !running_; });
+}
+
+void PipelinedHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
+  WaitForUpdate();
+  validator_->ProcessMetadata(meta);
+}
+
+void PipelinedHashValidator::ProcessHeader(std::string const& key,
+                                           std::string const& value) {
+  WaitForUpdate();
+  validator_->ProcessHeader(key, value);
+}
+
+HashValidator::Result PipelinedHashValidator::Finish() && {
+  WaitForUpdate();
+  return std::move(*validator_).Finish();
+}
+
+namespace {
+using Gf2Matrix = std::array<std::uint32_t, 32>;
+
+std::uint32_t Gf2MatrixTimes(Gf2Matrix const& mat, std::uint32_t vec) {
+  std::uint32_t sum = 0;
+  for (auto i = mat.begin(); vec != 0; vec >>= 1, ++i) {
+    if ((vec & 1U) != 0) {
+      sum ^= *i;
+    }
+  }
+  return sum;
+}
+
+void Gf2MatrixSquare(Gf2Matrix& square, Gf2Matrix const& mat) {
+  for (std::size_t n = 0; n != mat.size(); ++n) {
+    square[n] = Gf2MatrixTimes(mat, mat[n]);
+  }
+}
+}  // namespace
+
+std::uint32_t Crc32cCombine(std::uint32_t crc1, std::uint32_t crc2,
+                            std::uint64_t len2) {
+  // This is the algorithm used by zlib's crc32_combine(), using the (reflected)
+  // CRC32C polynomial. Appending `len2` zero bytes to the first block is a
+  // linear operation on the checksum, represented by a 32x32 matrix over
+  // GF(2). The matrix for 2^k zero bits is computed by repeated squaring.
+  if (len2 == 0) {
+    return crc1;
+  }
+  Gf2Matrix even{};
+  Gf2Matrix odd{};
+  // The operator for one zero bit.
+  odd[0] = 0x82F63B78U;
+  std::uint32_t row = 1;
+  for (std::size_t n = 1; n != odd.size(); ++n) {
+    odd[n] = row;
+    row <<= 1U;
+  }
+  // The operators for two and four zero bits.
+  Gf2MatrixSquare(even, odd);
+  Gf2MatrixSquare(odd, even);
+
+  // Apply `len2` zero bytes to `crc1`, the first squaring creates the operator
+  // for one zero byte (eight zero bits).
+  do {
+    Gf2MatrixSquare(even, odd);
+    if ((len2 & 1U) != 0) {
+      crc1 = Gf2MatrixTimes(even, crc1);
+    }
+    len2 >>= 1U;
+    if (len2 == 0) {
+      break;
+    }
+    Gf2MatrixSquare(odd, even);
+    if ((len2 & 1U) != 0) {
+      crc1 = Gf2MatrixTimes(odd, crc1);
+    }
+    len2 >>= 1U;
+  } while (len2 != 0);
+
+  return crc1 ^ crc2;
+}
+
+std::string FormatCrc32cChecksum(std::uint32_t checksum) {
+  std::uint32_t big_endian = google::cloud::internal::ToBigEndian(checksum);
   std::string hash;
   hash.resize(sizeof(big_endian));
   std::memcpy(&hash[0], &big_endian, sizeof(big_endian));
-  auto computed = OpenSslUtils::Base64Encode(hash);
-  bool is_mismatch = !received_hash_.empty() && (received_hash_ != computed);
-  return Result{std::move(received_hash_), std::move(computed), is_mismatch};
+  return OpenSslUtils::Base64Encode(hash);
 }
 
 }  // namespace internal
@@ -17,7 +17,10 @@
 
 #include "google/cloud/storage/version.h"
 #include <openssl/md5.h>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -38,7 +41,24 @@ class HashValidator {
   virtual std::string Name() const = 0;
 
   /// Update the computed hash value with some portion of the data.
-  virtual void Update(std::string const& payload) = 0;
+  virtual void Update(char const* buf, std::size_t n) = 0;
+
+  /// Update the computed hash value with some portion of the data.
+  void Update(std::string const& payload) {
+    Update(payload.data(), payload.size());
+  }
+
+  /**
+   * Starts updating the computed hash value in the background, if supported.
+   *
+   * Returns false if the validator does not support background updates, the
+   * caller should use `Update()` instead. Otherwise the caller must keep the
+   * data valid, and call `WaitForUpdate()` before calling any other function.
+   */
+  virtual bool StartUpdate(char const* buf, std::size_t n) { return false; }
+
+  /// Blocks until the update started by `StartUpdate()` completes.
+  virtual void WaitForUpdate() {}
 
   /// Update the received hash value based on a ObjectMetadata response.
   virtual void ProcessMetadata(ObjectMetadata const& meta) = 0;
@@ -75,7 +95,8 @@ class NullHashValidator : public HashValidator {
   NullHashValidator() = default;
 
   std::string Name() const override { return "null"; }
-  void Update(std::string const& payload) override {}
+  using HashValidator::Update;
+  void Update(char const* buf, std::size_t n) override {}
   void ProcessMetadata(ObjectMetadata const& meta) override {}
   void ProcessHeader(std::string const& key,
                      std::string const& value) override {}
@@ -92,7 +113,8 @@ class CompositeValidator : public HashValidator {
       : left_(std::move(left)), right_(std::move(right)) {}
 
   std::string Name() const override { return "composite"; }
-  void Update(std::string const& payload) override;
+  using HashValidator::Update;
+  void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
   Result Finish() && override;
@@ -113,7 +135,8 @@ class MD5HashValidator : public HashValidator {
   MD5HashValidator& operator=(MD5HashValidator const&) = delete;
 
   std::string Name() const override { return "md5"; }
-  void Update(std::string const& payload) override;
+  using HashValidator::Update;
+  void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
   Result Finish() && override;
@@ -134,7 +157,8 @@ class Crc32cHashValidator : public HashValidator {
   Crc32cHashValidator& operator=(Crc32cHashValidator const&) = delete;
 
   std::string Name() const override { return "crc32c"; }
-  void Update(std::string const& payload) override;
+  using HashValidator::Update;
+  void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
   Result Finish() && override;
@@ -144,6 +168,57 @@ class Crc32cHashValidator : public HashValidator {
   std::string received_hash_;
 };
 
+/**
+ * A validator that computes the hashes in a shared pool of threads.
+ *
+ * Wraps another validator. `StartUpdate()` hashes large chunks in a pool of
+ * threads shared by all the validators, without copying the data. When used as
+ * one of the validators in a `CompositeValidator` the hashes are computed in
+ * parallel. Chunks smaller than @p min_background_bytes are hashed inline, for
+ * them the hand off to another thread costs more than it saves.
+ */
+class PipelinedHashValidator : public HashValidator {
+ public:
+  PipelinedHashValidator(std::unique_ptr<HashValidator> validator,
+                         std::size_t min_background_bytes);
+  ~PipelinedHashValidator() override;
+
+  PipelinedHashValidator(PipelinedHashValidator const&) = delete;
+  PipelinedHashValidator& operator=(PipelinedHashValidator const&) = delete;
+
+  std::string Name() const override { return validator_->Name(); }
+  using HashValidator::Update;
+  void Update(char const* buf, std::size_t n) override;
+  bool StartUpdate(char const* buf, std::size_t n) override;
+  void WaitForUpdate() override;
+  void ProcessMetadata(ObjectMetadata const& meta) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  Result Finish() && override;
+
+ private:
+  std::unique_ptr<HashValidator> validator_;
+  std::size_t min_background_bytes_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  // Set while a thread in the pool is hashing data for this validator.
+  bool running_;
+};
+
+/**
+ * Combines the CRC32C checksums of two consecutive blocks of data.
+ *
+ * Given `crc1 == CRC32C(A)` and `crc2 == CRC32C(B)` this function returns
+ * `CRC32C(A + B)`, where `len2` is the length of `B`. The implementation does
+ * not need the data, only the checksums, so it can be used to validate
+ * downloads that fetch the object in multiple (parallel) slices.
+ */
+std::uint32_t Crc32cCombine(std::uint32_t crc1, std::uint32_t crc2,
+                            std::uint64_t len2);
+
+/// Format a CRC32C checksum using the encoding used by GCS.
+std::string FormatCrc32cChecksum(std::uint32_t checksum);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
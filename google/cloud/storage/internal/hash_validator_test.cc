@@ -17,7 +17,9 @@
 #include "google/cloud/status.h"
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/object_metadata.h"
+#include <crc32c/crc32c.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -217,6 +219,127 @@ TEST(CompositeHashValidator, Missing) {
   EXPECT_FALSE(result.is_mismatch);
 }
 
+TEST(CompositeHashValidator, UpdateFromBuffer) {
+  CompositeValidator validator(
+      google::cloud::internal::make_unique<Crc32cHashValidator>(),
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  std::string const text = "The quick brown fox jumps over the lazy dog";
+  validator.Update(text.data(), 9);
+  validator.Update(text.data() + 9, 0);
+  validator.Update(text.data() + 9, text.size() - 9);
+  validator.ProcessHeader("x-goog-hash", "crc32c=" + QUICK_FOX_CRC32C_CHECKSUM);
+  validator.ProcessHeader("x-goog-hash", "md5=" + QUICK_FOX_MD5_HASH);
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ(result.computed, result.received);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+TEST(PipelinedHashValidator, Inline) {
+  PipelinedHashValidator validator(
+      google::cloud::internal::make_unique<MD5HashValidator>(), 1024);
+  EXPECT_EQ("md5", validator.Name());
+  std::string const text = "The quick brown fox jumps over the lazy dog";
+  EXPECT_FALSE(validator.StartUpdate(text.data(), 9));
+  validator.Update(text.data(), 9);
+  validator.Update(text.data() + 9, text.size() - 9);
+  validator.ProcessHeader("x-goog-hash", "md5=" + QUICK_FOX_MD5_HASH);
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ(QUICK_FOX_MD5_HASH, result.received);
+  EXPECT_EQ(QUICK_FOX_MD5_HASH, result.computed);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+TEST(PipelinedHashValidator, Background) {
+  PipelinedHashValidator validator(
+      google::cloud::internal::make_unique<MD5HashValidator>(), 4);
+  std::string const text = "The quick brown fox jumps over the lazy dog";
+  ASSERT_TRUE(validator.StartUpdate(text.data(), 9));
+  validator.WaitForUpdate();
+  EXPECT_FALSE(validator.StartUpdate(text.data() + 9, 3));
+  validator.Update(text.data() + 9, 3);
+  ASSERT_TRUE(validator.StartUpdate(text.data() + 12, text.size() - 12));
+  validator.WaitForUpdate();
+  validator.ProcessHeader("x-goog-hash", "md5=<invalid-value-for-test>");
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ("<invalid-value-for-test>", result.received);
+  EXPECT_EQ(QUICK_FOX_MD5_HASH, result.computed);
+  EXPECT_TRUE(result.is_mismatch);
+}
+
+TEST(PipelinedHashValidator, ParallelComposite) {
+  std::string payload;
+  for (int i = 0; i != 1000; ++i) {
+    payload += "The quick brown fox jumps over the lazy dog\n";
+  }
+  CompositeValidator expected(
+      google::cloud::internal::make_unique<Crc32cHashValidator>(),
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  expected.Update(payload);
+  auto expected_result = std::move(expected).Finish();
+
+  CompositeValidator validator(
+      google::cloud::internal::make_unique<PipelinedHashValidator>(
+          google::cloud::internal::make_unique<Crc32cHashValidator>(), 0),
+      google::cloud::internal::make_unique<PipelinedHashValidator>(
+          google::cloud::internal::make_unique<MD5HashValidator>(), 0));
+  std::size_t const chunk_size = 1000;
+  for (std::size_t offset = 0; offset < payload.size(); offset += chunk_size) {
+    auto n = (std::min)(chunk_size, payload.size() - offset);
+    validator.Update(payload.data() + offset, n);
+  }
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ(expected_result.computed, result.computed);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+TEST(PipelinedHashValidator, DestroyWithoutWait) {
+  std::string const text = "The quick brown fox jumps over the lazy dog";
+  PipelinedHashValidator validator(
+      google::cloud::internal::make_unique<MD5HashValidator>(), 0);
+  EXPECT_TRUE(validator.StartUpdate(text.data(), text.size()));
+  // The destructor must wait for the background update.
+}
+
+std::uint32_t ComputeCrc32c(std::string const& payload) {
+  return crc32c::Extend(0,
+                        reinterpret_cast<std::uint8_t const*>(payload.data()),
+                        payload.size());
+}
+
+TEST(Crc32cCombine, Empty) {
+  EXPECT_EQ(EMPTY_STRING_CRC32C_CHECKSUM, FormatCrc32cChecksum(0));
+  EXPECT_EQ(EMPTY_STRING_CRC32C_CHECKSUM,
+            FormatCrc32cChecksum(Crc32cCombine(0, 0, 0)));
+}
+
+TEST(Crc32cCombine, AllSplits) {
+  std::string const quick_fox = "The quick brown fox jumps over the lazy dog";
+  EXPECT_EQ(QUICK_FOX_CRC32C_CHECKSUM,
+            FormatCrc32cChecksum(ComputeCrc32c(quick_fox)));
+  for (std::size_t i = 0; i <= quick_fox.size(); ++i) {
+    auto head = quick_fox.substr(0, i);
+    auto tail = quick_fox.substr(i);
+    auto combined =
+        Crc32cCombine(ComputeCrc32c(head), ComputeCrc32c(tail), tail.size());
+    EXPECT_EQ(QUICK_FOX_CRC32C_CHECKSUM, FormatCrc32cChecksum(combined))
+        << "i=" << i;
+  }
+}
+
+TEST(Crc32cCombine, MultipleSlices) {
+  std::string payload;
+  for (int i = 0; i != 1000; ++i) {
+    payload += "The quick brown fox jumps over the lazy dog\n";
+  }
+  std::size_t const slice_size = 1024;
+  std::uint32_t combined = 0;
+  for (std::size_t offset = 0; offset < payload.size(); offset += slice_size) {
+    auto slice = payload.substr(offset, slice_size);
+    combined = Crc32cCombine(combined, ComputeCrc32c(slice), slice.size());
+  }
+  EXPECT_EQ(ComputeCrc32c(payload), combined);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
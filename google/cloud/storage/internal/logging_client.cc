@@ -78,6 +78,31 @@ MakeCallNoResponseLogging(
   GCP_LOG(INFO) << context << "() << " << request;
   return (client.*function)(request);
 }
+
+/**
+ * Logs the input and results of an asynchronous `RawClient` operation.
+ *
+ * The result is logged from the thread that satisfies the future.
+ */
+template <typename Response, typename Request>
+future<StatusOr<Response>> MakeAsyncCall(
+    RawClient& client,
+    future<StatusOr<Response>> (RawClient::*function)(Request const&),
+    Request const& request, char const* context) {
+  GCP_LOG(INFO) << context << "() << " << request;
+  return (client.*function)(request).then(
+      [context](future<StatusOr<Response>> f) {
+        auto response = f.get();
+        if (response.ok()) {
+          GCP_LOG(INFO) << context << "() >> payload={" << response.value()
+                        << "}";
+        } else {
+          GCP_LOG(INFO) << context << "() >> status={" << response.status()
+                        << "}";
+        }
+        return response;
+      });
+}
 }  // namespace
 
 LoggingClient::LoggingClient(std::shared_ptr<RawClient> client)
@@ -336,6 +361,54 @@ StatusOr<EmptyResponse> LoggingClient::DeleteNotification(
   return MakeCall(*client_, &RawClient::DeleteNotification, request, __func__);
 }
 
+future<StatusOr<ObjectMetadata>> LoggingClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return MakeAsyncCall(*client_, &RawClient::AsyncInsertObjectMedia, request,
+                       __func__);
+}
+
+bool LoggingClient::SupportsAsync() const { return client_->SupportsAsync(); }
+
+future<StatusOr<ListObjectsResponse>> LoggingClient::AsyncListObjects(
+    ListObjectsRequest const& request) {
+  return MakeAsyncCall(*client_, &RawClient::AsyncListObjects, request,
+                       __func__);
+}
+
+future<StatusOr<ObjectMetadata>> LoggingClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return MakeAsyncCall(*client_, &RawClient::AsyncGetObjectMetadata, request,
+                       __func__);
+}
+
+future<StatusOr<std::string>> LoggingClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  // Like ReadObject(), do not log the object contents.
+  GCP_LOG(INFO) << __func__ << "() << " << request;
+  return client_->AsyncReadObject(request);
+}
+
+future<StatusOr<EmptyResponse>> LoggingClient::AsyncDeleteObject(
+    DeleteObjectRequest const& request) {
+  return MakeAsyncCall(*client_, &RawClient::AsyncDeleteObject, request,
+                       __func__);
+}
+
+future<void> LoggingClient::AsyncSleep(std::chrono::milliseconds duration) {
+  return client_->AsyncSleep(duration);
+}
+
+StatusOr<BatchResponse> LoggingClient::ExecuteBatch(
+    BatchRequest const& request) {
+  return MakeCall(*client_, &RawClient::ExecuteBatch, request, __func__);
+}
+
+StatusOr<ListObjectSummariesResponse> LoggingClient::ListObjectSummaries(
+    ListObjectsRequest const& request) {
+  return MakeCall(*client_, &RawClient::ListObjectSummaries, request,
+                  __func__);
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
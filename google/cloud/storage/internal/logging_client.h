@@ -128,6 +128,23 @@ class LoggingClient : public RawClient {
   StatusOr<EmptyResponse> DeleteNotification(
       DeleteNotificationRequest const&) override;
 
+  bool SupportsAsync() const override;
+  future<StatusOr<ListObjectsResponse>> AsyncListObjects(
+      ListObjectsRequest const& request) override;
+  future<StatusOr<ObjectMetadata>> AsyncInsertObjectMedia(
+      InsertObjectMediaRequest const& request) override;
+  future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      GetObjectMetadataRequest const& request) override;
+  future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const& request) override;
+  future<StatusOr<EmptyResponse>> AsyncDeleteObject(
+      DeleteObjectRequest const& request) override;
+  future<void> AsyncSleep(std::chrono::milliseconds duration) override;
+
+  StatusOr<BatchResponse> ExecuteBatch(BatchRequest const& request) override;
+  StatusOr<ListObjectSummariesResponse> ListObjectSummaries(
+      ListObjectsRequest const& request) override;
+
   std::shared_ptr<RawClient> client() const { return client_; }
 
  private:
@@ -15,6 +15,9 @@
 #include "google/cloud/storage/internal/metadata_parser.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/storage/internal/parse_rfc3339.h"
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
 #include <sstream>
 
 namespace google {
@@ -115,6 +118,55 @@ std::uint64_t ParseUnsignedLongField(nl::json const& json,
   google::cloud::internal::ThrowInvalidArgument(os.str());
 }
 
+namespace {
+Status InvalidIntegerValue(std::string const& text, char const* field_name,
+                           char const* type) {
+  std::ostringstream os;
+  os << "Error parsing field <" << field_name << "> as an " << type
+     << ", value=" << text;
+  return Status(StatusCode::kInvalidArgument, os.str());
+}
+}  // namespace
+
+StatusOr<std::int32_t> ParseIntValue(std::string const& text,
+                                     char const* field_name) {
+  auto value = ParseLongValue(text, field_name);
+  if (!value) {
+    return InvalidIntegerValue(text, field_name, "std::int32_t");
+  }
+  if (*value < (std::numeric_limits<std::int32_t>::min)() ||
+      *value > (std::numeric_limits<std::int32_t>::max)()) {
+    return InvalidIntegerValue(text, field_name, "std::int32_t");
+  }
+  return static_cast<std::int32_t>(*value);
+}
+
+StatusOr<std::int64_t> ParseLongValue(std::string const& text,
+                                      char const* field_name) {
+  char* end = nullptr;
+  errno = 0;
+  auto value = std::strtoll(text.c_str(), &end, 10);
+  if (text.empty() || errno != 0 || *end != '\0') {
+    return InvalidIntegerValue(text, field_name, "std::int64_t");
+  }
+  return static_cast<std::int64_t>(value);
+}
+
+StatusOr<std::uint64_t> ParseUnsignedLongValue(std::string const& text,
+                                               char const* field_name) {
+  char* end = nullptr;
+  errno = 0;
+  // std::strtoull() accepts (and negates) values with a leading minus sign.
+  if (text.find('-') != std::string::npos) {
+    return InvalidIntegerValue(text, field_name, "std::uint64_t");
+  }
+  auto value = std::strtoull(text.c_str(), &end, 10);
+  if (text.empty() || errno != 0 || *end != '\0') {
+    return InvalidIntegerValue(text, field_name, "std::uint64_t");
+  }
+  return static_cast<std::uint64_t>(value);
+}
+
 std::chrono::system_clock::time_point ParseTimestampField(
     nl::json const& json, char const* field_name) {
   if (json.count(field_name) == 0) {
@@ -15,8 +15,11 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METADATA_PARSER_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METADATA_PARSER_H_
 
+#include "google/cloud/status_or.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include <chrono>
+#include <cstdint>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -64,6 +67,22 @@ std::int64_t ParseLongField(nl::json const& json, char const* field_name);
 std::uint64_t ParseUnsignedLongField(nl::json const& json,
                                      char const* field_name);
 
+//@{
+/**
+ * Parses the text form of an integer field, without throwing exceptions.
+ *
+ * Used by parsers that do not create a JSON DOM. Malformed and out of range
+ * values return a `StatusCode::kInvalidArgument` error that names
+ * @p field_name.
+ */
+StatusOr<std::int32_t> ParseIntValue(std::string const& text,
+                                     char const* field_name);
+StatusOr<std::int64_t> ParseLongValue(std::string const& text,
+                                      char const* field_name);
+StatusOr<std::uint64_t> ParseUnsignedLongValue(std::string const& text,
+                                               char const* field_name);
+//@}
+
 /**
  * Parses a RFC 3339 timestamp.
  *
@@ -209,6 +209,34 @@ TEST(MetadataParserTest, ParseIntegralFieldInvalidFieldType) {
   CheckParseInvalidFieldType<std::uint64_t>(&ParseUnsignedLongField);
 }
 
+/// @test Verify Parse*Value returns errors instead of throwing.
+TEST(MetadataParserTest, ParseIntegralValue) {
+  EXPECT_EQ(-7, ParseIntValue("-7", "f").value());
+  EXPECT_EQ(1234567890123LL, ParseLongValue("1234567890123", "f").value());
+  EXPECT_EQ(18446744073709551615ULL,
+            ParseUnsignedLongValue("18446744073709551615", "f").value());
+
+  for (std::string const text : {"", "abc", "12abc", "1.5"}) {
+    SCOPED_TRACE("Testing with " + text);
+    EXPECT_EQ(StatusCode::kInvalidArgument,
+              ParseIntValue(text, "f").status().code());
+    EXPECT_EQ(StatusCode::kInvalidArgument,
+              ParseLongValue(text, "f").status().code());
+    EXPECT_EQ(StatusCode::kInvalidArgument,
+              ParseUnsignedLongValue(text, "f").status().code());
+  }
+  auto status = ParseIntValue("2147483648", "field_name").status();
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+  EXPECT_THAT(status.message(), ::testing::HasSubstr("<field_name>"));
+  EXPECT_EQ(StatusCode::kInvalidArgument,
+            ParseLongValue("9223372036854775808", "f").status().code());
+  EXPECT_EQ(
+      StatusCode::kInvalidArgument,
+      ParseUnsignedLongValue("18446744073709551616", "f").status().code());
+  EXPECT_EQ(StatusCode::kInvalidArgument,
+            ParseUnsignedLongValue("-1", "f").status().code());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -0,0 +1,432 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/metrics_client.h"
+#include "google/cloud/storage/internal/metrics_object_streambuf.h"
+#include "google/cloud/storage/internal/metrics_recorder.h"
+#include "google/cloud/storage/internal/metrics_resumable_upload_session.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+namespace {
+using raw_client_wrapper_utils::CheckSignature;
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds ElapsedSince(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               start);
+}
+
+/**
+ * Records the latency and result of each `RawClient` operation.
+ *
+ * @tparam MemberFunction the signature of the member function.
+ * @param client the MetricsClient making the call.
+ * @param function the pointer to the member function to call.
+ * @param request an initialized request parameter for the call.
+ * @param operation the name of the operation, used as the metric name.
+ * @param bytes_sent the request payload size, if any.
+ * @return the result from making the call;
+ */
+template <typename MemberFunction>
+static typename std::enable_if<
+    CheckSignature<MemberFunction>::value,
+    typename CheckSignature<MemberFunction>::ReturnType>::type
+MakeCall(MetricsClient& client, MemberFunction function,
+         typename CheckSignature<MemberFunction>::RequestType const& request,
+         char const* operation, std::uint64_t bytes_sent = 0) {
+  auto& recorder = client.metrics()->Recorder(operation);
+  auto const start = Clock::now();
+  auto response = (*client.client().*function)(request);
+  recorder.Record(ElapsedSince(start), response.status().code(), bytes_sent,
+                  0);
+  return response;
+}
+
+/**
+ * Records the latency and result of an asynchronous `RawClient` operation.
+ *
+ * The latency includes the time until the future is satisfied.
+ */
+template <typename Response, typename Request>
+future<StatusOr<Response>> MakeAsyncCall(
+    MetricsClient& client,
+    future<StatusOr<Response>> (RawClient::*function)(Request const&),
+    Request const& request, char const* operation,
+    std::uint64_t bytes_sent = 0) {
+  // Keep the metrics alive until the operation completes.
+  auto metrics = client.metrics();
+  auto& recorder = metrics->Recorder(operation);
+  auto const start = Clock::now();
+  return (*client.client().*function)(request).then(
+      [metrics, &recorder, start, bytes_sent](future<StatusOr<Response>> f) {
+        auto response = f.get();
+        recorder.Record(ElapsedSince(start), response.status().code(),
+                        bytes_sent, 0);
+        return response;
+      });
+}
+}  // namespace
+
+MetricsClient::MetricsClient(std::shared_ptr<RawClient> client,
+                             std::shared_ptr<ClientMetrics> metrics)
+    : client_(std::move(client)), metrics_(std::move(metrics)) {}
+
+ClientOptions const& MetricsClient::client_options() const {
+  return client_->client_options();
+}
+
+StatusOr<ListBucketsResponse> MetricsClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return MakeCall(*this, &RawClient::ListBuckets, request, __func__);
+}
+
+StatusOr<BucketMetadata> MetricsClient::CreateBucket(
+    CreateBucketRequest const& request) {
+  return MakeCall(*this, &RawClient::CreateBucket, request, __func__);
+}
+
+StatusOr<BucketMetadata> MetricsClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  return MakeCall(*this, &RawClient::GetBucketMetadata, request, __func__);
+}
+
+StatusOr<EmptyResponse> MetricsClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  return MakeCall(*this, &RawClient::DeleteBucket, request, __func__);
+}
+
+StatusOr<BucketMetadata> MetricsClient::UpdateBucket(
+    UpdateBucketRequest const& request) {
+  return MakeCall(*this, &RawClient::UpdateBucket, request, __func__);
+}
+
+StatusOr<BucketMetadata> MetricsClient::PatchBucket(
+    PatchBucketRequest const& request) {
+  return MakeCall(*this, &RawClient::PatchBucket, request, __func__);
+}
+
+StatusOr<IamPolicy> MetricsClient::GetBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return MakeCall(*this, &RawClient::GetBucketIamPolicy, request, __func__);
+}
+
+StatusOr<IamPolicy> MetricsClient::SetBucketIamPolicy(
+    SetBucketIamPolicyRequest const& request) {
+  return MakeCall(*this, &RawClient::SetBucketIamPolicy, request, __func__);
+}
+
+StatusOr<TestBucketIamPermissionsResponse>
+MetricsClient::TestBucketIamPermissions(
+    TestBucketIamPermissionsRequest const& request) {
+  return MakeCall(*this, &RawClient::TestBucketIamPermissions, request,
+                  __func__);
+}
+
+StatusOr<BucketMetadata> MetricsClient::LockBucketRetentionPolicy(
+    LockBucketRetentionPolicyRequest const& request) {
+  return MakeCall(*this, &RawClient::LockBucketRetentionPolicy, request,
+                  __func__);
+}
+
+StatusOr<ObjectMetadata> MetricsClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return MakeCall(*this, &RawClient::InsertObjectMedia, request, __func__,
+                  request.contents().size());
+}
+
+StatusOr<ObjectMetadata> MetricsClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return MakeCall(*this, &RawClient::CopyObject, request, __func__);
+}
+
+StatusOr<ObjectMetadata> MetricsClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return MakeCall(*this, &RawClient::GetObjectMetadata, request, __func__);
+}
+
+StatusOr<std::unique_ptr<ObjectReadStreambuf>>
+MetricsClient::ReadObject(ReadObjectRangeRequest const& request) {
+  // Successful downloads are recorded when the streambuf is closed, so the
+  // metrics include the transfer and the bytes received.
+  auto const start = Clock::now();
+  auto result = client_->ReadObject(request);
+  if (!result.ok()) {
+    metrics_->Recorder(__func__).Record(ElapsedSince(start),
+                                        result.status().code(), 0, 0);
+    return std::move(result).status();
+  }
+  return std::unique_ptr<ObjectReadStreambuf>(
+      google::cloud::internal::make_unique<MetricsObjectReadStreambuf>(
+          std::move(result).value(), metrics_, __func__, start));
+}
+
+StatusOr<std::unique_ptr<ObjectWriteStreambuf>>
+MetricsClient::WriteObject(InsertObjectStreamingRequest const& request) {
+  // Successful uploads are recorded when the streambuf is closed, so the
+  // metrics include the transfer and the bytes sent.
+  auto const start = Clock::now();
+  auto result = client_->WriteObject(request);
+  if (!result.ok()) {
+    metrics_->Recorder(__func__).Record(ElapsedSince(start),
+                                        result.status().code(), 0, 0);
+    return std::move(result).status();
+  }
+  return std::unique_ptr<ObjectWriteStreambuf>(
+      google::cloud::internal::make_unique<MetricsObjectWriteStreambuf>(
+          std::move(result).value(), metrics_, __func__, start));
+}
+
+StatusOr<ListObjectsResponse> MetricsClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return MakeCall(*this, &RawClient::ListObjects, request, __func__);
+}
+
+StatusOr<EmptyResponse> MetricsClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  return MakeCall(*this, &RawClient::DeleteObject, request, __func__);
+}
+
+StatusOr<ObjectMetadata> MetricsClient::UpdateObject(
+    UpdateObjectRequest const& request) {
+  return MakeCall(*this, &RawClient::UpdateObject, request, __func__);
+}
+
+StatusOr<ObjectMetadata> MetricsClient::PatchObject(
+    PatchObjectRequest const& request) {
+  return MakeCall(*this, &RawClient::PatchObject, request, __func__);
+}
+
+StatusOr<ObjectMetadata> MetricsClient::ComposeObject(
+    ComposeObjectRequest const& request) {
+  return MakeCall(*this, &RawClient::ComposeObject, request, __func__);
+}
+
+StatusOr<RewriteObjectResponse> MetricsClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return MakeCall(*this, &RawClient::RewriteObject, request, __func__);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+MetricsClient::CreateResumableSession(ResumableUploadRequest const& request) {
+  auto result =
+      MakeCall(*this, &RawClient::CreateResumableSession, request, __func__);
+  if (!result.ok()) {
+    return std::move(result).status();
+  }
+  return std::unique_ptr<ResumableUploadSession>(
+      google::cloud::internal::make_unique<MetricsResumableUploadSession>(
+          std::move(result).value(), metrics_));
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+MetricsClient::RestoreResumableSession(std::string const& request) {
+  auto result =
+      MakeCall(*this, &RawClient::RestoreResumableSession, request, __func__);
+  if (!result.ok()) {
+    return std::move(result).status();
+  }
+  return std::unique_ptr<ResumableUploadSession>(
+      google::cloud::internal::make_unique<MetricsResumableUploadSession>(
+          std::move(result).value(), metrics_));
+}
+
+StatusOr<ListBucketAclResponse> MetricsClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return MakeCall(*this, &RawClient::ListBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> MetricsClient::GetBucketAcl(
+    GetBucketAclRequest const& request) {
+  return MakeCall(*this, &RawClient::GetBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> MetricsClient::CreateBucketAcl(
+    CreateBucketAclRequest const& request) {
+  return MakeCall(*this, &RawClient::CreateBucketAcl, request, __func__);
+}
+
+StatusOr<EmptyResponse> MetricsClient::DeleteBucketAcl(
+    DeleteBucketAclRequest const& request) {
+  return MakeCall(*this, &RawClient::DeleteBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> MetricsClient::UpdateBucketAcl(
+    UpdateBucketAclRequest const& request) {
+  return MakeCall(*this, &RawClient::UpdateBucketAcl, request, __func__);
+}
+
+StatusOr<BucketAccessControl> MetricsClient::PatchBucketAcl(
+    PatchBucketAclRequest const& request) {
+  return MakeCall(*this, &RawClient::PatchBucketAcl, request, __func__);
+}
+
+StatusOr<ListObjectAclResponse> MetricsClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::ListObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::CreateObjectAcl, request, __func__);
+}
+
+StatusOr<EmptyResponse> MetricsClient::DeleteObjectAcl(
+    DeleteObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::DeleteObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::GetObjectAcl(
+    GetObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::GetObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::UpdateObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::PatchObjectAcl, request, __func__);
+}
+
+StatusOr<ListDefaultObjectAclResponse>
+MetricsClient::ListDefaultObjectAcl(
+    ListDefaultObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::ListDefaultObjectAcl, request,
+                  __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::CreateDefaultObjectAcl(
+    CreateDefaultObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::CreateDefaultObjectAcl, request,
+                  __func__);
+}
+
+StatusOr<EmptyResponse> MetricsClient::DeleteDefaultObjectAcl(
+    DeleteDefaultObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::DeleteDefaultObjectAcl, request,
+                  __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::GetDefaultObjectAcl(
+    GetDefaultObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::GetDefaultObjectAcl, request, __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::UpdateDefaultObjectAcl(
+    UpdateDefaultObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::UpdateDefaultObjectAcl, request,
+                  __func__);
+}
+
+StatusOr<ObjectAccessControl> MetricsClient::PatchDefaultObjectAcl(
+    PatchDefaultObjectAclRequest const& request) {
+  return MakeCall(*this, &RawClient::PatchDefaultObjectAcl, request,
+                  __func__);
+}
+
+StatusOr<ServiceAccount> MetricsClient::GetServiceAccount(
+    GetProjectServiceAccountRequest const& request) {
+  return MakeCall(*this, &RawClient::GetServiceAccount, request, __func__);
+}
+
+StatusOr<ListNotificationsResponse> MetricsClient::ListNotifications(
+    ListNotificationsRequest const& request) {
+  return MakeCall(*this, &RawClient::ListNotifications, request, __func__);
+}
+
+StatusOr<NotificationMetadata> MetricsClient::CreateNotification(
+    CreateNotificationRequest const& request) {
+  return MakeCall(*this, &RawClient::CreateNotification, request, __func__);
+}
+
+StatusOr<NotificationMetadata> MetricsClient::GetNotification(
+    GetNotificationRequest const& request) {
+  return MakeCall(*this, &RawClient::GetNotification, request, __func__);
+}
+
+StatusOr<EmptyResponse> MetricsClient::DeleteNotification(
+    DeleteNotificationRequest const& request) {
+  return MakeCall(*this, &RawClient::DeleteNotification, request, __func__);
+}
+
+future<StatusOr<ObjectMetadata>> MetricsClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return MakeAsyncCall(*this, &RawClient::AsyncInsertObjectMedia, request,
+                       __func__, request.contents().size());
+}
+
+bool MetricsClient::SupportsAsync() const { return client_->SupportsAsync(); }
+
+future<StatusOr<ListObjectsResponse>> MetricsClient::AsyncListObjects(
+    ListObjectsRequest const& request) {
+  return MakeAsyncCall(*this, &RawClient::AsyncListObjects, request,
+                       __func__);
+}
+
+future<StatusOr<ObjectMetadata>> MetricsClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return MakeAsyncCall(*this, &RawClient::AsyncGetObjectMetadata, request,
+                       __func__);
+}
+
+future<StatusOr<std::string>> MetricsClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  // Record the size of the downloaded data.
+  auto metrics = metrics_;
+  auto& recorder = metrics->Recorder(__func__);
+  auto const start = Clock::now();
+  return client_->AsyncReadObject(request).then(
+      [metrics, &recorder, start](future<StatusOr<std::string>> f) {
+        auto response = f.get();
+        recorder.Record(ElapsedSince(start), response.status().code(), 0,
+                        response.ok() ? response->size() : 0);
+        return response;
+      });
+}
+
+future<StatusOr<EmptyResponse>> MetricsClient::AsyncDeleteObject(
+    DeleteObjectRequest const& request) {
+  return MakeAsyncCall(*this, &RawClient::AsyncDeleteObject, request,
+                       __func__);
+}
+
+future<void> MetricsClient::AsyncSleep(std::chrono::milliseconds duration) {
+  return client_->AsyncSleep(duration);
+}
+
+StatusOr<BatchResponse> MetricsClient::ExecuteBatch(
+    BatchRequest const& request) {
+  return MakeCall(*this, &RawClient::ExecuteBatch, request, __func__);
+}
+
+StatusOr<ListObjectSummariesResponse> MetricsClient::ListObjectSummaries(
+    ListObjectsRequest const& request) {
+  return MakeCall(*this, &RawClient::ListObjectSummaries, request,
+                  __func__);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,261 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/metrics_client.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using google::cloud::storage::testing::canonical_errors::TransientError;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+using ::testing::Pair;
+using ::testing::Return;
+
+OperationMetrics FindMetrics(ClientMetrics const& metrics,
+                             std::string const& name) {
+  for (auto& m : metrics.Snapshot()) {
+    if (m.name == name) {
+      return m;
+    }
+  }
+  OperationMetrics empty;
+  empty.name = name;
+  empty.bytes_sent = 0;
+  empty.bytes_received = 0;
+  return empty;
+}
+
+/// A read streambuf returning a fixed string.
+class StringReadStreambuf : public ObjectReadStreambuf {
+ public:
+  explicit StringReadStreambuf(std::string contents)
+      : contents_(std::move(contents)) {
+    setg(&contents_[0], &contents_[0], &contents_[0] + contents_.size());
+  }
+
+  void Close() override { is_open_ = false; }
+  bool IsOpen() const override { return is_open_ && gptr() != egptr(); }
+  Status const& status() const override { return status_; }
+  std::string const& received_hash() const override { return hash_; }
+  std::string const& computed_hash() const override { return hash_; }
+  std::multimap<std::string, std::string> const& headers() const override {
+    return headers_;
+  }
+
+ private:
+  std::string contents_;
+  bool is_open_ = true;
+  Status status_;
+  std::string hash_;
+  std::multimap<std::string, std::string> headers_;
+};
+
+class MockWriteStreambuf : public ObjectWriteStreambuf {
+ public:
+  MOCK_CONST_METHOD0(IsOpen, bool());
+  MOCK_METHOD0(DoClose, StatusOr<HttpResponse>());
+  MOCK_METHOD1(ValidateHash, bool(ObjectMetadata const&));
+  MOCK_CONST_METHOD0(received_hash, std::string const&());
+  MOCK_CONST_METHOD0(computed_hash, std::string const&());
+  MOCK_CONST_METHOD0(resumable_session_id, std::string const&());
+  MOCK_CONST_METHOD0(next_expected_byte, std::uint64_t());
+  MOCK_METHOD2(xsputn, std::streamsize(char const*, std::streamsize));
+  MOCK_METHOD1(overflow, int_type(int_type));
+};
+
+TEST(MetricsClientTest, GetBucketMetadata) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(StatusOr<BucketMetadata>(TransientError())))
+      .WillOnce(Return(BucketMetadata{}));
+  auto metrics = std::make_shared<ClientMetrics>();
+  MetricsClient client(mock, metrics);
+
+  EXPECT_FALSE(client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"))
+                   .status()
+                   .ok());
+  EXPECT_TRUE(client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"))
+                  .status()
+                  .ok());
+
+  auto m = FindMetrics(*metrics, "GetBucketMetadata");
+  EXPECT_EQ(2U, m.latency.count());
+  EXPECT_THAT(m.errors, ElementsAre(Pair(TransientError().code(), 1U)));
+  EXPECT_EQ(0U, m.bytes_sent);
+  EXPECT_EQ(0U, m.bytes_received);
+}
+
+TEST(MetricsClientTest, InsertObjectMedia) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Return(ObjectMetadata{}));
+  auto metrics = std::make_shared<ClientMetrics>();
+  MetricsClient client(mock, metrics);
+
+  std::string const contents = "the contents";
+  EXPECT_TRUE(
+      client.InsertObjectMedia(InsertObjectMediaRequest("foo-bar", "baz",
+                                                        contents))
+          .status()
+          .ok());
+
+  auto m = FindMetrics(*metrics, "InsertObjectMedia");
+  EXPECT_EQ(1U, m.latency.count());
+  EXPECT_TRUE(m.errors.empty());
+  EXPECT_EQ(contents.size(), m.bytes_sent);
+}
+
+TEST(MetricsClientTest, AsyncGetObjectMetadata) {
+  auto mock = std::make_shared<testing::MockClient>();
+  // The default implementation of the asynchronous function calls the
+  // synchronous version.
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())));
+  auto metrics = std::make_shared<ClientMetrics>();
+  MetricsClient client(mock, metrics);
+
+  auto result =
+      client.AsyncGetObjectMetadata(GetObjectMetadataRequest("foo-bar", "baz"))
+          .get();
+  EXPECT_FALSE(result.status().ok());
+
+  auto m = FindMetrics(*metrics, "AsyncGetObjectMetadata");
+  EXPECT_EQ(1U, m.latency.count());
+  EXPECT_THAT(m.errors, ElementsAre(Pair(TransientError().code(), 1U)));
+}
+
+TEST(MetricsClientTest, ReadObject) {
+  std::string const contents = "0123456789";
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        return StatusOr<std::unique_ptr<ObjectReadStreambuf>>(
+            TransientError());
+      }))
+      .WillOnce(Invoke([&contents](ReadObjectRangeRequest const&) {
+        return StatusOr<std::unique_ptr<ObjectReadStreambuf>>(
+            std::unique_ptr<ObjectReadStreambuf>(
+                google::cloud::internal::make_unique<StringReadStreambuf>(
+                    contents)));
+      }));
+  auto metrics = std::make_shared<ClientMetrics>();
+  MetricsClient client(mock, metrics);
+
+  ReadObjectRangeRequest request("foo-bar", "baz");
+  EXPECT_FALSE(client.ReadObject(request).status().ok());
+  auto streambuf = client.ReadObject(request);
+  ASSERT_TRUE(streambuf.status().ok());
+
+  // The successful download is not recorded until it completes.
+  auto m = FindMetrics(*metrics, "ReadObject");
+  EXPECT_EQ(1U, m.latency.count());
+
+  std::string actual(contents.size(), '\0');
+  EXPECT_EQ(4, (*streambuf)->sgetn(&actual[0], 4));
+  EXPECT_EQ('4', (*streambuf)->sbumpc());
+  EXPECT_EQ(5, (*streambuf)->sgetn(&actual[5], 16));
+  (*streambuf)->Close();
+  streambuf->reset();
+
+  m = FindMetrics(*metrics, "ReadObject");
+  EXPECT_EQ(2U, m.latency.count());
+  EXPECT_THAT(m.errors, ElementsAre(Pair(TransientError().code(), 1U)));
+  EXPECT_EQ(0U, m.bytes_sent);
+  EXPECT_EQ(contents.size(), m.bytes_received);
+}
+
+TEST(MetricsClientTest, WriteObject) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, WriteObject(_))
+      .WillOnce(Invoke([](InsertObjectStreamingRequest const&) {
+        auto streambuf =
+            google::cloud::internal::make_unique<MockWriteStreambuf>();
+        EXPECT_CALL(*streambuf, xsputn(_, 12)).WillOnce(Return(12));
+        EXPECT_CALL(*streambuf, overflow('!')).WillOnce(Return('!'));
+        EXPECT_CALL(*streambuf, DoClose())
+            .WillOnce(Return(StatusOr<HttpResponse>(TransientError())));
+        return StatusOr<std::unique_ptr<ObjectWriteStreambuf>>(
+            std::unique_ptr<ObjectWriteStreambuf>(std::move(streambuf)));
+      }));
+  auto metrics = std::make_shared<ClientMetrics>();
+  MetricsClient client(mock, metrics);
+
+  auto streambuf =
+      client.WriteObject(InsertObjectStreamingRequest("foo-bar", "baz"));
+  ASSERT_TRUE(streambuf.status().ok());
+  std::string const contents = "the contents";
+  EXPECT_EQ(static_cast<std::streamsize>(contents.size()),
+            (*streambuf)->sputn(contents.data(), contents.size()));
+  EXPECT_EQ('!', (*streambuf)->sputc('!'));
+
+  // The upload is not recorded until it is closed.
+  EXPECT_EQ(0U, FindMetrics(*metrics, "WriteObject").latency.count());
+  EXPECT_FALSE((*streambuf)->Close().ok());
+  streambuf->reset();
+
+  auto m = FindMetrics(*metrics, "WriteObject");
+  EXPECT_EQ(1U, m.latency.count());
+  EXPECT_THAT(m.errors, ElementsAre(Pair(TransientError().code(), 1U)));
+  EXPECT_EQ(contents.size() + 1, m.bytes_sent);
+  EXPECT_EQ(0U, m.bytes_received);
+}
+
+TEST(MetricsClientTest, CreateResumableSession) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([](ResumableUploadRequest const&) {
+        return StatusOr<std::unique_ptr<ResumableUploadSession>>(
+            TransientError());
+      }))
+      .WillOnce(Invoke([](ResumableUploadRequest const&) {
+        auto session = google::cloud::internal::make_unique<
+            testing::MockResumableUploadSession>();
+        EXPECT_CALL(*session, UploadChunk(_, _))
+            .WillOnce(Return(ResumableUploadResponse{"", 9, ""}));
+        return StatusOr<std::unique_ptr<ResumableUploadSession>>(
+            std::unique_ptr<ResumableUploadSession>(std::move(session)));
+      }));
+  auto metrics = std::make_shared<ClientMetrics>();
+  MetricsClient client(mock, metrics);
+
+  ResumableUploadRequest request("foo-bar", "baz");
+  EXPECT_FALSE(client.CreateResumableSession(request).status().ok());
+  auto session = client.CreateResumableSession(request);
+  ASSERT_TRUE(session.status().ok());
+  EXPECT_TRUE((*session)->UploadChunk("0123456789", 10).status().ok());
+
+  auto create = FindMetrics(*metrics, "CreateResumableSession");
+  EXPECT_EQ(2U, create.latency.count());
+  EXPECT_THAT(create.errors, ElementsAre(Pair(TransientError().code(), 1U)));
+
+  auto upload = FindMetrics(*metrics, "UploadChunk");
+  EXPECT_EQ(1U, upload.latency.count());
+  EXPECT_EQ(10U, upload.bytes_sent);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,143 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/metrics_object_streambuf.h"
+#include "google/cloud/storage/internal/metrics_recorder.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds ElapsedSince(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               start);
+}
+}  // namespace
+
+MetricsObjectReadStreambuf::MetricsObjectReadStreambuf(
+    std::unique_ptr<ObjectReadStreambuf> source,
+    std::shared_ptr<ClientMetrics> metrics, char const* operation,
+    Clock::time_point start)
+    : source_(std::move(source)),
+      metrics_(std::move(metrics)),
+      recorder_(metrics_->Recorder(operation)),
+      start_(start) {}
+
+MetricsObjectReadStreambuf::~MetricsObjectReadStreambuf() { Record(); }
+
+void MetricsObjectReadStreambuf::Close() {
+  source_->Close();
+  Record();
+}
+
+MetricsObjectReadStreambuf::int_type MetricsObjectReadStreambuf::underflow() {
+  auto c = source_->sgetc();
+  if (traits_type::eq_int_type(c, traits_type::eof())) {
+    RecordIfDone();
+  }
+  return c;
+}
+
+MetricsObjectReadStreambuf::int_type MetricsObjectReadStreambuf::uflow() {
+  auto c = source_->sbumpc();
+  if (traits_type::eq_int_type(c, traits_type::eof())) {
+    RecordIfDone();
+  } else {
+    ++bytes_received_;
+  }
+  return c;
+}
+
+std::streamsize MetricsObjectReadStreambuf::xsgetn(char* s,
+                                                   std::streamsize count) {
+  auto n = source_->sgetn(s, count);
+  bytes_received_ += static_cast<std::uint64_t>(n);
+  if (n < count) {
+    RecordIfDone();
+  }
+  return n;
+}
+
+void MetricsObjectReadStreambuf::Record() {
+  if (recorded_) {
+    return;
+  }
+  recorded_ = true;
+  recorder_.Record(ElapsedSince(start_), source_->status().code(), 0,
+                   bytes_received_);
+}
+
+void MetricsObjectReadStreambuf::RecordIfDone() {
+  if (!source_->IsOpen()) {
+    Record();
+  }
+}
+
+MetricsObjectWriteStreambuf::MetricsObjectWriteStreambuf(
+    std::unique_ptr<ObjectWriteStreambuf> sink,
+    std::shared_ptr<ClientMetrics> metrics, char const* operation,
+    Clock::time_point start)
+    : sink_(std::move(sink)),
+      metrics_(std::move(metrics)),
+      recorder_(metrics_->Recorder(operation)),
+      start_(start) {}
+
+MetricsObjectWriteStreambuf::~MetricsObjectWriteStreambuf() {
+  // Uploads are suspended, or abandoned, by destroying the streambuf without
+  // closing it, that is not an error.
+  Record(StatusCode::kOk);
+}
+
+std::streamsize MetricsObjectWriteStreambuf::xsputn(char const* s,
+                                                    std::streamsize count) {
+  auto n = sink_->sputn(s, count);
+  bytes_sent_ += static_cast<std::uint64_t>(n);
+  return n;
+}
+
+MetricsObjectWriteStreambuf::int_type MetricsObjectWriteStreambuf::overflow(
+    int_type ch) {
+  if (traits_type::eq_int_type(ch, traits_type::eof())) {
+    return traits_type::not_eof(ch);
+  }
+  auto c = sink_->sputc(traits_type::to_char_type(ch));
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    ++bytes_sent_;
+  }
+  return c;
+}
+
+StatusOr<HttpResponse> MetricsObjectWriteStreambuf::DoClose() {
+  auto response = sink_->Close();
+  Record(response.status().code());
+  return response;
+}
+
+void MetricsObjectWriteStreambuf::Record(StatusCode code) {
+  if (recorded_) {
+    return;
+  }
+  recorded_ = true;
+  recorder_.Record(ElapsedSince(start_), code, bytes_sent_, 0);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,137 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_OBJECT_STREAMBUF_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_OBJECT_STREAMBUF_H_
+
+#include "google/cloud/storage/client_metrics.h"
+#include "google/cloud/storage/internal/object_streambuf.h"
+#include <chrono>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A decorator for `ObjectReadStreambuf` that records the metrics for a
+ * download.
+ *
+ * The latency is measured from the time the download starts until the
+ * streambuf is closed, or reaches the end of the download, and includes the
+ * bytes received.
+ */
+class MetricsObjectReadStreambuf : public ObjectReadStreambuf {
+ public:
+  MetricsObjectReadStreambuf(std::unique_ptr<ObjectReadStreambuf> source,
+                             std::shared_ptr<ClientMetrics> metrics,
+                             char const* operation,
+                             std::chrono::steady_clock::time_point start);
+  ~MetricsObjectReadStreambuf() override;
+
+  void Close() override;
+  bool IsOpen() const override { return source_->IsOpen(); }
+  Status const& status() const override { return source_->status(); }
+  std::string const& received_hash() const override {
+    return source_->received_hash();
+  }
+  std::string const& computed_hash() const override {
+    return source_->computed_hash();
+  }
+  std::multimap<std::string, std::string> const& headers() const override {
+    return source_->headers();
+  }
+
+ protected:
+  // This class does not buffer, all the operations go to `source_`, so the
+  // bytes are counted as they are returned to the application.
+  std::streamsize showmanyc() override { return source_->in_avail(); }
+  int_type underflow() override;
+  int_type uflow() override;
+  std::streamsize xsgetn(char* s, std::streamsize count) override;
+
+ private:
+  /// Record the metrics, unless they were already recorded.
+  void Record();
+
+  /// Record the metrics if the download has completed.
+  void RecordIfDone();
+
+  std::unique_ptr<ObjectReadStreambuf> source_;
+  std::shared_ptr<ClientMetrics> metrics_;
+  MetricsRecorder& recorder_;
+  std::chrono::steady_clock::time_point start_;
+  std::uint64_t bytes_received_ = 0;
+  bool recorded_ = false;
+};
+
+/**
+ * A decorator for `ObjectWriteStreambuf` that records the metrics for an
+ * upload.
+ *
+ * The latency is measured from the time the upload starts until the streambuf
+ * is closed, and includes the bytes sent.
+ */
+class MetricsObjectWriteStreambuf : public ObjectWriteStreambuf {
+ public:
+  MetricsObjectWriteStreambuf(std::unique_ptr<ObjectWriteStreambuf> sink,
+                              std::shared_ptr<ClientMetrics> metrics,
+                              char const* operation,
+                              std::chrono::steady_clock::time_point start);
+  ~MetricsObjectWriteStreambuf() override;
+
+  bool IsOpen() const override { return sink_->IsOpen(); }
+  bool ValidateHash(ObjectMetadata const& meta) override {
+    return sink_->ValidateHash(meta);
+  }
+  std::string const& received_hash() const override {
+    return sink_->received_hash();
+  }
+  std::string const& computed_hash() const override {
+    return sink_->computed_hash();
+  }
+  std::string const& resumable_session_id() const override {
+    return sink_->resumable_session_id();
+  }
+  std::uint64_t next_expected_byte() const override {
+    return sink_->next_expected_byte();
+  }
+
+ protected:
+  // This class does not buffer, all the operations go to `sink_`.
+  int sync() override { return sink_->pubsync(); }
+  std::streamsize xsputn(char const* s, std::streamsize count) override;
+  int_type overflow(int_type ch) override;
+  StatusOr<HttpResponse> DoClose() override;
+
+ private:
+  /// Record the metrics, unless they were already recorded.
+  void Record(StatusCode code);
+
+  std::unique_ptr<ObjectWriteStreambuf> sink_;
+  std::shared_ptr<ClientMetrics> metrics_;
+  MetricsRecorder& recorder_;
+  std::chrono::steady_clock::time_point start_;
+  std::uint64_t bytes_sent_ = 0;
+  bool recorded_ = false;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_OBJECT_STREAMBUF_H_
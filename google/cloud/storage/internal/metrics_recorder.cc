@@ -0,0 +1,77 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/metrics_recorder.h"
+#include <functional>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+std::size_t const MetricsRecorder::kShardCount;
+std::size_t const MetricsRecorder::kCodeCount;
+
+void MetricsRecorder::Record(std::chrono::microseconds latency,
+                             StatusCode code, std::uint64_t bytes_sent,
+                             std::uint64_t bytes_received) {
+  auto& shard = shards_[CurrentShard()];
+  shard.latency.Record(latency);
+  if (bytes_sent != 0) {
+    shard.bytes_sent.fetch_add(bytes_sent, std::memory_order_relaxed);
+  }
+  if (bytes_received != 0) {
+    shard.bytes_received.fetch_add(bytes_received, std::memory_order_relaxed);
+  }
+  if (code != StatusCode::kOk) {
+    auto index = static_cast<std::size_t>(code);
+    if (index >= kCodeCount) {
+      index = static_cast<std::size_t>(StatusCode::kUnknown);
+    }
+    errors_[index].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+OperationMetrics MetricsRecorder::Snapshot() const {
+  OperationMetrics result;
+  result.name = name_;
+  result.bytes_sent = 0;
+  result.bytes_received = 0;
+  for (auto const& shard : shards_) {
+    result.latency.Merge(shard.latency.Snapshot());
+    result.bytes_sent += shard.bytes_sent.load(std::memory_order_relaxed);
+    result.bytes_received +=
+        shard.bytes_received.load(std::memory_order_relaxed);
+  }
+  for (std::size_t i = 0; i != kCodeCount; ++i) {
+    auto count = errors_[i].load(std::memory_order_relaxed);
+    if (count != 0) {
+      result.errors[static_cast<StatusCode>(i)] = count;
+    }
+  }
+  return result;
+}
+
+std::size_t MetricsRecorder::CurrentShard() {
+  static thread_local std::size_t const shard =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) % kShardCount;
+  return shard;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
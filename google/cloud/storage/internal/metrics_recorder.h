@@ -0,0 +1,71 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_RECORDER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_RECORDER_H_
+
+#include "google/cloud/internal/latency_distribution.h"
+#include "google/cloud/storage/client_metrics.h"
+#include <array>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Record the metrics for one operation.
+ *
+ * The counters are split in shards, each thread updates a single shard using
+ * relaxed atomic increments, so recording never blocks and threads rarely
+ * contend on the same cache lines.
+ */
+class MetricsRecorder {
+ public:
+  static std::size_t const kShardCount = 8;
+
+  explicit MetricsRecorder(char const* name) : name_(name) {}
+
+  char const* name() const { return name_; }
+
+  void Record(std::chrono::microseconds latency, StatusCode code,
+              std::uint64_t bytes_sent, std::uint64_t bytes_received);
+
+  OperationMetrics Snapshot() const;
+
+ private:
+  struct Shard {
+    google::cloud::internal::AtomicLatencyHistogram latency;
+    std::atomic<std::uint64_t> bytes_sent;
+    std::atomic<std::uint64_t> bytes_received;
+  };
+
+  static std::size_t CurrentShard();
+
+  char const* name_;
+  // Value-initialized, that sets all the counters to 0.
+  std::array<Shard, kShardCount> shards_ = {};
+  // Errors are rare, no need to shard them.
+  static std::size_t const kCodeCount =
+      static_cast<std::size_t>(StatusCode::kUnauthenticated) + 1;
+  std::array<std::atomic<std::uint64_t>, kCodeCount> errors_ = {};
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_RECORDER_H_
@@ -0,0 +1,64 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/metrics_resumable_upload_session.h"
+#include "google/cloud/storage/internal/metrics_recorder.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds ElapsedSince(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               start);
+}
+}  // namespace
+
+StatusOr<ResumableUploadResponse>
+MetricsResumableUploadSession::UploadChunk(std::string const& buffer,
+                                           std::uint64_t upload_size) {
+  auto& recorder = metrics_->Recorder(__func__);
+  auto const start = Clock::now();
+  auto response = session_->UploadChunk(buffer, upload_size);
+  recorder.Record(ElapsedSince(start), response.status().code(),
+                  buffer.size(), 0);
+  return response;
+}
+
+StatusOr<ResumableUploadResponse>
+MetricsResumableUploadSession::ResetSession() {
+  auto& recorder = metrics_->Recorder(__func__);
+  auto const start = Clock::now();
+  auto response = session_->ResetSession();
+  recorder.Record(ElapsedSince(start), response.status().code(), 0, 0);
+  return response;
+}
+
+std::uint64_t MetricsResumableUploadSession::next_expected_byte() const {
+  return session_->next_expected_byte();
+}
+
+std::string const& MetricsResumableUploadSession::session_id() const {
+  return session_->session_id();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
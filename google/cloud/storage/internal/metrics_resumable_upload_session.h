@@ -0,0 +1,53 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_RESUMABLE_UPLOAD_SESSION_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_RESUMABLE_UPLOAD_SESSION_H_
+
+#include "google/cloud/storage/client_metrics.h"
+#include "google/cloud/storage/internal/resumable_upload_session.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A decorator for `ResumableUploadSession` that records the metrics for each
+ * operation.
+ */
+class MetricsResumableUploadSession : public ResumableUploadSession {
+ public:
+  MetricsResumableUploadSession(std::unique_ptr<ResumableUploadSession> session,
+                                std::shared_ptr<ClientMetrics> metrics)
+      : session_(std::move(session)), metrics_(std::move(metrics)) {}
+
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      std::string const& buffer, std::uint64_t upload_size) override;
+  StatusOr<ResumableUploadResponse> ResetSession() override;
+  std::uint64_t next_expected_byte() const override;
+  std::string const& session_id() const override;
+
+ private:
+  std::unique_ptr<ResumableUploadSession> session_;
+  std::shared_ptr<ClientMetrics> metrics_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_METRICS_RESUMABLE_UPLOAD_SESSION_H_
@@ -0,0 +1,320 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_stream_parser.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+Status SetField(ObjectMetadata& result, std::string const& parent,
+                std::string const& key, std::string& value) {
+  return ObjectMetadataParser::SetField(result, parent, key, value);
+}
+
+Status SetField(ObjectSummary& result, std::string const& parent,
+                std::string const& key, std::string& value) {
+  return ObjectSummaryParser::SetField(result, parent, key, value);
+}
+
+Status AddAccessControl(ObjectMetadata& result, nl::json const& json) {
+  return ObjectMetadataParser::AddAccessControl(result, json);
+}
+
+Status AddAccessControl(ObjectSummary&, nl::json const&) { return Status(); }
+
+/**
+ * Receives the SAX events from the JSON parser and fills the results.
+ *
+ * The handler keeps a stack with the kind of JSON object or array being
+ * parsed. Scalar values are converted to their text form and passed to
+ * `SetField()`, except for the elements of the `acl` array, which are captured
+ * into small `nl::json` objects.
+ *
+ * @tparam Response the type for `Objects: list` responses, its `items` field
+ *     determines the type for each object.
+ */
+template <typename Response>
+class ObjectMetadataHandler {
+ public:
+  using Item = typename decltype(Response::items)::value_type;
+
+  explicit ObjectMetadataHandler(bool parse_list) : parse_list_(parse_list) {}
+
+  Item& object() { return current_; }
+  Response& response() { return response_; }
+  Status const& status() const { return status_; }
+
+  bool null() {
+    if (!capture_.empty()) {
+      return CaptureValue(nullptr);
+    }
+    // A null value is equivalent to a missing field.
+    return !frames_.empty() && frames_.back() != kItems &&
+           frames_.back() != kAcl;
+  }
+
+  bool boolean(bool value) {
+    if (!capture_.empty()) {
+      return CaptureValue(value);
+    }
+    std::string text = value ? "true" : "false";
+    return OnScalar(text);
+  }
+
+  bool number_integer(nl::json::number_integer_t value) {
+    if (!capture_.empty()) {
+      return CaptureValue(value);
+    }
+    auto text = std::to_string(value);
+    return OnScalar(text);
+  }
+
+  bool number_unsigned(nl::json::number_unsigned_t value) {
+    if (!capture_.empty()) {
+      return CaptureValue(value);
+    }
+    auto text = std::to_string(value);
+    return OnScalar(text);
+  }
+
+  bool number_float(nl::json::number_float_t value,
+                    nl::json::string_t const& raw) {
+    if (!capture_.empty()) {
+      return CaptureValue(value);
+    }
+    std::string text = raw;
+    return OnScalar(text);
+  }
+
+  bool string(nl::json::string_t& value) {
+    if (!capture_.empty()) {
+      return CaptureValue(std::move(value));
+    }
+    return OnScalar(value);
+  }
+
+  // Newer versions of the JSON library also report binary values, these never
+  // appear in JSON text.
+  template <typename Binary>
+  bool binary(Binary&) {
+    return false;
+  }
+
+  bool start_object(std::size_t) {
+    if (!capture_.empty()) {
+      CaptureOpen(nl::json::object());
+      return true;
+    }
+    if (frames_.empty()) {
+      frames_.push_back(parse_list_ ? kList : kObject);
+      return true;
+    }
+    auto frame = kSkip;
+    switch (frames_.back()) {
+      case kItems:
+        current_ = Item{};
+        frame = kObject;
+        break;
+      case kAcl:
+        CaptureOpen(nl::json::object());
+        return true;
+      case kObject:
+        if (key_ == "owner" || key_ == "customerEncryption" ||
+            key_ == "metadata") {
+          parent_ = key_;
+          frame = kNested;
+        }
+        break;
+      default:
+        break;
+    }
+    frames_.push_back(frame);
+    return true;
+  }
+
+  bool end_object() {
+    if (!capture_.empty()) {
+      return CaptureClose();
+    }
+    auto frame = frames_.back();
+    frames_.pop_back();
+    if (frame == kNested) {
+      parent_.clear();
+    } else if (frame == kObject && parse_list_) {
+      response_.items.emplace_back(std::move(current_));
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t) {
+    if (!capture_.empty()) {
+      CaptureOpen(nl::json::array());
+      return true;
+    }
+    if (frames_.empty() || frames_.back() == kItems ||
+        frames_.back() == kAcl) {
+      return false;
+    }
+    auto frame = kSkip;
+    if (frames_.back() == kList && key_ == "items") {
+      frame = kItems;
+    } else if (frames_.back() == kList && key_ == "prefixes") {
+      frame = kPrefixes;
+    } else if (frames_.back() == kObject && key_ == "acl") {
+      frame = kAcl;
+    }
+    frames_.push_back(frame);
+    return true;
+  }
+
+  bool end_array() {
+    if (!capture_.empty()) {
+      return CaptureClose();
+    }
+    frames_.pop_back();
+    return true;
+  }
+
+  bool key(nl::json::string_t& value) {
+    if (!capture_.empty()) {
+      capture_key_ = std::move(value);
+    } else {
+      key_ = std::move(value);
+    }
+    return true;
+  }
+
+  template <typename Exception>
+  bool parse_error(std::size_t, std::string const&, Exception const&) {
+    return false;
+  }
+
+ private:
+  enum Frame { kList, kItems, kPrefixes, kObject, kNested, kAcl, kSkip };
+
+  bool OnScalar(std::string& value) {
+    if (frames_.empty()) {
+      return false;
+    }
+    switch (frames_.back()) {
+      case kObject:
+        status_ = SetField(current_, empty_, key_, value);
+        return status_.ok();
+      case kNested:
+        status_ = SetField(current_, parent_, key_, value);
+        return status_.ok();
+      case kList:
+        if (key_ == "nextPageToken") {
+          response_.next_page_token = std::move(value);
+        }
+        break;
+      case kPrefixes:
+        response_.prefixes.emplace_back(std::move(value));
+        break;
+      case kItems:
+      case kAcl:
+        // The elements of these arrays must be objects.
+        return false;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  void CaptureOpen(nl::json value) {
+    capture_.emplace_back(std::move(capture_key_), std::move(value));
+  }
+
+  bool CaptureValue(nl::json value) {
+    auto& top = capture_.back().second;
+    if (top.is_array()) {
+      top.push_back(std::move(value));
+    } else {
+      top[capture_key_] = std::move(value);
+    }
+    return true;
+  }
+
+  bool CaptureClose() {
+    auto closed = std::move(capture_.back());
+    capture_.pop_back();
+    if (!capture_.empty()) {
+      capture_key_ = std::move(closed.first);
+      return CaptureValue(std::move(closed.second));
+    }
+    status_ = AddAccessControl(current_, closed.second);
+    return status_.ok();
+  }
+
+  bool parse_list_;
+  std::vector<Frame> frames_;
+  std::string key_;
+  std::string parent_;
+  std::string const empty_;
+  Item current_;
+  Response response_;
+  // The (key, value) pairs for the JSON values being captured, the outermost
+  // value is an element of the `acl` array.
+  std::vector<std::pair<std::string, nl::json>> capture_;
+  std::string capture_key_;
+  Status status_;
+};
+
+template <typename Response>
+StatusOr<Response> ParseListImpl(std::string const& payload,
+                                 char const* where) {
+  ObjectMetadataHandler<Response> handler(true);
+  if (!nl::json::sax_parse(payload, &handler)) {
+    if (!handler.status().ok()) {
+      return handler.status();
+    }
+    return Status(StatusCode::kInvalidArgument, where);
+  }
+  return std::move(handler.response());
+}
+}  // namespace
+
+StatusOr<ObjectMetadata> ObjectMetadataStreamParser::ParseObject(
+    std::string const& payload) {
+  ObjectMetadataHandler<ListObjectsResponse> handler(false);
+  if (!nl::json::sax_parse(payload, &handler)) {
+    if (!handler.status().ok()) {
+      return handler.status();
+    }
+    return Status(StatusCode::kInvalidArgument, __func__);
+  }
+  return std::move(handler.object());
+}
+
+StatusOr<ListObjectsResponse> ObjectMetadataStreamParser::ParseList(
+    std::string const& payload) {
+  return ParseListImpl<ListObjectsResponse>(payload, __func__);
+}
+
+StatusOr<ListObjectSummariesResponse>
+ObjectMetadataStreamParser::ParseSummaryList(std::string const& payload) {
+  return ParseListImpl<ListObjectSummariesResponse>(payload, __func__);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
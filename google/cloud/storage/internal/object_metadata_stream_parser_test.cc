@@ -0,0 +1,205 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_stream_parser.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/internal/parse_rfc3339.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+std::string const kObjectText = R"""({
+    "acl": [{
+      "kind": "storage#objectAccessControl",
+      "id": "acl-id-0",
+      "bucket": "foo-bar",
+      "object": "baz",
+      "generation": 12345,
+      "entity": "user-qux",
+      "role": "OWNER",
+      "projectTeam": {"projectNumber": "4567", "team": "owners"},
+      "etag": "AYX="
+    }, {
+      "entity": "allUsers",
+      "role": "READER"
+    }],
+    "bucket": "foo-bar",
+    "cacheControl": "no-cache",
+    "componentCount": 7,
+    "contentDisposition": "a-disposition",
+    "contentEncoding": "an-encoding",
+    "contentLanguage": "a-language",
+    "contentType": "application/octet-stream",
+    "crc32c": "deadbeef",
+    "customerEncryption": {
+      "encryptionAlgorithm": "some-algo",
+      "keySha256": "abc123"
+    },
+    "etag": "XYZ=",
+    "eventBasedHold": true,
+    "generation": "12345",
+    "id": "foo-bar/baz/12345",
+    "kind": "storage#object",
+    "kmsKeyName": "/foo/bar/baz/key",
+    "md5Hash": "deaderBeef=",
+    "mediaLink": "https://www.googleapis.com/storage/v1/b/foo-bar/o/baz",
+    "metadata": {"foo": "bar", "baz": "qux"},
+    "metageneration": "4",
+    "name": "baz",
+    "owner": {"entity": "user-qux", "entityId": "user-qux-id-123"},
+    "retentionExpirationTime": "2019-01-01T00:00:00Z",
+    "selfLink": "https://www.googleapis.com/storage/v1/b/foo-bar/o/baz",
+    "size": "102400",
+    "storageClass": "STANDARD",
+    "temporaryHold": false,
+    "timeCreated": "2018-05-19T19:31:14Z",
+    "timeDeleted": "2018-05-19T19:32:24Z",
+    "timeStorageClassUpdated": "2018-05-19T19:31:34Z",
+    "updated": "2018-05-19T19:31:24Z",
+    "unknownField": {"nested": [1, 2, {"a": null}]},
+    "unknownArray": [{"name": "not-the-name"}]
+})""";
+
+/// @test Verify the stream parser produces the same results as the DOM parser.
+TEST(ObjectMetadataStreamParserTest, ParseObject) {
+  auto expected = ObjectMetadataParser::FromJson(nl::json::parse(kObjectText));
+  ASSERT_TRUE(expected.ok()) << "status=" << expected.status();
+
+  auto actual = ObjectMetadataStreamParser::ParseObject(kObjectText);
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ(*expected, *actual);
+  EXPECT_EQ("baz", actual->name());
+  EXPECT_EQ(102400U, actual->size());
+  EXPECT_EQ(7, actual->component_count());
+  EXPECT_TRUE(actual->event_based_hold());
+  EXPECT_FALSE(actual->temporary_hold());
+  ASSERT_EQ(2U, actual->acl().size());
+  EXPECT_EQ("owners", actual->acl()[0].project_team().team);
+  EXPECT_EQ("allUsers", actual->acl()[1].entity());
+  ASSERT_TRUE(actual->has_owner());
+  EXPECT_EQ(expected->owner(), actual->owner());
+  ASSERT_TRUE(actual->has_customer_encryption());
+  EXPECT_EQ("abc123", actual->customer_encryption().key_sha256);
+  EXPECT_EQ(2U, actual->metadata().size());
+}
+
+TEST(ObjectMetadataStreamParserTest, ParseList) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "nextPageToken": "some-token-42",
+      "prefixes": ["a/", "b/"],
+      "items": [)""" + kObjectText +
+                     R"""(, {"name": "second", "size": 7}, {}]
+  })""";
+
+  auto actual = ObjectMetadataStreamParser::ParseList(text);
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ("some-token-42", actual->next_page_token);
+  EXPECT_THAT(actual->prefixes, ElementsAre("a/", "b/"));
+  ASSERT_EQ(3U, actual->items.size());
+  EXPECT_EQ(ObjectMetadataParser::FromString(kObjectText).value(),
+            actual->items[0]);
+  EXPECT_EQ("second", actual->items[1].name());
+  EXPECT_EQ(7U, actual->items[1].size());
+  EXPECT_EQ(ObjectMetadata{}, actual->items[2]);
+}
+
+TEST(ObjectMetadataStreamParserTest, ParseSummaryList) {
+  std::string text = R"""({
+      "nextPageToken": "some-token-42",
+      "items": [)""" + kObjectText +
+                     R"""(, {"name": "second", "size": "7",
+                             "generation": "3", "crc32c": "AAAAAA==",
+                             "updated": "2019-01-02T03:04:05Z"}]
+  })""";
+
+  auto actual = ObjectMetadataStreamParser::ParseSummaryList(text);
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ("some-token-42", actual->next_page_token);
+  ASSERT_EQ(2U, actual->items.size());
+  auto full = ObjectMetadataParser::FromString(kObjectText).value();
+  EXPECT_EQ(ObjectSummaryParser::FromObjectMetadata(full), actual->items[0]);
+  EXPECT_EQ("second", actual->items[1].name());
+  EXPECT_EQ(7U, actual->items[1].size());
+  EXPECT_EQ(3, actual->items[1].generation());
+  EXPECT_EQ("AAAAAA==", actual->items[1].crc32c());
+  EXPECT_EQ(ParseRfc3339("2019-01-02T03:04:05Z"), actual->items[1].updated());
+}
+
+TEST(ObjectMetadataStreamParserTest, ParseEmptyList) {
+  auto actual = ObjectMetadataStreamParser::ParseList(
+      R"""({"kind": "storage#objects"})""");
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_TRUE(actual->next_page_token.empty());
+  EXPECT_TRUE(actual->items.empty());
+  EXPECT_TRUE(actual->prefixes.empty());
+}
+
+TEST(ObjectMetadataStreamParserTest, ParseErrors) {
+  for (std::string const text :
+       {"", "not-json", "[]", "42", R"""("a string")""", R"""({"name": )""",
+        R"""({"name": "foo"} trailing)"""}) {
+    SCOPED_TRACE("Testing with " + text);
+    EXPECT_EQ(StatusCode::kInvalidArgument,
+              ObjectMetadataStreamParser::ParseObject(text).status().code());
+    EXPECT_EQ(StatusCode::kInvalidArgument,
+              ObjectMetadataStreamParser::ParseList(text).status().code());
+  }
+
+  EXPECT_EQ(StatusCode::kInvalidArgument,
+            ObjectMetadataStreamParser::ParseObject(
+                R"""({"acl": ["not-an-acl"]})""")
+                .status()
+                .code());
+  EXPECT_EQ(StatusCode::kInvalidArgument,
+            ObjectMetadataStreamParser::ParseList(
+                R"""({"items": ["not-an-object"]})""")
+                .status()
+                .code());
+}
+
+TEST(ObjectMetadataStreamParserTest, ParseInvalidNumbers) {
+  for (std::string const text :
+       {R"""({"size": "not-a-number"})""", R"""({"size": -1})""",
+        R"""({"generation": "99999999999999999999"})""",
+        R"""({"metageneration": 1.5})""",
+        R"""({"componentCount": 4294967296})"""}) {
+    SCOPED_TRACE("Testing with " + text);
+    EXPECT_EQ(StatusCode::kInvalidArgument,
+              ObjectMetadataStreamParser::ParseObject(text).status().code());
+    EXPECT_EQ(StatusCode::kInvalidArgument,
+              ObjectMetadataStreamParser::ParseList(
+                  R"""({"items": [)""" + text + "]}")
+                  .status()
+                  .code());
+  }
+  auto summaries = ObjectMetadataStreamParser::ParseSummaryList(
+      R"""({"items": [{"name": "foo", "size": "12x"}]})""");
+  EXPECT_EQ(StatusCode::kInvalidArgument, summaries.status().code());
+  EXPECT_THAT(summaries.status().message(), HasSubstr("<size>"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
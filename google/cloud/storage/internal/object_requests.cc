@@ -17,6 +17,8 @@
 #include "google/cloud/storage/internal/metadata_parser.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include "google/cloud/storage/internal/object_acl_requests.h"
+#include "google/cloud/storage/internal/object_metadata_stream_parser.h"
+#include "google/cloud/storage/internal/parse_rfc3339.h"
 #include "google/cloud/storage/object_metadata.h"
 #include <sstream>
 
@@ -99,8 +101,99 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
 
 StatusOr<ObjectMetadata> ObjectMetadataParser::FromString(
     std::string const& payload) {
-  auto json = internal::nl::json::parse(payload, nullptr, false);
-  return FromJson(json);
+  return ObjectMetadataStreamParser::ParseObject(payload);
+}
+
+Status ObjectMetadataParser::SetField(ObjectMetadata& result,
+                                      std::string const& parent,
+                                      std::string const& key,
+                                      std::string& value) {
+  auto common =
+      CommonMetadata<ObjectMetadata>::SetField(result, parent, key, value);
+  if (!common) {
+    return std::move(common).status();
+  }
+  if (*common) {
+    return Status();
+  }
+  if (parent == "metadata") {
+    result.metadata_[key] = std::move(value);
+    return Status();
+  }
+  if (parent == "customerEncryption") {
+    if (!result.customer_encryption_.has_value()) {
+      result.customer_encryption_ = CustomerEncryption{};
+    }
+    if (key == "encryptionAlgorithm") {
+      result.customer_encryption_->encryption_algorithm = std::move(value);
+    } else if (key == "keySha256") {
+      result.customer_encryption_->key_sha256 = std::move(value);
+    }
+    return Status();
+  }
+  if (!parent.empty()) {
+    return Status();
+  }
+  if (key == "bucket") {
+    result.bucket_ = std::move(value);
+  } else if (key == "cacheControl") {
+    result.cache_control_ = std::move(value);
+  } else if (key == "componentCount") {
+    auto parsed = ParseIntValue(value, "componentCount");
+    if (!parsed) {
+      return std::move(parsed).status();
+    }
+    result.component_count_ = *parsed;
+  } else if (key == "contentDisposition") {
+    result.content_disposition_ = std::move(value);
+  } else if (key == "contentEncoding") {
+    result.content_encoding_ = std::move(value);
+  } else if (key == "contentLanguage") {
+    result.content_language_ = std::move(value);
+  } else if (key == "contentType") {
+    result.content_type_ = std::move(value);
+  } else if (key == "crc32c") {
+    result.crc32c_ = std::move(value);
+  } else if (key == "eventBasedHold") {
+    result.event_based_hold_ = value == "true";
+  } else if (key == "generation") {
+    auto parsed = ParseLongValue(value, "generation");
+    if (!parsed) {
+      return std::move(parsed).status();
+    }
+    result.generation_ = *parsed;
+  } else if (key == "kmsKeyName") {
+    result.kms_key_name_ = std::move(value);
+  } else if (key == "md5Hash") {
+    result.md5_hash_ = std::move(value);
+  } else if (key == "mediaLink") {
+    result.media_link_ = std::move(value);
+  } else if (key == "retentionExpirationTime") {
+    result.retention_expiration_time_ = ParseRfc3339(value);
+  } else if (key == "size") {
+    auto parsed = ParseUnsignedLongValue(value, "size");
+    if (!parsed) {
+      return std::move(parsed).status();
+    }
+    result.size_ = *parsed;
+  } else if (key == "temporaryHold") {
+    result.temporary_hold_ = value == "true";
+  } else if (key == "timeDeleted") {
+    result.time_deleted_ = ParseRfc3339(value);
+  } else if (key == "timeStorageClassUpdated") {
+    result.time_storage_class_updated_ = ParseRfc3339(value);
+  }
+  return Status();
+}
+
+Status ObjectMetadataParser::AddAccessControl(ObjectMetadata& result,
+                                              internal::nl::json const& json) {
+  auto parsed = ObjectAccessControlParser::FromJson(json);
+  if (!parsed.ok()) {
+    return std::move(parsed).status();
+  }
+  result.acl_.emplace_back(std::move(*parsed));
+  return Status();
 }
 
 internal::nl::json ObjectMetadataJsonForUpdate(ObjectMetadata const& meta) {
@@ -193,31 +286,77 @@ std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r) {
 
 StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
     HttpResponse&& response) {
-  auto json =
-      storage::internal::nl::json::parse(response.payload, nullptr, false);
-  if (!json.is_object()) {
-    return Status(StatusCode::kInvalidArgument, __func__);
-  }
+  return ObjectMetadataStreamParser::ParseList(response.payload);
+}
 
-  ListObjectsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
+std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
+  os << "ListObjectsResponse={next_page_token=" << r.next_page_token
+     << ", items={";
+  std::copy(r.items.begin(), r.items.end(),
+            std::ostream_iterator<ObjectMetadata>(os, "\n  "));
+  os << "}, prefixes={";
+  std::copy(r.prefixes.begin(), r.prefixes.end(),
+            std::ostream_iterator<std::string>(os, ", "));
+  return os << "}}";
+}
 
-  for (auto const& kv : json["items"].items()) {
-    auto parsed = internal::ObjectMetadataParser::FromJson(kv.value());
-    if (!parsed.ok()) {
+Status ObjectSummaryParser::SetField(ObjectSummary& result,
+                                     std::string const& parent,
+                                     std::string const& key,
+                                     std::string& value) {
+  if (!parent.empty()) {
+    return Status();
+  }
+  if (key == "name") {
+    result.name_ = std::move(value);
+  } else if (key == "size") {
+    auto parsed = ParseUnsignedLongValue(value, "size");
+    if (!parsed) {
       return std::move(parsed).status();
     }
-    result.items.emplace_back(std::move(*parsed));
-  }
-
+    result.size_ = *parsed;
+  } else if (key == "generation") {
+    auto parsed = ParseLongValue(value, "generation");
+    if (!parsed) {
+      return std::move(parsed).status();
+    }
+    result.generation_ = *parsed;
+  } else if (key == "crc32c") {
+    result.crc32c_ = std::move(value);
+  } else if (key == "updated") {
+    result.updated_ = ParseRfc3339(value);
+  }
+  return Status();
+}
+
+ObjectSummary ObjectSummaryParser::FromObjectMetadata(
+    ObjectMetadata const& object) {
+  ObjectSummary result;
+  result.name_ = object.name();
+  result.size_ = object.size();
+  result.generation_ = object.generation();
+  result.crc32c_ = object.crc32c();
+  result.updated_ = object.updated();
   return result;
 }
 
-std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
-  os << "ListObjectsResponse={next_page_token=" << r.next_page_token
+char const kObjectSummaryFields[] =
+    "kind,nextPageToken,prefixes,items(name,size,generation,crc32c,updated)";
+
+StatusOr<ListObjectSummariesResponse>
+ListObjectSummariesResponse::FromHttpResponse(HttpResponse&& response) {
+  return ObjectMetadataStreamParser::ParseSummaryList(response.payload);
+}
+
+std::ostream& operator<<(std::ostream& os,
+                         ListObjectSummariesResponse const& r) {
+  os << "ListObjectSummariesResponse={next_page_token=" << r.next_page_token
      << ", items={";
   std::copy(r.items.begin(), r.items.end(),
-            std::ostream_iterator<ObjectMetadata>(os, "\n  "));
+            std::ostream_iterator<ObjectSummary>(os, "\n  "));
+  os << "}, prefixes={";
+  std::copy(r.prefixes.begin(), r.prefixes.end(),
+            std::ostream_iterator<std::string>(os, ", "));
   return os << "}}";
 }
 
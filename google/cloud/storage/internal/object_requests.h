@@ -20,6 +20,7 @@
 #include "google/cloud/storage/internal/generic_object_request.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/object_summary.h"
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/well_known_parameters.h"
 
@@ -31,6 +32,21 @@ namespace internal {
 struct ObjectMetadataParser {
   static StatusOr<ObjectMetadata> FromJson(internal::nl::json const& json);
   static StatusOr<ObjectMetadata> FromString(std::string const& payload);
+
+  /**
+   * Sets a field of @p result from a scalar JSON value.
+   *
+   * Used by `ObjectMetadataStreamParser`, see `CommonMetadata::SetField()` for
+   * the meaning of the parameters. Unknown fields are ignored.
+   *
+   * @return an error if the value of a numeric field cannot be parsed.
+   */
+  static Status SetField(ObjectMetadata& result, std::string const& parent,
+                         std::string const& key, std::string& value);
+
+  /// Appends an element of the `acl` field to @p result.
+  static Status AddAccessControl(ObjectMetadata& result,
+                                 internal::nl::json const& json);
 };
 
 internal::nl::json ObjectMetadataJsonForUpdate(ObjectMetadata const& meta);
@@ -43,8 +59,8 @@ std::string ObjectMetadataJsonPayloadForCopy(ObjectMetadata const& meta);
  * Represents a request to the `Objects: list` API.
  */
 class ListObjectsRequest
-    : public GenericRequest<ListObjectsRequest, MaxResults, Prefix, Projection,
-                            UserProject, Versions> {
+    : public GenericRequest<ListObjectsRequest, Delimiter, MaxResults, Prefix,
+                            Projection, UserProject, Versions> {
  public:
   ListObjectsRequest() = default;
   explicit ListObjectsRequest(std::string bucket_name)
@@ -70,18 +86,48 @@ struct ListObjectsResponse {
 
   std::string next_page_token;
   std::vector<ObjectMetadata> items;
+  /// The common prefixes, only returned when the request uses a `Delimiter`.
+  std::vector<std::string> prefixes;
 };
 
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r);
 
+/// Sets the fields of `ObjectSummary`, see `ObjectMetadataParser::SetField()`.
+struct ObjectSummaryParser {
+  static Status SetField(ObjectSummary& result, std::string const& parent,
+                         std::string const& key, std::string& value);
+  static ObjectSummary FromObjectMetadata(ObjectMetadata const& object);
+};
+
+/**
+ * The partial response for `Objects: list` used by `ListObjectSummaries()`.
+ *
+ * Unless the request sets a `Fields` parameter, `RawClient` implementations
+ * should request only `kObjectSummaryFields`.
+ */
+struct ListObjectSummariesResponse {
+  static StatusOr<ListObjectSummariesResponse> FromHttpResponse(
+      HttpResponse&& response);
+
+  std::string next_page_token;
+  std::vector<ObjectSummary> items;
+  std::vector<std::string> prefixes;
+};
+
+/// The value for the `fields` parameter to list only the `ObjectSummary` data.
+extern char const kObjectSummaryFields[];
+
+std::ostream& operator<<(std::ostream& os,
+                         ListObjectSummariesResponse const& r);
+
 /**
  * Represents a request to the `Objects: get` API.
  */
 class GetObjectMetadataRequest
     : public GenericObjectRequest<
-          GetObjectMetadataRequest, Generation, IfGenerationMatch,
-          IfGenerationNotMatch, IfMetagenerationMatch, IfMetagenerationNotMatch,
-          Projection, UserProject> {
+          GetObjectMetadataRequest, EncryptionKey, Generation,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetagenerationMatch,
+          IfMetagenerationNotMatch, Projection, UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 };
@@ -190,8 +236,8 @@ class ReadObjectRangeRequest
     : public GenericObjectRequest<
           ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, ReadRange,
-          UserProject> {
+          IfMetagenerationMatch, IfMetagenerationNotMatch,
+          ParallelDownloadSlices, ReadRange, UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 };
@@ -265,6 +311,10 @@ class ComposeObjectRequest
                                 std::vector<ComposeSourceObject> source_objects,
                                 std::string destination_object_name);
 
+  std::vector<ComposeSourceObject> const& source_objects() const {
+    return source_objects_;
+  }
+
   /// Returns the request as the JSON API payload.
   std::string JsonPayload() const;
 
@@ -367,8 +417,9 @@ class ResumableUploadRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
-          UserProject, WithObjectMetadata> {
+          MD5HashValue, ParallelUploadId, ParallelUploadShards, PredefinedAcl,
+          Projection, UseResumableUploadSession, UserProject,
+          WithObjectMetadata> {
  public:
   ResumableUploadRequest() = default;
 
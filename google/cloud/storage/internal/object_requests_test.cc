@@ -51,7 +51,8 @@ TEST(ObjectRequestsTest, ParseAclListFailure) {
 TEST(ObjectRequestsTest, List) {
   ListObjectsRequest request("my-bucket");
   EXPECT_EQ("my-bucket", request.bucket_name());
-  request.set_multiple_options(UserProject("my-project"), Prefix("foo/"));
+  request.set_multiple_options(UserProject("my-project"), Prefix("foo/"),
+                               Delimiter("/"));
 
   std::ostringstream os;
   os << request;
@@ -59,6 +60,7 @@ TEST(ObjectRequestsTest, List) {
   EXPECT_THAT(actual, HasSubstr("my-bucket"));
   EXPECT_THAT(actual, HasSubstr("userProject=my-project"));
   EXPECT_THAT(actual, HasSubstr("prefix=foo/"));
+  EXPECT_THAT(actual, HasSubstr("delimiter=/"));
 }
 
 TEST(ObjectRequestsTest, ParseListResponse) {
@@ -117,6 +119,20 @@ TEST(ObjectRequestsTest, ParseListResponse) {
   EXPECT_THAT(actual.items, ::testing::ElementsAre(o1, o2));
 }
 
+TEST(ObjectRequestsTest, ParseListResponsePrefixes) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "prefixes": ["foo/", "bar/"]
+})""";
+
+  auto actual =
+      ListObjectsResponse::FromHttpResponse(HttpResponse{200, text, {}})
+          .value();
+  EXPECT_EQ("", actual.next_page_token);
+  EXPECT_TRUE(actual.items.empty());
+  EXPECT_THAT(actual.prefixes, ::testing::ElementsAre("foo/", "bar/"));
+}
+
 TEST(ObjectRequestsTest, ParseListResponseFailure) {
   std::string text = R"""({123)""";
 
@@ -0,0 +1,149 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/parallel_list_objects.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Coordinates the threads listing each prefix.
+ *
+ * The pending prefixes form a work queue. A worker exits once the queue is
+ * empty and no other worker is active (so no more prefixes can be discovered),
+ * or as soon as any request fails.
+ */
+class ParallelLister {
+ public:
+  ParallelLister(RawClient& client, ListObjectsRequest request,
+                 std::function<void(ObjectMetadata)> callback)
+      : client_(client),
+        request_(std::move(request)),
+        callback_(std::move(callback)) {
+    if (!request_.HasOption<Delimiter>()) {
+      request_.set_option(Delimiter("/"));
+    }
+    auto prefix = request_.GetOption<Prefix>();
+    pending_.push_back(prefix.has_value() ? prefix.value() : std::string{});
+  }
+
+  Status Run(std::size_t concurrency) {
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < concurrency; ++i) {
+      workers.emplace_back([this] { Worker(); });
+    }
+    Worker();
+    for (auto& t : workers) {
+      t.join();
+    }
+    return status_;
+  }
+
+ private:
+  void Worker() {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (true) {
+      cv_.wait(lk, [this] {
+        return !pending_.empty() || active_ == 0 || !status_.ok();
+      });
+      if (pending_.empty() || !status_.ok()) {
+        cv_.notify_all();
+        return;
+      }
+      auto prefix = std::move(pending_.front());
+      pending_.pop_front();
+      ++active_;
+      lk.unlock();
+      auto status = ListPrefix(std::move(prefix));
+      lk.lock();
+      --active_;
+      if (!status.ok() && status_.ok()) {
+        status_ = std::move(status);
+      }
+      cv_.notify_all();
+    }
+  }
+
+  Status ListPrefix(std::string prefix) {
+    ListObjectsRequest request = request_;
+    request.set_option(Prefix(std::move(prefix)));
+    auto page = client_.ListObjects(request);
+    while (true) {
+      if (!page) {
+        return std::move(page).status();
+      }
+      // Overlap the request for the next page with the delivery of this one.
+      future<StatusOr<ListObjectsResponse>> next;
+      if (!page->next_page_token.empty()) {
+        request.set_page_token(std::move(page->next_page_token));
+        next = client_.AsyncListObjects(request);
+      }
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        if (!status_.ok()) {
+          return Status();
+        }
+        for (auto& p : page->prefixes) {
+          pending_.push_back(std::move(p));
+        }
+        cv_.notify_all();
+      }
+      {
+        std::unique_lock<std::mutex> lk(callback_mu_);
+        for (auto& o : page->items) {
+          callback_(std::move(o));
+        }
+      }
+      if (!next.valid()) {
+        return Status();
+      }
+      page = next.get();
+    }
+  }
+
+  RawClient& client_;
+  ListObjectsRequest request_;
+  std::function<void(ObjectMetadata)> callback_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::string> pending_;
+  std::size_t active_ = 0;
+  Status status_;
+
+  std::mutex callback_mu_;
+};
+}  // namespace
+
+Status ParallelListObjects(RawClient& client, ListObjectsRequest request,
+                           std::size_t concurrency,
+                           std::function<void(ObjectMetadata)> callback) {
+  ParallelLister lister(client, std::move(request), std::move(callback));
+  return lister.Run((std::max)(concurrency, std::size_t{1}));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
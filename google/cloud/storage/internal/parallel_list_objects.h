@@ -0,0 +1,50 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PARALLEL_LIST_OBJECTS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PARALLEL_LIST_OBJECTS_H_
+
+#include "google/cloud/status.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include <functional>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Lists all the objects matching @p request using multiple threads.
+ *
+ * The key space is split using the prefixes returned by the service when
+ * listing with a delimiter (`/` unless @p request sets a `Delimiter`). Each
+ * prefix is listed by one of up to @p concurrency threads, and any nested
+ * prefixes it returns are queued to be listed in turn. Every object found is
+ * passed to @p callback, the calls are serialized but their order is
+ * unspecified.
+ *
+ * @return the status of the first failed request, the listing stops as soon
+ *     as any request fails.
+ */
+Status ParallelListObjects(RawClient& client, ListObjectsRequest request,
+                           std::size_t concurrency,
+                           std::function<void(ObjectMetadata)> callback);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PARALLEL_LIST_OBJECTS_H_
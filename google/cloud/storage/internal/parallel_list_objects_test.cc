@@ -0,0 +1,146 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/parallel_list_objects.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+
+ObjectMetadata CreateElement(std::string const& name) {
+  nl::json metadata{
+      {"bucket", "test-bucket"},
+      {"name", name},
+      {"kind", "storage#object"},
+  };
+  return ObjectMetadataParser::FromJson(metadata).value();
+}
+
+/**
+ * Simulates the service: list @p names as `Objects: list` would.
+ *
+ * Each page contains at most one object or prefix, to exercise pagination.
+ */
+StatusOr<ListObjectsResponse> SimulateList(
+    std::vector<std::string> const& names, ListObjectsRequest const& request) {
+  auto prefix = request.GetOption<Prefix>().value();
+  auto delimiter = request.GetOption<Delimiter>().value();
+  // Each entry is either an object name or a prefix (marked with `true`).
+  std::vector<std::pair<std::string, bool>> entries;
+  for (auto const& n : names) {
+    if (n.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    auto pos = n.find(delimiter, prefix.size());
+    auto entry =
+        pos == std::string::npos
+            ? std::make_pair(n, false)
+            : std::make_pair(n.substr(0, pos + delimiter.size()), true);
+    if (std::find(entries.begin(), entries.end(), entry) == entries.end()) {
+      entries.push_back(std::move(entry));
+    }
+  }
+  std::size_t index =
+      request.page_token().empty() ? 0 : std::stoul(request.page_token());
+  ListObjectsResponse response;
+  if (index >= entries.size()) {
+    return response;
+  }
+  if (entries[index].second) {
+    response.prefixes.push_back(entries[index].first);
+  } else {
+    response.items.push_back(CreateElement(entries[index].first));
+  }
+  if (index + 1 < entries.size()) {
+    response.next_page_token = std::to_string(index + 1);
+  }
+  return response;
+}
+
+TEST(ParallelListObjectsTest, ListsNestedPrefixes) {
+  std::vector<std::string> const names{
+      "top-1", "top-2", "a/1", "a/2", "a/b/1", "a/b/c/1", "d/1", "d/e/1",
+  };
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([&names](ListObjectsRequest const& r) {
+        EXPECT_EQ("test-bucket", r.bucket_name());
+        EXPECT_EQ("/", r.GetOption<Delimiter>().value());
+        return SimulateList(names, r);
+      }));
+
+  std::multiset<std::string> actual;
+  auto status = ParallelListObjects(
+      *mock, ListObjectsRequest("test-bucket"), 4,
+      [&actual](ObjectMetadata m) { actual.insert(m.name()); });
+  ASSERT_TRUE(status.ok()) << "status=" << status;
+  EXPECT_EQ(std::multiset<std::string>(names.begin(), names.end()), actual);
+}
+
+TEST(ParallelListObjectsTest, HonorsPrefixAndDelimiter) {
+  std::vector<std::string> const names{
+      "x-1", "dir:1", "dir:sub:1", "dir:sub:2", "other:1",
+  };
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([&names](ListObjectsRequest const& r) {
+        EXPECT_EQ(":", r.GetOption<Delimiter>().value());
+        return SimulateList(names, r);
+      }));
+
+  ListObjectsRequest request("test-bucket");
+  request.set_multiple_options(Prefix("dir:"), Delimiter(":"));
+  std::multiset<std::string> actual;
+  auto status = ParallelListObjects(
+      *mock, std::move(request), 0,
+      [&actual](ObjectMetadata m) { actual.insert(m.name()); });
+  ASSERT_TRUE(status.ok()) << "status=" << status;
+  EXPECT_EQ(std::multiset<std::string>({"dir:1", "dir:sub:1", "dir:sub:2"}),
+            actual);
+}
+
+TEST(ParallelListObjectsTest, StopsOnError) {
+  std::vector<std::string> const names{"a/1", "b/1", "c/1", "d/1"};
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([&names](ListObjectsRequest const& r) {
+        if (r.GetOption<Prefix>().value() == "c/") {
+          return StatusOr<ListObjectsResponse>(PermanentError());
+        }
+        return SimulateList(names, r);
+      }));
+
+  auto status = ParallelListObjects(*mock, ListObjectsRequest("test-bucket"),
+                                    2, [](ObjectMetadata) {});
+  EXPECT_EQ(PermanentError().code(), status.code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,179 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/object_stream.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Satisfies the futures returned by `RawClient::AsyncSleep()`.
+ *
+ * A single background thread waits for all the timers. The continuations of
+ * the futures run in this thread, they should not block for long.
+ */
+class SleepTimer {
+ public:
+  SleepTimer() : thread_([this] { Run(); }) { thread_.detach(); }
+
+  future<void> Schedule(std::chrono::milliseconds duration) {
+    promise<void> done;
+    auto result = done.get_future();
+    std::lock_guard<std::mutex> lk(mu_);
+    timers_.emplace(std::chrono::steady_clock::now() + duration,
+                    std::move(done));
+    cv_.notify_one();
+    return result;
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+      if (timers_.empty()) {
+        cv_.wait(lk);
+        continue;
+      }
+      auto const deadline = timers_.begin()->first;
+      if (std::chrono::steady_clock::now() < deadline) {
+        cv_.wait_until(lk, deadline);
+        continue;
+      }
+      auto done = std::move(timers_.begin()->second);
+      timers_.erase(timers_.begin());
+      lk.unlock();
+      done.set_value();
+      lk.lock();
+    }
+  }
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::multimap<std::chrono::steady_clock::time_point, promise<void>> timers_;
+  // Initialized last, the thread uses the other members.
+  std::thread thread_;
+};
+
+SleepTimer& DefaultSleepTimer() {
+  // Never deleted, the thread may be waiting when the program exits.
+  static auto* const timer = new SleepTimer;
+  return *timer;
+}
+}  // namespace
+
+future<StatusOr<ListObjectsResponse>> RawClient::AsyncListObjects(
+    ListObjectsRequest const& request) {
+  return make_ready_future(ListObjects(request));
+}
+
+future<StatusOr<ObjectMetadata>> RawClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return make_ready_future(InsertObjectMedia(request));
+}
+
+future<StatusOr<ObjectMetadata>> RawClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return make_ready_future(GetObjectMetadata(request));
+}
+
+future<StatusOr<std::string>> RawClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  auto buf = ReadObject(request);
+  if (!buf.ok()) {
+    return make_ready_future(StatusOr<std::string>(std::move(buf).status()));
+  }
+  ObjectReadStream stream(*std::move(buf));
+  std::string contents;
+  char buffer[64 * 1024];
+  do {
+    stream.read(buffer, sizeof(buffer));
+    contents.append(buffer, static_cast<std::size_t>(stream.gcount()));
+  } while (stream.good());
+  stream.Close();
+  if (!stream.status().ok()) {
+    return make_ready_future(StatusOr<std::string>(stream.status()));
+  }
+  if (stream.bad()) {
+    // The streambuf raised an exception, currently only possible for a hash
+    // mismatch.
+    return make_ready_future(StatusOr<std::string>(
+        Status(StatusCode::kDataLoss, "mismatched hashes in download")));
+  }
+  return make_ready_future(StatusOr<std::string>(std::move(contents)));
+}
+
+future<StatusOr<EmptyResponse>> RawClient::AsyncDeleteObject(
+    DeleteObjectRequest const& request) {
+  return make_ready_future(DeleteObject(request));
+}
+
+future<void> RawClient::AsyncSleep(std::chrono::milliseconds duration) {
+  return DefaultSleepTimer().Schedule(duration);
+}
+
+StatusOr<BatchResponse> RawClient::ExecuteBatch(BatchRequest const& request) {
+  BatchResponse response;
+  response.results.reserve(request.size());
+  for (auto const& operation : request.operations()) {
+    switch (operation.type) {
+      case BatchOperation::kDeleteObject: {
+        auto result = DeleteObject(operation.delete_object);
+        if (!result) {
+          response.results.emplace_back(std::move(result).status());
+        } else {
+          response.results.emplace_back(ObjectMetadata{});
+        }
+      } break;
+      case BatchOperation::kGetObjectMetadata:
+        response.results.emplace_back(
+            GetObjectMetadata(operation.get_object_metadata));
+        break;
+      case BatchOperation::kPatchObject:
+        response.results.emplace_back(PatchObject(operation.patch_object));
+        break;
+    }
+  }
+  return response;
+}
+
+StatusOr<ListObjectSummariesResponse> RawClient::ListObjectSummaries(
+    ListObjectsRequest const& request) {
+  auto list = ListObjects(request);
+  if (!list) {
+    return std::move(list).status();
+  }
+  ListObjectSummariesResponse response;
+  response.next_page_token = std::move(list->next_page_token);
+  response.prefixes = std::move(list->prefixes);
+  response.items.reserve(list->items.size());
+  for (auto const& object : list->items) {
+    response.items.push_back(ObjectSummaryParser::FromObjectMetadata(object));
+  }
+  return response;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
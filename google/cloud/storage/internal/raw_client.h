@@ -15,10 +15,12 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RAW_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RAW_CLIENT_H_
 
+#include "google/cloud/future.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/bucket_metadata.h"
 #include "google/cloud/storage/client_options.h"
+#include "google/cloud/storage/internal/batch_requests.h"
 #include "google/cloud/storage/internal/bucket_acl_requests.h"
 #include "google/cloud/storage/internal/bucket_requests.h"
 #include "google/cloud/storage/internal/default_object_acl_requests.h"
@@ -32,6 +34,7 @@
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/service_account.h"
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -158,6 +161,56 @@ class RawClient {
   virtual StatusOr<EmptyResponse> DeleteNotification(
       DeleteNotificationRequest const&) = 0;
   //@}
+
+  //@{
+  /**
+   * @name Asynchronous object operations
+   *
+   * The default implementations make the synchronous call and return a
+   * satisfied future. Implementations with a non-blocking transport override
+   * them.
+   */
+  /// Returns true if the asynchronous operations do not block the caller.
+  virtual bool SupportsAsync() const { return false; }
+  virtual future<StatusOr<ListObjectsResponse>> AsyncListObjects(
+      ListObjectsRequest const& request);
+  virtual future<StatusOr<ObjectMetadata>> AsyncInsertObjectMedia(
+      InsertObjectMediaRequest const& request);
+  virtual future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      GetObjectMetadataRequest const& request);
+  virtual future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const& request);
+  virtual future<StatusOr<EmptyResponse>> AsyncDeleteObject(
+      DeleteObjectRequest const& request);
+
+  /**
+   * Returns a future satisfied after @p duration, used to back off retries.
+   *
+   * The default implementation does not block the calling thread. The future
+   * is satisfied by a shared background thread, so the continuations (such as
+   * the next attempt of a retry loop, which may refresh the credentials) never
+   * run in the threads that perform asynchronous transfers.
+   */
+  virtual future<void> AsyncSleep(std::chrono::milliseconds duration);
+  //@}
+
+  /**
+   * Executes the operations in @p request, returning one result per operation.
+   *
+   * The default implementation makes one synchronous call per operation.
+   * Implementations that can use the batch endpoint override it.
+   */
+  virtual StatusOr<BatchResponse> ExecuteBatch(BatchRequest const& request);
+
+  /**
+   * Lists objects, returning only the fields in `ObjectSummary`.
+   *
+   * The default implementation calls `ListObjects()` and discards the other
+   * fields. Implementations override it to request only `kObjectSummaryFields`
+   * from the service.
+   */
+  virtual StatusOr<ListObjectSummariesResponse> ListObjectSummaries(
+      ListObjectsRequest const& request);
 };
 
 }  // namespace internal
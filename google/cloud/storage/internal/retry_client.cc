@@ -16,6 +16,7 @@
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
 #include "google/cloud/storage/internal/retry_resumable_upload_session.h"
+#include <numeric>
 #include <sstream>
 #include <thread>
 
@@ -78,6 +79,7 @@ MakeCall(RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
   while (!retry_policy.IsExhausted()) {
     auto result = (client.*function)(request);
     if (result.ok()) {
+      retry_policy.OnSuccess();
       return result;
     }
     last_status = std::move(result).status();
@@ -106,6 +108,133 @@ MakeCall(RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
   os << "Retry policy exhausted in " << error_message << ": " << last_status;
   return error(std::move(os).str());
 }
+
+/**
+ * Runs an asynchronous client operation, with retries.
+ *
+ * This is the asynchronous version of `MakeCall()`, it uses the same policies
+ * and produces the same errors. The backoff between attempts uses
+ * `RawClient::AsyncSleep()`, so no thread is blocked while waiting. The next
+ * attempt starts in the continuation of that future, which does not run in the
+ * reactor threads, so refreshing the credentials never stalls other transfers.
+ *
+ * The loop only holds a weak reference to the client, if the client is
+ * destroyed while an attempt is pending the operation fails with
+ * `StatusCode::kCancelled` instead of starting a new attempt.
+ */
+template <typename Response, typename Request>
+class AsyncRetryLoop
+    : public std::enable_shared_from_this<AsyncRetryLoop<Response, Request>> {
+ public:
+  using MemberFunction =
+      future<StatusOr<Response>> (RawClient::*)(Request const&);
+
+  static future<StatusOr<Response>> Start(
+      std::unique_ptr<RetryPolicy> retry_policy,
+      std::unique_ptr<BackoffPolicy> backoff_policy, bool is_idempotent,
+      std::shared_ptr<RawClient> const& client, MemberFunction function,
+      Request const& request, char const* error_message) {
+    std::shared_ptr<AsyncRetryLoop> loop(new AsyncRetryLoop(
+        std::move(retry_policy), std::move(backoff_policy), is_idempotent,
+        client, function, request, error_message));
+    auto result = loop->promise_.get_future();
+    loop->StartAttempt();
+    return result;
+  }
+
+ private:
+  AsyncRetryLoop(std::unique_ptr<RetryPolicy> retry_policy,
+                 std::unique_ptr<BackoffPolicy> backoff_policy,
+                 bool is_idempotent, std::shared_ptr<RawClient> const& client,
+                 MemberFunction function, Request const& request,
+                 char const* error_message)
+      : retry_policy_(std::move(retry_policy)),
+        backoff_policy_(std::move(backoff_policy)),
+        is_idempotent_(is_idempotent),
+        client_(client),
+        function_(function),
+        request_(request),
+        error_message_(error_message) {}
+
+  void StartAttempt() {
+    if (retry_policy_->IsExhausted()) {
+      return Finish("Retry policy exhausted in ");
+    }
+    auto client = client_.lock();
+    if (!client) {
+      return Cancel();
+    }
+    auto self = this->shared_from_this();
+    (client.get()->*function_)(request_)
+        .then([self](future<StatusOr<Response>> f) {
+          self->OnCompletion(f.get());
+        });
+  }
+
+  void OnCompletion(StatusOr<Response> result) {
+    if (result.ok()) {
+      retry_policy_->OnSuccess();
+      promise_.set_value(std::move(result));
+      return;
+    }
+    last_status_ = std::move(result).status();
+    if (!is_idempotent_) {
+      return Finish("Error in non-idempotent operation ");
+    }
+    if (!retry_policy_->OnFailure(last_status_)) {
+      if (!retry_policy_->IsExhausted()) {
+        // The last error cannot be retried, but it is not because the retry
+        // policy is exhausted, we call these "permanent errors", and they
+        // get a special message.
+        return Finish("Permanent error in ");
+      }
+      return Finish("Retry policy exhausted in ");
+    }
+    auto client = client_.lock();
+    if (!client) {
+      return Cancel();
+    }
+    auto self = this->shared_from_this();
+    client->AsyncSleep(backoff_policy_->OnCompletion())
+        .then([self](future<void>) { self->StartAttempt(); });
+  }
+
+  void Finish(char const* prefix) {
+    std::ostringstream os;
+    os << prefix << error_message_ << ": " << last_status_;
+    promise_.set_value(Status(last_status_.code(), std::move(os).str()));
+  }
+
+  void Cancel() {
+    std::ostringstream os;
+    os << "Client destroyed before completing " << error_message_
+       << ", last error: " << last_status_;
+    promise_.set_value(
+        Status(StatusCode::kCancelled, std::move(os).str()));
+  }
+
+  std::unique_ptr<RetryPolicy> retry_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+  bool is_idempotent_;
+  std::weak_ptr<RawClient> client_;
+  MemberFunction function_;
+  Request request_;
+  char const* error_message_;
+  Status last_status_;
+  promise<StatusOr<Response>> promise_;
+};
+
+template <typename Response, typename Request>
+future<StatusOr<Response>> MakeAsyncCall(
+    std::unique_ptr<RetryPolicy> retry_policy,
+    std::unique_ptr<BackoffPolicy> backoff_policy, bool is_idempotent,
+    std::shared_ptr<RawClient> const& client,
+    future<StatusOr<Response>> (RawClient::*function)(Request const&),
+    Request const& request, char const* error_message) {
+  return AsyncRetryLoop<Response, Request>::Start(
+      std::move(retry_policy), std::move(backoff_policy), is_idempotent,
+      client, function, request, error_message);
+}
 }  // namespace
 
 RetryClient::RetryClient(std::shared_ptr<RawClient> client, DefaultPolicies)
@@ -595,6 +724,124 @@ StatusOr<EmptyResponse> RetryClient::DeleteNotification(
                   __func__);
 }
 
+future<StatusOr<ObjectMetadata>> RetryClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall(retry_policy_->clone(), backoff_policy_->clone(),
+                       is_idempotent, client_,
+                       &RawClient::AsyncInsertObjectMedia, request, __func__);
+}
+
+bool RetryClient::SupportsAsync() const { return client_->SupportsAsync(); }
+
+future<StatusOr<ListObjectsResponse>> RetryClient::AsyncListObjects(
+    ListObjectsRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall(retry_policy_->clone(), backoff_policy_->clone(),
+                       is_idempotent, client_, &RawClient::AsyncListObjects,
+                       request, __func__);
+}
+
+future<StatusOr<ObjectMetadata>> RetryClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall(retry_policy_->clone(), backoff_policy_->clone(),
+                       is_idempotent, client_,
+                       &RawClient::AsyncGetObjectMetadata, request, __func__);
+}
+
+future<StatusOr<std::string>> RetryClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall(retry_policy_->clone(), backoff_policy_->clone(),
+                       is_idempotent, client_, &RawClient::AsyncReadObject,
+                       request, __func__);
+}
+
+future<StatusOr<EmptyResponse>> RetryClient::AsyncDeleteObject(
+    DeleteObjectRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall(retry_policy_->clone(), backoff_policy_->clone(),
+                       is_idempotent, client_, &RawClient::AsyncDeleteObject,
+                       request, __func__);
+}
+
+future<void> RetryClient::AsyncSleep(std::chrono::milliseconds duration) {
+  return client_->AsyncSleep(duration);
+}
+
+StatusOr<BatchResponse> RetryClient::ExecuteBatch(BatchRequest const& request) {
+  // The operations in a batch succeed or fail independently. Only the
+  // operations that failed with a transient error, and are idempotent, are
+  // sent again, the other results are final.
+  auto retry_policy = retry_policy_->clone();
+  auto backoff_policy = backoff_policy_->clone();
+  auto is_idempotent = [this](BatchOperation const& operation) {
+    switch (operation.type) {
+      case BatchOperation::kDeleteObject:
+        return idempotency_policy_->IsIdempotent(operation.delete_object);
+      case BatchOperation::kGetObjectMetadata:
+        return idempotency_policy_->IsIdempotent(
+            operation.get_object_metadata);
+      case BatchOperation::kPatchObject:
+        return idempotency_policy_->IsIdempotent(operation.patch_object);
+    }
+    return false;
+  };
+
+  auto const& operations = request.operations();
+  BatchResponse response;
+  response.results.resize(operations.size());
+  std::vector<std::size_t> pending(operations.size());
+  std::iota(pending.begin(), pending.end(), std::size_t{0});
+  while (!pending.empty()) {
+    BatchRequest attempt;
+    for (auto i : pending) {
+      attempt.AddOperation(operations[i]);
+    }
+    auto result = client_->ExecuteBatch(attempt);
+    for (std::size_t j = 0; j != pending.size(); ++j) {
+      auto& target = response.results[pending[j]];
+      if (!result) {
+        target = StatusOr<ObjectMetadata>(result.status());
+      } else if (j < result->results.size()) {
+        target = std::move(result->results[j]);
+      } else {
+        target = StatusOr<ObjectMetadata>(
+            Status(StatusCode::kInternal,
+                   "missing operation result in batch response"));
+      }
+    }
+
+    std::vector<std::size_t> retry;
+    Status last_status;
+    for (auto i : pending) {
+      auto const& r = response.results[i];
+      if (r.ok() || !is_idempotent(operations[i]) ||
+          StatusTraits::IsPermanentFailure(r.status())) {
+        continue;
+      }
+      retry.push_back(i);
+      last_status = r.status();
+    }
+    if (retry.empty() || !retry_policy->OnFailure(last_status)) {
+      break;
+    }
+    std::this_thread::sleep_for(backoff_policy->OnCompletion());
+    pending = std::move(retry);
+  }
+  return response;
+}
+
+StatusOr<ListObjectSummariesResponse> RetryClient::ListObjectSummaries(
+    ListObjectsRequest const& request) {
+  auto retry_policy = retry_policy_->clone();
+  auto backoff_policy = backoff_policy_->clone();
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
+                  &RawClient::ListObjectSummaries, request, __func__);
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
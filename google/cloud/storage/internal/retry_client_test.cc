@@ -90,6 +90,105 @@ TEST_F(RetryClientTest, TooManyTransientsHandling) {
   EXPECT_EQ(TransientError().code(), result.status().code());
 }
 
+/// @test Verify that a shared RetryBudget limits the retries.
+TEST_F(RetryClientTest, RetryBudgetExhausted) {
+  auto budget = std::make_shared<RetryBudget>(4, 0.1);
+  RetryClient client(
+      std::shared_ptr<internal::RawClient>(mock),
+      RetryBudgetPolicy(budget, LimitedErrorCountRetryPolicy(10)),
+      // Make the tests faster.
+      ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  // The first failure is retried, the second would leave less than half the
+  // tokens in the budget.
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(2)
+      .WillRepeatedly(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  StatusOr<ObjectMetadata> result = client.GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object"));
+  EXPECT_EQ(TransientError().code(), result.status().code());
+  EXPECT_DOUBLE_EQ(2.0, budget->tokens());
+}
+
+/// @test Verify that successful operations deposit tokens in the budget.
+TEST_F(RetryClientTest, RetryBudgetOnSuccess) {
+  auto budget = std::make_shared<RetryBudget>(4, 0.5);
+  RetryClient client(
+      std::shared_ptr<internal::RawClient>(mock),
+      RetryBudgetPolicy(budget, LimitedErrorCountRetryPolicy(10)),
+      // Make the tests faster.
+      ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(ObjectMetadata{})));
+
+  StatusOr<ObjectMetadata> result = client.GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object"));
+  ASSERT_TRUE(result.ok()) << "status=" << result.status();
+  EXPECT_DOUBLE_EQ(3.5, budget->tokens());
+}
+
+/// @test Verify that non-idempotent asynchronous operations are not retried.
+TEST_F(RetryClientTest, AsyncNonIdempotentErrorHandling) {
+  auto client = std::make_shared<RetryClient>(
+      std::shared_ptr<internal::RawClient>(mock),
+      LimitedErrorCountRetryPolicy(3), StrictIdempotencyPolicy(),
+      // Make the tests faster.
+      ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillOnce(Return(StatusOr<EmptyResponse>(TransientError())));
+
+  auto result = client
+                    ->AsyncDeleteObject(
+                        DeleteObjectRequest("test-bucket", "test-object"))
+                    .get();
+  EXPECT_EQ(TransientError().code(), result.status().code());
+  EXPECT_THAT(result.status().message(), HasSubstr("non-idempotent"));
+}
+
+/// @test Verify that the asynchronous retry loop stops on permanent failures.
+TEST_F(RetryClientTest, AsyncPermanentErrorHandling) {
+  auto client = std::make_shared<RetryClient>(
+      std::shared_ptr<internal::RawClient>(mock),
+      LimitedErrorCountRetryPolicy(3),
+      // Make the tests faster.
+      ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+
+  auto result = client
+                    ->AsyncGetObjectMetadata(
+                        GetObjectMetadataRequest("test-bucket", "test-object"))
+                    .get();
+  EXPECT_EQ(PermanentError().code(), result.status().code());
+  EXPECT_THAT(result.status().message(), HasSubstr("Permanent error"));
+}
+
+/// @test Verify that the asynchronous retry loop stops after too many errors.
+TEST_F(RetryClientTest, AsyncTooManyTransientsHandling) {
+  auto client = std::make_shared<RetryClient>(
+      std::shared_ptr<internal::RawClient>(mock),
+      LimitedErrorCountRetryPolicy(3),
+      // Make the tests faster.
+      ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(4)
+      .WillRepeatedly(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  auto result = client
+                    ->AsyncGetObjectMetadata(
+                        GetObjectMetadataRequest("test-bucket", "test-object"))
+                    .get();
+  EXPECT_EQ(TransientError().code(), result.status().code());
+  EXPECT_THAT(result.status().message(), HasSubstr("Retry policy exhausted"));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -43,6 +43,7 @@ RetryResumableUploadSession::UploadChunk(std::string const& buffer,
   while (!retry_policy_->IsExhausted()) {
     auto result = session_->UploadChunk(buffer, upload_size);
     if (result.ok()) {
+      retry_policy_->OnSuccess();
       return result;
     }
     last_status = std::move(result).status();
@@ -68,6 +69,7 @@ RetryResumableUploadSession::ResetSession() {
   while (!retry_policy_->IsExhausted()) {
     auto result = session_->ResetSession();
     if (result.ok()) {
+      retry_policy_->OnSuccess();
       return result;
     }
     last_status = std::move(result).status();
@@ -0,0 +1,37 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/list_object_summaries_reader.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+static_assert(std::is_same<std::iterator_traits<
+                               ListObjectSummariesIterator>::iterator_category,
+                           std::input_iterator_tag>::value,
+              "ListObjectSummariesIterator should be an InputIterator");
+static_assert(
+    std::is_same<std::iterator_traits<ListObjectSummariesIterator>::value_type,
+                 StatusOr<ObjectSummary>>::value,
+    "ListObjectSummariesIterator should be an InputIterator of ObjectSummary");
+
+namespace internal {
+template class ListObjectsReaderImpl<ObjectSummary>;
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
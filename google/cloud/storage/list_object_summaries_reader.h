@@ -0,0 +1,43 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECT_SUMMARIES_READER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECT_SUMMARIES_READER_H_
+
+#include "google/cloud/storage/list_objects_reader.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/// Implements a C++ iterator for listing object summaries.
+using ListObjectSummariesIterator =
+    internal::ListObjectsIteratorImpl<ObjectSummary>;
+
+/**
+ * Represents the result of listing a set of Objects, as `ObjectSummary` values.
+ *
+ * Each page of results is requested with the `fields` parameter set to
+ * `internal::kObjectSummaryFields` (unless the application provides a `Fields`
+ * option), so the service only returns the data needed for `ObjectSummary`.
+ */
+using ListObjectSummariesReader =
+    internal::ListObjectsReaderImpl<ObjectSummary>;
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECT_SUMMARIES_READER_H_
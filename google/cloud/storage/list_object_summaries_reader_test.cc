@@ -0,0 +1,137 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/list_object_summaries_reader.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using internal::ListObjectsRequest;
+using internal::ListObjectsResponse;
+using storage::testing::MockClient;
+using storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+ObjectMetadata CreateElement(int index) {
+  std::string name = "object-" + std::to_string(index);
+  internal::nl::json metadata{
+      {"bucket", "test-bucket"},
+      {"name", name},
+      {"generation", std::to_string(1000 + index)},
+      {"size", std::to_string(index * 1024)},
+      {"crc32c", "AAAAAA=="},
+      {"updated", "2019-02-03T04:05:06Z"},
+      {"contentType", "text/plain"},
+      {"metadata", {{"some-key", "some-value"}}},
+  };
+  return internal::ObjectMetadataParser::FromJson(metadata).value();
+}
+
+TEST(ListObjectSummariesReaderTest, Basic) {
+  int const page_count = 3;
+  std::vector<ObjectMetadata> expected;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .Times(page_count)
+      .WillRepeatedly(Invoke([&](ListObjectsRequest const& r) {
+        EXPECT_EQ("foo-bar-baz", r.bucket_name());
+        EXPECT_EQ("dir/", r.GetOption<Prefix>().value());
+        EXPECT_EQ(internal::kObjectSummaryFields,
+                  r.GetOption<Fields>().value());
+        int page = r.page_token().empty() ? 0 : std::stoi(r.page_token());
+        ListObjectsResponse response;
+        if (page + 1 != page_count) {
+          response.next_page_token = std::to_string(page + 1);
+        }
+        response.items.push_back(expected[2 * page]);
+        response.items.push_back(expected[2 * page + 1]);
+        return make_status_or(std::move(response));
+      }));
+
+  ListObjectSummariesReader reader(mock, "foo-bar-baz", Prefix("dir/"));
+  std::size_t index = 0;
+  for (auto&& summary : reader) {
+    ASSERT_TRUE(summary.ok()) << "status=" << summary.status();
+    ASSERT_LT(index, expected.size());
+    auto const& e = expected[index++];
+    EXPECT_EQ(e.name(), summary->name());
+    EXPECT_EQ(e.size(), summary->size());
+    EXPECT_EQ(e.generation(), summary->generation());
+    EXPECT_EQ(e.crc32c(), summary->crc32c());
+    EXPECT_EQ(e.updated(), summary->updated());
+  }
+  EXPECT_EQ(expected.size(), index);
+}
+
+TEST(ListObjectSummariesReaderTest, ApplicationFields) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("items(name)", r.GetOption<Fields>().value());
+        return make_status_or(ListObjectsResponse{});
+      }));
+
+  ListObjectSummariesReader reader(mock, "foo-bar-baz", Fields("items(name)"));
+  auto count = std::distance(reader.begin(), reader.end());
+  EXPECT_EQ(0U, count);
+}
+
+TEST(ListObjectSummariesReaderTest, Empty) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Return(make_status_or(ListObjectsResponse{})));
+
+  ListObjectSummariesReader reader(mock, "foo-bar-baz");
+  auto count = std::distance(reader.begin(), reader.end());
+  EXPECT_EQ(0U, count);
+}
+
+TEST(ListObjectSummariesReaderTest, PermanentFailure) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjectsResponse first_page;
+  first_page.next_page_token = "page-1";
+  first_page.items.emplace_back(CreateElement(0));
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Return(make_status_or(first_page)))
+      .WillOnce(Return(StatusOr<ListObjectsResponse>(PermanentError())));
+
+  ListObjectSummariesReader reader(mock, "foo-bar-baz");
+  auto it = reader.begin();
+  ASSERT_NE(reader.end(), it);
+  ASSERT_TRUE(it->ok());
+  EXPECT_EQ("object-0", (*it)->name());
+  ++it;
+  ASSERT_NE(reader.end(), it);
+  EXPECT_EQ(PermanentError().code(), it->status().code());
+  ++it;
+  EXPECT_EQ(reader.end(), it);
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -13,7 +13,6 @@
 // limitations under the License.
 
 #include "google/cloud/storage/list_objects_reader.h"
-#include "google/cloud/internal/throw_delegate.h"
 
 namespace google {
 namespace cloud {
@@ -59,49 +58,9 @@ static_assert(
     "++it when it is of ListObjectsReader::iterator type must be a "
     "ListObjectsReader::iterator &>");
 
-ListObjectsIterator::ListObjectsIterator(ListObjectsReader* owner,
-                                         value_type value)
-    : owner_(owner), value_(std::move(value)) {}
-
-ListObjectsIterator& ListObjectsIterator::operator++() {
-  *this = owner_->GetNext();
-  return *this;
-}
-
-// NOLINTNEXTLINE(readability-identifier-naming)
-ListObjectsReader::iterator ListObjectsReader::begin() {
-  return GetNext();
-}
-
-ListObjectsIterator ListObjectsReader::GetNext() {
-  static Status const past_the_end_error(
-      StatusCode::kFailedPrecondition,
-      "Cannot iterating past the end of ListObjectReader");
-  if (current_objects_.end() == current_) {
-    if (on_last_page_) {
-      return ListObjectsIterator(nullptr, StatusOr<ObjectMetadata>(past_the_end_error));
-    }
-    request_.set_page_token(std::move(next_page_token_));
-    auto response = client_->ListObjects(request_);
-    if (!response.ok()) {
-      next_page_token_.clear();
-      current_objects_.clear();
-      on_last_page_ = true;
-      current_ = current_objects_.begin();
-      return ListObjectsIterator(this, std::move(response).status());
-    }
-    next_page_token_ = std::move(response->next_page_token);
-    current_objects_ = std::move(response->items);
-    current_ = current_objects_.begin();
-    if (next_page_token_.empty()) {
-      on_last_page_ = true;
-    }
-    if (current_objects_.end() == current_) {
-      return ListObjectsIterator(nullptr, past_the_end_error);
-    }
-  }
-  return ListObjectsIterator(this, std::move(*current_++));
-}
+namespace internal {
+template class ListObjectsReaderImpl<ObjectMetadata>;
+}  // namespace internal
 
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
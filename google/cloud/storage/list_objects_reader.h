@@ -15,36 +15,101 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECTS_READER_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECTS_READER_H_
 
+#include "google/cloud/future.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
-class ListObjectsReader;
+namespace internal {
+/**
+ * Defines how `ListObjectsReaderImpl<Item>` fetches each page of results.
+ */
+template <typename Item>
+struct ListObjectsTraits;
+
+template <>
+struct ListObjectsTraits<ObjectMetadata> {
+  using Response = ListObjectsResponse;
+
+  static void SetDefaults(ListObjectsRequest&) {}
+
+  static StatusOr<Response> ListPage(RawClient& client,
+                                     ListObjectsRequest const& request) {
+    return client.ListObjects(request);
+  }
+
+  static bool CanPrefetch(RawClient const& client) {
+    return client.SupportsAsync();
+  }
+
+  static future<StatusOr<Response>> AsyncListPage(
+      RawClient& client, ListObjectsRequest const& request) {
+    return client.AsyncListObjects(request);
+  }
+};
+
+template <>
+struct ListObjectsTraits<ObjectSummary> {
+  using Response = ListObjectSummariesResponse;
+
+  /// Only request the fields in `ObjectSummary`, unless the application
+  /// provides its own projection.
+  static void SetDefaults(ListObjectsRequest& request) {
+    if (!request.HasOption<Fields>()) {
+      request.set_option(Fields(kObjectSummaryFields));
+    }
+  }
+
+  static StatusOr<Response> ListPage(RawClient& client,
+                                     ListObjectsRequest const& request) {
+    return client.ListObjectSummaries(request);
+  }
+
+  // There is no asynchronous version of `ListObjectSummaries()`.
+  static bool CanPrefetch(RawClient const&) { return false; }
+
+  static future<StatusOr<Response>> AsyncListPage(
+      RawClient& client, ListObjectsRequest const& request) {
+    return make_ready_future(client.ListObjectSummaries(request));
+  }
+};
+
+template <typename Item>
+class ListObjectsReaderImpl;
 
 /**
  * Implements a C++ iterator for listing objects.
  */
-class ListObjectsIterator {
+template <typename Item>
+class ListObjectsIteratorImpl {
  public:
   //@{
   /// @name Iterator traits
   using iterator_category = std::input_iterator_tag;
-  using value_type = StatusOr<ObjectMetadata>;
+  using value_type = StatusOr<Item>;
   using difference_type = std::ptrdiff_t;
   using pointer = value_type*;
   using reference = value_type&;
   //@}
 
-  ListObjectsIterator() : owner_(nullptr) {}
+  ListObjectsIteratorImpl() : owner_(nullptr) {}
 
-  ListObjectsIterator& operator++();
-  ListObjectsIterator const operator++(int) {
-    ListObjectsIterator tmp(*this);
+  ListObjectsIteratorImpl& operator++() {
+    *this = owner_->GetNext();
+    return *this;
+  }
+  ListObjectsIteratorImpl const operator++(int) {
+    ListObjectsIteratorImpl tmp(*this);
     operator++();
     return tmp;
   }
@@ -59,8 +124,8 @@ class ListObjectsIterator {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_CONST_REF_REF
   value_type&& operator*() && { return std::move(value_); }
 
-  friend bool operator==(ListObjectsIterator const& lhs,
-                         ListObjectsIterator const& rhs) {
+  friend bool operator==(ListObjectsIteratorImpl const& lhs,
+                         ListObjectsIteratorImpl const& rhs) {
     // All end iterators are equal.
     if (lhs.owner_ == nullptr) {
       return rhs.owner_ == nullptr;
@@ -76,55 +141,68 @@ class ListObjectsIterator {
     return lhs.value_.status() == rhs.value_.status();
   }
 
-  friend bool operator!=(ListObjectsIterator const& lhs,
-                         ListObjectsIterator const& rhs) {
+  friend bool operator!=(ListObjectsIteratorImpl const& lhs,
+                         ListObjectsIteratorImpl const& rhs) {
     return !(lhs == rhs);
   }
 
  private:
-  friend class ListObjectsReader;
-  explicit ListObjectsIterator(ListObjectsReader* owner, value_type value);
+  friend class ListObjectsReaderImpl<Item>;
+  explicit ListObjectsIteratorImpl(ListObjectsReaderImpl<Item>* owner,
+                                   value_type value)
+      : owner_(owner), value_(std::move(value)) {}
 
- private:
-  ListObjectsReader* owner_;
+  ListObjectsReaderImpl<Item>* owner_;
   value_type value_;
 };
 
 /**
  * Represents the result of listing a set of Objects.
+ *
+ * The results are fetched one page at a time. If the client supports
+ * asynchronous operations, as soon as a page arrives the request for the
+ * following page is started in the background, so the application rarely
+ * waits for the service when iterating over large buckets.
+ *
+ * @tparam Item the type of each element, `ObjectMetadata` or `ObjectSummary`.
  */
-class ListObjectsReader {
+template <typename Item>
+class ListObjectsReaderImpl {
  public:
   template <typename... Parameters>
-  ListObjectsReader(std::shared_ptr<internal::RawClient> client,
-                    std::string bucket_name, Parameters&&... parameters)
+  ListObjectsReaderImpl(std::shared_ptr<internal::RawClient> client,
+                        std::string bucket_name, Parameters&&... parameters)
       : client_(std::move(client)),
         request_(std::move(bucket_name)),
+        current_(0),
         next_page_token_(),
         on_last_page_(false) {
     request_.set_multiple_options(std::forward<Parameters>(parameters)...);
-    current_ = current_objects_.begin();
+    ListObjectsTraits<Item>::SetDefaults(request_);
   }
 
   /// The iterator type for this stream.
-  using iterator = ListObjectsIterator;
+  using iterator = ListObjectsIteratorImpl<Item>;
 
   /**
    * Return an iterator over the list of objects.
    *
-   * The returned iterator is a single-pass input iterator that reads object
-   * metadata from the ListObjectsReader when incremented.
+   * The returned iterator is a single-pass input iterator that reads the
+   * objects from the reader when incremented.
    *
    * Creating, and particularly incrementing, multiple iterators on the same
-   * ListObjectsReader is unsupported and can produce incorrect results.
+   * reader is unsupported and can produce incorrect results.
    */
-  iterator begin();
+  iterator begin() { return GetNext(); }
 
   /// Return an iterator pointing to the end of the stream.
-  iterator end() { return ListObjectsIterator(); }
+  iterator end() { return iterator(); }
 
  private:
-  friend class ListObjectsIterator;
+  friend class ListObjectsIteratorImpl<Item>;
+  using Traits = ListObjectsTraits<Item>;
+  using Response = typename Traits::Response;
+
   /**
    * Fetches (or returns if already fetched) the next object from the stream.
    *
@@ -132,17 +210,100 @@ class ListObjectsReader {
    *   it returns an iterator that is different from `.end()`, but has an error
    *   status. If the stream is exhausted, it returns the `.end()` iterator.
    */
-  ListObjectsIterator GetNext();
+  iterator GetNext();
+
+  /// Returns the prefetched page, or fetches the next page if there is none.
+  StatusOr<Response> FetchNextPage();
+
+  /**
+   * Starts fetching the page for `next_page_token_` in the background.
+   *
+   * The request for the next page is issued as soon as the current page
+   * arrives, so the round-trip overlaps with the application processing the
+   * current page.
+   */
+  void StartPrefetch();
 
- private:
   std::shared_ptr<internal::RawClient> client_;
   internal::ListObjectsRequest request_;
-  std::vector<ObjectMetadata> current_objects_;
-  std::vector<ObjectMetadata>::iterator current_;
+  std::vector<Item> current_objects_;
+  // An index rather than an iterator, so copies of the reader remain valid.
+  std::size_t current_;
   std::string next_page_token_;
   bool on_last_page_;
+  // Shared, so the reader remains copyable. Only one of the copies consumes
+  // the prefetched page, the others fetch it again.
+  std::shared_ptr<future<StatusOr<Response>>> next_page_;
 };
 
+template <typename Item>
+typename ListObjectsReaderImpl<Item>::iterator
+ListObjectsReaderImpl<Item>::GetNext() {
+  static Status const past_the_end_error(
+      StatusCode::kFailedPrecondition,
+      "Cannot iterate past the end of the object list");
+  if (current_objects_.size() == current_) {
+    if (on_last_page_) {
+      return iterator(nullptr, past_the_end_error);
+    }
+    auto response = FetchNextPage();
+    if (!response.ok()) {
+      next_page_token_.clear();
+      current_objects_.clear();
+      on_last_page_ = true;
+      current_ = 0;
+      return iterator(this, std::move(response).status());
+    }
+    next_page_token_ = std::move(response->next_page_token);
+    current_objects_ = std::move(response->items);
+    current_ = 0;
+    if (next_page_token_.empty()) {
+      on_last_page_ = true;
+    } else if (Traits::CanPrefetch(*client_)) {
+      StartPrefetch();
+    }
+    if (current_objects_.size() == current_) {
+      return iterator(nullptr, past_the_end_error);
+    }
+  }
+  return iterator(this, std::move(current_objects_[current_++]));
+}
+
+template <typename Item>
+StatusOr<typename ListObjectsReaderImpl<Item>::Response>
+ListObjectsReaderImpl<Item>::FetchNextPage() {
+  auto next_page = std::move(next_page_);
+  if (next_page && next_page->valid()) {
+    return next_page->get();
+  }
+  request_.set_page_token(std::move(next_page_token_));
+  return Traits::ListPage(*client_, request_);
+}
+
+template <typename Item>
+void ListObjectsReaderImpl<Item>::StartPrefetch() {
+  request_.set_page_token(next_page_token_);
+  next_page_ = std::make_shared<future<StatusOr<Response>>>(
+      Traits::AsyncListPage(*client_, request_));
+}
+
+// Instantiated in list_objects_reader.cc and list_object_summaries_reader.cc.
+extern template class ListObjectsReaderImpl<ObjectMetadata>;
+extern template class ListObjectsReaderImpl<ObjectSummary>;
+}  // namespace internal
+
+/// Implements a C++ iterator for listing objects.
+using ListObjectsIterator = internal::ListObjectsIteratorImpl<ObjectMetadata>;
+
+/**
+ * Represents the result of listing a set of Objects.
+ *
+ * As soon as a page arrives the request for the following page is started in
+ * the background, using `RawClient::AsyncListObjects()`, if the client
+ * supports asynchronous operations.
+ */
+using ListObjectsReader = internal::ListObjectsReaderImpl<ObjectMetadata>;
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
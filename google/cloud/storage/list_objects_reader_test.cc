@@ -196,6 +196,99 @@ TEST(ListObjectsReaderTest, IteratorCompare) {
   EXPECT_NE(a1, a2);
 }
 
+TEST(ListObjectsReaderTest, PrefetchNextPage) {
+  std::vector<std::string> tokens;
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([&tokens](ListObjectsRequest const& r) {
+        tokens.push_back(r.page_token());
+        ListObjectsResponse response;
+        if (tokens.size() < 3) {
+          response.next_page_token = "page-" + std::to_string(tokens.size());
+        }
+        response.items.emplace_back(CreateElement(int(tokens.size())));
+        return make_status_or(std::move(response));
+      }));
+  EXPECT_CALL(*mock, SupportsAsync()).WillRepeatedly(Return(true));
+
+  ListObjectsReader reader(mock, "foo-bar-baz");
+  auto it = reader.begin();
+  ASSERT_TRUE(it->ok());
+  // The request for the second page starts as soon as the first page arrives,
+  // before the application consumes any of the elements.
+  EXPECT_THAT(tokens, ContainerEq(std::vector<std::string>{"", "page-1"}));
+
+  auto count = std::distance(it, reader.end());
+  EXPECT_EQ(3, count);
+  EXPECT_THAT(tokens, ContainerEq(std::vector<std::string>{"", "page-1",
+                                                           "page-2"}));
+}
+
+TEST(ListObjectsReaderTest, NoPrefetchWithoutAsync) {
+  std::vector<std::string> tokens;
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([&tokens](ListObjectsRequest const& r) {
+        tokens.push_back(r.page_token());
+        ListObjectsResponse response;
+        if (tokens.size() < 3) {
+          response.next_page_token = "page-" + std::to_string(tokens.size());
+        }
+        response.items.emplace_back(CreateElement(int(tokens.size())));
+        return make_status_or(std::move(response));
+      }));
+  EXPECT_CALL(*mock, SupportsAsync()).WillRepeatedly(Return(false));
+
+  ListObjectsReader reader(mock, "foo-bar-baz");
+  auto it = reader.begin();
+  ASSERT_TRUE(it->ok());
+  // The "asynchronous" request would block, so it is not started early.
+  EXPECT_THAT(tokens, ContainerEq(std::vector<std::string>{""}));
+
+  auto count = std::distance(it, reader.end());
+  EXPECT_EQ(3, count);
+  EXPECT_THAT(tokens, ContainerEq(std::vector<std::string>{"", "page-1",
+                                                           "page-2"}));
+}
+
+TEST(ListObjectsReaderTest, CopyWithPrefetch) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const& r) {
+        ListObjectsResponse response;
+        if (r.page_token().empty()) {
+          response.next_page_token = "page-1";
+          response.items.emplace_back(CreateElement(0));
+        } else {
+          response.items.emplace_back(CreateElement(1));
+        }
+        return make_status_or(std::move(response));
+      }));
+  EXPECT_CALL(*mock, SupportsAsync()).WillRepeatedly(Return(true));
+
+  static_assert(std::is_copy_constructible<ListObjectsReader>::value,
+                "ListObjectsReader should be copyable");
+  ListObjectsReader reader(mock, "foo-bar-baz");
+  auto it = reader.begin();
+  ASSERT_TRUE(it->ok());
+  EXPECT_EQ("object-0", (*it)->name());
+
+  // Both copies return the second page, only one of them can use the
+  // prefetched response.
+  ListObjectsReader copy = reader;
+  std::vector<std::string> names;
+  for (auto& o : copy) {
+    ASSERT_TRUE(o.ok());
+    names.push_back(o->name());
+  }
+  EXPECT_THAT(names, ContainerEq(std::vector<std::string>{"object-1"}));
+  ++it;
+  ASSERT_NE(reader.end(), it);
+  ASSERT_TRUE(it->ok());
+  EXPECT_EQ("object-1", (*it)->name());
+  EXPECT_EQ(reader.end(), ++it);
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
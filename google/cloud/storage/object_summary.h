@@ -0,0 +1,83 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_SUMMARY_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_SUMMARY_H_
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <tuple>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+struct ObjectSummaryParser;
+}  // namespace internal
+
+/**
+ * A compact subset of the metadata for an object.
+ *
+ * Applications that list many objects, e.g. to build an inventory of a bucket,
+ * often need only a few attributes of each object. `Client::ListObjects()`
+ * returns the full `ObjectMetadata`, including its ACL, the custom metadata
+ * map, and the owner. This class contains only the attributes below, and
+ * `Client::ListObjectSummaries()` asks the service to return only these
+ * fields, reducing both the size of the responses and the memory allocations
+ * to represent each object.
+ */
+class ObjectSummary {
+ public:
+  ObjectSummary() : size_(0), generation_(0) {}
+
+  std::string const& name() const { return name_; }
+  std::uint64_t size() const { return size_; }
+  std::int64_t generation() const { return generation_; }
+  std::string const& crc32c() const { return crc32c_; }
+  std::chrono::system_clock::time_point updated() const { return updated_; }
+
+ private:
+  friend struct internal::ObjectSummaryParser;
+  friend bool operator==(ObjectSummary const& lhs, ObjectSummary const& rhs);
+
+  std::string name_;
+  std::uint64_t size_;
+  std::int64_t generation_;
+  std::string crc32c_;
+  std::chrono::system_clock::time_point updated_;
+};
+
+inline bool operator==(ObjectSummary const& lhs, ObjectSummary const& rhs) {
+  return std::tie(lhs.name_, lhs.generation_, lhs.size_, lhs.crc32c_,
+                  lhs.updated_) == std::tie(rhs.name_, rhs.generation_,
+                                            rhs.size_, rhs.crc32c_,
+                                            rhs.updated_);
+}
+
+inline bool operator!=(ObjectSummary const& lhs, ObjectSummary const& rhs) {
+  return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, ObjectSummary const& rhs);
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_SUMMARY_H_
@@ -31,6 +31,7 @@ using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnRef;
 using ms = std::chrono::milliseconds;
+using testing::canonical_errors::PermanentError;
 using testing::canonical_errors::TransientError;
 
 /**
@@ -211,6 +212,95 @@ TEST_F(ObjectTest, DeleteObjectPermanentFailure) {
       "DeleteObject");
 }
 
+TEST_F(ObjectTest, AsyncInsertObject) {
+  auto expected = internal::ObjectMetadataParser::FromString(R"""({
+      "bucket": "test-bucket-name",
+      "name": "test-object-name",
+      "generation": "12345"
+})""").value();
+
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Invoke(
+          [&expected](internal::InsertObjectMediaRequest const& request) {
+            EXPECT_EQ("test-bucket-name", request.bucket_name());
+            EXPECT_EQ("test-object-name", request.object_name());
+            EXPECT_EQ("test object contents", request.contents());
+            return make_status_or(expected);
+          }));
+
+  auto actual = client
+                    ->AsyncInsertObject("test-bucket-name", "test-object-name",
+                                        "test object contents")
+                    .get();
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ(expected, *actual);
+}
+
+TEST_F(ObjectTest, AsyncGetObjectMetadata) {
+  auto expected = internal::ObjectMetadataParser::FromString(R"""({
+      "bucket": "test-bucket-name",
+      "name": "test-object-name",
+      "generation": "12345"
+})""").value();
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(
+          Invoke([&expected](internal::GetObjectMetadataRequest const& r) {
+            EXPECT_EQ("test-bucket-name", r.bucket_name());
+            EXPECT_EQ("test-object-name", r.object_name());
+            return make_status_or(expected);
+          }));
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                LimitedErrorCountRetryPolicy(2)};
+
+  auto actual =
+      client.AsyncGetObjectMetadata("test-bucket-name", "test-object-name")
+          .get();
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ(expected, *actual);
+}
+
+TEST_F(ObjectTest, AsyncReadObjectPermanentFailure) {
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Return(StatusOr<std::unique_ptr<internal::ObjectReadStreambuf>>(
+          PermanentError())));
+
+  auto actual =
+      client->AsyncReadObject("test-bucket-name", "test-object-name").get();
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("AsyncReadObject"));
+}
+
+TEST_F(ObjectTest, AsyncDeleteObject) {
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillOnce(Return(StatusOr<internal::EmptyResponse>(TransientError())))
+      .WillOnce(Invoke([](internal::DeleteObjectRequest const& r) {
+        EXPECT_EQ("test-bucket-name", r.bucket_name());
+        EXPECT_EQ("test-object-name", r.object_name());
+        return make_status_or(internal::EmptyResponse{});
+      }));
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                LimitedErrorCountRetryPolicy(2),
+                ExponentialBackoffPolicy(ms(1), ms(5), 2)};
+
+  auto status =
+      client.AsyncDeleteObject("test-bucket-name", "test-object-name").get();
+  EXPECT_TRUE(status.ok()) << "status=" << status;
+}
+
+TEST_F(ObjectTest, AsyncDeleteObjectNonIdempotent) {
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillOnce(Return(StatusOr<internal::EmptyResponse>(TransientError())));
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                StrictIdempotencyPolicy()};
+
+  auto status =
+      client.AsyncDeleteObject("test-bucket-name", "test-object-name").get();
+  EXPECT_EQ(TransientError().code(), status.code());
+  EXPECT_THAT(status.message(), HasSubstr("non-idempotent"));
+}
+
 TEST_F(ObjectTest, UpdateObject) {
   std::string text = R"""({
       "bucket": "test-bucket-name",
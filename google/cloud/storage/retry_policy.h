@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_RETRY_POLICY_H_
 
 #include "google/cloud/internal/backoff_policy.h"
+#include "google/cloud/internal/retry_budget.h"
 #include "google/cloud/internal/retry_policy.h"
 #include "google/cloud/status.h"
 
@@ -48,6 +49,26 @@ using LimitedErrorCountRetryPolicy =
     google::cloud::internal::LimitedErrorCountRetryPolicy<
         Status, internal::StatusTraits>;
 
+/// Limit the retries across all the operations sharing a budget.
+using RetryBudget = google::cloud::internal::RetryBudget;
+
+/**
+ * Decorate a retry policy to also consume a shared `RetryBudget`.
+ *
+ * Use this policy to limit the retries across all the `Client` objects (and
+ * all the threads) in the application, for example:
+ *
+ * @code
+ * auto budget = std::make_shared<storage::RetryBudget>(100, 0.1);
+ * storage::Client client(
+ *     options, storage::RetryBudgetPolicy(
+ *                  budget, storage::LimitedTimeRetryPolicy(
+ *                              std::chrono::minutes(1))));
+ * @endcode
+ */
+using RetryBudgetPolicy =
+    google::cloud::internal::RetryBudgetPolicy<Status, internal::StatusTraits>;
+
 /// The backoff policy base class.
 using BackoffPolicy = google::cloud::internal::BackoffPolicy;
 
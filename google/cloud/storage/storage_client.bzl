@@ -17,14 +17,17 @@
 """Automatically generated source lists for storage_client - DO NOT EDIT."""
 
 storage_client_hdrs = [
+    "batch_builder.h",
     "bucket_access_control.h",
     "bucket_metadata.h",
     "client.h",
+    "client_metrics.h",
     "client_options.h",
     "download_options.h",
     "hashing_options.h",
     "idempotency_policy.h",
     "internal/access_control_common.h",
+    "internal/batch_requests.h",
     "internal/binary_data_as_debug_string.h",
     "internal/bucket_acl_requests.h",
     "internal/bucket_requests.h",
@@ -33,6 +36,7 @@ storage_client_hdrs = [
     "internal/compute_engine_util.h",
     "internal/curl_handle.h",
     "internal/curl_handle_factory.h",
+    "internal/curl_multi_reactor.h",
     "internal/curl_download_request.h",
     "internal/curl_request.h",
     "internal/curl_request_builder.h",
@@ -43,6 +47,7 @@ storage_client_hdrs = [
     "internal/curl_resumable_upload_session.h",
     "internal/curl_streambuf.h",
     "internal/default_object_acl_requests.h",
+    "internal/download_buffer_sizer.h",
     "internal/empty_response.h",
     "internal/format_rfc3339.h",
     "internal/generate_message_boundary.h",
@@ -53,12 +58,18 @@ storage_client_hdrs = [
     "internal/logging_client.h",
     "internal/logging_resumable_upload_session.h",
     "internal/metadata_parser.h",
+    "internal/metrics_client.h",
+    "internal/metrics_object_streambuf.h",
+    "internal/metrics_recorder.h",
+    "internal/metrics_resumable_upload_session.h",
     "internal/nljson.h",
     "internal/notification_requests.h",
     "internal/openssl_util.h",
     "internal/object_acl_requests.h",
+    "internal/object_metadata_stream_parser.h",
     "internal/object_requests.h",
     "internal/object_streambuf.h",
+    "internal/parallel_list_objects.h",
     "internal/parse_rfc3339.h",
     "internal/patch_builder.h",
     "internal/raw_client.h",
@@ -70,6 +81,7 @@ storage_client_hdrs = [
     "internal/signed_url_requests.h",
     "lifecycle_rule.h",
     "list_buckets_reader.h",
+    "list_object_summaries_reader.h",
     "list_objects_reader.h",
     "notification_event_type.h",
     "notification_metadata.h",
@@ -87,6 +99,7 @@ storage_client_hdrs = [
     "object_metadata.h",
     "object_rewriter.h",
     "object_stream.h",
+    "object_summary.h",
     "retry_policy.h",
     "service_account.h",
     "signed_url_options.h",
@@ -98,19 +111,23 @@ storage_client_hdrs = [
 ]
 
 storage_client_srcs = [
+    "batch_builder.cc",
     "bucket_access_control.cc",
     "bucket_metadata.cc",
     "client.cc",
+    "client_metrics.cc",
     "client_options.cc",
     "hashing_options.cc",
     "idempotency_policy.cc",
     "internal/access_control_common.cc",
+    "internal/batch_requests.cc",
     "internal/binary_data_as_debug_string.cc",
     "internal/bucket_acl_requests.cc",
     "internal/bucket_requests.cc",
     "internal/compute_engine_util.cc",
     "internal/curl_handle.cc",
     "internal/curl_handle_factory.cc",
+    "internal/curl_multi_reactor.cc",
     "internal/curl_download_request.cc",
     "internal/curl_request.cc",
     "internal/curl_request_builder.cc",
@@ -121,6 +138,7 @@ storage_client_srcs = [
     "internal/curl_resumable_upload_session.cc",
     "internal/curl_streambuf.cc",
     "internal/default_object_acl_requests.cc",
+    "internal/download_buffer_sizer.cc",
     "internal/empty_response.cc",
     "internal/format_rfc3339.cc",
     "internal/hash_validator.cc",
@@ -128,18 +146,26 @@ storage_client_srcs = [
     "internal/logging_client.cc",
     "internal/logging_resumable_upload_session.cc",
     "internal/metadata_parser.cc",
+    "internal/metrics_client.cc",
+    "internal/metrics_object_streambuf.cc",
+    "internal/metrics_recorder.cc",
+    "internal/metrics_resumable_upload_session.cc",
     "internal/notification_requests.cc",
     "internal/openssl_util.cc",
     "internal/object_acl_requests.cc",
+    "internal/object_metadata_stream_parser.cc",
     "internal/object_requests.cc",
     "internal/object_streambuf.cc",
+    "internal/parallel_list_objects.cc",
     "internal/parse_rfc3339.cc",
+    "internal/raw_client.cc",
     "internal/retry_client.cc",
     "internal/retry_resumable_upload_session.cc",
     "internal/service_account_requests.cc",
     "internal/signed_url_requests.cc",
     "lifecycle_rule.cc",
     "list_buckets_reader.cc",
+    "list_object_summaries_reader.cc",
     "list_objects_reader.cc",
     "notification_metadata.cc",
     "oauth2/anonymous_credentials.cc",
@@ -152,6 +178,7 @@ storage_client_srcs = [
     "object_metadata.cc",
     "object_rewriter.cc",
     "object_stream.cc",
+    "object_summary.cc",
     "service_account.cc",
     "signed_url_options.cc",
     "version.cc",
@@ -169,6 +169,15 @@ TEST_F(ClientOptionsTest, SetEnableLockingCallbacks) {
   EXPECT_TRUE(client_options.enable_ssl_locking_callbacks());
 }
 
+TEST_F(ClientOptionsTest, SetEnablePipelinedUploads) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.enable_pipelined_uploads());
+  client_options.set_enable_pipelined_uploads(true);
+  EXPECT_TRUE(client_options.enable_pipelined_uploads());
+  client_options.set_enable_pipelined_uploads(false);
+  EXPECT_FALSE(client_options.enable_pipelined_uploads());
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
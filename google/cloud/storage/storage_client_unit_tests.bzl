@@ -20,28 +20,35 @@ storage_client_unit_tests = [
     "bucket_access_control_test.cc",
     "bucket_metadata_test.cc",
     "bucket_test.cc",
+    "client_batch_test.cc",
     "client_bucket_acl_test.cc",
     "client_default_object_acl_test.cc",
     "client_object_acl_test.cc",
     "client_object_copy_test.cc",
+    "client_parallel_transfer_test.cc",
     "client_service_account_test.cc",
     "client_notifications_test.cc",
     "client_sign_url_test.cc",
+    "client_metrics_test.cc",
     "client_test.cc",
     "client_write_object_test.cc",
     "hashing_options_test.cc",
     "idempotency_policy_test.cc",
     "internal/access_control_common_test.cc",
+    "internal/batch_requests_test.cc",
     "internal/binary_data_as_debug_string_test.cc",
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
     "internal/compute_engine_util_test.cc",
     "internal/curl_client_test.cc",
+    "internal/curl_multi_reactor_test.cc",
+    "internal/curl_resumable_streambuf_test.cc",
     "internal/curl_resumable_upload_session_test.cc",
     "internal/curl_wrappers_locking_already_present_test.cc",
     "internal/curl_wrappers_locking_enabled_test.cc",
     "internal/curl_wrappers_locking_disabled_test.cc",
     "internal/default_object_acl_requests_test.cc",
+    "internal/download_buffer_sizer_test.cc",
     "internal/format_rfc3339_test.cc",
     "internal/generate_message_boundary_test.cc",
     "internal/hash_validator_test.cc",
@@ -49,10 +56,13 @@ storage_client_unit_tests = [
     "internal/logging_client_test.cc",
     "internal/logging_resumable_upload_session_test.cc",
     "internal/metadata_parser_test.cc",
+    "internal/metrics_client_test.cc",
     "internal/nljson_test.cc",
     "internal/notification_requests_test.cc",
     "internal/object_acl_requests_test.cc",
+    "internal/object_metadata_stream_parser_test.cc",
     "internal/object_requests_test.cc",
+    "internal/parallel_list_objects_test.cc",
     "internal/parse_rfc3339_test.cc",
     "internal/patch_builder_test.cc",
     "internal/retry_client_test.cc",
@@ -61,6 +71,7 @@ storage_client_unit_tests = [
     "internal/signed_url_requests_test.cc",
     "lifecycle_rule_test.cc",
     "list_buckets_reader_test.cc",
+    "list_object_summaries_reader_test.cc",
     "list_objects_reader_test.cc",
     "oauth2/anonymous_credentials_test.cc",
     "oauth2/authorized_user_credentials_test.cc",
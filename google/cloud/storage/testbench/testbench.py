@@ -25,6 +25,8 @@ import json
 import os
 import re
 import testbench_utils
+import werkzeug.test
+import werkzeug.wrappers
 from werkzeug import serving
 from werkzeug import wsgi
 
@@ -371,16 +373,29 @@ def objects_list(bucket_name):
     versions_parameter = flask.request.args.get('versions')
     all_versions = (versions_parameter is not None
                     and bool(versions_parameter))
+    prefix = flask.request.args.get('prefix', '')
+    delimiter = flask.request.args.get('delimiter', '')
+    prefixes = set()
     for name, o in testbench_utils.all_objects():
         if name.find(bucket_name + '/o') != 0:
             continue
         if o.get_latest() is None:
             continue
+        object_name = o.get_latest().metadata.get('name', '')
+        if not object_name.startswith(prefix):
+            continue
+        if delimiter != '':
+            index = object_name.find(delimiter, len(prefix))
+            if index != -1:
+                prefixes.add(object_name[:index + len(delimiter)])
+                continue
         if all_versions:
             for object_version in o.revisions.itervalues():
                 result['items'].append(object_version.metadata)
         else:
             result['items'].append(o.get_latest().metadata)
+    if prefixes:
+        result['prefixes'] = sorted(prefixes)
     return testbench_utils.filtered_response(flask.request, result)
 
 
@@ -757,12 +772,101 @@ def xmlapi_put_object(bucket_name, object_name):
     return response
 
 
+# Define the WSGI application to handle batch requests.
+BATCH_HANDLER_PATH = '/batch/storage/v1'
+batch = flask.Flask(__name__)
+batch.debug = True
+
+
+@batch.errorhandler(error_response.ErrorResponse)
+def batch_error(error):
+    return error.as_response()
+
+
+def _parse_batch_part(part):
+    """Split one part of a batch request into the embedded request fields.
+
+    :param part:str the part, including its own headers.
+    :return: the Content-ID of the part, and the method, path, headers, and
+        body of the embedded request.
+    """
+    part_headers, _, embedded = part.partition('\r\n\r\n')
+    content_id = ''
+    for line in part_headers.split('\r\n'):
+        name, _, value = line.partition(':')
+        if name.strip().lower() == 'content-id':
+            content_id = value.strip().strip('<>')
+    request_headers, _, body = embedded.partition('\r\n\r\n')
+    lines = request_headers.split('\r\n')
+    method, path, _ = lines[0].split(' ', 2)
+    headers = {}
+    for line in lines[1:]:
+        name, _, value = line.partition(':')
+        headers[name.strip()] = value.strip()
+    return content_id, method, path, headers, body
+
+
+@batch.route('/', methods=['POST'])
+def batch_execute():
+    """Implement the batch endpoint for the JSON API.
+
+    Each part in the multipart/mixed payload contains a complete HTTP request,
+    these are dispatched to the testbench application and their responses are
+    returned as the parts of a multipart/mixed response.
+    """
+    content_type = flask.request.headers.get('content-type', '')
+    match = re.search('boundary="?([^";]+)"?', content_type)
+    if not content_type.startswith('multipart/mixed') or match is None:
+        raise error_response.ErrorResponse(
+            'Missing or invalid content-type header in batch request')
+    boundary = match.group(1)
+    body = flask.request.get_data()
+    end = body.find('--' + boundary + '--')
+    if end != -1:
+        body = body[:end]
+    parts = [p for p in body.split('--' + boundary + '\r\n') if p != '']
+    if len(parts) > 100:
+        raise error_response.ErrorResponse(
+            'Too many requests in a batch (%d)' % len(parts))
+
+    client = werkzeug.test.Client(application, werkzeug.wrappers.BaseResponse)
+    response_boundary = 'batch_' + base64.b16encode(os.urandom(16))
+    payload = ''
+    for part in parts:
+        # Remove the CRLF that belongs to the following delimiter.
+        if part.endswith('\r\n'):
+            part = part[:-2]
+        content_id, method, path, headers, data = _parse_batch_part(part)
+        headers.pop('Content-Length', None)
+        headers.setdefault('Authorization',
+                           flask.request.headers.get('Authorization', ''))
+        result = client.open(
+            path=path,
+            method=method,
+            headers=headers,
+            data=data,
+            base_url=flask.request.host_url)
+        payload += '--' + response_boundary + '\r\n'
+        payload += 'Content-Type: application/http\r\n'
+        payload += 'Content-ID: <response-%s>\r\n\r\n' % content_id
+        payload += 'HTTP/1.1 %s\r\n' % result.status
+        for name, value in result.headers.items():
+            payload += '%s: %s\r\n' % (name, value)
+        payload += '\r\n' + result.get_data() + '\r\n'
+    payload += '--' + response_boundary + '--\r\n'
+    response = flask.make_response(payload)
+    response.headers['Content-Type'] = (
+        'multipart/mixed; boundary=' + response_boundary)
+    return response
+
+
 application = wsgi.DispatcherMiddleware(
     root, {
         '/httpbin': httpbin.app,
         GCS_HANDLER_PATH: gcs,
         UPLOAD_HANDLER_PATH: upload,
         XMLAPI_HANDLER_PATH: xmlapi,
+        BATCH_HANDLER_PATH: batch,
     })
 
 
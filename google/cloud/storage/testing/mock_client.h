@@ -67,6 +67,7 @@ class MockClient : public google::cloud::storage::internal::RawClient {
                    internal::InsertObjectStreamingRequest const&));
   MOCK_METHOD1(ListObjects, StatusOr<internal::ListObjectsResponse>(
                                 internal::ListObjectsRequest const&));
+  MOCK_CONST_METHOD0(SupportsAsync, bool());
   MOCK_METHOD1(DeleteObject, StatusOr<internal::EmptyResponse>(
                                  internal::DeleteObjectRequest const&));
   MOCK_METHOD1(UpdateObject, StatusOr<storage::ObjectMetadata>(
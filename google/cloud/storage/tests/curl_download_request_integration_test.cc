@@ -74,6 +74,81 @@ TEST(CurlDownloadRequestTest, SimpleStream) {
   EXPECT_EQ(kDownloadedLines, count);
 }
 
+TEST(CurlDownloadRequestTest, SimpleStreamReactor) {
+  // httpbin can generate up to 100 lines, do not try to download more than
+  // that.
+  constexpr int kDownloadedLines = 100;
+  auto reactor = std::make_shared<CurlMultiReactor>(2);
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/stream/" + std::to_string(kDownloadedLines),
+      storage::internal::GetDefaultCurlHandleFactory());
+  request.SetReactor(reactor);
+
+  auto download = request.BuildDownloadRequest(std::string{});
+
+  StatusOr<HttpResponse> response;
+  std::string buffer;
+  std::iterator_traits<std::string::iterator>::difference_type count = 0;
+  do {
+    response = download.GetMore(buffer);
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    count += std::count(buffer.begin(), buffer.end(), '\n');
+  } while (response->status_code == 100);
+
+  EXPECT_EQ(200, response->status_code);
+  EXPECT_EQ(kDownloadedLines, count);
+}
+
+TEST(CurlDownloadRequestTest, StreamIntoBuffer) {
+  constexpr int kDownloadedBytes = 256 * 1024;
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/stream-bytes/" + std::to_string(kDownloadedBytes),
+      storage::internal::GetDefaultCurlHandleFactory());
+  request.SetInitialBufferSize(16 * 1024);
+
+  auto download = request.BuildDownloadRequest(std::string{});
+
+  StatusOr<HttpResponse> response;
+  std::vector<char> buffer(24 * 1024);
+  std::size_t count = 0;
+  do {
+    std::size_t bytes_read = 0;
+    response = download.GetMore(buffer.data(), buffer.size(), bytes_read);
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    ASSERT_LE(bytes_read, buffer.size());
+    count += bytes_read;
+  } while (response->status_code == 100);
+
+  EXPECT_EQ(200, response->status_code);
+  EXPECT_EQ(kDownloadedBytes, count);
+}
+
+TEST(CurlDownloadRequestTest, StreamIntoBufferReactor) {
+  constexpr int kDownloadedBytes = 256 * 1024;
+  auto reactor = std::make_shared<CurlMultiReactor>(2);
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/stream-bytes/" + std::to_string(kDownloadedBytes),
+      storage::internal::GetDefaultCurlHandleFactory());
+  request.SetInitialBufferSize(16 * 1024);
+  request.SetReactor(reactor);
+
+  auto download = request.BuildDownloadRequest(std::string{});
+
+  StatusOr<HttpResponse> response;
+  std::vector<char> buffer(24 * 1024);
+  std::size_t count = 0;
+  do {
+    std::size_t bytes_read = 0;
+    response = download.GetMore(buffer.data(), buffer.size(), bytes_read);
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    ASSERT_LE(bytes_read, buffer.size());
+    count += bytes_read;
+  } while (response->status_code == 100);
+
+  EXPECT_EQ(200, response->status_code);
+  EXPECT_EQ(kDownloadedBytes, count);
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -337,6 +337,61 @@ TEST_F(ObjectIntegrationTest, BasicReadWrite) {
   ASSERT_TRUE(status.ok()) << "status=" << status;
 }
 
+TEST_F(ObjectIntegrationTest, AsyncBasicCRUD) {
+  StatusOr<Client> client = Client::CreateDefaultClient();
+  ASSERT_TRUE(client.ok()) << "status=" << client.status();
+
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+  std::string expected = LoremIpsum();
+
+  // Start several operations before waiting on any of them.
+  int const object_count = 8;
+  std::vector<std::string> names;
+  std::vector<future<StatusOr<ObjectMetadata>>> inserts;
+  for (int i = 0; i != object_count; ++i) {
+    names.push_back(MakeRandomObjectName());
+    inserts.push_back(client->AsyncInsertObject(
+        bucket_name, names.back(), expected, IfGenerationMatch(0)));
+  }
+  std::vector<ObjectMetadata> inserted;
+  for (auto& f : inserts) {
+    auto meta = f.get();
+    ASSERT_TRUE(meta.ok()) << "status=" << meta.status();
+    inserted.push_back(*std::move(meta));
+  }
+
+  for (int i = 0; i != object_count; ++i) {
+    auto get_meta =
+        client->AsyncGetObjectMetadata(bucket_name, names[i]).get();
+    ASSERT_TRUE(get_meta.ok()) << "status=" << get_meta.status();
+    EXPECT_EQ(names[i], get_meta->name());
+    EXPECT_EQ(inserted[i].generation(), get_meta->generation());
+
+    auto contents = client->AsyncReadObject(bucket_name, names[i]).get();
+    ASSERT_TRUE(contents.ok()) << "status=" << contents.status();
+    EXPECT_EQ(expected, *contents);
+
+    auto range = client
+                     ->AsyncReadObject(bucket_name, names[i], ReadRange(0, 16))
+                     .get();
+    ASSERT_TRUE(range.ok()) << "status=" << range.status();
+    EXPECT_EQ(expected.substr(0, 16), *range);
+  }
+
+  std::vector<future<Status>> deletes;
+  for (int i = 0; i != object_count; ++i) {
+    deletes.push_back(client->AsyncDeleteObject(
+        bucket_name, names[i], Generation(inserted[i].generation())));
+  }
+  for (auto& f : deletes) {
+    auto status = f.get();
+    EXPECT_TRUE(status.ok()) << "status=" << status;
+  }
+
+  auto get_meta = client->AsyncGetObjectMetadata(bucket_name, names[0]).get();
+  EXPECT_FALSE(get_meta.ok());
+}
+
 TEST_F(ObjectIntegrationTest, EncryptedReadWrite) {
   StatusOr<Client> client = Client::CreateDefaultClient();
   ASSERT_TRUE(client.ok()) << "status=" << client.status();
@@ -24,6 +24,7 @@
 #include <fstream>
 #include <regex>
 #include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -127,6 +128,53 @@ TEST_F(ObjectMediaIntegrationTest, JsonDownloadFile) {
   EXPECT_EQ(0, std::remove(file_name.c_str()));
 }
 
+TEST_F(ObjectMediaIntegrationTest, ParallelDownloadFile) {
+  StatusOr<Client> client = Client::CreateDefaultClient();
+  ASSERT_TRUE(client.ok()) << "status=" << client.status();
+
+  auto bucket_name = ObjectMediaTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+  auto file_name = MakeRandomObjectName();
+
+  // We will construct the expected response while streaming the data up.
+  std::ostringstream expected;
+  // Create an object with the contents to download.
+  auto upload =
+      client->WriteObject(bucket_name, object_name, IfGenerationMatch(0));
+  WriteRandomLines(upload, expected);
+  upload.Close();
+  ObjectMetadata meta = upload.metadata().value();
+
+  auto status = client->DownloadToFile(bucket_name, object_name, file_name,
+                                       ParallelDownloadSlices(7));
+  ASSERT_TRUE(status.ok()) << "status=" << status;
+  // Create a iostream to read the object back.
+  std::ifstream stream(file_name, std::ios::binary);
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  ASSERT_FALSE(actual.empty());
+  auto expected_str = expected.str();
+  ASSERT_EQ(expected_str.size(), actual.size()) << " meta=" << meta;
+  EXPECT_EQ(expected_str, actual);
+
+  status = client->DeleteObject(bucket_name, object_name);
+  EXPECT_TRUE(status.ok()) << "status=" << status;
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectMediaIntegrationTest, ParallelDownloadFileFailure) {
+  StatusOr<Client> client = Client::CreateDefaultClient();
+  ASSERT_TRUE(client.ok()) << "status=" << client.status();
+
+  auto bucket_name = ObjectMediaTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+  auto file_name = MakeRandomObjectName();
+
+  auto status = client->DownloadToFile(bucket_name, object_name, file_name,
+                                       ParallelDownloadSlices(4));
+  EXPECT_FALSE(status.ok());
+  EXPECT_THAT(status.message(), HasSubstr(object_name));
+}
+
 TEST_F(ObjectMediaIntegrationTest, DownloadFileFailure) {
   StatusOr<Client> client = Client::CreateDefaultClient();
   ASSERT_TRUE(client.ok()) << "status=" << client.status();
@@ -575,6 +623,74 @@ TEST_F(ObjectMediaIntegrationTest, UploadFileResumableUploadFailure) {
   EXPECT_EQ(0, std::remove(file_name.c_str()));
 }
 
+TEST_F(ObjectMediaIntegrationTest, UploadFileParallel) {
+  StatusOr<Client> client = Client::CreateDefaultClient();
+  ASSERT_TRUE(client.ok()) << "status=" << client.status();
+
+  auto file_name = ::testing::TempDir() + MakeRandomObjectName();
+  auto bucket_name = ObjectMediaTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+
+  // We will construct the expected response while streaming the data up.
+  std::ostringstream expected;
+  // Create a file with the contents to upload.
+  std::ofstream os(file_name);
+  auto desired_size = (5 * internal::UploadChunkRequest::kChunkSizeQuantum / 2);
+  WriteRandomLines(os, expected, desired_size / 128, 128);
+  os.close();
+
+  // Use more than 32 shards to exercise the intermediate compose requests.
+  StatusOr<ObjectMetadata> meta = client->UploadFile(
+      file_name, bucket_name, object_name, IfGenerationMatch(0),
+      ParallelUploadShards(40), ContentType("text/plain"));
+  ASSERT_TRUE(meta.ok()) << "status=" << meta.status();
+  EXPECT_EQ(object_name, meta->name());
+  EXPECT_EQ(bucket_name, meta->bucket());
+  EXPECT_EQ("text/plain", meta->content_type());
+  auto expected_str = expected.str();
+  ASSERT_EQ(expected_str.size(), meta->size());
+
+  // Create a iostream to read the object back.
+  auto stream = client->ReadObject(bucket_name, object_name);
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  ASSERT_FALSE(actual.empty());
+  EXPECT_EQ(expected_str.size(), actual.size()) << " meta=" << *meta;
+  EXPECT_EQ(expected_str, actual);
+
+  // The temporary objects should have been deleted.
+  std::vector<std::string> names;
+  for (auto&& o : client->ListObjects(bucket_name)) {
+    ASSERT_TRUE(o.ok()) << "status=" << o.status();
+    if (o->name().find(object_name) == 0) {
+      names.push_back(o->name());
+    }
+  }
+  EXPECT_THAT(names, ::testing::ElementsAre(object_name));
+
+  auto status = client->DeleteObject(bucket_name, object_name);
+  EXPECT_TRUE(status.ok()) << "status=" << status;
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectMediaIntegrationTest, UploadFileParallelUploadFailure) {
+  StatusOr<Client> client = Client::CreateDefaultClient();
+  ASSERT_TRUE(client.ok()) << "status=" << client.status();
+  auto file_name = ::testing::TempDir() + MakeRandomObjectName();
+  auto bucket_name = MakeRandomBucketName();
+  auto object_name = MakeRandomObjectName();
+
+  // Create the file.
+  std::ofstream(file_name) << LoremIpsum();
+
+  // Trying to upload the file to a non-existing bucket should fail.
+  StatusOr<ObjectMetadata> meta =
+      client->UploadFile(file_name, bucket_name, object_name,
+                         IfGenerationMatch(0), ParallelUploadShards(4));
+  EXPECT_FALSE(meta.ok()) << "value=" << meta.value();
+
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
 TEST_F(ObjectMediaIntegrationTest, StreamingReadClose) {
   StatusOr<Client> client = Client::CreateDefaultClient();
   ASSERT_TRUE(client.ok()) << "status=" << client.status();
@@ -613,6 +729,47 @@ TEST_F(ObjectMediaIntegrationTest, StreamingReadClose) {
   EXPECT_TRUE(status.ok()) << "status=" << status;
 }
 
+/// @test Verify large reads are written directly into the application buffer.
+TEST_F(ObjectMediaIntegrationTest, ReadIntoLargeBuffer) {
+  StatusOr<Client> client = Client::CreateDefaultClient();
+  ASSERT_TRUE(client.ok()) << "status=" << client.status();
+
+  auto bucket_name = ObjectMediaTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+
+  long const lines = 4 * 1024 * 1024 / 128;
+  std::string large_text;
+  for (long i = 0; i != lines; ++i) {
+    auto line = google::cloud::internal::Sample(generator_, 127,
+                                                "abcdefghijklmnopqrstuvwxyz"
+                                                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                                "012456789");
+    large_text += line + "\n";
+  }
+  StatusOr<ObjectMetadata> source_meta = client->InsertObject(
+      bucket_name, object_name, large_text, IfGenerationMatch(0));
+  ASSERT_TRUE(source_meta.ok()) << "status=" << source_meta.status();
+
+  auto stream = client->ReadObject(bucket_name, object_name);
+  // Start with a small read, so the first large read() consumes the data
+  // already buffered by the stream before reading directly.
+  std::string actual(128, '\0');
+  stream.read(&actual[0], actual.size());
+  ASSERT_EQ(128, stream.gcount());
+
+  std::vector<char> buffer(1024 * 1024 + 7);
+  while (stream.read(buffer.data(), buffer.size()), stream.gcount() > 0) {
+    actual.append(buffer.data(), static_cast<std::size_t>(stream.gcount()));
+  }
+  EXPECT_FALSE(stream.bad());
+  EXPECT_TRUE(stream.status().ok()) << "status=" << stream.status();
+  EXPECT_EQ(large_text.size(), actual.size());
+  EXPECT_EQ(large_text, actual);
+
+  auto status = client->DeleteObject(bucket_name, object_name);
+  EXPECT_TRUE(status.ok()) << "status=" << status;
+}
+
 /// @test Read a portion of a relatively large object using the JSON API.
 TEST_F(ObjectMediaIntegrationTest, ReadRangeJSON) {
   // The testbench always requires multiple iterations to copy this object.
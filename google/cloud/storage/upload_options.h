@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_UPLOAD_OPTIONS_H_
 
 #include "google/cloud/storage/internal/complex_option.h"
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -49,6 +50,55 @@ inline UseResumableUploadSession NewResumableUploadSession() {
   return UseResumableUploadSession("");
 }
 
+/**
+ * Upload a file using multiple streams in parallel.
+ *
+ * When this option is used with `Client::UploadFile()` and its value is larger
+ * than one, the file is split into (at most) that many shards. Each shard is
+ * uploaded concurrently, as a temporary object in the destination bucket, and
+ * then the shards are combined using `ComposeObject()`. The temporary objects
+ * are deleted once the destination object is created. If the CRC32C checksum
+ * of the destination object does not match the local data the destination
+ * object is deleted too.
+ *
+ * Parallel uploads can be resumed if the application provides a
+ * `ParallelUploadId`, see its documentation for details.
+ *
+ * @note Composite objects do not have an MD5 hash, the `MD5HashValue` option
+ *   is ignored in parallel uploads. The option is also ignored when
+ *   `UseResumableUploadSession` restores a previous upload session.
+ *
+ * @note The compose API does not support the `IfGenerationNotMatch`,
+ *   `IfMetagenerationNotMatch`, and `Projection` options, parallel uploads
+ *   using any of them fail with `StatusCode::kInvalidArgument`.
+ */
+struct ParallelUploadShards
+    : public internal::ComplexOption<ParallelUploadShards, std::size_t> {
+  using ComplexOption<ParallelUploadShards, std::size_t>::ComplexOption;
+  static char const* name() { return "parallel-upload-shards"; }
+};
+
+/**
+ * Identify a parallel upload, so it can be resumed if interrupted.
+ *
+ * The names of the temporary objects created by a parallel upload include this
+ * value. Without this option the library uses a random value, so concurrent
+ * uploads of the same object never share temporary objects. Such uploads
+ * cannot be resumed, and their temporary objects are deleted if the upload
+ * fails.
+ *
+ * When this option is used the temporary objects are kept if the upload fails.
+ * Calling `Client::UploadFile()` again, with the same file, the same number of
+ * shards, and the same `ParallelUploadId`, skips any shard that was already
+ * uploaded and whose CRC32C checksum matches the local data. Concurrent uploads
+ * of the same object must use different values.
+ */
+struct ParallelUploadId
+    : public internal::ComplexOption<ParallelUploadId, std::string> {
+  using ComplexOption<ParallelUploadId, std::string>::ComplexOption;
+  static char const* name() { return "parallel-upload-id"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
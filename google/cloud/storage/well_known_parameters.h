@@ -68,6 +68,19 @@ struct ContentEncoding
   static char const* well_known_parameter_name() { return "contentEncoding"; }
 };
 
+/**
+ * Returns results in a directory-like mode.
+ *
+ * Objects whose names, aside from the `Prefix`, do not contain the delimiter
+ * are returned in the `items` of the response. Objects whose names contain the
+ * delimiter are grouped by the name prefix up to (and including) the first
+ * occurrence of the delimiter, only these common prefixes are returned.
+ */
+struct Delimiter : public internal::WellKnownParameter<Delimiter, std::string> {
+  using WellKnownParameter<Delimiter, std::string>::WellKnownParameter;
+  static char const* well_known_parameter_name() { return "delimiter"; }
+};
+
 /**
  * Configure the Customer-Managed Encryption Key (CMEK) for an rewrite.
  *